@@ -87,6 +87,7 @@ enum class TransformChanged
 	TRANSLATION = 0x01,
 	ROTATION = 0x02,
 	SCALE = 0x04,
+	RENDER_POSE = 0x08, //Interpolated physics pose only (TransformHierarchy::SetRenderPose), the local transform is unchanged
 };
 ENABLE_BITMASK_OPERATORS(TransformChanged)
 #pragma endregion
\ No newline at end of file
@@ -12,6 +12,7 @@ int GameStats::m_FrameTimingCount = 20;
 float GameStats::m_InterimDelay = 1.f;
 std::deque<float> GameStats::m_FrameMsTimings = {};
 PerfStats GameStats::m_Stats = {};
+FrameStats GameStats::m_FrameStats = {};
 
 void GameStats::BeginFrame()
 {
@@ -28,6 +29,8 @@ void GameStats::BeginFrame()
 		m_ResetPending = false;
 	}
 
+	m_FrameStats.Reset();
+
 	m_FrameStart = std::chrono::steady_clock::now();
 	m_IsMeasuring = true;
 
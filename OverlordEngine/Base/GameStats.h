@@ -9,6 +9,7 @@ public:
 	static void EndFrame();
 	static void Reset();
 	static const PerfStats& GetStats() { return m_Stats; }
+	static FrameStats& GetFrameStats() { return m_FrameStats; } //Reset every frame
 
 private:
 	static bool m_IsMeasuring;
@@ -21,5 +22,6 @@ private:
 	static std::deque<float> m_FrameMsTimings;
 
 	static PerfStats m_Stats;
+	static FrameStats m_FrameStats;
 };
 
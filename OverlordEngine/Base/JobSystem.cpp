@@ -0,0 +1,296 @@
+#include "stdafx.h"
+#include "JobSystem.h"
+
+namespace
+{
+	//Identifies the pool (and its queue) the current thread works for
+	thread_local const JobSystem* s_pOwner{};
+	thread_local UINT s_QueueIndex{};
+}
+
+bool JobSystem::Counter::IsDone() const
+{
+	if (m_Pending.load(std::memory_order_acquire) != 0)
+		return false;
+
+	//The last Finish may still hold the lock
+	std::lock_guard lock{ m_Mutex };
+	return true;
+}
+
+JobSystem::JobSystem(UINT workerCount)
+{
+	if (workerCount == 0)
+	{
+		const UINT hardwareThreads{ std::thread::hardware_concurrency() };
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	m_Queues.reserve(workerCount + 1);
+	for (UINT i{}; i <= workerCount; ++i)
+	{
+		m_Queues.emplace_back(std::make_unique<WorkerQueue>());
+	}
+
+	m_Stats.resize(workerCount + 1);
+	m_LastSample = std::chrono::steady_clock::now();
+
+	m_Workers.reserve(workerCount);
+	for (UINT i{ 1 }; i <= workerCount; ++i)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	Logger::LogInfo(L"JobSystem > {} worker threads", workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock{ m_WakeMutex };
+		m_IsShuttingDown = true;
+	}
+	m_WakeCondition.notify_all();
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::Run(JobFunction function, Counter* pCounter, Counter* pDependency)
+{
+	if (pCounter)
+		pCounter->m_Pending.fetch_add(1, std::memory_order_acq_rel);
+
+	Job job{ std::move(function), pCounter };
+
+	if (pDependency)
+	{
+		//Checked under the dependency's lock, Finish drains the continuations under the same lock
+		std::lock_guard lock{ pDependency->m_Mutex };
+		if (pDependency->m_Pending.load(std::memory_order_acquire) != 0)
+		{
+			pDependency->m_Continuations.emplace_back(std::move(job));
+			m_ParkedJobs.fetch_add(1);
+			return;
+		}
+	}
+
+	Push(std::move(job));
+}
+
+void JobSystem::ParallelFor(UINT count, const RangeFunction& function, UINT batchSize)
+{
+	if (count == 0)
+		return;
+
+	//Default: ~4 batches per thread (load balancing through stealing)
+	if (batchSize == 0)
+	{
+		const UINT targetBatches{ (GetWorkerCount() + 1) * 4 };
+		batchSize = std::max(1u, (count + targetBatches - 1) / targetBatches);
+	}
+
+	if (batchSize >= count)
+	{
+		function(0, count);
+		return;
+	}
+
+	Counter counter{};
+	for (UINT begin{ batchSize }; begin < count; begin += batchSize)
+	{
+		const UINT end{ std::min(begin + batchSize, count) };
+		Run([&function, begin, end]() { function(begin, end); }, &counter);
+	}
+
+	//First batch on the calling thread
+	function(0, batchSize);
+
+	Wait(counter);
+}
+
+void JobSystem::Wait(const Counter& counter)
+{
+	const UINT queueIndex{ GetCurrentQueue() };
+	while (!counter.IsDone())
+	{
+		if (!TryExecuteOne(queueIndex))
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::SampleStats()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const float elapsedNs{ static_cast<float>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastSample).count()) };
+	m_LastSample = now;
+
+	for (size_t i{}; i < m_Queues.size(); ++i)
+	{
+		WorkerQueue& queue = *m_Queues[i];
+		WorkerStats& stats = m_Stats[i];
+
+		stats.utilisation = elapsedNs > 0.f ? std::min(1.f, static_cast<float>(queue.busyNs.exchange(0)) / elapsedNs) : 0.f;
+		stats.jobsExecuted = queue.jobsExecuted.exchange(0);
+		stats.jobsStolen = queue.jobsStolen.exchange(0);
+	}
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+	return s_pOwner == this && s_QueueIndex != m_ExternalQueue;
+}
+
+void JobSystem::WorkerLoop(UINT queueIndex)
+{
+	s_pOwner = this;
+	s_QueueIndex = queueIndex;
+
+	//Content loaded on workers goes through WIC (textures)
+	const HRESULT comResult{ CoInitializeEx(nullptr, COINIT_MULTITHREADED) };
+
+	while (true)
+	{
+		if (TryExecuteOne(queueIndex))
+			continue;
+
+		std::unique_lock lock{ m_WakeMutex };
+		m_SleepingWorkers.fetch_add(1);
+		m_WakeCondition.wait(lock, [this]() { return m_QueuedJobs.load() > 0 || m_IsShuttingDown.load(); });
+		m_SleepingWorkers.fetch_sub(1);
+
+		//Queued work (parked continuations included) is finished before shutting down
+		if (m_IsShuttingDown.load() && m_QueuedJobs.load() == 0)
+		{
+			if (m_ParkedJobs.load() == 0)
+				break;
+
+			//Released by a job that is still running on another worker
+			lock.unlock();
+			std::this_thread::yield();
+		}
+	}
+
+	if (SUCCEEDED(comResult))
+	{
+		CoUninitialize();
+	}
+}
+
+void JobSystem::Push(Job&& job)
+{
+	WorkerQueue& queue = *m_Queues[GetCurrentQueue()];
+	{
+		std::lock_guard lock{ queue.mutex };
+		queue.jobs.emplace_back(std::move(job));
+	}
+
+	//Only touch the wake mutex when someone is (about to be) asleep
+	m_QueuedJobs.fetch_add(1);
+	if (m_SleepingWorkers.load() > 0)
+	{
+		{ std::lock_guard lock{ m_WakeMutex }; }
+		m_WakeCondition.notify_one();
+	}
+}
+
+bool JobSystem::TryPop(UINT queueIndex, Job& job, bool& isStolen)
+{
+	//Own queue first (workers pop their newest job, the external queue is FIFO)
+	{
+		WorkerQueue& queue = *m_Queues[queueIndex];
+		std::lock_guard lock{ queue.mutex };
+		if (!queue.jobs.empty())
+		{
+			if (queueIndex == m_ExternalQueue)
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+			else
+			{
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			}
+
+			isStolen = false;
+			return true;
+		}
+	}
+
+	//Steal the oldest job of another queue
+	const UINT queueCount{ static_cast<UINT>(m_Queues.size()) };
+	for (UINT offset{ 1 }; offset < queueCount; ++offset)
+	{
+		WorkerQueue& victim = *m_Queues[(queueIndex + offset) % queueCount];
+		std::lock_guard lock{ victim.mutex };
+		if (!victim.jobs.empty())
+		{
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+
+			isStolen = true;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::TryExecuteOne(UINT queueIndex)
+{
+	Job job{};
+	bool isStolen{};
+	if (!TryPop(queueIndex, job, isStolen))
+		return false;
+
+	m_QueuedJobs.fetch_sub(1);
+	Execute(job, queueIndex, isStolen);
+	return true;
+}
+
+void JobSystem::Execute(Job& job, UINT queueIndex, bool isStolen)
+{
+	const auto start = std::chrono::steady_clock::now();
+	job.function();
+	const auto end = std::chrono::steady_clock::now();
+
+	WorkerQueue& queue = *m_Queues[queueIndex];
+	queue.busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+	queue.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+	if (isStolen)
+		queue.jobsStolen.fetch_add(1, std::memory_order_relaxed);
+
+	Finish(job.pCounter);
+}
+
+void JobSystem::Finish(Counter* pCounter)
+{
+	if (!pCounter)
+		return;
+
+	//Last job of the counter releases the jobs that depend on it
+	//(the counter is not touched after the lock is released, waiters may destroy it)
+	std::vector<Job> continuations{};
+	{
+		std::lock_guard lock{ pCounter->m_Mutex };
+		if (pCounter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			continuations.swap(pCounter->m_Continuations);
+	}
+
+	//Queued before they stop counting as parked, the workers never see both counts at zero in between
+	for (Job& continuation : continuations)
+	{
+		Push(std::move(continuation));
+	}
+
+	if (!continuations.empty())
+		m_ParkedJobs.fetch_sub(static_cast<UINT>(continuations.size()));
+}
+
+UINT JobSystem::GetCurrentQueue() const
+{
+	return s_pOwner == this ? s_QueueIndex : m_ExternalQueue;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+//Engine-wide worker pool (owned by OverlordGame)
+//Every worker owns a deque (LIFO for the owner, FIFO for thieves), jobs submitted from outside the pool (main thread)
+//go to a shared external queue. Idle workers steal from the other queues before going to sleep.
+class JobSystem final
+{
+	struct Job;
+
+public:
+	using JobFunction = std::function<void()>;
+	using RangeFunction = std::function<void(UINT begin, UINT end)>;
+
+	//Tracks a group of jobs, jobs can be chained to a counter (run once all its jobs are done)
+	class Counter final
+	{
+	public:
+		Counter() = default;
+		~Counter() = default;
+		Counter(const Counter& other) = delete;
+		Counter(Counter&& other) noexcept = delete;
+		Counter& operator=(const Counter& other) = delete;
+		Counter& operator=(Counter&& other) noexcept = delete;
+
+		bool IsDone() const;
+		UINT GetPending() const { return m_Pending.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		//Decremented under the mutex, IsDone syncs with it so the counter can be destroyed once it returns true
+		std::atomic<UINT> m_Pending{};
+		mutable std::mutex m_Mutex{};
+		std::vector<Job> m_Continuations{};
+	};
+
+	struct WorkerStats
+	{
+		float utilisation{}; //Busy time / wall time since the previous SampleStats [0,1]
+		UINT jobsExecuted{};
+		UINT jobsStolen{};
+	};
+
+	explicit JobSystem(UINT workerCount = 0); //0 == one worker per hardware thread (minus the main thread)
+	~JobSystem(); //Finishes all queued jobs before joining the workers
+	JobSystem(const JobSystem& other) = delete;
+	JobSystem(JobSystem&& other) noexcept = delete;
+	JobSystem& operator=(const JobSystem& other) = delete;
+	JobSystem& operator=(JobSystem&& other) noexcept = delete;
+
+	//pCounter (optional) is incremented now and decremented once the job finished
+	//pDependency (optional) delays the job until all jobs of that counter are done
+	void Run(JobFunction function, Counter* pCounter = nullptr, Counter* pDependency = nullptr);
+
+	//Calls function(begin, end) for batches of [0, count), blocks until all batches are done (the calling thread helps)
+	void ParallelFor(UINT count, const RangeFunction& function, UINT batchSize = 0);
+
+	//Executes queued jobs on the calling thread until the counter reaches zero
+	void Wait(const Counter& counter);
+	//Executes one queued job on the calling thread, false when there was none (helping waits on something other than a Counter)
+	bool TryRunOne() { return TryExecuteOne(GetCurrentQueue()); }
+
+	//Per-queue utilisation since the previous call (index 0 == external threads helping in Wait/ParallelFor)
+	void SampleStats();
+	const std::vector<WorkerStats>& GetStats() const { return m_Stats; }
+
+	UINT GetWorkerCount() const { return static_cast<UINT>(m_Workers.size()); }
+	bool IsWorkerThread() const;
+
+private:
+	struct Job
+	{
+		JobFunction function{};
+		Counter* pCounter{};
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex mutex{};
+		std::deque<Job> jobs{};
+
+		//Stats (written by the executing thread, read & reset by SampleStats)
+		std::atomic<long long> busyNs{};
+		std::atomic<UINT> jobsExecuted{};
+		std::atomic<UINT> jobsStolen{};
+	};
+
+	static constexpr UINT m_ExternalQueue{ 0 };
+
+	void WorkerLoop(UINT queueIndex);
+	void Push(Job&& job);
+	bool TryPop(UINT queueIndex, Job& job, bool& isStolen);
+	bool TryExecuteOne(UINT queueIndex);
+	void Execute(Job& job, UINT queueIndex, bool isStolen);
+	void Finish(Counter* pCounter);
+	UINT GetCurrentQueue() const;
+
+	std::vector<std::thread> m_Workers{};
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues{}; //[0] == external, [1..n] == workers
+
+	std::atomic<UINT> m_QueuedJobs{};
+	std::atomic<UINT> m_ParkedJobs{}; //Continuations waiting for their dependency (not in a queue yet)
+	std::atomic<UINT> m_SleepingWorkers{};
+	std::atomic<bool> m_IsShuttingDown{};
+	std::mutex m_WakeMutex{};
+	std::condition_variable m_WakeCondition{};
+
+	std::chrono::time_point<std::chrono::steady_clock> m_LastSample{};
+	std::vector<WorkerStats> m_Stats{};
+};
@@ -14,6 +14,9 @@ OverlordGame::~OverlordGame()
 	SafeRelease(m_GameContext.d3dContext.pAdapter);
 	SafeRelease(m_GameContext.d3dContext.pOutput);
 
+	//Jobs can still reference managers/scenes, finish them first
+	SafeDelete(m_pJobSystem);
+
 	//Game Cleanup
 	MaterialManager::Destroy();
 	ContentManager::Release(); //TODO > Singleton
@@ -326,6 +329,10 @@ HRESULT OverlordGame::InitializeGame()
 	//MANAGER INITIALIZE
 	TextureData::CreateGUID();
 
+	//Before the managers (copied into their GameContext)
+	m_pJobSystem = new JobSystem(m_GameContext.jobWorkerCount);
+	m_GameContext.pJobSystem = m_pJobSystem;
+
 	ContentManager::Initialize(m_GameContext);
 	DebugRenderer::Initialize(m_GameContext);
 	InputManager::Initialize(m_GameContext);
@@ -454,6 +461,7 @@ LRESULT OverlordGame::WindowProcedureHook(HWND hWnd, UINT message, WPARAM wParam
 void OverlordGame::GameLoop() const
 {
 	GameStats::BeginFrame();
+	m_pJobSystem->SampleStats(); //Utilisation of the previous frame
 
 	//******
 	//UPDATE
@@ -1,6 +1,7 @@
 #pragma once
 
 class RenderTarget;
+class JobSystem;
 
 class OverlordGame
 {
@@ -22,6 +23,8 @@ public:
 	void SetRenderTarget(RenderTarget* renderTarget);
 	RenderTarget* GetRenderTarget() const;
 
+	JobSystem* GetJobSystem() const { return m_pJobSystem; }
+
 protected:
 	virtual void OnGamePreparing(GameContext& /*gameContext*/){}
 	virtual LRESULT WindowProcedureHook(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
@@ -53,6 +56,8 @@ private:
 	RenderTarget* m_pDefaultRenderTarget{}, * m_pCurrentRenderTarget{};
 	D3D11_VIEWPORT m_Viewport{};
 
+	JobSystem* m_pJobSystem{};
+
 	GameContext m_GameContext{};
 };
 
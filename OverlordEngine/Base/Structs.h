@@ -5,6 +5,7 @@ class LightManager;
 class GameTime;
 class OverlordGame;
 class MaterialManager;
+class JobSystem;
 
 struct D3D11Context
 {
@@ -26,6 +27,14 @@ struct SceneSettings
 	bool vSyncEnabled{ true };
 	XMFLOAT4 clearColor{ Colors::CornflowerBlue };
 
+	bool updateComponentsByType{ false }; //Component updates grouped per type instead of per GameObject (see GameScene::UpdateComponentBuckets)
+	bool asyncPhysics{ false }; //PhysX step overlaps with the next frame (see PhysxProxy::Simulate)
+	bool frustumCulling{ true }; //ModelComponents outside the camera frustum are not drawn (see ModelComponent::Draw)
+	bool shadowCasterCulling{ true }; //Casters that can't shadow anything the camera sees are skipped (see ShadowMapRenderer::DrawMesh)
+	bool sortedRendering{ false }; //Opt-in, ModelComponents are drawn through the scene's RenderQueue instead of in tree order
+	bool instancing{ false }; //Opt-in (needs sortedRendering), queued draws of the same submesh and material are merged into one instanced draw (see RenderQueue::BuildBatches)
+	bool staticBatching{ false }; //Opt-in, static models are merged per material once the scene is built (see StaticBatcher)
+
 	void Toggle_ShowInfoOverlay() { showInfoOverlay = !showInfoOverlay; }
 	bool Toggle_DrawPhysXDebug() { drawPhysXDebug = !drawPhysXDebug; }
 	bool Toggle_DrawGrid() { drawGrid = !drawGrid; }
@@ -37,6 +46,7 @@ struct SceneContext
 	LightManager* pLights{};
 	CameraComponent* pCamera{};
 	GameTime* pGameTime{};
+	JobSystem* pJobSystem{};
 	D3D11Context d3dContext{};
 
 	float windowWidth{};
@@ -56,10 +66,15 @@ struct GameContext
 	std::wstring windowTitle{L"GP2 - Overlord Engine 2023 (x64)"};
 	HWND windowHandle{};
 	std::wstring contentRoot{ L"./Resources/" };
+	std::wstring contentPack{ L"./Resources.ovpk" }; //Opened when it exists, assets it doesn't contain are loaded from contentRoot ("" == loose files only)
 	float inputUpdateFrequency{ 0.016f };
+	UINT jobWorkerCount{}; //0 == one worker per hardware thread (minus the main thread)
+	bool serialContentLoading{}; //Content requests of a background load run one after another in a single job (startup comparison)
+	UINT64 contentBudgetBytes{ 512ull * 1024 * 1024 }; //Unreferenced content is evicted (LRU) once all content exceeds it, 0 == unlimited (see ContentManager::Trim)
 
 	D3D11Context d3dContext{};
 	OverlordGame* pGame{};
+	JobSystem* pJobSystem{};
 };
 
 struct PerfStats
@@ -86,4 +101,84 @@ struct PerfStats
 
 		frameNr = 0;
 	}
-};
\ No newline at end of file
+};
+
+struct FrameStats
+{
+	//Update
+	float sceneUpdateMs;
+
+	//Transforms
+	UINT transformsRecomputed;
+	UINT transformsRegistered;
+
+	//Spatial index
+	UINT spatialRefits; //Moved models that stayed inside their fat bounds
+	UINT spatialReinserts;
+
+	//Culling (submesh draws of ModelComponents)
+	UINT meshesVisible;
+	UINT meshesCulled;
+	UINT shadowCasters; //Submitted to the shadow pass
+	UINT shadowCastersDrawn; //Left after caster culling
+
+	//Render queue (sorted rendering)
+	UINT queuedDraws;
+	UINT stateChanges; //Binds after elision (material, technique, input layout, vertex & index buffer)
+	UINT drawCalls; //Queued draws after instancing
+	UINT instancedBatches;
+
+	//Static batching
+	UINT staticChunksDrawn;
+	UINT staticChunksCulled;
+
+	//Materials
+	UINT materialSwitches; //Instance parameters loaded into a shared effect (BaseMaterial::MakeCurrent)
+
+	//Physics
+	float physicsWaitMs; //Main thread blocked on PhysX
+	float physicsOverlapMs; //Async only, time between simulate and the sync point
+	UINT physicsEarlySyncs; //Async only, fetches forced before the sync point
+	UINT physicsSteps;
+
+	void Reset()
+	{
+		sceneUpdateMs = 0;
+
+		transformsRecomputed = 0;
+		transformsRegistered = 0;
+
+		spatialRefits = 0;
+		spatialReinserts = 0;
+
+		meshesVisible = 0;
+		meshesCulled = 0;
+		shadowCasters = 0;
+		shadowCastersDrawn = 0;
+
+		queuedDraws = 0;
+		stateChanges = 0;
+		drawCalls = 0;
+		instancedBatches = 0;
+
+		staticChunksDrawn = 0;
+		staticChunksCulled = 0;
+
+		materialSwitches = 0;
+
+		physicsWaitMs = 0;
+		physicsOverlapMs = 0;
+		physicsEarlySyncs = 0;
+		physicsSteps = 0;
+	}
+};
+
+//Per scene, measured by the SceneManager
+struct SceneStats
+{
+	float initializeMs{}; //Main thread time of the last initialization
+	float contentMs{}; //Wall time of the content requests of the last background load (SceneManager::LoadGameSceneAsync)
+	long long initializeBytes{}; //Process private bytes gained by the last initialization
+	UINT initializeCount{};
+	UINT unloadCount{};
+};
@@ -8,6 +8,13 @@ BaseComponent::BaseComponent()
 	m_ComponentId = m_ComponentCounter;
 }
 
+BaseComponent::~BaseComponent()
+{
+	//Deleted while attached (owner deleted in the scene, scene graph teardown), the index can't keep a dangling entry
+	if (m_SceneIndex != UINT_MAX && m_pScene)
+		m_pScene->UnregisterComponent(this);
+}
+
 void BaseComponent::RootInitialize(const SceneContext& sceneContext)
 {
 	//assert(!m_IsInitialized); //Shouldn't be called more than once...
@@ -27,6 +34,9 @@ void BaseComponent::RootOnSceneAttach(GameScene* pScene)
 		RootInitialize(pScene->GetSceneContext());
 	}
 
+	//Scene-wide component index
+	pScene->RegisterComponent(this);
+
 	//Signal Derived
 	OnSceneAttach(pScene);
 }
@@ -37,6 +47,9 @@ void BaseComponent::RootOnSceneDetach(GameScene* pScene)
 
 	m_pScene = pScene;
 
+	//Scene-wide component index
+	pScene->UnregisterComponent(this);
+
 	//Signal Derived
 	OnSceneDetach(pScene);
 }
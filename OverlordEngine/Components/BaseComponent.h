@@ -7,16 +7,21 @@ class BaseComponent
 {
 public:
 	BaseComponent();
-	virtual ~BaseComponent() = default;
+	virtual ~BaseComponent();
 	BaseComponent(const BaseComponent& other) = delete;
 	BaseComponent(BaseComponent&& other) noexcept = delete;
 	BaseComponent& operator=(const BaseComponent& other) = delete;
 	BaseComponent& operator=(BaseComponent&& other) noexcept = delete;
 
+	//Allocated from the current scene's PoolAllocator (see GameScene)
+	static void* operator new(size_t size) { return PoolAllocator::AllocateObject(size); }
+	static void operator delete(void* pObject) { PoolAllocator::FreeObject(pObject); }
+
 	GameObject* GetGameObject() const { return m_pGameObject; }
 	GameScene* GetScene() const { return m_pScene; }
 	TransformComponent* GetTransform() const;
 	UINT GetComponentId() const { return m_ComponentId; }
+	ComponentTypeId GetComponentTypeId() const { return m_TypeId; }
 
 protected:
 
@@ -42,11 +47,15 @@ protected:
 
 private:
 	friend class GameObject;
+	friend class GameScene;
 
 	void RootInitialize(const SceneContext& sceneContext);
 	void RootOnSceneAttach(GameScene*);
 	void RootOnSceneDetach(GameScene*);
 
+	ComponentTypeId m_TypeId{ ComponentTypeRegistry::InvalidTypeId }; //Exact type, assigned when added to a GameObject
+	UINT m_SceneIndex{ UINT_MAX }; //Position in the GameScene component index
+
 	static UINT m_ComponentCounter;
 };
 
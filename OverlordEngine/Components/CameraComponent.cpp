@@ -16,6 +16,13 @@ CameraComponent::CameraComponent() :
 }
 
 void CameraComponent::Update(const SceneContext& sceneContext)
+{
+	//Active camera is updated by the GameScene, after the world transforms are resolved
+	if (!m_IsActive)
+		UpdateMatrices(sceneContext);
+}
+
+void CameraComponent::UpdateMatrices(const SceneContext& sceneContext)
 {
 	// see https://stackoverflow.com/questions/21688529/binary-directxxmvector-does-not-define-this-operator-or-a-conversion
 	using namespace DirectX;
@@ -33,9 +40,12 @@ void CameraComponent::Update(const SceneContext& sceneContext)
 		projection = XMMatrixOrthographicLH(viewWidth, viewHeight, m_NearPlane, m_FarPlane);
 	}
 
-	const XMVECTOR worldPosition = XMLoadFloat3(&GetTransform()->GetWorldPosition());
-	const XMVECTOR lookAt = XMLoadFloat3(&GetTransform()->GetForward());
-	const XMVECTOR upVec = XMLoadFloat3(&GetTransform()->GetUp());
+	//Render world, a camera attached to a physics driven object follows its interpolated pose
+	const XMFLOAT4X4 transformWorld{ GetTransform()->GetRenderWorld() };
+	const XMMATRIX renderWorld{ XMLoadFloat4x4(&transformWorld) };
+	const XMVECTOR worldPosition = renderWorld.r[3];
+	const XMVECTOR lookAt = XMVector3Normalize(renderWorld.r[2]);
+	const XMVECTOR upVec = XMVector3Normalize(renderWorld.r[1]);
 
 	const XMMATRIX view = XMMatrixLookAtLH(worldPosition, worldPosition + lookAt, upVec);
 	const XMMATRIX viewInv = XMMatrixInverse(nullptr, view);
@@ -46,6 +56,8 @@ void CameraComponent::Update(const SceneContext& sceneContext)
 	XMStoreFloat4x4(&m_ViewInverse, viewInv);
 	XMStoreFloat4x4(&m_ViewProjection, view * projection);
 	XMStoreFloat4x4(&m_ViewProjectionInverse, viewProjectionInv);
+
+	m_CullingFrustum = CullingFrustum{ m_ViewProjection };
 }
 
 void CameraComponent::SetActive(bool active)
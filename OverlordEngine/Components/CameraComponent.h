@@ -27,6 +27,7 @@ public:
 	const XMFLOAT4X4& GetViewProjection() const {return m_ViewProjection;}
 	const XMFLOAT4X4& GetViewInverse() const {return m_ViewInverse;}
 	const XMFLOAT4X4& GetViewProjectionInverse() const {return m_ViewProjectionInverse;}
+	const CullingFrustum& GetCullingFrustum() const {return m_CullingFrustum;}
 
 	GameObject* Pick(CollisionGroup ignoreGroups = CollisionGroup::None) const;
 
@@ -36,11 +37,16 @@ protected:
 	void Update(const SceneContext& sceneContext) override;
 
 private:
+	friend class GameScene;
+
+	void UpdateMatrices(const SceneContext& sceneContext);
+
 	XMFLOAT4X4 m_View{};
 	XMFLOAT4X4 m_Projection{};
 	XMFLOAT4X4 m_ViewInverse{};
 	XMFLOAT4X4 m_ViewProjection{};
 	XMFLOAT4X4 m_ViewProjectionInverse{};
+	CullingFrustum m_CullingFrustum{};
 
 	float m_FarPlane{}, m_NearPlane{}, m_FOV{}, m_Size{};
 	bool m_IsActive{}, m_PerspectiveProjection{};
@@ -0,0 +1,30 @@
+#include "stdafx.h"
+#include "ComponentTypeRegistry.h"
+
+std::mutex ComponentTypeRegistry::m_Mutex{};
+std::unordered_map<std::type_index, ComponentTypeId> ComponentTypeRegistry::m_TypeIds{};
+
+ComponentTypeId ComponentTypeRegistry::GetTypeId(const std::type_info& typeInfo)
+{
+	std::lock_guard lock{ m_Mutex };
+	const auto it = m_TypeIds.find(typeInfo);
+	if (it != m_TypeIds.end())
+		return it->second;
+
+	const ComponentTypeId typeId{ static_cast<ComponentTypeId>(m_TypeIds.size()) };
+	if (typeId >= MaxComponentTypes)
+	{
+		//An id past the mask would corrupt every GameObject's component mask, no way to continue (also when the error is ignored)
+		Logger::LogError(L"ComponentTypeRegistry::GetTypeId > Too many component types (max {}), increase MaxComponentTypes", MaxComponentTypes);
+		std::abort();
+	}
+
+	m_TypeIds.emplace(typeInfo, typeId);
+	return typeId;
+}
+
+UINT ComponentTypeRegistry::GetTypeCount()
+{
+	std::lock_guard lock{ m_Mutex };
+	return static_cast<UINT>(m_TypeIds.size());
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <mutex>
+#include <typeindex>
+
+using ComponentTypeId = UINT;
+
+//Maps every (exact) component type to a small sequential id
+//Ids are used as bit index in the GameObject component mask and as bucket index in the GameScene component index
+class ComponentTypeRegistry final
+{
+public:
+	static constexpr ComponentTypeId MaxComponentTypes{ 64 };
+	static constexpr ComponentTypeId InvalidTypeId{ UINT_MAX };
+
+	//Slow path (locked hash lookup), used once when a component is added, safe to call from worker threads (content jobs, PhysxProxy)
+	//Registering more than MaxComponentTypes types terminates, the ids index a 64-bit mask
+	static ComponentTypeId GetTypeId(const std::type_info& typeInfo);
+
+	//Fast path, resolved once per type
+	template<typename T>
+	static ComponentTypeId GetTypeId()
+	{
+		static const ComponentTypeId typeId{ GetTypeId(typeid(T)) };
+		return typeId;
+	}
+
+	static UINT GetTypeCount();
+
+private:
+	static std::mutex m_Mutex;
+	static std::unordered_map<std::type_index, ComponentTypeId> m_TypeIds;
+};
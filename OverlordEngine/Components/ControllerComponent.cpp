@@ -12,6 +12,7 @@ void ControllerComponent::Initialize(const SceneContext& /*sceneContext*/)
 	{
 		m_ControllerDesc.position = ConvertUtil::ToPxExtendedVec3(GetTransform()->GetWorldPosition());
 		m_ControllerDesc.userData = this;
+		m_pScene->GetPhysxProxy()->EnsureNotSimulating();
 		ASSERT_NULL_(m_pController = m_pScene->GetPhysxProxy()->GetControllerManager()->createController(m_ControllerDesc));
 		m_pController->getActor()->userData = this;
 		SetCollisionGroup(static_cast<CollisionGroup>(m_CollisionGroups.word0));
@@ -19,18 +20,20 @@ void ControllerComponent::Initialize(const SceneContext& /*sceneContext*/)
 	}
 }
 
-void ControllerComponent::OnSceneDetach(GameScene*)
+void ControllerComponent::OnSceneDetach(GameScene* pScene)
 {
 	if (m_pController)
 	{
+		pScene->GetPhysxProxy()->EnsureNotSimulating();
 		m_pController->getActor()->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, true);
 	}
 }
 
-void ControllerComponent::OnSceneAttach(GameScene*)
+void ControllerComponent::OnSceneAttach(GameScene* pScene)
 {
 	if (m_pController)
 	{
+		pScene->GetPhysxProxy()->EnsureNotSimulating();
 		m_pController->getActor()->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, false);
 	}
 }
@@ -70,12 +73,14 @@ void ControllerComponent::ApplyFilterData() const
 void ControllerComponent::Translate(const XMFLOAT3& pos) const
 {
 	ASSERT_NULL_(m_pController);
+	m_pScene->GetPhysxProxy()->EnsureNotSimulating();
 	m_pController->setPosition(PhysxHelper::ToPxExtendedVec3(pos));
 }
 
 void ControllerComponent::Move(const XMFLOAT3& displacement, float minDistance)
 {
 	ASSERT_NULL_(m_pController);
+	m_pScene->GetPhysxProxy()->EnsureNotSimulating(); //Controllers run scene queries & move their kinematic actor
 	m_CollisionFlag = m_pController->move(PhysxHelper::ToPxVec3(displacement), minDistance, 0, nullptr, nullptr);
 }
 
@@ -91,6 +96,38 @@ XMFLOAT3 ControllerComponent::GetFootPosition() const
 	return PhysxHelper::ToXMFLOAT3(m_pController->getFootPosition());
 }
 
+XMFLOAT3 ControllerComponent::GetRenderPosition() const
+{
+	ASSERT_NULL_(m_pController);
+
+	const PhysxProxy* pPhysxProxy{ m_pScene ? m_pScene->GetPhysxProxy() : nullptr };
+	const XMFLOAT3 position{ GetPosition() };
+
+	//Not captured by the latest step, or moved outside of it since (Move in Update, Translate) > no interpolation
+	if (!pPhysxProxy || m_PoseStep != pPhysxProxy->GetStepIndex() || !XMVector3Equal(XMLoadFloat3(&position), XMLoadFloat3(&m_CurrentPosition)))
+		return position;
+
+	XMFLOAT3 renderPosition{};
+	XMStoreFloat3(&renderPosition, XMVectorLerp(XMLoadFloat3(&m_PreviousPosition), XMLoadFloat3(&m_CurrentPosition), pPhysxProxy->GetInterpolationAlpha()));
+	return renderPosition;
+}
+
+void ControllerComponent::BeginStep()
+{
+	if (m_pController)
+		m_StepStartPosition = GetPosition();
+}
+
+void ControllerComponent::CapturePose(UINT stepIndex)
+{
+	if (!m_pController)
+		return;
+
+	m_PreviousPosition = m_StepStartPosition;
+	m_CurrentPosition = GetPosition();
+	m_PoseStep = stepIndex;
+}
+
 void ControllerComponent::SetCollisionGroup(CollisionGroup groups)
 {
 	m_CollisionGroups.word0 = PxU32(groups);
@@ -19,6 +19,8 @@ public:
 
 	XMFLOAT3 GetPosition() const;
 	XMFLOAT3 GetFootPosition() const;
+	//Interpolated between the start and the end of the latest fixed step, when the controller was moved by it (see PhysxProxy::GetInterpolationAlpha)
+	XMFLOAT3 GetRenderPosition() const;
 	PxControllerCollisionFlags GetCollisionFlags() const {return m_CollisionFlag;}
 	PxController* GetPxController() const { return m_pController; }
 
@@ -30,6 +32,7 @@ protected:
 	void OnOwnerDetach(GameObject*) override;
 
 private:
+	friend class PhysxProxy;
 
 	PxCapsuleControllerDesc m_ControllerDesc{};
 
@@ -37,6 +40,12 @@ private:
 	PxControllerCollisionFlags m_CollisionFlag{};
 	PxFilterData m_CollisionGroups{ static_cast<UINT32>(CollisionGroup::Group0), 0, 0, 0 };
 
+	//Render interpolation (captured around every step)
+	XMFLOAT3 m_StepStartPosition{}, m_PreviousPosition{}, m_CurrentPosition{};
+	UINT m_PoseStep{};
+
 	void ApplyFilterData() const;
+	void BeginStep();
+	void CapturePose(UINT stepIndex);
 };
 
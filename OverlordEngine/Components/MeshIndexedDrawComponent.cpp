@@ -155,7 +155,8 @@ void MeshIndexedDrawComponent::Draw(const SceneContext& sceneContext)
 		return;
 
 	auto& d3d = sceneContext.d3dContext;
-	auto world = XMLoadFloat4x4(&GetTransform()->GetWorld());
+	const XMFLOAT4X4 transformWorld{ GetTransform()->GetRenderWorld() };
+	auto world = XMLoadFloat4x4(&transformWorld);
 	const auto viewProjection = XMLoadFloat4x4(&sceneContext.pCamera->GetViewProjection());
 
 	m_pWorldVar->SetMatrix(reinterpret_cast<float*>(&world));
@@ -9,6 +9,16 @@ ModelComponent::ModelComponent(const std::wstring& assetFile, bool castShadows):
 
 ModelComponent::~ModelComponent()
 {
+	if (m_IsFinalizePending && m_pScene)
+		m_pScene->CancelGpuFinalize(this);
+
+	//The spatial index is already gone when the whole scene is released
+	if (m_SpatialProxy != BoundingVolumeHierarchy::InvalidProxy && m_pScene && m_pScene->GetSpatialIndex())
+		m_pScene->GetSpatialIndex()->DestroyProxy(m_SpatialProxy);
+
+	if (m_IsStaticBatched && m_pScene)
+		m_pScene->GetStaticBatcher()->Invalidate();
+
 	SafeDelete(m_pAnimator);
 
 	m_pDefaultMaterial = nullptr;
@@ -18,7 +28,6 @@ ModelComponent::~ModelComponent()
 void ModelComponent::Initialize(const SceneContext& sceneContext)
 {
 	m_pMeshFilter = ContentManager::Load<MeshFilter>(m_AssetFile);
-	m_pMeshFilter->BuildIndexBuffer(sceneContext);
 
 	//Resize Materials Array (if needed)
 	if(m_Materials.size() < m_pMeshFilter->GetMeshCount())
@@ -29,13 +38,33 @@ void ModelComponent::Initialize(const SceneContext& sceneContext)
 	if (m_pMeshFilter->m_HasAnimations)
 		m_pAnimator = new ModelAnimator(m_pMeshFilter);
 
+	//GPU resources: built by the time-sliced scene initialization while the scene loads, right away otherwise
+	//(the component isn't attached to the scene yet when its object initializes, the owner is)
+	GameScene* pScene{ m_pGameObject->GetScene() };
+	if (pScene && !pScene->IsInitialized())
+	{
+		m_IsFinalizePending = true;
+		pScene->QueueGpuFinalize(this);
+		return;
+	}
+
+	BuildGpuResources(sceneContext);
+}
+
+void ModelComponent::BuildGpuResources(const SceneContext& sceneContext)
+{
+	m_IsFinalizePending = false;
+	m_pMeshFilter->BuildIndexBuffer(sceneContext);
+
 	if (m_MaterialChanged)
 	{
+		//All submeshes in one build (interleaved in parallel), layouts built while loading are skipped
+		std::vector<BaseMaterial*> subMeshMaterials(m_pMeshFilter->GetMeshCount());
 		for(auto& subMesh: m_pMeshFilter->GetMeshes())
 		{
-			const auto pMaterial = m_Materials[subMesh.id]!=nullptr?m_Materials[subMesh.id]:m_pDefaultMaterial;
-			m_pMeshFilter->BuildVertexBuffer(sceneContext, pMaterial, subMesh.id);
+			subMeshMaterials[subMesh.id] = m_Materials[subMesh.id]!=nullptr?m_Materials[subMesh.id]:m_pDefaultMaterial;
 		}
+		m_pMeshFilter->BuildVertexBuffers(sceneContext, subMeshMaterials);
 		
 		m_MaterialChanged = false;
 	}
@@ -55,33 +84,105 @@ void ModelComponent::Update(const SceneContext& sceneContext)
 
 void ModelComponent::Draw(const SceneContext& sceneContext)
 {
+	//Part of the scene's static batches
+	if (m_IsStaticBatched && sceneContext.settings.staticBatching)
+		return;
+
 	if (!m_pDefaultMaterial)
 	{
 		Logger::LogWarning(L"ModelComponent::Draw() > No Default Material Set!");
 		return;
 	}
 
+	//Frustum culling, before any material work
+	//Skinned meshes leave their bind pose bounds when animated, they are always drawn
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	const bool isCulling{ sceneContext.settings.frustumCulling && sceneContext.pCamera && !m_pAnimator };
+	const XMFLOAT4X4 transformWorld{ GetTransform()->GetRenderWorld() };
+	const XMMATRIX world{ XMLoadFloat4x4(&transformWorld) };
+
+	if (isCulling && !sceneContext.pCamera->GetCullingFrustum().Intersects(m_pMeshFilter->GetBounds(), world))
+	{
+		frameStats.meshesCulled += m_pMeshFilter->GetMeshCount();
+		return;
+	}
+
+	//Single submesh, its bounds are the mesh bounds
+	const bool isCullingSubMeshes{ isCulling && m_pMeshFilter->GetMeshCount() > 1 };
+
+	//Sorted rendering, the submeshes are queued and drawn by the scene after the traversal (see GameScene::RootDraw)
+	RenderQueue* pRenderQueue{ sceneContext.settings.sortedRendering && sceneContext.pCamera && GetScene() ? GetScene()->GetRenderQueue() : nullptr };
+	float viewDepth{};
+	if (pRenderQueue)
+	{
+		const XMMATRIX worldView{ world * XMLoadFloat4x4(&sceneContext.pCamera->GetView()) };
+		viewDepth = XMVectorGetZ(XMVector3Transform(XMLoadFloat3(&m_pMeshFilter->GetBounds().Center), worldView));
+	}
+
 	//Update Materials
 	BaseMaterial* pCurrMaterial = nullptr;
 	for (const auto& subMesh : m_pMeshFilter->GetMeshes())
 	{
+		if (isCullingSubMeshes && !sceneContext.pCamera->GetCullingFrustum().Intersects(subMesh.bounds, world))
+		{
+			++frameStats.meshesCulled;
+			continue;
+		}
+
+		++frameStats.meshesVisible;
+
 		//Gather Material
 		pCurrMaterial = m_Materials[subMesh.id] != nullptr ? m_Materials[subMesh.id] : m_pDefaultMaterial;
+
+		if (pRenderQueue)
+		{
+			const MaterialTechniqueContext& techniqueContext{ pCurrMaterial->GetTechniqueContext() };
+			const auto& vertexBufferData = m_pMeshFilter->GetVertexBufferData(sceneContext, pCurrMaterial, subMesh.id);
+
+			RenderQueue::DrawItem item{};
+			item.key = RenderQueue::MakeKey(0, pCurrMaterial->GetMaterialId(), techniqueContext.inputLayoutID, RenderQueue::MakeMeshKey(m_pMeshFilter->GetMeshId(), subMesh.id), viewDepth);
+			item.pMaterial = pCurrMaterial;
+			item.pModel = this;
+			item.pTechnique = techniqueContext.pTechnique;
+			item.pInputLayout = techniqueContext.pStreamInputLayout;
+			item.pPositionBuffer = subMesh.buffers.pPositionBuffer;
+			item.pVertexBuffer = vertexBufferData.pVertexBuffer;
+			item.vertexStride = vertexBufferData.VertexStride;
+			item.pIndexBuffer = subMesh.buffers.pIndexBuffer;
+			item.indexFormat = subMesh.buffers.indexFormat;
+			item.indexCount = subMesh.indexCount;
+
+			if (const MaterialTechniqueContext* pInstancedContext = pCurrMaterial->GetInstancedTechniqueContext())
+			{
+				item.world = GetTransform()->GetRenderWorld();
+				item.pInstancedTechnique = pInstancedContext->pTechnique;
+				item.pInstancedInputLayout = pInstancedContext->pStreamInputLayout;
+
+				if (m_pAnimator)
+				{
+					const auto& boneTransforms = m_pAnimator->GetBoneTransforms();
+					item.pBones = boneTransforms.data();
+					item.boneCount = static_cast<UINT>(boneTransforms.size());
+				}
+			}
+
+			pRenderQueue->Add(item);
+			continue;
+		}
+
 		pCurrMaterial->UpdateEffectVariables(sceneContext, this);
 
 		const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
 
 		//Set Inputlayout
-		pDeviceContext->IASetInputLayout(pCurrMaterial->GetTechniqueContext().pInputLayout);
+		pDeviceContext->IASetInputLayout(pCurrMaterial->GetTechniqueContext().pStreamInputLayout);
 
-		//Set Vertex Buffer
-		const UINT offset = 0;
-		const auto& vertexBufferData = m_pMeshFilter->GetVertexBufferData(sceneContext, pCurrMaterial, subMesh.id);
-		pDeviceContext->IASetVertexBuffers(0, 1, &vertexBufferData.pVertexBuffer, &vertexBufferData.VertexStride,
-			&offset);
+		//Set Vertex Buffers (position & attribute stream)
+		m_pMeshFilter->GetVertexBufferData(sceneContext, pCurrMaterial, subMesh.id);
+		m_pMeshFilter->SetVertexStreams(pDeviceContext, pCurrMaterial->GetTechniqueContext().inputLayoutID, subMesh.id);
 
 		//Set Index Buffer
-		pDeviceContext->IASetIndexBuffer(subMesh.buffers.pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		pDeviceContext->IASetIndexBuffer(subMesh.buffers.pIndexBuffer, subMesh.buffers.indexFormat, 0);
 
 		//Set Primitive Topology
 		pDeviceContext->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -108,9 +209,44 @@ void ModelComponent::ShadowMapDraw(const SceneContext& sceneContext)
 	//Here we want to Draw this Mesh to the ShadowMap, using the ShadowMapRenderer::DrawMesh function
 	//1. Call ShadowMapRenderer::DrawMesh with the required function arguments BUT boneTransforms are only required for skinned meshes of course..
 	if(m_pMeshFilter->HasAnimations())
-		ShadowMapRenderer::Get()->DrawMesh(sceneContext, m_pMeshFilter, GetTransform()->GetWorld(), m_pAnimator->GetBoneTransforms());
+		ShadowMapRenderer::Get()->DrawMesh(sceneContext, m_pMeshFilter, GetTransform()->GetRenderWorld(), m_pAnimator->GetBoneTransforms());
 	else
-		ShadowMapRenderer::Get()->DrawMesh(sceneContext, m_pMeshFilter, GetTransform()->GetWorld());
+		ShadowMapRenderer::Get()->DrawMesh(sceneContext, m_pMeshFilter, GetTransform()->GetRenderWorld());
+}
+
+void ModelComponent::OnSceneAttach(GameScene* pScene)
+{
+	if (m_SpatialProxy == BoundingVolumeHierarchy::InvalidProxy)
+		m_SpatialProxy = pScene->GetSpatialIndex()->CreateProxy(GetWorldBounds(), this);
+}
+
+void ModelComponent::OnSceneDetach(GameScene* pScene)
+{
+	if (m_IsFinalizePending)
+	{
+		pScene->CancelGpuFinalize(this);
+		m_IsFinalizePending = false;
+	}
+
+	if (m_IsStaticBatched)
+	{
+		pScene->GetStaticBatcher()->Invalidate();
+		m_IsStaticBatched = false;
+	}
+
+	if (m_SpatialProxy == BoundingVolumeHierarchy::InvalidProxy)
+		return;
+
+	pScene->GetSpatialIndex()->DestroyProxy(m_SpatialProxy);
+	m_SpatialProxy = BoundingVolumeHierarchy::InvalidProxy;
+}
+
+BoundingBox ModelComponent::GetWorldBounds() const
+{
+	BoundingBox bounds{};
+	const XMFLOAT4X4 world{ GetTransform()->GetRenderWorld() };
+	m_pMeshFilter->GetBounds().Transform(bounds, XMLoadFloat4x4(&world));
+	return bounds;
 }
 
 void ModelComponent::SetMaterial(BaseMaterial* pMaterial, UINT8 submeshId)
@@ -141,7 +277,11 @@ void ModelComponent::SetMaterial(BaseMaterial* pMaterial, UINT8 submeshId)
 	m_Materials[submeshId] = pMaterial;
 	m_MaterialChanged = true;
 
-	if (m_IsInitialized && GetScene())
+	if (m_IsStaticBatched && GetScene())
+		GetScene()->GetStaticBatcher()->Invalidate();
+
+	//A pending GPU finalize builds every submesh with its material
+	if (m_IsInitialized && !m_IsFinalizePending && GetScene())
 	{
 		ASSERT_IF(m_pMeshFilter->GetMeshCount() <= submeshId, L"Invalid SubMeshID({}) for current MeshFilter({} submeshes)", submeshId, m_pMeshFilter->GetMeshCount())
 		m_pMeshFilter->BuildVertexBuffer(GetScene()->GetSceneContext(), pMaterial, submeshId);
@@ -1,5 +1,6 @@
 #pragma once
 #include "BaseComponent.h"
+#include "Scenegraph/BoundingVolumeHierarchy.h"
 
 class MeshFilter;
 class ModelAnimator;
@@ -18,6 +19,9 @@ public:
 	void SetMaterial(BaseMaterial* pMaterial, UINT8 submeshId = 0);
 	void SetMaterial(UINT materialId, UINT8 submeshId = 0);
 
+	//World space bounds of the mesh (see GameScene::GetSpatialIndex)
+	BoundingBox GetWorldBounds() const;
+
 	ModelAnimator* GetAnimator() const { return m_pAnimator; }
 	bool HasAnimator() const { return m_pAnimator != nullptr; }
 
@@ -28,7 +32,15 @@ protected:
 
 	void ShadowMapDraw(const SceneContext& sceneContext) override; //update_W9
 
+	void OnSceneAttach(GameScene* pScene) override;
+	void OnSceneDetach(GameScene* pScene) override;
+
 private:
+	void BuildGpuResources(const SceneContext& sceneContext); //Index & vertex buffers, shadow map layouts
+
+	friend class GameScene;
+	friend class StaticBatcher;
+
 	std::wstring m_AssetFile{};
 	MeshFilter* m_pMeshFilter{};
 
@@ -41,4 +53,8 @@ private:
 
 	//W9
 	bool m_CastShadows{ true };
+
+	UINT m_SpatialProxy{ BoundingVolumeHierarchy::InvalidProxy };
+	bool m_IsStaticBatched{}; //Drawn by the scene's StaticBatcher (while SceneSettings::staticBatching is on)
+	bool m_IsFinalizePending{}; //Queued in GameScene::QueueGpuFinalize, GPU resources not built yet
 };
@@ -3,6 +3,9 @@
 #include "Misc/ParticleMaterial.h"
 
 ParticleMaterial* ParticleEmitterComponent::m_pParticleMaterial{};
+MaterialVariable<XMFLOAT4X4> ParticleEmitterComponent::m_EVar_WorldViewProj{};
+MaterialVariable<XMFLOAT4X4> ParticleEmitterComponent::m_EVar_ViewInverse{};
+MaterialVariable<ID3D11ShaderResourceView*> ParticleEmitterComponent::m_EVar_ParticleTexture{};
 
 ParticleEmitterComponent::ParticleEmitterComponent(const std::wstring& assetFile, const ParticleEmitterSettings& emitterSettings, UINT particleCount):
 	m_ParticlesArray(new Particle[particleCount]),
@@ -23,7 +26,14 @@ ParticleEmitterComponent::~ParticleEmitterComponent()
 void ParticleEmitterComponent::Initialize(const SceneContext& sceneContext)
 {
 	if (!m_pParticleMaterial)
+	{
+		//Shared by the emitters of every scene, not owned by the scene that creates it
+		MaterialManager::Scope sharedScope{ nullptr };
 		m_pParticleMaterial = MaterialManager::Get()->CreateMaterial<ParticleMaterial>();
+		m_EVar_WorldViewProj = m_pParticleMaterial->GetVariableHandle<XMFLOAT4X4>(L"gWorldViewProj");
+		m_EVar_ViewInverse = m_pParticleMaterial->GetVariableHandle<XMFLOAT4X4>(L"gViewInverse");
+		m_EVar_ParticleTexture = m_pParticleMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gParticleTexture");
+	}
 
 	CreateVertexBuffer(sceneContext);
 
@@ -142,9 +152,10 @@ void ParticleEmitterComponent::SpawnParticle(Particle& p)
 	};
 	const auto rndRange{ MathHelper::randF(m_EmitterSettings.minEmitterRadius, m_EmitterSettings.maxEmitterRadius) };
 
+	const XMFLOAT3 emitterPosition{ GetTransform()->GetWorldPosition() };
 	XMStoreFloat3(&p.vertexInfo.Position,
 			XMVectorAdd(
-				XMVectorAdd(XMLoadFloat3(&GetTransform()->GetWorldPosition()),
+				XMVectorAdd(XMLoadFloat3(&emitterPosition),
 					XMLoadFloat3(&m_SpawnOffset)),
 					XMVectorMultiply(rndVec,XMVectorSet(rndRange, rndRange, rndRange, 0.f)))
 	);
@@ -163,9 +174,9 @@ void ParticleEmitterComponent::SpawnParticle(Particle& p)
 
 void ParticleEmitterComponent::PostDraw(const SceneContext& sceneContext)
 {
-	m_pParticleMaterial->SetVariable_Matrix(L"gWorldViewProj", sceneContext.pCamera->GetViewProjection());
-	m_pParticleMaterial->SetVariable_Matrix(L"gViewInverse", sceneContext.pCamera->GetViewInverse());
-	m_pParticleMaterial->SetVariable_Texture(L"gParticleTexture", m_pParticleTexture->GetShaderResourceView());
+	m_EVar_WorldViewProj.Set(sceneContext.pCamera->GetViewProjection());
+	m_EVar_ViewInverse.Set(sceneContext.pCamera->GetViewInverse());
+	m_EVar_ParticleTexture.Set(m_pParticleTexture->GetShaderResourceView());
 
 	const auto& techContext{ m_pParticleMaterial->GetTechniqueContext() };
 
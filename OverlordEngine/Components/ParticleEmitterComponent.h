@@ -67,6 +67,8 @@ private:
 
 	TextureData* m_pParticleTexture{};
 	static ParticleMaterial* m_pParticleMaterial; //Material used to render the particles (static >> shared by all emitters)
+	static MaterialVariable<XMFLOAT4X4> m_EVar_WorldViewProj, m_EVar_ViewInverse;
+	static MaterialVariable<ID3D11ShaderResourceView*> m_EVar_ParticleTexture;
 	ParticleEmitterSettings m_EmitterSettings{}; //The settings for this particle system
 
 	ID3D11Buffer* m_pVertexBuffer{}; //The vertex buffer, containing ParticleVertex information for each Particle
@@ -40,16 +40,18 @@ void RigidBodyComponent::OnSceneAttach(GameScene* pScene)
 {
 	if(m_pActor && !m_pActor->getScene())
 	{
+		pScene->GetPhysxProxy()->EnsureNotSimulating();
 		pScene->GetPhysxProxy()->GetPhysxScene()->addActor(*m_pActor);
 	}
 }
 
-void RigidBodyComponent::OnSceneDetach(GameScene* /*pScene*/)
+void RigidBodyComponent::OnSceneDetach(GameScene* pScene)
 {
 	if(m_pActor)
 	{
 		if (const auto pxScene = m_pActor->getScene())
 		{
+			pScene->GetPhysxProxy()->EnsureNotSimulating();
 			pxScene->removeActor(*m_pActor); //Remove actor from pxScene if component is detached from scenegraph
 		}
 	}
@@ -159,8 +161,10 @@ void RigidBodyComponent::CreateActor()
 	ASSERT_IF(m_pActor != nullptr, L"CreateActor cannot be called multiple times")
 
 	const auto pPhysX = PhysXManager::Get()->GetPhysics();
-	const auto pPhysxScene = GetGameObject()->GetScene()->GetPhysxProxy()->GetPhysxScene();
+	const auto pPhysxProxy = GetGameObject()->GetScene()->GetPhysxProxy();
+	const auto pPhysxScene = pPhysxProxy->GetPhysxScene();
 	const auto pTransform = GetTransform();
+	pPhysxProxy->EnsureNotSimulating();
 
 	if (m_IsStatic)
 		m_pActor = pPhysX->createRigidStatic(PxTransform(PhysxHelper::ToPxVec3(pTransform->GetPosition()), PhysxHelper::ToPxQuat(pTransform->GetRotation())));
@@ -188,9 +192,10 @@ void RigidBodyComponent::SetDensity(float density) const
 	}
 }
 
-void RigidBodyComponent::Translate(const XMFLOAT3& position) const
+void RigidBodyComponent::Translate(const XMFLOAT3& position)
 {
 	ASSERT_NULL_(m_pActor)
+	m_PoseStep = 0; //Teleport, don't interpolate from the previous pose
 	const PxTransform localPose = PxTransform(PhysxHelper::ToPxVec3(position), PhysxHelper::ToPxQuat(GetRotation()));
 
 	if (!m_IsKinematic)
@@ -204,9 +209,10 @@ void RigidBodyComponent::Translate(const XMFLOAT3& position) const
 		m_pActor->is<PxRigidDynamic>()->setKinematicTarget(localPose);
 }
 
-void RigidBodyComponent::Rotate(const XMFLOAT4& rotation) const
+void RigidBodyComponent::Rotate(const XMFLOAT4& rotation)
 {
 	ASSERT_NULL_(m_pActor)
+	m_PoseStep = 0; //Teleport, don't interpolate from the previous pose
 	const PxTransform localPose = PxTransform(PhysxHelper::ToPxVec3(GetPosition()), PhysxHelper::ToPxQuat(rotation));
 
 	if (!m_IsKinematic) {
@@ -241,6 +247,40 @@ XMFLOAT4 RigidBodyComponent::GetRotation() const
 	return { pose.q.x, pose.q.y, pose.q.z, pose.q.w };
 }
 
+void RigidBodyComponent::GetRenderPose(XMFLOAT3& position, XMFLOAT4& rotation) const
+{
+	ASSERT_NULL_(m_pActor);
+
+	const PhysxProxy* pPhysxProxy{ m_pScene ? m_pScene->GetPhysxProxy() : nullptr };
+	const PxTransform pose{ m_pActor->getGlobalPose() };
+
+	//Not moved by the latest step, or moved directly through the actor since > no interpolation
+	const bool isMovedSinceStep{ pose.p != m_CurrentPose.p || pose.q.x != m_CurrentPose.q.x || pose.q.y != m_CurrentPose.q.y || pose.q.z != m_CurrentPose.q.z || pose.q.w != m_CurrentPose.q.w };
+	if (m_IsStatic || m_IsKinematic || !pPhysxProxy || m_PoseStep != pPhysxProxy->GetStepIndex() || isMovedSinceStep)
+	{
+		position = GetPosition();
+		rotation = GetRotation();
+		return;
+	}
+
+	const float alpha{ pPhysxProxy->GetInterpolationAlpha() };
+	XMStoreFloat3(&position, XMVectorLerp(XMVectorSet(m_PreviousPose.p.x, m_PreviousPose.p.y, m_PreviousPose.p.z, 0.f), XMVectorSet(pose.p.x, pose.p.y, pose.p.z, 0.f), alpha));
+	XMStoreFloat4(&rotation, XMQuaternionSlerp(XMVectorSet(m_PreviousPose.q.x, m_PreviousPose.q.y, m_PreviousPose.q.z, m_PreviousPose.q.w), XMVectorSet(pose.q.x, pose.q.y, pose.q.z, pose.q.w), alpha));
+}
+
+void RigidBodyComponent::CapturePose(UINT stepIndex)
+{
+	//An actor that was not active in the previous steps did not move, its last captured pose is still valid
+	m_PreviousPose = m_CurrentPose;
+	m_CurrentPose = m_pActor->getGlobalPose();
+
+	//First capture or teleported through Translate/Rotate, nothing to interpolate from
+	if (m_PoseStep == 0)
+		m_PreviousPose = m_CurrentPose;
+
+	m_PoseStep = stepIndex;
+}
+
 void RigidBodyComponent::PutToSleep() const
 {
 	if (m_pActor != nullptr && !m_IsStatic)
@@ -73,11 +73,14 @@ public:
 	void SetDensity(float density) const;
 
 	//Internal Use (use Transform Component for Transformations)
-	void Translate(const XMFLOAT3& position) const;
-	void Rotate(const XMFLOAT4& rotation) const;
+	void Translate(const XMFLOAT3& position);
+	void Rotate(const XMFLOAT4& rotation);
 	XMFLOAT3 GetPosition() const;
 	XMFLOAT4 GetRotation() const;
 
+	//Pose for rendering, interpolated between the previous and the latest fixed physics step (dynamic bodies only)
+	void GetRenderPose(XMFLOAT3& position, XMFLOAT4& rotation) const;
+
 	//Shapes (Colliders)
 	template<typename T>
 	UINT AddCollider(const T& geometry, const PxMaterial& material, bool isTrigger=false, const PxTransform& localPose = PxTransform(PxIdentity));
@@ -95,6 +98,8 @@ protected:
 	void OnOwnerDetach(GameObject*) override;
 
 private:
+	friend class PhysxProxy;
+
 	//Temporary Storage data
 	struct ColliderCreationInfo
 	{
@@ -116,7 +121,12 @@ private:
 
 	RigidBodyConstraint m_InitialConstraints{};
 
+	//Render interpolation (captured after every step the actor was active in)
+	PxTransform m_PreviousPose{ PxIdentity }, m_CurrentPose{ PxIdentity };
+	UINT m_PoseStep{};
+
 	void CreateActor();
+	void CapturePose(UINT stepIndex);
 	UINT _AddCollider(const PxGeometry& geometry, const PxMaterial& material, bool isTrigger = false, const PxTransform& localPose = PxTransform(PxIdentity), UINT colliderId = UINT_MAX);
 };
 
@@ -11,104 +11,131 @@ TransformComponent::TransformComponent():
 	m_Right{ 1, 0, 0 },
 	m_Rotation{ 0, 0, 0, 1 },
 	m_WorldRotation{ 0, 0, 0, 1 }
-{}
-
-bool TransformComponent::CheckIfDirty()
 {
-	//If Parent is dirty == update required (spatial relation)
-	if(const GameObject* pParent = GetGameObject()->GetParent())
-	{
-		if(pParent->GetTransform()->IsDirty())
-		{
-			m_IsDirty = true;
-			return true;
-		}
-	}
-
-	//RigidBody (non static), Controller or Transform changed == update required
-	m_IsDirty = m_pRigidBodyComponent != nullptr && !m_pRigidBodyComponent->IsStatic();
-	m_IsDirty = m_IsDirty || m_pControllerComponent != nullptr;
-	m_IsDirty = m_IsDirty || m_IsTransformChanged != TransformChanged::NONE;
+	XMStoreFloat4x4(&m_World, XMMatrixIdentity());
+}
 
-	return m_IsDirty;
+TransformComponent::~TransformComponent()
+{
+	if (m_pHierarchy)
+		m_pHierarchy->Unregister(m_Slot);
 }
 
 void TransformComponent::Initialize(const SceneContext& )
 {
-	UpdateTransforms();
+	//Register right away, components initialized after this one (RigidBody, Controller, ...) rely on a valid world transform
+	if (GameScene* pScene = GetGameObject()->GetScene())
+		AttachToHierarchy(pScene);
 }
 
 void TransformComponent::Update(const SceneContext& )
 {
-	m_IsDirty = CheckIfDirty();
-
-	if (m_IsDirty)
-		UpdateTransforms();
+	//World matrices are resolved by TransformHierarchy::Update (GameScene::RootUpdate)
+	//Only the physics <> transform synchronization remains per component
+	if (m_pHierarchy && (m_pRigidBodyComponent || m_pControllerComponent))
+		SyncPhysics();
 }
 
-void TransformComponent::UpdateTransforms()
+void TransformComponent::OnSceneAttach(GameScene* pScene)
 {
-	ASSERT_IF(m_pRigidBodyComponent && m_pControllerComponent, L"Single GameObject can't have a RigidBodyComponent AND ControllerComponent at the same time (remove one)")
+	AttachToHierarchy(pScene);
+}
 
-	if (m_pRigidBodyComponent && m_IsInitialized)
-	{
-		if (isSet(m_IsTransformChanged, TransformChanged::TRANSLATION))m_pRigidBodyComponent->Translate(m_Position);
-		else m_Position = m_pRigidBodyComponent->GetPosition();
+void TransformComponent::AttachToHierarchy(GameScene* pScene)
+{
+	if (m_pHierarchy)
+		return;
 
-		if (isSet(m_IsTransformChanged, TransformChanged::ROTATION)) m_pRigidBodyComponent->Rotate(m_Rotation);
-		else m_Rotation = m_pRigidBodyComponent->GetRotation();
-	}
-	else if(m_pControllerComponent && m_IsInitialized)
+	//Parent has to be registered first (keeps the hierarchy in parent-before-child order)
+	UINT parentSlot{ TransformHierarchy::InvalidSlot };
+	if (const GameObject* pParent = GetGameObject()->GetParent())
 	{
-		if (isSet(m_IsTransformChanged, TransformChanged::TRANSLATION)) m_pControllerComponent->Translate(m_Position);
-		else m_Position = m_pControllerComponent->GetPosition();
+		TransformComponent* pParentTransform{ pParent->GetTransform() };
+		pParentTransform->AttachToHierarchy(pScene);
+		parentSlot = pParentTransform->m_Slot;
 	}
 
-	//Calculate World Matrix
-	//**********************
-	auto rot = XMLoadFloat4(&m_Rotation);
-	auto world = XMMatrixScaling(m_Scale.x, m_Scale.y, m_Scale.z) *
-		XMMatrixRotationQuaternion(rot) *
-		XMMatrixTranslation(m_Position.x, m_Position.y, m_Position.z);
+	m_pHierarchy = pScene->GetTransformHierarchy();
+	m_Slot = m_pHierarchy->Register(this, parentSlot);
+}
 
-	if (const auto pParent = m_pGameObject->GetParent())
-	{
-		const auto parentWorld = XMLoadFloat4x4(&pParent->GetTransform()->m_World);
-		world *= parentWorld;
-	}
+void TransformComponent::OnSceneDetach(GameScene* )
+{
+	if (!m_pHierarchy)
+		return;
+
+	m_pHierarchy->Unregister(m_Slot);
+	m_pHierarchy = nullptr;
+	m_Slot = TransformHierarchy::InvalidSlot;
+}
 
-	XMStoreFloat4x4(&m_World, world);
+void TransformComponent::SyncPhysics()
+{
+	ASSERT_IF(m_pRigidBodyComponent && m_pControllerComponent, L"Single GameObject can't have a RigidBodyComponent AND ControllerComponent at the same time (remove one)")
 
-	//Get World Transform
-	XMVECTOR pos, scale;
-	if (XMMatrixDecompose(&scale, &rot, &pos, world))
+	const TransformChanged changed{ m_pHierarchy->GetChanged(m_Slot) };
+
+	//Only mark the transform as changed when the physics pose actually moved (sleeping/static actors cost nothing)
+	//The local transform takes the simulated pose, the pose interpolated between the last two fixed steps is rendering only
+	if (m_pRigidBodyComponent && (!m_pRigidBodyComponent->IsStatic() || changed != TransformChanged::NONE))
 	{
-		XMStoreFloat3(&m_WorldPosition, pos);
-		XMStoreFloat3(&m_WorldScale, scale);
-		XMStoreFloat4(&m_WorldRotation, rot);
-	}
+		if (isSet(changed, TransformChanged::TRANSLATION)) m_pRigidBodyComponent->Translate(LocalPosition());
+		else
+		{
+			const XMFLOAT3 position{ m_pRigidBodyComponent->GetPosition() };
+			if (!XMVector3Equal(XMLoadFloat3(&position), XMLoadFloat3(&LocalPosition())))
+			{
+				LocalPosition() = position;
+				MarkChanged(TransformChanged::TRANSLATION);
+			}
+		}
 
-	const auto rotMat = XMMatrixRotationQuaternion(rot);
-	const auto forward = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rotMat);
-	const auto right = XMVector3TransformCoord(XMVectorSet(1, 0, 0, 0), rotMat);
-	const auto up = XMVector3Cross(forward, right);
+		if (isSet(changed, TransformChanged::ROTATION)) m_pRigidBodyComponent->Rotate(LocalRotation());
+		else
+		{
+			const XMFLOAT4 rotation{ m_pRigidBodyComponent->GetRotation() };
+			if (!XMVector4Equal(XMLoadFloat4(&rotation), XMLoadFloat4(&LocalRotation())))
+			{
+				LocalRotation() = rotation;
+				MarkChanged(TransformChanged::ROTATION);
+			}
+		}
 
-	XMStoreFloat3(&m_Forward, forward);
-	XMStoreFloat3(&m_Right, right);
-	XMStoreFloat3(&m_Up, up);
+		XMFLOAT3 renderPosition{};
+		XMFLOAT4 renderRotation{};
+		m_pRigidBodyComponent->GetRenderPose(renderPosition, renderRotation);
+		m_pHierarchy->SetRenderPose(m_Slot, renderPosition, renderRotation);
+	}
+	else if (m_pControllerComponent)
+	{
+		if (isSet(changed, TransformChanged::TRANSLATION)) m_pControllerComponent->Translate(LocalPosition());
+		else
+		{
+			const XMFLOAT3 position{ m_pControllerComponent->GetPosition() };
+			if (!XMVector3Equal(XMLoadFloat3(&position), XMLoadFloat3(&LocalPosition())))
+			{
+				LocalPosition() = position;
+				MarkChanged(TransformChanged::TRANSLATION);
+			}
+		}
 
-	m_IsTransformChanged = TransformChanged::NONE;
+		m_pHierarchy->SetRenderPose(m_Slot, m_pControllerComponent->GetRenderPosition(), LocalRotation());
+	}
+}
+
+void TransformComponent::MarkChanged(TransformChanged changed)
+{
+	if (m_pHierarchy) m_pHierarchy->MarkChanged(m_Slot, changed);
+	else m_IsTransformChanged |= changed;
 }
 
 void TransformComponent::Translate(float x, float y, float z)
 {
-	//if (!CheckConstraints())
-		//return;
+	if (!CheckConstraints())
+		return;
 
-	m_IsTransformChanged |= TransformChanged::TRANSLATION;
-	m_Position.x = x;
-	m_Position.y = y;
-	m_Position.z = z;
+	MarkChanged(TransformChanged::TRANSLATION);
+	LocalPosition() = XMFLOAT3{ x, y, z };
 }
 
 void TransformComponent::Translate(const XMFLOAT3& position)
@@ -118,29 +145,29 @@ void TransformComponent::Translate(const XMFLOAT3& position)
 
 void TransformComponent::Translate(const XMVECTOR& position)
 {
-	//if (!CheckConstraints())
-		//return;
+	if (!CheckConstraints())
+		return;
 
-	m_IsTransformChanged |= TransformChanged::TRANSLATION;
-	XMStoreFloat3(&m_Position, position);
+	MarkChanged(TransformChanged::TRANSLATION);
+	XMStoreFloat3(&LocalPosition(), position);
 }
 
 void TransformComponent::Rotate(float x, float y, float z, bool degrees)
 {
-	//if (!CheckConstraints())
-		//return;
+	if (!CheckConstraints())
+		return;
 
-	m_IsTransformChanged |= TransformChanged::ROTATION;
+	MarkChanged(TransformChanged::ROTATION);
 	if (degrees)
 	{
-		XMStoreFloat4(&m_Rotation,
+		XMStoreFloat4(&LocalRotation(),
 		              XMQuaternionRotationRollPitchYaw(XMConvertToRadians(x),
 		                                                        XMConvertToRadians(y),
 		                                                        XMConvertToRadians(z)));
 	}
 	else
 	{
-		XMStoreFloat4(&m_Rotation, XMQuaternionRotationRollPitchYaw(x, y, z));
+		XMStoreFloat4(&LocalRotation(), XMQuaternionRotationRollPitchYaw(x, y, z));
 	}
 }
 
@@ -151,13 +178,13 @@ void TransformComponent::Rotate(const XMFLOAT3& rotation, bool areDegrees)
 
 void TransformComponent::Rotate(const XMVECTOR& rotation, bool isQuaternion)
 {
-	//if (!CheckConstraints())
-		//return;
+	if (!CheckConstraints())
+		return;
 
-	m_IsTransformChanged |= TransformChanged::ROTATION;
+	MarkChanged(TransformChanged::ROTATION);
 	if (isQuaternion)
 	{
-		XMStoreFloat4(&m_Rotation, rotation);
+		XMStoreFloat4(&LocalRotation(), rotation);
 	}
 	else
 	{
@@ -167,13 +194,11 @@ void TransformComponent::Rotate(const XMVECTOR& rotation, bool isQuaternion)
 
 void TransformComponent::Scale(float x, float y, float z)
 {
-	//if (!CheckConstraints())
-		//return;
+	if (!CheckConstraints())
+		return;
 
-	m_IsTransformChanged |= TransformChanged::SCALE;
-	m_Scale.x = x;
-	m_Scale.y = y;
-	m_Scale.z = z;
+	MarkChanged(TransformChanged::SCALE);
+	LocalScale() = XMFLOAT3{ x, y, z };
 }
 
 void TransformComponent::Scale(float s)
@@ -188,16 +213,17 @@ void TransformComponent::Scale(const XMFLOAT3& scale)
 
 bool TransformComponent::CheckConstraints() const
 {
-	return true;
-	//if (!m_IsInitialized)
-	//	return true;
-
-	//const auto rigidBody = GetGameObject()->GetComponent<RigidBodyComponent>();
-	//if (rigidBody != nullptr && rigidBody->IsStatic())
-	//{
-	//	Logger::LogWarning(L"[TransformComponent] Constraint Broken: GameObject with a static rigid body can't be transformed!");
-	//	//return false;
-	//}
+	//Frozen (static) subtrees can't be transformed
+	if (m_pGameObject && m_pGameObject->GetIsFrozen())
+	{
+		//Once per object, a per frame transform would flood the log
+		if (!m_IsFrozenWarningLogged)
+		{
+			Logger::LogWarning(L"[TransformComponent] Constraint Broken: GameObject is frozen and can't be transformed! (GameObject::SetFrozen)");
+			m_IsFrozenWarningLogged = true;
+		}
+		return false;
+	}
 
-	//return true;
+	return true;
 }
\ No newline at end of file
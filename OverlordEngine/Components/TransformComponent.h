@@ -1,4 +1,5 @@
 #pragma once
+#include "Scenegraph/TransformHierarchy.h"
 
 class ControllerComponent;
 class RigidBodyComponent;
@@ -7,7 +8,7 @@ class TransformComponent : public BaseComponent
 {
 public:
 	TransformComponent();
-	~TransformComponent() override = default;
+	~TransformComponent() override;
 
 	TransformComponent(const TransformComponent& other) = delete;
 	TransformComponent(TransformComponent&& other) noexcept = delete;
@@ -27,19 +28,24 @@ public:
 	void Scale(float s);
 	void Scale(const XMFLOAT3& scale);
 
-	const XMFLOAT3& GetPosition() const { return m_Position; }
-	const XMFLOAT3& GetWorldPosition() const { return m_WorldPosition; }
-	const XMFLOAT3& GetScale() const { return m_Scale; }
-	const XMFLOAT3& GetWorldScale() const { return m_WorldScale; }
-	const XMFLOAT4& GetRotation() const { return m_Rotation; }
-	const XMFLOAT4& GetWorldRotation() const { return m_WorldRotation; }
-	const XMFLOAT4X4& GetWorld() const { return m_World; }
-
-	const XMFLOAT3& GetForward() const { return m_Forward; }
-	const XMFLOAT3& GetUp() const { return m_Up; }
-	const XMFLOAT3& GetRight() const { return m_Right; }
-
-	bool IsDirty() const { return m_IsDirty; }
+	//Registered transforms live in the scene's TransformHierarchy, detached ones use their own (cached) state
+	//Returned by value, the hierarchy storage moves when transforms are registered or compacted
+	//Physics driven transforms hold the simulated pose of the latest fixed step, rendering uses GetRenderWorld
+	XMFLOAT3 GetPosition() const { return m_pHierarchy ? m_pHierarchy->GetLocalPosition(m_Slot) : m_Position; }
+	XMFLOAT3 GetWorldPosition() const { return m_pHierarchy ? m_pHierarchy->GetWorldPosition(m_Slot) : m_WorldPosition; }
+	XMFLOAT3 GetScale() const { return m_pHierarchy ? m_pHierarchy->GetLocalScale(m_Slot) : m_Scale; }
+	XMFLOAT3 GetWorldScale() const { return m_pHierarchy ? m_pHierarchy->GetWorldScale(m_Slot) : m_WorldScale; }
+	XMFLOAT4 GetRotation() const { return m_pHierarchy ? m_pHierarchy->GetLocalRotation(m_Slot) : m_Rotation; }
+	XMFLOAT4 GetWorldRotation() const { return m_pHierarchy ? m_pHierarchy->GetWorldRotation(m_Slot) : m_WorldRotation; }
+	XMFLOAT4X4 GetWorld() const { return m_pHierarchy ? m_pHierarchy->GetWorld(m_Slot) : m_World; }
+	//World to draw with, the physics pose interpolated between the last two fixed steps (GetWorld when not interpolating)
+	XMFLOAT4X4 GetRenderWorld() const { return m_pHierarchy ? m_pHierarchy->GetRenderWorld(m_Slot) : m_World; }
+
+	XMFLOAT3 GetForward() const { return m_pHierarchy ? m_pHierarchy->GetForward(m_Slot) : m_Forward; }
+	XMFLOAT3 GetUp() const { return m_pHierarchy ? m_pHierarchy->GetUp(m_Slot) : m_Up; }
+	XMFLOAT3 GetRight() const { return m_pHierarchy ? m_pHierarchy->GetRight(m_Slot) : m_Right; }
+
+	bool IsDirty() const { return m_pHierarchy && m_pHierarchy->IsDirty(m_Slot); }
 	void SetRigidBodyComponent(RigidBodyComponent* pRigidBody) { m_pRigidBodyComponent = pRigidBody; }
 	void SetControllerComponent(ControllerComponent* pController) { m_pControllerComponent = pController; }
 
@@ -47,14 +53,20 @@ protected:
 
 	void Initialize(const SceneContext& sceneContext) override;
 	void Update(const SceneContext& sceneContext) override;
+	void OnSceneAttach(GameScene* pScene) override;
+	void OnSceneDetach(GameScene* pScene) override;
 
-	void UpdateTransforms();
+	void AttachToHierarchy(GameScene* pScene);
+	void SyncPhysics();
 	bool CheckConstraints() const;
 
-	bool CheckIfDirty();
-	bool m_IsDirty{};
-
 private:
+	friend class TransformHierarchy;
+
+	XMFLOAT3& LocalPosition() { return m_pHierarchy ? m_pHierarchy->GetLocalPosition(m_Slot) : m_Position; }
+	XMFLOAT4& LocalRotation() { return m_pHierarchy ? m_pHierarchy->GetLocalRotation(m_Slot) : m_Rotation; }
+	XMFLOAT3& LocalScale() { return m_pHierarchy ? m_pHierarchy->GetLocalScale(m_Slot) : m_Scale; }
+	void MarkChanged(TransformChanged changed);
 
 	XMFLOAT3 m_Position{}, m_WorldPosition{};
 	XMFLOAT3 m_Scale{}, m_WorldScale{};
@@ -63,6 +75,11 @@ private:
 	XMFLOAT4X4 m_World{};
 	TransformChanged m_IsTransformChanged{};
 
+	TransformHierarchy* m_pHierarchy{};
+	UINT m_Slot{ TransformHierarchy::InvalidSlot };
+
 	RigidBodyComponent* m_pRigidBodyComponent{};
 	ControllerComponent* m_pControllerComponent{};
+
+	mutable bool m_IsFrozenWarningLogged{};
 };
@@ -1,4 +1,8 @@
 #pragma once
+#include <future>
+#include <mutex>
+#include "ContentScope.h"
+
 struct ContentLoadInfo
 {
 	fs::path assetFullPath{};
@@ -9,6 +13,18 @@ struct ContentLoadInfo
 class BaseLoader
 {
 public:
+	//Cached content of one type (see ContentManager::GetResidency)
+	struct ResidencyStats
+	{
+		UINT assets{};
+		UINT unreferenced{}; //Evictable (no scope references it, not pinned)
+		UINT pinned{};
+		UINT64 bytes{};
+		UINT64 unreferencedBytes{};
+		UINT64 budgetBytes{}; //0 == unlimited
+		UINT evictions{}; //Since startup
+	};
+
 	BaseLoader(const BaseLoader& other) = delete;
 	BaseLoader(BaseLoader&& other) noexcept = delete;
 	BaseLoader& operator=(const BaseLoader& other) = delete;
@@ -20,8 +36,66 @@ public:
 	virtual void Unload() = 0;
 	void Initialize(const GameContext& gameContext) { m_GameContext = gameContext; }
 
+	virtual void ReleaseReference(size_t pathHash, ContentScope* pScope) = 0; //ContentScope::Release
+	virtual ResidencyStats GetResidency() const = 0;
+	virtual UINT64 GetResidentBytes() const = 0;
+	virtual UINT64 GetOldestUnreferenced() const = 0; //Use tick of the least recently used evictable asset, 0 == none
+	virtual bool EvictOldest() = 0; //False when nothing can be evicted
+
+	void SetBudget(UINT64 budgetBytes) { m_BudgetBytes = budgetBytes; }
+	UINT64 GetBudget() const { return m_BudgetBytes; }
+
 protected:
+	//Shared by all loaders, orders the assets of different types for LRU eviction
+	static UINT64 NextUseTick() { return m_UseTick.fetch_add(1, std::memory_order_relaxed) + 1; }
+
 	GameContext m_GameContext{};
+	UINT64 m_BudgetBytes{};
+
+private:
+	static inline std::atomic<UINT64> m_UseTick{};
+};
+
+template <class T>
+class ContentLoader;
+
+//One load of an asset, shared by every request that arrives while it is in flight
+template <class T>
+struct ContentRequest
+{
+	ContentLoadInfo loadInfo{};
+	size_t pathHash{};
+	std::atomic<bool> isClaimed{}; //Set by the thread that runs LoadContent (a queued job or the first Get)
+	std::atomic<std::thread::id> claimingThread{};
+	std::promise<T*> promise{};
+	std::shared_future<T*> result{ promise.get_future().share() };
+
+	//Guarded by the loader's mutex, moved to the cache entry once loaded
+	std::vector<ContentScope*> scopes{}; //Scopes referencing the asset, each one holds it in its set until the load completes
+	bool isPinned{};
+	std::unique_ptr<ContentScope> pDependencies{ std::make_unique<ContentScope>() }; //Content loaded by LoadContent itself
+};
+
+//ContentManager::LoadAsync result, cheap to copy (all copies share the same request)
+template <class T>
+class ContentHandle final
+{
+public:
+	ContentHandle() = default;
+
+	bool IsValid() const { return m_pRequest != nullptr || m_pContent != nullptr; }
+	bool IsReady() const { return !m_pRequest || m_pRequest->result.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready; }
+	//Blocks until the asset is loaded, loads it on the calling thread when no worker picked the request up yet (nullptr if the load failed)
+	T* Get() const { return m_pRequest ? m_pLoader->Resolve(*m_pRequest) : m_pContent; }
+
+private:
+	friend class ContentLoader<T>;
+	explicit ContentHandle(T* pContent) : m_pContent{ pContent } {}
+	ContentHandle(ContentLoader<T>* pLoader, std::shared_ptr<ContentRequest<T>> pRequest) : m_pLoader{ pLoader }, m_pRequest{ std::move(pRequest) } {}
+
+	ContentLoader<T>* m_pLoader{};
+	std::shared_ptr<ContentRequest<T>> m_pRequest{};
+	T* m_pContent{}; //Already cached when requested
 };
 
 template <class T>
@@ -37,14 +111,50 @@ public:
 
 	const type_info& GetType() const override { return typeid(T); }
 	T* GetContent(const ContentLoadInfo& loadInfo);
+	ContentHandle<T> GetContentAsync(const ContentLoadInfo& loadInfo); //Queued on the JobSystem (see ContentManager::LoadAsync)
 	void Unload() override;
 
+	void ReleaseReference(size_t pathHash, ContentScope* pScope) override;
+	ResidencyStats GetResidency() const override;
+	UINT64 GetResidentBytes() const override;
+	UINT64 GetOldestUnreferenced() const override;
+	bool EvictOldest() override;
+
 protected:
 	virtual T* LoadContent(const ContentLoadInfo& loadInfo) = 0;
 	virtual void Destroy(T* objToDestroy) = 0;
+	virtual UINT64 GetContentBytes(T* /*pContent*/) const { return 0; } //Measured once loaded (CPU & GPU memory owned by the asset)
 
 private:
-	static std::unordered_map<size_t, T*> m_ContentReferences;
+	friend class ContentHandle<T>;
+
+	struct CacheEntry
+	{
+		T* pContent{};
+		UINT64 bytes{};
+		UINT references{}; //Scopes referencing the asset
+		bool isPinned{};
+		UINT64 lastUse{}; //Last request or last released reference (LRU)
+		std::unique_ptr<ContentScope> pDependencies{};
+
+		bool IsEvictable() const { return references == 0 && !isPinned; }
+	};
+
+	//Cached content or the request that loads it (a new one when nobody is loading the asset yet)
+	std::shared_ptr<ContentRequest<T>> FindRequest(const ContentLoadInfo& loadInfo, T*& pCached, bool& isNew);
+	//Loads the asset unless another thread claimed the request, waits for that thread then (unless waitIfClaimed is false)
+	T* Resolve(ContentRequest<T>& request, bool waitIfClaimed = true);
+	T* WaitFor(const ContentRequest<T>& request) const;
+	void Complete(ContentRequest<T>& request, T* pContent); //Caches a loaded asset & fulfils the request (nullptr == failed)
+	//Evictable entry with the lowest use tick, needs the lock
+	const CacheEntry* FindOldest(size_t& pathHash) const;
+
+	//Guards the cache & the in-flight requests only, LoadContent runs unlocked (content can be requested from worker threads)
+	static std::mutex m_ContentMutex;
+	static std::unordered_map<size_t, CacheEntry> m_ContentReferences;
+	static std::unordered_map<size_t, std::shared_ptr<ContentRequest<T>>> m_PendingContent;
+	static UINT64 m_ResidentBytes;
+	static UINT m_Evictions;
 	static int m_LoaderReferences;
 };
 
@@ -57,17 +167,250 @@ ContentLoader<T>::ContentLoader()
 template <class T>
 T* ContentLoader<T>::GetContent(const ContentLoadInfo& loadInfo)
 {
-	size_t pathHash = fs::hash_value(loadInfo.assetSubPath);
-	auto it = m_ContentReferences.find(pathHash);
-	if(it != m_ContentReferences.end())
+	T* pCached{};
+	bool isNew{};
+	const auto pRequest = FindRequest(loadInfo, pCached, isNew);
+	return pRequest ? Resolve(*pRequest) : pCached;
+}
+
+template <class T>
+ContentHandle<T> ContentLoader<T>::GetContentAsync(const ContentLoadInfo& loadInfo)
+{
+	T* pCached{};
+	bool isNew{};
+	auto pRequest = FindRequest(loadInfo, pCached, isNew);
+	if (!pRequest)
+		return ContentHandle<T>{ pCached };
+
+	if (isNew)
+		m_GameContext.pJobSystem->Run([this, pRequest]() { Resolve(*pRequest, false); }); //Nothing to wait for, a Get claimed it first
+
+	return ContentHandle<T>{ this, std::move(pRequest) };
+}
+
+template <class T>
+std::shared_ptr<ContentRequest<T>> ContentLoader<T>::FindRequest(const ContentLoadInfo& loadInfo, T*& pCached, bool& isNew)
+{
+	const size_t pathHash = fs::hash_value(loadInfo.assetSubPath);
+
+	//The reference is taken by the requesting thread, also when the asset is loaded by another one
+	ContentScope* pScope{ ContentScope::GetActive() };
+	const bool isPinned{ pScope == nullptr };
+
+	//Added to the scope under the cache lock, a concurrent ContentScope::Release decrements after the count below is raised
+	std::lock_guard lock{ m_ContentMutex };
+	const UINT newReference{ pScope && pScope->Add(this, pathHash) ? 1u : 0u };
+	const auto it = m_ContentReferences.find(pathHash);
+	if (it != m_ContentReferences.end())
 	{
-		return (* it).second;
+		CacheEntry& entry = (*it).second;
+		entry.references += newReference;
+		entry.isPinned |= isPinned;
+		entry.lastUse = NextUseTick();
+
+		pCached = entry.pContent;
+		return nullptr;
 	}
 
-	T* content = LoadContent(loadInfo);
-	if (content != nullptr)m_ContentReferences.insert(std::pair<size_t, T*>(pathHash, content));
+	auto& pRequest = m_PendingContent[pathHash];
+	isNew = pRequest == nullptr;
+	if (isNew)
+	{
+		pRequest = std::make_shared<ContentRequest<T>>();
+		pRequest->loadInfo = loadInfo;
+		pRequest->pathHash = pathHash;
+	}
 
-	return content;
+	if (newReference > 0)
+		pRequest->scopes.push_back(pScope);
+	pRequest->isPinned |= isPinned;
+	return pRequest;
+}
+
+template <class T>
+T* ContentLoader<T>::Resolve(ContentRequest<T>& request, bool waitIfClaimed)
+{
+	//Only the first thread loads, the others wait for its result (a failed load isn't cached, the next request tries again)
+	if (request.isClaimed.exchange(true))
+		return waitIfClaimed ? WaitFor(request) : nullptr;
+
+	request.claimingThread.store(std::this_thread::get_id());
+
+	T* pContent{};
+	try
+	{
+		//Content loaded by the loader itself is referenced by this asset
+		ContentScope::Active dependencyScope{ request.pDependencies.get() };
+		pContent = LoadContent(request.loadInfo);
+	}
+	catch (...)
+	{
+		//Waiters get nullptr, the request is dropped
+		Complete(request, nullptr);
+		throw;
+	}
+
+	Complete(request, pContent);
+	return pContent;
+}
+
+template <class T>
+T* ContentLoader<T>::WaitFor(const ContentRequest<T>& request) const
+{
+	//Picked up by a helping wait further down the claiming thread's own stack, the load can't finish before this returns
+	ASSERT_IF(request.claimingThread.load() == std::this_thread::get_id(), L"ContentLoader > \"{}\" is requested again while this thread loads it", request.loadInfo.assetSubPath);
+
+	//Helps instead of blocking, the claiming thread may be waiting for queued jobs (e.g. MeshFilter::BuildVertexBuffer batches)
+	JobSystem* pJobSystem{ m_GameContext.pJobSystem };
+	while (request.result.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready)
+	{
+		if (!pJobSystem || !pJobSystem->TryRunOne())
+			std::this_thread::yield();
+	}
+
+	return request.result.get();
+}
+
+template <class T>
+void ContentLoader<T>::Complete(ContentRequest<T>& request, T* pContent)
+{
+	const UINT64 bytes{ pContent ? GetContentBytes(pContent) : 0 };
+	std::unique_ptr<ContentScope> pDependencies{};
+	{
+		std::lock_guard lock{ m_ContentMutex };
+		m_PendingContent.erase(request.pathHash);
+		pDependencies = std::move(request.pDependencies);
+
+		if (pContent)
+		{
+			const UINT references{ static_cast<UINT>(request.scopes.size()) };
+			m_ContentReferences.emplace(request.pathHash, CacheEntry{ pContent, bytes, references, request.isPinned, NextUseTick(), std::move(pDependencies) });
+			m_ResidentBytes += bytes;
+		}
+		else
+		{
+			//Nothing was counted, a retry from the same scope has to reference the asset again (under the lock, a scope releases
+			//its pending references through ReleaseReference before it is destroyed)
+			for (ContentScope* pScope : request.scopes)
+			{
+				pScope->Remove(this, request.pathHash);
+			}
+		}
+		request.scopes.clear();
+	}
+
+	//Left over from a failed load
+	if (pDependencies)
+		pDependencies->Release();
+
+	request.promise.set_value(pContent);
+}
+
+template <class T>
+void ContentLoader<T>::ReleaseReference(size_t pathHash, ContentScope* pScope)
+{
+	std::lock_guard lock{ m_ContentMutex };
+	const auto it = m_ContentReferences.find(pathHash);
+	if (it != m_ContentReferences.end())
+	{
+		CacheEntry& entry = (*it).second;
+		if (entry.references > 0 && --entry.references == 0)
+			entry.lastUse = NextUseTick();
+
+		return;
+	}
+
+	//Released while still loading
+	const auto pendingIt = m_PendingContent.find(pathHash);
+	if (pendingIt != m_PendingContent.end())
+		std::erase((*pendingIt).second->scopes, pScope);
+}
+
+template <class T>
+BaseLoader::ResidencyStats ContentLoader<T>::GetResidency() const
+{
+	ResidencyStats stats{};
+	stats.budgetBytes = m_BudgetBytes;
+
+	std::lock_guard lock{ m_ContentMutex };
+	for (const auto& kvp : m_ContentReferences)
+	{
+		const CacheEntry& entry = kvp.second;
+		++stats.assets;
+		stats.bytes += entry.bytes;
+
+		if (entry.isPinned)
+			++stats.pinned;
+
+		if (entry.IsEvictable())
+		{
+			++stats.unreferenced;
+			stats.unreferencedBytes += entry.bytes;
+		}
+	}
+	stats.evictions = m_Evictions;
+
+	return stats;
+}
+
+template <class T>
+UINT64 ContentLoader<T>::GetResidentBytes() const
+{
+	std::lock_guard lock{ m_ContentMutex };
+	return m_ResidentBytes;
+}
+
+template <class T>
+const typename ContentLoader<T>::CacheEntry* ContentLoader<T>::FindOldest(size_t& pathHash) const
+{
+	const CacheEntry* pOldest{};
+	for (const auto& [entryHash, entry] : m_ContentReferences)
+	{
+		if (entry.IsEvictable() && (!pOldest || entry.lastUse < pOldest->lastUse))
+		{
+			pOldest = &entry;
+			pathHash = entryHash;
+		}
+	}
+
+	return pOldest;
+}
+
+template <class T>
+UINT64 ContentLoader<T>::GetOldestUnreferenced() const
+{
+	std::lock_guard lock{ m_ContentMutex };
+	size_t pathHash{};
+	const CacheEntry* pOldest{ FindOldest(pathHash) };
+	return pOldest ? pOldest->lastUse : 0;
+}
+
+template <class T>
+bool ContentLoader<T>::EvictOldest()
+{
+	T* pContent{};
+	std::unique_ptr<ContentScope> pDependencies{};
+	{
+		std::lock_guard lock{ m_ContentMutex };
+		size_t pathHash{};
+		if (!FindOldest(pathHash))
+			return false;
+
+		const auto it = m_ContentReferences.find(pathHash);
+		CacheEntry& entry = (*it).second;
+		pContent = entry.pContent;
+		pDependencies = std::move(entry.pDependencies);
+		m_ResidentBytes -= entry.bytes;
+		++m_Evictions;
+		m_ContentReferences.erase(it);
+	}
+
+	//Unreferenced, nothing can request it anymore without loading it again
+	Destroy(pContent);
+	if (pDependencies)
+		pDependencies->Release();
+
+	return true;
 }
 
 #pragma warning(push)
@@ -75,22 +418,38 @@ T* ContentLoader<T>::GetContent(const ContentLoadInfo& loadInfo)
 template <class T>
 void ContentLoader<T>::Unload()
 {
+	std::lock_guard lock{ m_ContentMutex };
 	--m_LoaderReferences;
 
 	if (m_LoaderReferences <= 0)
 	{
-		for (std::pair<size_t, T*> kvp : m_ContentReferences)
+		//The dependency scopes release nothing, ContentManager::Release detached the loaders first
+		for (const auto& kvp : m_ContentReferences)
 		{
-			Destroy(kvp.second);
+			Destroy(kvp.second.pContent);
 		}
 
 		m_ContentReferences.clear();
+		m_PendingContent.clear();
+		m_ResidentBytes = 0;
 	}
 }
 #pragma warning(pop)
 
 template <class T>
-std::unordered_map<size_t, T*> ContentLoader<T>::m_ContentReferences = {};
+std::mutex ContentLoader<T>::m_ContentMutex{};
+
+template <class T>
+std::unordered_map<size_t, typename ContentLoader<T>::CacheEntry> ContentLoader<T>::m_ContentReferences = {};
+
+template <class T>
+std::unordered_map<size_t, std::shared_ptr<ContentRequest<T>>> ContentLoader<T>::m_PendingContent = {};
+
+template <class T>
+UINT64 ContentLoader<T>::m_ResidentBytes = {};
+
+template <class T>
+UINT ContentLoader<T>::m_Evictions = {};
 
 template <class T>
 int ContentLoader<T>::m_LoaderReferences = {};
@@ -0,0 +1,287 @@
+#include "stdafx.h"
+#include "ContentPack.h"
+
+namespace
+{
+	//Read by a loader, .wav files stay loose (SoundManager streams them through FMOD)
+	const wchar_t* gPackableExtensions[] = { L".fx", L".fxc", L".ovm", L".ovmc", L".ovpc", L".ovpt", L".dds", L".tga", L".png", L".jpg", L".fnt" };
+	//Compressed formats already (and .ovmc, uploaded straight out of the mapped pack)
+	const wchar_t* gStoredExtensions[] = { L".png", L".jpg", L".ovmc" };
+
+	std::wstring ToLower(std::wstring string)
+	{
+		std::ranges::transform(string, string.begin(), [](wchar_t character) { return static_cast<wchar_t>(towlower(character)); });
+		return string;
+	}
+
+	bool HasExtension(const fs::path& file, const wchar_t* const* pBegin, const wchar_t* const* pEnd)
+	{
+		const std::wstring extension{ ToLower(file.extension().wstring()) };
+		return std::find(pBegin, pEnd, extension) != pEnd;
+	}
+
+	bool ReadFile(const fs::path& file, std::vector<BYTE>& data)
+	{
+		std::ifstream stream{ file, std::ios::in | std::ios::binary | std::ios::ate };
+		if (!stream.is_open())
+			return false;
+
+		data.resize(static_cast<size_t>(stream.tellg()));
+		stream.seekg(0, std::ios::beg);
+		stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		return !stream.fail();
+	}
+}
+
+bool ContentPack::Open(const fs::path& packFile)
+{
+	Close();
+
+	m_Reader.OpenMapped(packFile.wstring());
+	if (!m_Reader.Exists())
+		return false;
+
+	const auto magic = m_Reader.Read<UINT32>();
+	const auto version = m_Reader.Read<UINT32>();
+	const auto entryCount = m_Reader.Read<UINT32>();
+	const auto indexOffset = m_Reader.Read<UINT64>();
+
+	if (magic != Magic || version != Version)
+	{
+		Logger::LogWarning(L"Unsupported content pack (version {}), assets are loaded from the content root\n\tFile: \"{}\"", version, packFile.wstring());
+		Close();
+		return false;
+	}
+
+	//INDEX (every count, length & offset is checked against the mapped size before it is used)
+	if (indexOffset <= static_cast<UINT64>(LLONG_MAX) && m_Reader.SetBufferPosition(static_cast<INT64>(indexOffset)) && m_Reader.ReadArray(m_Entries, entryCount))
+	{
+		m_Paths.reserve(entryCount);
+		for (UINT32 i{}; i < entryCount && !m_Reader.HasFailed(); ++i)
+		{
+			m_Paths.emplace_back(m_Reader.ReadLongString());
+		}
+	}
+
+	const bool isValid{ !m_Reader.HasFailed() && m_Paths.size() == entryCount && std::ranges::all_of(m_Entries, [this](const Entry& entry)
+	{
+		//Decompressed sizes are allocated by Read
+		const bool isSizeValid{ (entry.flags & CompressedFlag) ? entry.size <= Lz4::GetDecompressBound(entry.storedSize) : entry.size == entry.storedSize };
+		return isSizeValid && m_Reader.GetView(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.storedSize)) != nullptr;
+	}) };
+
+	if (!isValid)
+	{
+		Logger::LogWarning(L"Corrupt content pack, assets are loaded from the content root\n\tFile: \"{}\"", packFile.wstring());
+		Close();
+		return false;
+	}
+
+	m_PackFile = packFile;
+	return true;
+}
+
+void ContentPack::Close()
+{
+	m_Reader.Close();
+	m_PackFile.clear();
+	m_Entries.clear();
+	m_Paths.clear();
+}
+
+bool ContentPack::Read(const std::wstring& assetSubPath, ContentBlob& blob) const
+{
+	const Entry* pEntry{ Find(assetSubPath) };
+	if (!pEntry)
+		return false;
+
+	const auto pStored = static_cast<const BYTE*>(m_Reader.GetView(static_cast<size_t>(pEntry->offset), static_cast<size_t>(pEntry->storedSize)));
+	blob.size = static_cast<size_t>(pEntry->size);
+
+	if ((pEntry->flags & CompressedFlag) == 0)
+	{
+		blob.pData = pStored;
+		blob.buffer.clear();
+		return true;
+	}
+
+	blob.buffer.resize(blob.size);
+	if (!Lz4::Decompress(pStored, static_cast<size_t>(pEntry->storedSize), blob.buffer.data(), blob.size))
+	{
+		Logger::LogWarning(L"Corrupt content pack entry \"{}\"\n\tFile: \"{}\"", assetSubPath, m_PackFile.wstring());
+		blob = {};
+		return false;
+	}
+
+	blob.pData = blob.buffer.data();
+	return true;
+}
+
+const ContentPack::Entry* ContentPack::Find(const std::wstring& assetSubPath) const
+{
+	if (m_Entries.empty())
+		return nullptr;
+
+	const std::wstring path{ NormalizePath(assetSubPath) };
+	const UINT64 pathHash{ HashPath(path) };
+
+	auto it = std::ranges::lower_bound(m_Entries, pathHash, {}, &Entry::pathHash);
+	for (; it != m_Entries.end() && it->pathHash == pathHash; ++it)
+	{
+		if (m_Paths[static_cast<size_t>(it - m_Entries.begin())] == path)
+			return &*it;
+	}
+
+	return nullptr;
+}
+
+bool ContentPack::Build(const fs::path& contentRoot, const fs::path& packFile, bool compress, BuildStats* pStats)
+{
+	struct Source
+	{
+		fs::path file{};
+		std::wstring path{};
+		UINT64 pathHash{};
+	};
+
+	//SOURCES
+	std::vector<Source> sources{};
+	std::error_code error{};
+	fs::recursive_directory_iterator directoryIt{ contentRoot, error };
+	if (error)
+	{
+		Logger::LogWarning(L"Failed to list the content root \"{}\" ({})", contentRoot.wstring(), StringUtil::utf8_decode(error.message()));
+		return false;
+	}
+
+	for (const fs::directory_entry& directoryEntry : directoryIt)
+	{
+		const fs::path& file{ directoryEntry.path() };
+		if (!directoryEntry.is_regular_file(error) || !IsPackable(file))
+			continue;
+
+		//An outdated cooked mesh wouldn't be loaded either (see MeshCooker::IsCookedUpToDate)
+		if (MeshCooker::IsCookedFile(file) && !MeshCooker::IsCookedUpToDate(fs::path{ file }.replace_extension(L".ovm")))
+			continue;
+
+		std::wstring path{ NormalizePath(file.lexically_relative(contentRoot)) };
+		const UINT64 pathHash{ HashPath(path) };
+		sources.push_back({ file, std::move(path), pathHash });
+	}
+
+	std::ranges::sort(sources, [](const Source& a, const Source& b) { return a.pathHash != b.pathHash ? a.pathHash < b.pathHash : a.path < b.path; });
+
+	fs::path tempFile{ packFile };
+	tempFile += L".tmp";
+
+	BinaryWriter writer{};
+	writer.Open(tempFile.wstring());
+	if (!writer.Exists())
+		return false;
+
+	//HEADER (index offset patched once the data is written)
+	writer.Write(Magic);
+	writer.Write(Version);
+	writer.Write(static_cast<UINT32>(sources.size()));
+	const INT64 indexOffsetPosition{ writer.GetBufferPosition() };
+	writer.Write(UINT64{});
+
+	//DATA
+	BuildStats stats{};
+	std::vector<Entry> entries{};
+	entries.reserve(sources.size());
+	std::vector<BYTE> data{};
+	std::vector<BYTE> compressed{};
+	bool isRead{ true };
+
+	for (const Source& source : sources)
+	{
+		if (!ReadFile(source.file, data))
+		{
+			Logger::LogWarning(L"Failed to read \"{}\" for the content pack", source.file.wstring());
+			isRead = false;
+			break;
+		}
+
+		Entry entry{ source.pathHash, 0, data.size(), data.size(), 0, 0 };
+		const BYTE* pStored{ data.data() };
+
+		if (compress && IsCompressible(source.file) && !data.empty())
+		{
+			compressed.resize(Lz4::GetCompressBound(data.size()));
+			const size_t compressedSize{ Lz4::Compress(data.data(), data.size(), compressed.data(), compressed.size()) };
+			if (compressedSize > 0 && compressedSize <= data.size() - data.size() / 8)
+			{
+				entry.flags |= CompressedFlag;
+				entry.storedSize = compressedSize;
+				pStored = compressed.data();
+				++stats.compressed;
+			}
+		}
+
+		writer.AlignBufferPosition(Alignment);
+		entry.offset = static_cast<UINT64>(writer.GetBufferPosition());
+		writer.WriteBytes(pStored, static_cast<size_t>(entry.storedSize));
+		entries.push_back(entry);
+
+		++stats.entries;
+		stats.bytes += entry.size;
+		stats.storedBytes += entry.storedSize;
+	}
+
+	//INDEX
+	writer.AlignBufferPosition(Alignment);
+	const INT64 indexOffset{ writer.GetBufferPosition() };
+	writer.WriteArray(entries);
+	for (const Source& source : sources)
+	{
+		writer.WriteLongString(source.path);
+	}
+
+	writer.SetBufferPosition(indexOffsetPosition);
+	writer.Write(static_cast<UINT64>(indexOffset));
+	writer.Close();
+
+	const bool isWritten{ isRead && !writer.HasFailed() && indexOffset > 0 };
+	if (isWritten)
+		fs::rename(tempFile, packFile, error);
+
+	if (!isWritten || error)
+	{
+		Logger::LogWarning(L"Failed to write the content pack\n\tFile: \"{}\"", packFile.wstring());
+		fs::remove(tempFile, error);
+		return false;
+	}
+
+	if (pStats)
+		*pStats = stats;
+
+	return true;
+}
+
+bool ContentPack::IsPackable(const fs::path& file)
+{
+	return HasExtension(file, std::begin(gPackableExtensions), std::end(gPackableExtensions));
+}
+
+bool ContentPack::IsCompressible(const fs::path& file)
+{
+	return !HasExtension(file, std::begin(gStoredExtensions), std::end(gStoredExtensions));
+}
+
+std::wstring ContentPack::NormalizePath(const fs::path& assetSubPath)
+{
+	return ToLower(assetSubPath.lexically_normal().generic_wstring());
+}
+
+UINT64 ContentPack::HashPath(const std::wstring& normalizedPath)
+{
+	UINT64 hash{ 14695981039346656037ull };
+	for (const wchar_t character : normalizedPath)
+	{
+		hash ^= static_cast<UINT64>(character);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+//Bytes of one pack entry: a view into the mapped pack (stored entries) or the decompressed copy in buffer
+//pData is valid as long as the blob and the pack (ContentManager keeps it open until Release)
+struct ContentBlob
+{
+	const BYTE* pData{};
+	size_t size{};
+	std::vector<BYTE> buffer{};
+};
+
+//Single file content archive (.ovpk), ContentManager resolves asset sub paths through it before the loose files (see GameContext::contentPack)
+//Entries are found by the hash of their normalized sub path (lower case, '/' separators), the stored path settles collisions
+//
+//Layout (BinaryWriter, [A] == padding up to Alignment)
+//	Header		UINT32 Magic, Version, entryCount | UINT64 indexOffset
+//	Data		per entry [A] storedSize bytes (Lz4 block when CompressedFlag is set)
+//	Index		[A] entryCount x Entry (sorted by pathHash) | entryCount x long string path (same order)
+class ContentPack final
+{
+public:
+	static constexpr UINT32 Magic{ 'O' | 'V' << 8 | 'P' << 16 | 'K' << 24 };
+	static constexpr UINT32 Version{ 1 };
+	static constexpr UINT Alignment{ 16 }; //Stored .ovmc entries keep the alignment of their blocks (see MeshCooker::Alignment)
+	static constexpr UINT32 CompressedFlag{ 1 << 0 };
+
+	struct Entry
+	{
+		UINT64 pathHash;
+		UINT64 offset;
+		UINT64 storedSize;
+		UINT64 size;
+		UINT32 flags;
+		UINT32 reserved;
+	};
+
+	struct BuildStats
+	{
+		UINT entries{};
+		UINT compressed{};
+		UINT64 bytes{}; //Source files
+		UINT64 storedBytes{}; //Entries in the pack (no header, index or padding)
+	};
+
+	ContentPack() = default;
+	~ContentPack() = default;
+	ContentPack(const ContentPack& other) = delete;
+	ContentPack(ContentPack&& other) noexcept = delete;
+	ContentPack& operator=(const ContentPack& other) = delete;
+	ContentPack& operator=(ContentPack&& other) noexcept = delete;
+
+	//Maps the pack, fails (closed) on a different version or an index, path or entry that doesn't fit the file
+	bool Open(const fs::path& packFile);
+	void Close();
+	bool IsOpen() const { return m_Reader.Exists(); }
+
+	//Thread safe once opened (loaders read entries on JobSystem workers)
+	bool Contains(const std::wstring& assetSubPath) const { return Find(assetSubPath) != nullptr; }
+	bool Read(const std::wstring& assetSubPath, ContentBlob& blob) const;
+
+	UINT GetEntryCount() const { return static_cast<UINT>(m_Entries.size()); }
+	const std::vector<std::wstring>& GetPaths() const { return m_Paths; } //Normalized, index order
+	const fs::path& GetPackFile() const { return m_PackFile; }
+
+	//Every packable file under contentRoot, written to a temporary file first (an existing pack is only replaced by a complete one)
+	//Entries are compressed when that saves at least an eighth of their size, formats that are compressed already are stored as is
+	static bool Build(const fs::path& contentRoot, const fs::path& packFile, bool compress, BuildStats* pStats = nullptr);
+
+	static bool IsPackable(const fs::path& file);
+	static std::wstring NormalizePath(const fs::path& assetSubPath); //Effects\\Sub/./X.fx > effects/sub/x.fx
+	static UINT64 HashPath(const std::wstring& normalizedPath); //FNV-1a
+
+private:
+	BinaryReader m_Reader{};
+	fs::path m_PackFile{};
+	std::vector<Entry> m_Entries{};
+	std::vector<std::wstring> m_Paths{};
+
+	const Entry* Find(const std::wstring& assetSubPath) const;
+	static bool IsCompressible(const fs::path& file);
+};
@@ -0,0 +1,42 @@
+#include "stdafx.h"
+#include "ContentScope.h"
+
+thread_local ContentScope* ContentScope::m_pActive{};
+
+ContentScope::~ContentScope()
+{
+	Release();
+}
+
+bool ContentScope::Add(BaseLoader* pLoader, size_t pathHash)
+{
+	std::lock_guard lock{ m_Mutex };
+	return m_References.emplace(pLoader, pathHash).second;
+}
+
+void ContentScope::Remove(BaseLoader* pLoader, size_t pathHash)
+{
+	std::lock_guard lock{ m_Mutex };
+	m_References.erase({ pLoader, pathHash });
+}
+
+void ContentScope::Release()
+{
+	//Released outside the lock, evicting an asset releases its own dependency scope
+	std::set<std::pair<BaseLoader*, size_t>> references{};
+	{
+		std::lock_guard lock{ m_Mutex };
+		references.swap(m_References);
+	}
+
+	for (const auto& [pLoader, pathHash] : references)
+	{
+		ContentManager::ReleaseReference(pLoader, pathHash, this);
+	}
+}
+
+size_t ContentScope::GetReferenceCount() const
+{
+	std::lock_guard lock{ m_Mutex };
+	return m_References.size();
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <mutex>
+#include <set>
+
+class BaseLoader;
+
+//References to cached content, held by a scene (GameScene::RootUninitialize releases them) or by an asset that loads other assets
+//(the texture of a SpriteFont, the layout effects of a mesh). Every load on a thread with an active scope references the asset once per scope,
+//without an active scope the asset is pinned (engine systems, effects shared across scenes) and kept until shutdown
+//Unreferenced content stays cached until a memory budget evicts it (see ContentManager::Trim)
+class ContentScope final
+{
+public:
+	//Makes a scope active on the calling thread for the lifetime of the guard (restores the previous one), nullptr == pin
+	class Active final
+	{
+	public:
+		explicit Active(ContentScope* pScope) : m_pPrevious(m_pActive) { m_pActive = pScope; }
+		~Active() { m_pActive = m_pPrevious; }
+		Active(const Active& other) = delete;
+		Active(Active&& other) noexcept = delete;
+		Active& operator=(const Active& other) = delete;
+		Active& operator=(Active&& other) noexcept = delete;
+
+	private:
+		ContentScope* m_pPrevious{};
+	};
+
+	ContentScope() = default;
+	~ContentScope();
+	ContentScope(const ContentScope& other) = delete;
+	ContentScope(ContentScope&& other) noexcept = delete;
+	ContentScope& operator=(const ContentScope& other) = delete;
+	ContentScope& operator=(ContentScope&& other) noexcept = delete;
+
+	static ContentScope* GetActive() { return m_pActive; }
+
+	bool Add(BaseLoader* pLoader, size_t pathHash); //False when the scope already references the asset
+	void Remove(BaseLoader* pLoader, size_t pathHash); //Drops a reference that was never counted (failed load, see ContentLoader::Complete)
+	void Release(); //Drops every reference
+	size_t GetReferenceCount() const;
+
+private:
+	mutable std::mutex m_Mutex{};
+	std::set<std::pair<BaseLoader*, size_t>> m_References{};
+
+	static thread_local ContentScope* m_pActive;
+};
@@ -1,14 +1,71 @@
 #include "stdafx.h"
 #include "EffectLoader.h"
 
+namespace
+{
+	//#include of a packed effect, relative to the including file (same as D3D_COMPILE_STANDARD_FILE_INCLUDE)
+	//Files missing from the pack are read from the content root
+	class PackInclude final : public ID3DInclude
+	{
+	public:
+		explicit PackInclude(const fs::path& effectDirectory) :m_EffectDirectory(effectDirectory) {}
+		~PackInclude() = default;
+		PackInclude(const PackInclude& other) = delete;
+		PackInclude(PackInclude&& other) noexcept = delete;
+		PackInclude& operator=(const PackInclude& other) = delete;
+		PackInclude& operator=(PackInclude&& other) noexcept = delete;
+
+		HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR pFileName, LPCVOID pParentData, LPCVOID* ppData, UINT* pBytes) override
+		{
+			const auto it = m_Directories.find(pParentData);
+			const fs::path& directory{ it != m_Directories.end() ? it->second : m_EffectDirectory };
+			const fs::path subPath{ (directory / StringUtil::utf8_decode(pFileName)).lexically_normal() };
+
+			auto pBlob = std::make_unique<ContentBlob>();
+			if (!ContentManager::ReadPacked(subPath.wstring(), *pBlob))
+			{
+				std::ifstream stream{ ContentManager::GetFullAssetPath(subPath.wstring()), std::ios::in | std::ios::binary | std::ios::ate };
+				if (!stream.is_open())
+					return E_FAIL;
+
+				pBlob->buffer.resize(static_cast<size_t>(stream.tellg()));
+				stream.seekg(0, std::ios::beg);
+				stream.read(reinterpret_cast<char*>(pBlob->buffer.data()), static_cast<std::streamsize>(pBlob->buffer.size()));
+				pBlob->pData = pBlob->buffer.data();
+				pBlob->size = pBlob->buffer.size();
+			}
+
+			*ppData = pBlob->pData;
+			*pBytes = static_cast<UINT>(pBlob->size);
+			m_Directories[pBlob->pData] = subPath.parent_path();
+			m_Blobs.push_back(std::move(pBlob));
+			return S_OK;
+		}
+
+		//Kept until the compile is done
+		HRESULT __stdcall Close(LPCVOID) override { return S_OK; }
+
+	private:
+		fs::path m_EffectDirectory{};
+		std::unordered_map<LPCVOID, fs::path> m_Directories{};
+		std::vector<std::unique_ptr<ContentBlob>> m_Blobs{};
+	};
+}
+
 ID3DX11Effect* EffectLoader::LoadContent(const ContentLoadInfo& loadInfo)
 {
+	ContentBlob blob{};
+	const bool isPacked{ ContentManager::ReadPacked(loadInfo.assetSubPath, blob) };
+
 	//If compiled effect
 	const auto& assetPath = loadInfo.assetFullPath;
 	if(assetPath.extension() == L".fxc")
 	{
-		ID3DX11Effect* pEffect;
-		D3DX11CreateEffectFromFile(assetPath.c_str(),0, m_GameContext.d3dContext.pDevice, &pEffect);
+		ID3DX11Effect* pEffect{};
+		if (isPacked)
+			D3DX11CreateEffectFromMemory(blob.pData, blob.size, 0, m_GameContext.d3dContext.pDevice, &pEffect);
+		else
+			D3DX11CreateEffectFromFile(assetPath.c_str(),0, m_GameContext.d3dContext.pDevice, &pEffect);
 		return pEffect;
 	}
 
@@ -23,14 +80,31 @@ ID3DX11Effect* EffectLoader::LoadContent(const ContentLoadInfo& loadInfo)
 	shaderFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
-	hr = D3DX11CompileEffectFromFile(assetPath.c_str(),
-		nullptr,
-		D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		shaderFlags,
-		0,
-		m_GameContext.d3dContext.pDevice,
-		&pEffect,
-		&pErrorBlob);
+	if (isPacked)
+	{
+		PackInclude include{ fs::path{ loadInfo.assetSubPath }.parent_path() };
+		const std::string sourceName{ StringUtil::utf8_encode(loadInfo.assetSubPath) }; //Error messages
+		hr = D3DX11CompileEffectFromMemory(blob.pData, blob.size,
+			sourceName.c_str(),
+			nullptr,
+			&include,
+			shaderFlags,
+			0,
+			m_GameContext.d3dContext.pDevice,
+			&pEffect,
+			&pErrorBlob);
+	}
+	else
+	{
+		hr = D3DX11CompileEffectFromFile(assetPath.c_str(),
+			nullptr,
+			D3D_COMPILE_STANDARD_FILE_INCLUDE,
+			shaderFlags,
+			0,
+			m_GameContext.d3dContext.pDevice,
+			&pEffect,
+			&pErrorBlob);
+	}
 
 	if(FAILED(hr))
 	{
@@ -64,3 +138,9 @@ void EffectLoader::Destroy(ID3DX11Effect* objToDestroy)
 {
 	SafeRelease(objToDestroy);
 }
+
+UINT64 EffectLoader::GetContentBytes(ID3DX11Effect* pContent) const
+{
+	//Constant buffers only, shader blobs aren't exposed by the effect
+	return EffectHelper::GetConstantBufferBytes(pContent);
+}
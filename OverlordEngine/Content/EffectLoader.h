@@ -12,4 +12,5 @@ public:
 protected:
 	ID3DX11Effect* LoadContent(const ContentLoadInfo& loadInfo) override;
 	void Destroy(ID3DX11Effect* objToDestroy) override;
+	UINT64 GetContentBytes(ID3DX11Effect* pContent) const override;
 };
@@ -0,0 +1,203 @@
+#include "stdafx.h"
+#include "MeshCooker.h"
+
+namespace
+{
+	template<typename T>
+	void WriteArrayBlock(BinaryWriter& writer, const std::vector<T>& source)
+	{
+		writer.Write(static_cast<UINT32>(source.size()));
+		writer.AlignBufferPosition(MeshCooker::Alignment);
+		writer.WriteArray(source);
+	}
+}
+
+std::vector<MeshCooker::Layout> MeshCooker::ResolveLayouts(const D3D11Context& d3dContext, const std::vector<std::wstring>& layoutEffects)
+{
+	std::vector<Layout> layouts{};
+	for (const std::wstring& effectFile : layoutEffects)
+	{
+		const auto pEffect = ContentManager::Load<ID3DX11Effect>(effectFile);
+		if (!pEffect)
+			continue;
+
+		//Same layout as MeshFilterLoader::BuildLoadLayouts, the layout object itself isn't needed
+		Layout layout{};
+		ID3D11InputLayout* pInputLayout{};
+		const bool isBuilt{ EffectHelper::BuildInputLayout(d3dContext.pDevice, pEffect->GetTechniqueByIndex(0), &pInputLayout, layout.descriptions, layout.inputLayoutSize, layout.inputLayoutID) };
+		SafeRelease(pInputLayout);
+
+		if (isBuilt)
+			layouts.emplace_back(std::move(layout));
+	}
+
+	return layouts;
+}
+
+bool MeshCooker::Cook(const MeshFilter* pMeshFilter, const std::vector<Layout>& layouts, bool includeAttributeArrays, const fs::path& cookedFile)
+{
+	if (pMeshFilter->IsCpuDataReleased())
+	{
+		Logger::LogWarning(L"Mesh \"{}\" released its CPU vertex data, it can't be cooked\n\tFile: \"{}\"", pMeshFilter->m_MeshName, cookedFile.wstring());
+		return false;
+	}
+
+	if (pMeshFilter->m_Meshes.size() > 256)
+	{
+		Logger::LogWarning(L"Mesh \"{}\" has more submeshes ({}) than a BYTE id can address\n\tFile: \"{}\"", pMeshFilter->m_MeshName, pMeshFilter->m_Meshes.size(), cookedFile.wstring());
+		return false;
+	}
+
+	//One stream per layout ID, the loader looks layouts up by ID (see MeshFilter::GetVertexBufferId)
+	std::vector<const Layout*> uniqueLayouts{};
+	for (const Layout& layout : layouts)
+	{
+		if (std::ranges::none_of(uniqueLayouts, [&layout](const Layout* pOther) { return pOther->inputLayoutID == layout.inputLayoutID; }))
+			uniqueLayouts.push_back(&layout);
+	}
+
+	fs::path tempFile{ cookedFile };
+	tempFile += L".tmp";
+
+	BinaryWriter writer{};
+	writer.Open(tempFile.wstring());
+	if (!writer.Exists())
+		return false;
+
+	//HEADER
+	UINT32 flags{};
+	if (includeAttributeArrays) flags |= AttributeArraysFlag;
+	if (pMeshFilter->m_HasAnimations) flags |= AnimationsFlag;
+
+	writer.Write(Magic);
+	writer.Write(Version);
+	writer.Write(flags);
+	writer.WriteLongString(pMeshFilter->m_MeshName);
+	writer.Write(pMeshFilter->m_BoneCount);
+	writer.Write(pMeshFilter->m_Bounds);
+	writer.Write(static_cast<UINT32>(pMeshFilter->m_Meshes.size()));
+	writer.Write(static_cast<UINT32>(pMeshFilter->m_AnimationClips.size()));
+
+	//SUBMESHES
+	for (const SubMeshFilter& subMesh : pMeshFilter->m_Meshes)
+	{
+		WriteSubMesh(writer, subMesh, uniqueLayouts, includeAttributeArrays);
+	}
+
+	//ANIMATION CLIPS
+	for (const AnimationClip& clip : pMeshFilter->m_AnimationClips)
+	{
+		writer.WriteLongString(clip.name);
+		writer.Write(clip.duration);
+		writer.Write(clip.ticksPerSecond);
+		writer.Write(static_cast<UINT32>(clip.keys.size()));
+
+		for (const AnimationKey& key : clip.keys)
+		{
+			writer.Write(key.tick);
+			WriteArrayBlock(writer, key.boneTransforms);
+		}
+	}
+
+	writer.Close();
+
+	std::error_code error{};
+	if (!writer.HasFailed())
+		fs::rename(tempFile, cookedFile, error);
+
+	if (writer.HasFailed() || error)
+	{
+		Logger::LogWarning(L"Failed to write the cooked mesh \"{}\"\n\tFile: \"{}\"", pMeshFilter->m_MeshName, cookedFile.wstring());
+		fs::remove(tempFile, error);
+		return false;
+	}
+
+	return true;
+}
+
+void MeshCooker::WriteSubMesh(BinaryWriter& writer, const SubMeshFilter& subMesh, const std::vector<const Layout*>& layouts, bool includeAttributeArrays)
+{
+	//16-bit indices when every index fits
+	const bool isIndex16{ std::ranges::all_of(subMesh.indices, [](UINT index) { return index <= USHRT_MAX; }) };
+
+	writer.WriteLongString(subMesh.name);
+	writer.Write(subMesh.vertexCount);
+	writer.Write(subMesh.indexCount);
+	writer.Write(subMesh.uvChannelCount);
+	writer.Write(subMesh.layoutElements);
+	writer.Write(subMesh.bounds);
+	writer.Write(isIndex16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT);
+
+	std::vector<LayoutRecord> records{};
+	std::vector<const VertexInterleaver*> interleavers{};
+	for (const Layout* pLayout : layouts)
+	{
+		const VertexInterleaver& interleaver = VertexInterleaver::Get(pLayout->inputLayoutID, pLayout->inputLayoutSize, pLayout->descriptions);
+		records.push_back({ pLayout->inputLayoutID, pLayout->inputLayoutSize, interleaver.GetStride() });
+		interleavers.push_back(&interleaver);
+	}
+	WriteArrayBlock(writer, records);
+
+	WriteArrayBlock(writer, subMesh.positions);
+
+	if (isIndex16)
+	{
+		std::vector<USHORT> indices(subMesh.indices.size());
+		std::ranges::transform(subMesh.indices, indices.begin(), [](UINT index) { return static_cast<USHORT>(index); });
+		WriteArrayBlock(writer, indices);
+	}
+	else
+	{
+		WriteArrayBlock(writer, subMesh.indices);
+	}
+
+	//Attribute streams, exactly what MeshFilter::BuildVertexBuffer uploads
+	std::vector<BYTE> stream{};
+	for (const VertexInterleaver* pInterleaver : interleavers)
+	{
+		if (pInterleaver->GetStride() == 0)
+			continue;
+
+		stream.resize(static_cast<size_t>(pInterleaver->GetStride()) * subMesh.vertexCount);
+		pInterleaver->Interleave(subMesh, stream.data());
+
+		writer.AlignBufferPosition(Alignment);
+		writer.WriteArray(stream);
+	}
+
+	if (includeAttributeArrays)
+	{
+		WriteArrayBlock(writer, subMesh.normals);
+		WriteArrayBlock(writer, subMesh.tangents);
+		WriteArrayBlock(writer, subMesh.binormals);
+		WriteArrayBlock(writer, subMesh.texCoords);
+		WriteArrayBlock(writer, subMesh.colors);
+		WriteArrayBlock(writer, subMesh.blendIndices);
+		WriteArrayBlock(writer, subMesh.blendWeights);
+	}
+}
+
+fs::path MeshCooker::GetCookedPath(const fs::path& meshFile)
+{
+	fs::path cookedFile{ meshFile };
+	return cookedFile.replace_extension(L".ovmc");
+}
+
+bool MeshCooker::IsCookedFile(const fs::path& file)
+{
+	return file.extension() == L".ovmc";
+}
+
+bool MeshCooker::IsCookedUpToDate(const fs::path& meshFile)
+{
+	std::error_code error{};
+	const fs::path cookedFile{ GetCookedPath(meshFile) };
+	if (!fs::exists(cookedFile, error))
+		return false;
+
+	const auto cookedTime = fs::last_write_time(cookedFile, error);
+	if (error) return false;
+
+	const auto meshTime = fs::last_write_time(meshFile, error);
+	return !error && cookedTime >= meshTime;
+}
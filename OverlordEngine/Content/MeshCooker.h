@@ -0,0 +1,59 @@
+#pragma once
+class MeshFilter;
+struct SubMeshFilter;
+
+//Writes the cooked runtime mesh format (.ovmc), MeshFilterLoader loads it instead of the .ovm it was cooked from (see LoadContent)
+//The attribute streams of the cooked input layouts are stored interleaved (VertexInterleaver output), positions & indices in their
+//GPU format, every GPU block 16 byte aligned: the loader creates the buffers straight out of the mapped file (no parse, no interleave)
+//
+//Layout (BinaryWriter, [A] == padding up to Alignment, Array == UINT32 count | [A] | count elements)
+//	Header		UINT32 Magic, Version, flags | long string name | USHORT boneCount | BoundingBox bounds | UINT32 subMeshCount, clipCount
+//	SubMesh		long string name | UINT32 vertexCount, indexCount, uvChannelCount | ILSemantic elements | BoundingBox bounds | DXGI_FORMAT indexFormat
+//				Array LayoutRecord | Array positions | Array indices (indexFormat) | per layout [A] vertexCount x attributeStride bytes
+//				AttributeArraysFlag only: Array normals, tangents, binormals, texCoords, colors, blendIndices, blendWeights
+//	Clip		long string name | float duration, ticksPerSecond | UINT32 keyCount | per key float tick | Array XMFLOAT4X4
+class MeshCooker final
+{
+public:
+	static constexpr UINT32 Magic{ 'O' | 'V' << 8 | 'M' << 16 | 'C' << 24 };
+	static constexpr UINT32 Version{ 1 }; //Files of other versions are skipped by the loader (the .ovm is loaded instead)
+	static constexpr UINT Alignment{ 16 };
+	static constexpr UINT32 AttributeArraysFlag{ 1 << 0 }; //CPU attribute arrays included, without them the mesh loads as released (MeshFilter::ReleaseCpuData)
+	static constexpr UINT32 AnimationsFlag{ 1 << 1 };
+
+	struct LayoutRecord
+	{
+		UINT32 inputLayoutID;
+		UINT32 layoutSize; //Whole input layout, position included
+		UINT32 attributeStride; //0 == position only layout (no stream)
+	};
+
+	//Input layout of the first technique of an effect (same as MeshFilterLoader::LoadOptions::layoutEffects)
+	struct Layout
+	{
+		UINT inputLayoutID{};
+		UINT inputLayoutSize{};
+		std::vector<ILDescription> descriptions{};
+	};
+
+	MeshCooker() = delete;
+	~MeshCooker() = delete;
+	MeshCooker(const MeshCooker& other) = delete;
+	MeshCooker(MeshCooker&& other) noexcept = delete;
+	MeshCooker& operator=(const MeshCooker& other) = delete;
+	MeshCooker& operator=(MeshCooker&& other) noexcept = delete;
+
+	static std::vector<Layout> ResolveLayouts(const D3D11Context& d3dContext, const std::vector<std::wstring>& layoutEffects);
+
+	//The mesh needs its CPU data (not released), layouts sharing an ID are cooked once
+	//Written to a temporary file first, an existing cooked file is only replaced by a complete one
+	static bool Cook(const MeshFilter* pMeshFilter, const std::vector<Layout>& layouts, bool includeAttributeArrays, const fs::path& cookedFile);
+
+	static fs::path GetCookedPath(const fs::path& meshFile); //Meshes/X.ovm > Meshes/X.ovmc
+	static bool IsCookedFile(const fs::path& file);
+	//The cooked file exists and isn't older than the .ovm (an edited .ovm is loaded until it is cooked again)
+	static bool IsCookedUpToDate(const fs::path& meshFile);
+
+private:
+	static void WriteSubMesh(BinaryWriter& writer, const SubMeshFilter& subMesh, const std::vector<const Layout*>& layouts, bool includeAttributeArrays);
+};
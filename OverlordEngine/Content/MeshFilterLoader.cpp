@@ -1,15 +1,133 @@
 #include "stdafx.h"
 #include "MeshFilterLoader.h"
 
+namespace
+{
+	//Vertex & index blocks hold exactly count elements, checked against the block size before the bulk copy
+	//A mismatching block is skipped (the file is rejected once parsed)
+	template<typename T>
+	bool ReadBlock(BinaryReader* pReader, std::vector<T>& destination, size_t count, UINT blockSize)
+	{
+		if (count * sizeof(T) != blockSize)
+		{
+			Logger::LogWarning(L"OVM block size ({} bytes) doesn't match its element count ({} x {} bytes)", blockSize, count, sizeof(T));
+			pReader->SkipBytes(blockSize);
+			return false;
+		}
+
+		return pReader->ReadArray(destination, count);
+	}
+
+	//OVMC array block (see MeshCooker), a view into the mapped file (nullptr when the file ends first)
+	template<typename T>
+	const T* ReadCookedArray(BinaryReader* pReader, UINT32& count, size_t elementSize = sizeof(T))
+	{
+		count = pReader->Read<UINT32>();
+		pReader->AlignBufferPosition(MeshCooker::Alignment);
+		return static_cast<const T*>(pReader->ReadView(static_cast<size_t>(count) * elementSize));
+	}
+
+	template<typename T>
+	void ReadCookedArray(BinaryReader* pReader, std::vector<T>& destination)
+	{
+		UINT32 count{};
+		if (const T* pData = ReadCookedArray<T>(pReader, count))
+			destination.assign(pData, pData + count);
+	}
+
+	//Vertex streams are empty (not in the source mesh) or hold exactly expectedCount elements, same as ReadBlock
+	template<typename T>
+	bool ReadCookedArray(BinaryReader* pReader, std::vector<T>& destination, size_t expectedCount)
+	{
+		UINT32 count{};
+		const T* pData = ReadCookedArray<T>(pReader, count);
+		if (count != 0 && count != expectedCount)
+			return false;
+
+		if (pData)
+			destination.assign(pData, pData + count);
+		return true;
+	}
+
+	ID3D11Buffer* CreateImmutableBuffer(ID3D11Device* pDevice, UINT bindFlags, const void* pData, UINT byteWidth)
+	{
+		D3D11_BUFFER_DESC bd = {};
+		bd.Usage = D3D11_USAGE_IMMUTABLE;
+		bd.ByteWidth = byteWidth;
+		bd.BindFlags = bindFlags;
+
+		D3D11_SUBRESOURCE_DATA initData{};
+		initData.pSysMem = pData;
+
+		ID3D11Buffer* pBuffer{};
+		HANDLE_ERROR(pDevice->CreateBuffer(&bd, &initData, &pBuffer))
+		return pBuffer;
+	}
+}
 
 MeshFilter* MeshFilterLoader::LoadContent(const ContentLoadInfo& loadInfo)
 {
-	const auto pReader = new BinaryReader();
-	pReader->Open(loadInfo.assetFullPath);
+	//Layout effects compile on other workers while the file is parsed
+	const auto pOptions = static_cast<const LoadOptions*>(loadInfo.pUserData);
+	std::vector<ContentHandle<ID3DX11Effect>> layoutEffects{};
+	if (pOptions)
+	{
+		for (const std::wstring& effectFile : pOptions->layoutEffects)
+			layoutEffects.emplace_back(ContentManager::LoadAsync<ID3DX11Effect>(effectFile));
+	}
+
+	//Content pack first, its cooked meshes are up to date (see ContentPack::Build)
+	const fs::path& assetPath{ loadInfo.assetFullPath };
+	MeshFilter* pMeshFilter{};
+	if (!MeshCooker::IsCookedFile(assetPath))
+		pMeshFilter = LoadPacked(MeshCooker::GetCookedPath(loadInfo.assetSubPath), m_GameContext.d3dContext);
+
+	if (!pMeshFilter)
+		pMeshFilter = LoadPacked(loadInfo.assetSubPath, m_GameContext.d3dContext);
+
+	//A cooked file next to the .ovm replaces it unless the .ovm changed since (a rejected cooked file falls back to the .ovm)
+	if (!pMeshFilter && !MeshCooker::IsCookedFile(assetPath) && MeshCooker::IsCookedUpToDate(assetPath))
+		pMeshFilter = LoadFile(MeshCooker::GetCookedPath(assetPath), m_GameContext.d3dContext);
+
+	if (!pMeshFilter)
+		pMeshFilter = LoadFile(assetPath, m_GameContext.d3dContext);
+
+	if (pMeshFilter && pOptions)
+		BuildLoadLayouts(pMeshFilter, layoutEffects, pOptions->releaseCpuData);
+
+	return pMeshFilter;
+}
+
+MeshFilter* MeshFilterLoader::LoadFile(const fs::path& filePath, const D3D11Context& d3dContext)
+{
+	BinaryReader reader{};
+	reader.OpenMapped(filePath);
 
-	if (!pReader->Exists())
+	if (!reader.Exists())
 		return nullptr;
 
+	const std::wstring fileName{ filePath.filename().wstring() };
+	return MeshCooker::IsCookedFile(filePath) ? ParseCooked(&reader, fileName, &d3dContext) : Parse(&reader, fileName);
+}
+
+MeshFilter* MeshFilterLoader::LoadPacked(const fs::path& assetSubPath, const D3D11Context& d3dContext)
+{
+	ContentBlob blob{};
+	if (!ContentManager::ReadPacked(assetSubPath.wstring(), blob))
+		return nullptr;
+
+	BinaryReader reader{};
+	reader.OpenView(blob.pData, blob.size);
+
+	if (!reader.Exists())
+		return nullptr;
+
+	const std::wstring fileName{ assetSubPath.filename().wstring() };
+	return MeshCooker::IsCookedFile(assetSubPath) ? ParseCooked(&reader, fileName, &d3dContext) : Parse(&reader, fileName);
+}
+
+MeshFilter* MeshFilterLoader::Parse(BinaryReader* pReader, const std::wstring& fileName)
+{
 	//READ OVM FILE
 	const int versionMajor = pReader->Read<char>();
 	const int versionMinor = pReader->Read<char>();
@@ -22,21 +140,60 @@ MeshFilter* MeshFilterLoader::LoadContent(const ContentLoadInfo& loadInfo)
 	else if (versionMajor == 2 && versionMinor == 0) pMeshFilter = ParseOVM20(pReader);
 	else
 	{
-		Logger::LogWarning(L"Unsupported OVM Version ({}.{})\n\tFile: \"{}\"", loadInfo.assetFullPath.filename().wstring(), versionMajor, versionMinor);
-
-		delete pReader;
+		Logger::LogWarning(L"Unsupported OVM Version ({}.{})\n\tFile: \"{}\"", versionMajor, versionMinor, fileName);
 		return nullptr;
 	}
 
-	delete pReader;
+	//Strict: a block running past the end of the file or mismatching its size rejects the whole mesh
+	if (pReader->HasFailed())
+	{
+		Logger::LogWarning(L"Corrupt OVM file, data runs past the end of the file\n\tFile: \"{}\"", fileName);
+		SafeDelete(pMeshFilter);
+	}
+
+	if (pMeshFilter)
+		pMeshFilter->ComputeBounds();
+
 	return pMeshFilter;
 }
 
+void MeshFilterLoader::BuildLoadLayouts(MeshFilter* pMeshFilter, const std::vector<ContentHandle<ID3DX11Effect>>& layoutEffects, bool releaseCpuData) const
+{
+	const D3D11Context& d3dContext{ m_GameContext.d3dContext };
+
+	for (const ContentHandle<ID3DX11Effect>& effect : layoutEffects)
+	{
+		const auto pEffect = effect.Get();
+		if (!pEffect)
+			continue;
+
+		//Same layout as the default technique of a material using the effect (see Material::Initialize), the layout object itself isn't needed
+		ID3D11InputLayout* pInputLayout{};
+		std::vector<ILDescription> inputLayoutDescriptions{};
+		UINT inputLayoutSize{}, inputLayoutID{};
+		const bool isBuilt{ EffectHelper::BuildInputLayout(d3dContext.pDevice, pEffect->GetTechniqueByIndex(0), &pInputLayout, inputLayoutDescriptions, inputLayoutSize, inputLayoutID) };
+		SafeRelease(pInputLayout);
+
+		if (isBuilt)
+			pMeshFilter->BuildVertexBuffer(d3dContext, inputLayoutID, inputLayoutSize, inputLayoutDescriptions, m_GameContext.pJobSystem);
+	}
+
+	if (releaseCpuData)
+		pMeshFilter->ReleaseCpuData();
+}
+
 void MeshFilterLoader::Destroy(MeshFilter* objToDestroy)
 {
 	SafeDelete(objToDestroy);
 }
 
+UINT64 MeshFilterLoader::GetContentBytes(MeshFilter* pContent) const
+{
+	//Layouts built later on (ModelComponent) aren't counted
+	const MeshFilter::MemoryStats stats{ pContent->GetMemoryStats() };
+	return stats.cpuBytes + stats.positionBytes + stats.attributeBytes + stats.indexBytes;
+}
+
 #pragma region OVM 1.1 Parser
 MeshFilter* MeshFilterLoader::ParseOVM11(BinaryReader* pReader)
 {
@@ -61,9 +218,10 @@ MeshFilter* MeshFilterLoader::ParseOVM11(BinaryReader* pReader)
 #pragma endregion
 
 	//Parsing Logic
-	const auto pMeshFilter = new MeshFilter();
+	auto pMeshFilter = new MeshFilter();
 	SubMeshFilter subMesh{};
 	subMesh.id = 0;
+	bool isValid{ true };
 
 	for (;;)
 	{
@@ -87,81 +245,55 @@ MeshFilter* MeshFilterLoader::ParseOVM11(BinaryReader* pReader)
 		case OVM_HEADER::POSITIONS:
 		{
 			subMesh.layoutElements |= ILSemantic::POSITION;
-			subMesh.positions.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.positions.emplace_back(pReader->Read<XMFLOAT3>());
+			isValid &= ReadBlock(pReader, subMesh.positions, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::INDICES:
 		{
-			subMesh.indices.reserve(subMesh.indexCount);
-
-			for (UINT i = 0; i < subMesh.indexCount; ++i)
-				subMesh.indices.emplace_back(pReader->Read<UINT>());
+			isValid &= ReadBlock(pReader, subMesh.indices, subMesh.indexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::NORMALS:
 		{
 			subMesh.layoutElements |= ILSemantic::NORMAL;
-			subMesh.normals.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.normals.emplace_back(pReader->Read<XMFLOAT3>());
+			isValid &= ReadBlock(pReader, subMesh.normals, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::TANGENTS:
 		{
 			subMesh.layoutElements |= ILSemantic::TANGENT;
-			subMesh.tangents.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.tangents.emplace_back(pReader->Read<XMFLOAT3>());
+			isValid &= ReadBlock(pReader, subMesh.tangents, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::BINORMALS:
 		{
 			subMesh.layoutElements |= ILSemantic::BINORMAL;
-			subMesh.binormals.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.binormals.emplace_back(pReader->Read<XMFLOAT3>());
+			isValid &= ReadBlock(pReader, subMesh.binormals, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::TEXCOORDS:
 		{
 			subMesh.layoutElements |= ILSemantic::TEXCOORD;
-			subMesh.texCoords.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.texCoords.emplace_back(pReader->Read<XMFLOAT2>());
+			subMesh.uvChannelCount = 1; //OVM 1.1 has a single uv channel
+			isValid &= ReadBlock(pReader, subMesh.texCoords, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::COLORS:
 		{
 			subMesh.layoutElements |= ILSemantic::COLOR;
-			subMesh.colors.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.colors.emplace_back(pReader->Read<XMFLOAT4>());
+			isValid &= ReadBlock(pReader, subMesh.colors, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::BLENDINDICES:
 		{
 			subMesh.layoutElements |= ILSemantic::BLENDINDICES;
-			subMesh.blendIndices.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.blendIndices.emplace_back(pReader->Read<XMFLOAT4>());
+			isValid &= ReadBlock(pReader, subMesh.blendIndices, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::BLENDWEIGHTS:
 		{
 			subMesh.layoutElements |= ILSemantic::BLENDWEIGHTS;
-			subMesh.blendWeights.reserve(subMesh.vertexCount);
-
-			for (UINT i = 0; i < subMesh.vertexCount; ++i)
-				subMesh.blendWeights.emplace_back(pReader->Read<XMFLOAT4>());
+			isValid &= ReadBlock(pReader, subMesh.blendWeights, subMesh.vertexCount, blockSize);
 		}
 		break;
 		case OVM_HEADER::ANIMATIONCLIPS:
@@ -184,10 +316,7 @@ MeshFilter* MeshFilterLoader::ParseOVM11(BinaryReader* pReader)
 					animKey.tick = pReader->Read<float>();
 
 					const auto transformCount = pReader->Read<USHORT>();
-					for (auto i = 0; i < transformCount; ++i)
-					{
-						animKey.boneTransforms.emplace_back(pReader->Read<XMFLOAT4X4>());
-					}
+					pReader->ReadArray(animKey.boneTransforms, transformCount);
 
 					clip.keys.emplace_back(animKey);
 				}
@@ -199,15 +328,22 @@ MeshFilter* MeshFilterLoader::ParseOVM11(BinaryReader* pReader)
 		case OVM_HEADER::SKELETON:
 		{
 			pMeshFilter->m_BoneCount = pReader->Read<USHORT>();
-			pReader->MoveBufferPosition(blockSize - sizeof(USHORT));
+			//A block smaller than its bone count wraps around and fails the skip
+			pReader->SkipBytes(static_cast<UINT64>(blockSize) - sizeof(USHORT));
 		}
 		break;
 		default:
-			pReader->MoveBufferPosition(blockSize);
+			pReader->SkipBytes(blockSize);
 			break;
 		}
 	}
 
+	if (!isValid)
+	{
+		SafeDelete(pMeshFilter);
+		return nullptr;
+	}
+
 	pMeshFilter->m_Meshes.push_back(subMesh);
 	return pMeshFilter;
 }
@@ -249,6 +385,7 @@ MeshFilter* MeshFilterLoader::ParseOVM20(BinaryReader* pReader)
 #pragma endregion
 
 	auto pMeshFilter = new MeshFilter();
+	bool isValid{ true };
 
 	for (;;)
 	{
@@ -286,80 +423,62 @@ MeshFilter* MeshFilterLoader::ParseOVM20(BinaryReader* pReader)
 					const auto meshBlockId = static_cast<OVM_HEADER_MESHES>(pReader->Read<BYTE>());
 					if (meshBlockId == OVM_HEADER_MESHES::END)break;
 
-					/*auto meshBlockSize = */pReader->Read<UINT32>();
+					const auto meshBlockSize = pReader->Read<UINT32>();
 
 					switch (meshBlockId)
 					{
 					case OVM_HEADER_MESHES::POSITIONS:
 					{
 						subMesh.layoutElements |= ILSemantic::POSITION;
-						subMesh.positions.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.positions.emplace_back(pReader->Read<XMFLOAT3>());
+						isValid &= ReadBlock(pReader, subMesh.positions, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::INDICES:
 					{
-						subMesh.indices.reserve(subMesh.indexCount);
-						for (size_t i{ 0 }; i < subMesh.indexCount; ++i)
-							subMesh.indices.emplace_back(pReader->Read <UINT32>());
+						isValid &= ReadBlock(pReader, subMesh.indices, subMesh.indexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::NORMALS:
 					{
 						subMesh.layoutElements |= ILSemantic::NORMAL;
-						subMesh.normals.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.normals.emplace_back(pReader->Read<XMFLOAT3>());
+						isValid &= ReadBlock(pReader, subMesh.normals, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::TANGENTS:
 					{
 						subMesh.layoutElements |= ILSemantic::TANGENT;
-						subMesh.tangents.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.tangents.emplace_back(pReader->Read<XMFLOAT3>());
+						isValid &= ReadBlock(pReader, subMesh.tangents, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::BINORMALS:
 					{
 						subMesh.layoutElements |= ILSemantic::BINORMAL;
-						subMesh.binormals.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.binormals.emplace_back(pReader->Read<XMFLOAT3>());
+						isValid &= ReadBlock(pReader, subMesh.binormals, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::COLORS:
 					{
 						subMesh.layoutElements |= ILSemantic::COLOR;
-						subMesh.colors.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.colors.emplace_back(pReader->Read<XMFLOAT4>());
+						isValid &= ReadBlock(pReader, subMesh.colors, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::TEXCOORDS:
 					{
 						subMesh.layoutElements |= ILSemantic::TEXCOORD;
 						const auto texCoordCount = static_cast<size_t>(subMesh.vertexCount) * subMesh.uvChannelCount;
-						subMesh.texCoords.reserve(texCoordCount);
-						for (size_t i{ 0 }; i < texCoordCount; ++i)
-							subMesh.texCoords.emplace_back(pReader->Read<XMFLOAT2>());
+						isValid &= ReadBlock(pReader, subMesh.texCoords, texCoordCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::BLENDINDICES:
 					{
 						subMesh.layoutElements |= ILSemantic::BLENDINDICES;
-						subMesh.blendIndices.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.blendIndices.emplace_back(pReader->Read<XMFLOAT4>());
+						isValid &= ReadBlock(pReader, subMesh.blendIndices, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					case OVM_HEADER_MESHES::BLENDWEIGHTS:
 					{
 						subMesh.layoutElements |= ILSemantic::BLENDWEIGHTS;
-						subMesh.blendWeights.reserve(subMesh.vertexCount);
-						for (size_t i{ 0 }; i < subMesh.vertexCount; ++i)
-							subMesh.blendWeights.emplace_back(pReader->Read<XMFLOAT4>());
+						isValid &= ReadBlock(pReader, subMesh.blendWeights, subMesh.vertexCount, meshBlockSize);
 					}
 					break;
 					}
@@ -407,12 +526,7 @@ MeshFilter* MeshFilterLoader::ParseOVM20(BinaryReader* pReader)
 							animKey.tick = pReader->Read<float>();
 
 							const auto transformCount = static_cast<size_t>(pReader->Read<USHORT>());
-							animKey.boneTransforms.reserve(transformCount);
-
-							for (size_t i = 0; i < transformCount; ++i)
-							{
-								animKey.boneTransforms.emplace_back(pReader->Read<XMFLOAT4X4>());
-							}
+							pReader->ReadArray(animKey.boneTransforms, transformCount);
 
 							clip.keys.emplace_back(animKey);
 						}
@@ -424,7 +538,7 @@ MeshFilter* MeshFilterLoader::ParseOVM20(BinaryReader* pReader)
 				case OVM_HEADER_ANIMATIONS::SKELETON:
 				{
 					pMeshFilter->m_BoneCount = pReader->Read<UINT16>();
-					pReader->MoveBufferPosition(animationBlockSize - sizeof(UINT16));
+					pReader->SkipBytes(static_cast<UINT64>(animationBlockSize) - sizeof(UINT16));
 				}
 				break;
 				}
@@ -433,6 +547,182 @@ MeshFilter* MeshFilterLoader::ParseOVM20(BinaryReader* pReader)
 		}
 	}
 
+	if (!isValid)
+	{
+		SafeDelete(pMeshFilter);
+		return nullptr;
+	}
+
+	return pMeshFilter;
+}
+#pragma endregion
+
+#pragma region OVMC Parser
+MeshFilter* MeshFilterLoader::ParseCooked(BinaryReader* pReader, const std::wstring& fileName, const D3D11Context* pD3DContext)
+{
+	if (!pReader->IsMapped())
+	{
+		Logger::LogWarning(L"Cooked meshes are read from a mapped file (BinaryReader::OpenMapped or OpenView)\n\tFile: \"{}\"", fileName);
+		return nullptr;
+	}
+
+	const auto magic = pReader->Read<UINT32>();
+	const auto version = pReader->Read<UINT32>();
+	if (magic != MeshCooker::Magic || version != MeshCooker::Version)
+	{
+		Logger::LogWarning(L"Unsupported OVMC Version ({}, expected {}), cook the mesh again\n\tFile: \"{}\"", version, MeshCooker::Version, fileName);
+		return nullptr;
+	}
+
+	const auto flags = pReader->Read<UINT32>();
+
+	auto pMeshFilter = new MeshFilter();
+	pMeshFilter->m_MeshName = pReader->ReadLongString();
+	pMeshFilter->m_BoneCount = pReader->Read<USHORT>();
+	pMeshFilter->m_Bounds = pReader->Read<BoundingBox>();
+	pMeshFilter->m_HasAnimations = (flags & MeshCooker::AnimationsFlag) != 0;
+	pMeshFilter->m_IsCpuDataReleased = (flags & MeshCooker::AttributeArraysFlag) == 0;
+
+	const auto subMeshCount = pReader->Read<UINT32>();
+	const auto clipCount = pReader->Read<UINT32>();
+	bool isValid{ subMeshCount <= 256 };
+
+	for (UINT32 meshId{}; isValid && meshId < subMeshCount && !pReader->HasFailed(); ++meshId)
+	{
+#pragma region SubMeshes
+		SubMeshFilter& subMesh = pMeshFilter->m_Meshes.emplace_back();
+		subMesh.id = static_cast<BYTE>(meshId);
+		subMesh.name = pReader->ReadLongString();
+		subMesh.vertexCount = pReader->Read<UINT32>();
+		subMesh.indexCount = pReader->Read<UINT32>();
+		subMesh.uvChannelCount = pReader->Read<UINT32>();
+		subMesh.layoutElements = pReader->Read<ILSemantic>();
+		subMesh.bounds = pReader->Read<BoundingBox>();
+
+		const auto indexFormat = pReader->Read<DXGI_FORMAT>();
+		const bool isIndex16{ indexFormat == DXGI_FORMAT_R16_UINT };
+		isValid &= isIndex16 || indexFormat == DXGI_FORMAT_R32_UINT;
+
+		std::vector<MeshCooker::LayoutRecord> layouts{};
+		ReadCookedArray(pReader, layouts);
+
+		//POSITIONS (CPU copy for bounds, picking & batching)
+		UINT32 positionCount{};
+		const XMFLOAT3* pPositions = ReadCookedArray<XMFLOAT3>(pReader, positionCount);
+		isValid &= positionCount == 0 || positionCount == subMesh.vertexCount;
+		if (pPositions && isValid)
+			subMesh.positions.assign(pPositions, pPositions + positionCount);
+
+		//INDICES (CPU copy widened to 32-bit)
+		UINT32 indexCount{};
+		const BYTE* pIndices = ReadCookedArray<BYTE>(pReader, indexCount, isIndex16 ? sizeof(USHORT) : sizeof(UINT));
+		isValid &= indexCount == subMesh.indexCount;
+		if (pIndices && isValid)
+		{
+			if (isIndex16)
+			{
+				const auto pIndices16 = reinterpret_cast<const USHORT*>(pIndices);
+				subMesh.indices.assign(pIndices16, pIndices16 + indexCount);
+			}
+			else
+			{
+				const auto pIndices32 = reinterpret_cast<const UINT*>(pIndices);
+				subMesh.indices.assign(pIndices32, pIndices32 + indexCount);
+			}
+		}
+
+		if (pD3DContext && isValid && !pReader->HasFailed())
+		{
+			//Meshes without positions get the zero default of MeshFilter::BuildPositionBuffer
+			if (positionCount > 0)
+				subMesh.buffers.pPositionBuffer = CreateImmutableBuffer(pD3DContext->pDevice, D3D11_BIND_VERTEX_BUFFER, pPositions, static_cast<UINT>(sizeof(XMFLOAT3)) * subMesh.vertexCount);
+			else
+				MeshFilter::BuildPositionBuffer(*pD3DContext, subMesh);
+
+			if (indexCount > 0)
+			{
+				subMesh.buffers.pIndexBuffer = CreateImmutableBuffer(pD3DContext->pDevice, D3D11_BIND_INDEX_BUFFER, pIndices, indexCount * static_cast<UINT>(isIndex16 ? sizeof(USHORT) : sizeof(UINT)));
+				subMesh.buffers.indexFormat = indexFormat;
+			}
+		}
+
+		//ATTRIBUTE STREAMS (one per cooked input layout)
+		for (const MeshCooker::LayoutRecord& layout : layouts)
+		{
+			VertexBufferData data{};
+			data.VertexStride = layout.attributeStride;
+			data.LayoutStride = layout.layoutSize;
+			data.VertexCount = subMesh.vertexCount;
+			data.IndexCount = subMesh.indexCount;
+			data.InputLayoutID = layout.inputLayoutID;
+
+			//Stride and count both come from the file, the product can wrap a UINT
+			const UINT64 streamSize{ static_cast<UINT64>(layout.attributeStride) * subMesh.vertexCount };
+			if (streamSize > 0)
+			{
+				pReader->AlignBufferPosition(MeshCooker::Alignment);
+				if (streamSize > pReader->GetRemainingSize() || streamSize > UINT_MAX)
+				{
+					isValid = false;
+					break;
+				}
+
+				data.BufferSize = static_cast<UINT>(streamSize);
+				const void* pStream = pReader->ReadView(data.BufferSize);
+				if (!pStream)
+					break;
+
+				if (pD3DContext)
+				{
+					data.pVertexBuffer = CreateImmutableBuffer(pD3DContext->pDevice, D3D11_BIND_VERTEX_BUFFER, pStream, data.BufferSize);
+				}
+				else
+				{
+					data.pDataStart = malloc(data.BufferSize);
+					if (data.pDataStart) std::memcpy(data.pDataStart, pStream, data.BufferSize);
+				}
+			}
+
+			subMesh.buffers.vertexbuffers.push_back(data);
+		}
+
+		if (!pMeshFilter->m_IsCpuDataReleased)
+		{
+			const size_t vertexCount{ subMesh.vertexCount };
+			isValid &= ReadCookedArray(pReader, subMesh.normals, vertexCount);
+			isValid &= ReadCookedArray(pReader, subMesh.tangents, vertexCount);
+			isValid &= ReadCookedArray(pReader, subMesh.binormals, vertexCount);
+			isValid &= ReadCookedArray(pReader, subMesh.texCoords, vertexCount * subMesh.uvChannelCount);
+			isValid &= ReadCookedArray(pReader, subMesh.colors, vertexCount);
+			isValid &= ReadCookedArray(pReader, subMesh.blendIndices, vertexCount);
+			isValid &= ReadCookedArray(pReader, subMesh.blendWeights, vertexCount);
+		}
+#pragma endregion
+	}
+
+	for (UINT32 clipId{}; isValid && clipId < clipCount && !pReader->HasFailed(); ++clipId)
+	{
+		AnimationClip& clip = pMeshFilter->m_AnimationClips.emplace_back();
+		clip.name = pReader->ReadLongString();
+		clip.duration = pReader->Read<float>();
+		clip.ticksPerSecond = pReader->Read<float>();
+
+		const auto keyCount = pReader->Read<UINT32>();
+		for (UINT32 key{}; key < keyCount && !pReader->HasFailed(); ++key)
+		{
+			AnimationKey& animKey = clip.keys.emplace_back();
+			animKey.tick = pReader->Read<float>();
+			ReadCookedArray(pReader, animKey.boneTransforms);
+		}
+	}
+
+	//Strict, same as the OVM parsers: a block running past the end of the file rejects the whole mesh
+	if (!isValid || pReader->HasFailed())
+	{
+		Logger::LogWarning(L"Corrupt OVMC file, cook the mesh again\n\tFile: \"{}\"", fileName);
+		SafeDelete(pMeshFilter);
+	}
+
 	return pMeshFilter;
 }
 #pragma endregion
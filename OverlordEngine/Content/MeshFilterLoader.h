@@ -9,11 +9,33 @@ public:
 	MeshFilterLoader& operator=(const MeshFilterLoader& other) = delete;
 	MeshFilterLoader& operator=(MeshFilterLoader&& other) noexcept = delete;
 
+	//ContentManager::Load<MeshFilter> user data (see ContentManifest::AddMesh)
+	//Vertex buffers for the first technique of every effect are built on the loading thread
+	//instead of on the main thread once a ModelComponent using the mesh initializes
+	struct LoadOptions
+	{
+		std::vector<std::wstring> layoutEffects{};
+		bool releaseCpuData{}; //MeshFilter::ReleaseCpuData once the layouts are built (no other layouts or static batching afterwards)
+	};
+
+	//OVM 1.1/2.0 from an opened reader (LoadContent maps the file or reads it out of the content pack), vertex & index blocks are bulk copied
+	//Returns nullptr for unsupported or corrupt files, the mesh isn't cached (owned by the caller)
+	static MeshFilter* Parse(BinaryReader* pReader, const std::wstring& fileName);
+	//Cooked OVMC from a mapped reader (see MeshCooker), the GPU buffers are created straight out of the mapped view
+	//Without a context (headless) the attribute streams are kept as CPU copies in VertexBufferData::pDataStart and nothing is uploaded
+	static MeshFilter* ParseCooked(BinaryReader* pReader, const std::wstring& fileName, const D3D11Context* pD3DContext);
+
 protected:
 	MeshFilter* LoadContent(const ContentLoadInfo& loadInfo) override;
 	void Destroy(MeshFilter* objToDestroy) override;
+	UINT64 GetContentBytes(MeshFilter* pContent) const override;
 
 private:
 	static MeshFilter* ParseOVM11(BinaryReader* pReader);
-	MeshFilter* ParseOVM20(BinaryReader* pReader);
+	static MeshFilter* ParseOVM20(BinaryReader* pReader);
+
+	static MeshFilter* LoadFile(const fs::path& filePath, const D3D11Context& d3dContext);
+	static MeshFilter* LoadPacked(const fs::path& assetSubPath, const D3D11Context& d3dContext); //nullptr when the pack doesn't contain it
+
+	void BuildLoadLayouts(MeshFilter* pMeshFilter, const std::vector<ContentHandle<ID3DX11Effect>>& layoutEffects, bool releaseCpuData) const;
 };
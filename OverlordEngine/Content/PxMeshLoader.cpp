@@ -9,6 +9,14 @@ PxConvexMesh* PxConvexMeshLoader::LoadContent(const ContentLoadInfo& loadInfo)
 	//std::string buffer = converter.to_bytes(assetPath.c_str());
 	////std::string buffer = std::string(assetFile.begin(), assetFile.end());
 
+	//Packed: read out of the pack (PhysX only reads the data, the stream takes a non const pointer)
+	ContentBlob blob{};
+	if (ContentManager::ReadPacked(loadInfo.assetSubPath, blob))
+	{
+		PxDefaultMemoryInputData memoryStream{ const_cast<PxU8*>(blob.pData), static_cast<PxU32>(blob.size) };
+		return PxGetPhysics().createConvexMesh(memoryStream);
+	}
+
 	const auto utf8_assetPath = StringUtil::utf8_encode(loadInfo.assetFullPath);
 	auto inputStream  = PxDefaultFileInputData(utf8_assetPath.c_str());
 	return PxGetPhysics().createConvexMesh(inputStream);
@@ -21,8 +29,35 @@ PxTriangleMesh* PxTriangleMeshLoader::LoadContent(const ContentLoadInfo& loadInf
 	//std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
 	//std::string buffer = converter.to_bytes(assetPath.c_str());
 	////std::string buffer =std::string(assetFile.begin(), assetFile.end());
+	ContentBlob blob{};
+	if (ContentManager::ReadPacked(loadInfo.assetSubPath, blob))
+	{
+		PxDefaultMemoryInputData memoryStream{ const_cast<PxU8*>(blob.pData), static_cast<PxU32>(blob.size) };
+		return PxGetPhysics().createTriangleMesh(memoryStream);
+	}
+
 	const auto utf8_assetPath = StringUtil::utf8_encode(loadInfo.assetFullPath);
 
 	auto inputStream = PxDefaultFileInputData(utf8_assetPath.c_str());
 	return PxGetPhysics().createTriangleMesh(inputStream);
-}
\ No newline at end of file
+}
+
+UINT64 PxConvexMeshLoader::GetContentBytes(PxConvexMesh* pContent) const
+{
+	//Vertices, polygons & their index buffer (cooked hull data, no internal acceleration structures)
+	UINT64 indexCount{};
+	for (PxU32 i{}; i < pContent->getNbPolygons(); ++i)
+	{
+		PxHullPolygon polygon{};
+		if (pContent->getPolygonData(i, polygon))
+			indexCount += polygon.mNbVerts;
+	}
+
+	return pContent->getNbVertices() * sizeof(PxVec3) + pContent->getNbPolygons() * sizeof(PxHullPolygon) + indexCount * sizeof(PxU8);
+}
+
+UINT64 PxTriangleMeshLoader::GetContentBytes(PxTriangleMesh* pContent) const
+{
+	const bool isIndex16{ pContent->getTriangleMeshFlags().isSet(PxTriangleMeshFlag::e16_BIT_INDICES) };
+	return pContent->getNbVertices() * sizeof(PxVec3) + pContent->getNbTriangles() * 3ull * (isIndex16 ? sizeof(PxU16) : sizeof(PxU32));
+}
@@ -15,7 +15,8 @@ public:
 
 protected:
 	PxConvexMesh* LoadContent(const ContentLoadInfo& loadInfo) override;
-	void Destroy(PxConvexMesh* /*pObjToDestroy*/) override {};
+	void Destroy(PxConvexMesh* pObjToDestroy) override { pObjToDestroy->release(); } //Shapes using the mesh keep it alive (PhysX reference count)
+	UINT64 GetContentBytes(PxConvexMesh* pContent) const override;
 };
 
 //TRIANGLE MESH
@@ -32,6 +33,7 @@ public:
 	PxTriangleMeshLoader& operator=(PxTriangleMeshLoader&& other) noexcept = delete;
 protected:
 	PxTriangleMesh* LoadContent(const ContentLoadInfo& loadInfo) override;
-	void Destroy(PxTriangleMesh* /*pObjToDestroy*/) override {};
+	void Destroy(PxTriangleMesh* pObjToDestroy) override { pObjToDestroy->release(); }
+	UINT64 GetContentBytes(PxTriangleMesh* pContent) const override;
 };
 
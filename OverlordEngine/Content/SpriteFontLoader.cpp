@@ -4,7 +4,11 @@
 SpriteFont* SpriteFontLoader::LoadContent(const ContentLoadInfo& loadInfo)
 {
 	const auto pReader = new BinaryReader();
-	pReader->Open(loadInfo.assetFullPath);
+	ContentBlob blob{};
+	if (ContentManager::ReadPacked(loadInfo.assetSubPath, blob))
+		pReader->OpenView(blob.pData, blob.size);
+	else
+		pReader->Open(loadInfo.assetFullPath);
 
 	if (!pReader->Exists())
 	{
@@ -81,12 +85,13 @@ SpriteFont* SpriteFontLoader::LoadContent(const ContentLoadInfo& loadInfo)
 	//	>> page texture should be stored next to the .fnt file, pageName contains the name of the texture file
 	//	>> full texture path = asset parent_path of .fnt file (see loadInfo.assetFullPath > get parent_path) + pageName (filesystem::path::append)
 	//	>> Load the texture (ContentManager::Load<TextureData>) & Store [fontDesc.pTexture]
+	//	>> (relative to the asset sub path, so a packed font finds its packed page)
 	
 	blockId = pReader->Read<char>();
 	blockSize = pReader->Read<int>();
 
 	const auto pageName = pReader->ReadNullString();
-	fontDesc.pTexture = ContentManager::Load<TextureData>(loadInfo.assetFullPath.parent_path().append(pageName));
+	fontDesc.pTexture = ContentManager::Load<TextureData>(fs::path{ loadInfo.assetSubPath }.parent_path().append(pageName));
 
 	//**********
 	// BLOCK 3 *
@@ -162,3 +167,8 @@ void SpriteFontLoader::Destroy(SpriteFont* objToDestroy)
 {
 	SafeDelete(objToDestroy);
 }
+
+UINT64 SpriteFontLoader::GetContentBytes(SpriteFont* pContent) const
+{
+	return sizeof(SpriteFont) + pContent->GetMetricCount() * (sizeof(wchar_t) + sizeof(FontMetric));
+}
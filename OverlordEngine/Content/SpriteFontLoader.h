@@ -15,5 +15,6 @@ public:
 protected:
 	SpriteFont* LoadContent(const ContentLoadInfo& loadInfo) override;
 	void Destroy(SpriteFont* objToDestroy) override;
+	UINT64 GetContentBytes(SpriteFont* pContent) const override; //The texture is a dependency, counted by the TextureDataLoader
 };
 
@@ -15,19 +15,23 @@ TextureData* TextureDataLoader::LoadContent(const ContentLoadInfo& loadInfo)
 
 	const auto extension = assetPath.extension().wstring();
 
+	//Decoded straight out of the content pack when it contains the texture
+	ContentBlob blob{};
+	const bool isPacked{ ContentManager::ReadPacked(loadInfo.assetSubPath, blob) };
+
 	if (extension == L".dds")
 	//if (lstrcmpiW(extension.c_str(), L"dds") == 0) //DDS Loader
 	{
-		HANDLE_ERROR(LoadFromDDSFile(assetPath.c_str(), DirectX::DDS_FLAGS_NONE, &info, *image));
+		HANDLE_ERROR(isPacked ? LoadFromDDSMemory(blob.pData, blob.size, DirectX::DDS_FLAGS_NONE, &info, *image) : LoadFromDDSFile(assetPath.c_str(), DirectX::DDS_FLAGS_NONE, &info, *image));
 	}
 	else if (extension == L".tga")
 	//else if (lstrcmpiW(extension.c_str(), L"tga") == 0) //TGA Loader
 	{
-		HANDLE_ERROR(LoadFromTGAFile(assetPath.c_str(), &info, *image));
+		HANDLE_ERROR(isPacked ? LoadFromTGAMemory(blob.pData, blob.size, &info, *image) : LoadFromTGAFile(assetPath.c_str(), &info, *image));
 	}
 	else //WIC Loader
 	{
-		HANDLE_ERROR(LoadFromWICFile(assetPath.c_str(), DirectX::WIC_FLAGS_NONE, &info, *image));
+		HANDLE_ERROR(isPacked ? LoadFromWICMemory(blob.pData, blob.size, DirectX::WIC_FLAGS_NONE, &info, *image) : LoadFromWICFile(assetPath.c_str(), DirectX::WIC_FLAGS_NONE, &info, *image));
 	}
 	
 
@@ -42,3 +46,25 @@ void TextureDataLoader::Destroy(TextureData* objToDestroy)
 {
 	SafeDelete(objToDestroy);
 }
+
+UINT64 TextureDataLoader::GetContentBytes(TextureData* pContent) const
+{
+	//Every mip of every array slice (2D textures & cube maps)
+	ID3D11Texture2D* pTexture2D{};
+	if (FAILED(pContent->GetResource()->QueryInterface(IID_PPV_ARGS(&pTexture2D))))
+		return 0;
+
+	D3D11_TEXTURE2D_DESC desc{};
+	pTexture2D->GetDesc(&desc);
+	SafeRelease(pTexture2D);
+
+	UINT64 bytes{};
+	for (UINT mip{}; mip < desc.MipLevels; ++mip)
+	{
+		size_t rowPitch{}, slicePitch{};
+		ComputePitch(desc.Format, std::max(1u, desc.Width >> mip), std::max(1u, desc.Height >> mip), rowPitch, slicePitch);
+		bytes += slicePitch;
+	}
+
+	return bytes * desc.ArraySize;
+}
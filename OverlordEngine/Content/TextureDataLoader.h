@@ -14,6 +14,7 @@ public:
 protected:
 	TextureData* LoadContent(const ContentLoadInfo& loadInfo) override;
 	void Destroy(TextureData* objToDestroy) override;
+	UINT64 GetContentBytes(TextureData* pContent) const override;
 
 };
 
@@ -10,16 +10,27 @@ void DeferredLightRenderer::Initialize(const D3D11Context& d3dContext)
 {
 	//Directional LightPass
 	m_pDirectionalLightMaterial = MaterialManager::Get()->CreateMaterial<DirectionalLightMaterial>();
+	m_DirectionalGBufferVars.Resolve(m_pDirectionalLightMaterial);
+	m_EVar_DirectionalLight = m_pDirectionalLightMaterial->GetVariableHandle<Light>(L"gDirectionalLight");
+	m_EVar_ShadowMap = m_pDirectionalLightMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureShadowMap");
+	m_EVar_LightViewProj = m_pDirectionalLightMaterial->GetVariableHandle<XMFLOAT4X4>(L"gLightViewProj");
+	m_EVar_UseBakedShadowMap = m_pDirectionalLightMaterial->GetVariableHandle<bool>(L"gUseBakedShadowMap");
+	m_EVar_BakedLightViewProj = m_pDirectionalLightMaterial->GetVariableHandle<XMFLOAT4X4>(L"gBakedLightViewProj");
+	m_EVar_BakedShadowMap = m_pDirectionalLightMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureBakedShadowMap");
 
 	//Volumetric LightPass
 	m_pVolumetricLightMaterial = MaterialManager::Get()->CreateMaterial<VolumetricLightMaterial>();
-	const auto inputLayoutID = m_pVolumetricLightMaterial->GetTechniqueContext().inputLayoutID;
+	m_VolumetricGBufferVars.Resolve(m_pVolumetricLightMaterial);
+	m_EVar_WorldViewProjection = m_pVolumetricLightMaterial->GetVariableHandle<XMFLOAT4X4>(L"gWorldViewProjection");
+	m_EVar_CurrentLight = m_pVolumetricLightMaterial->GetVariableHandle<Light>(L"gCurrentLight");
+
+	//Light meshes are pinned, the renderer outlives the scene that created it
+	ContentScope::Active pinned{ nullptr };
 
 	//Sphere Light Mesh
 	m_pSphereMesh = ContentManager::Load<MeshFilter>(L"Meshes/UnitSphere.ovm");
 
 	m_pSphereMesh->BuildVertexBuffer(d3dContext, m_pVolumetricLightMaterial);
-	m_pSphereVB = m_pSphereMesh->GetVertexBufferData(inputLayoutID).pVertexBuffer;
 
 	m_pSphereMesh->BuildIndexBuffer(d3dContext);
 	m_pSphereIB = m_pSphereMesh->GetIndexBuffer();
@@ -28,9 +39,6 @@ void DeferredLightRenderer::Initialize(const D3D11Context& d3dContext)
 	m_pConeMesh = ContentManager::Load<MeshFilter>(L"Meshes/UnitCone.ovm");
 
 	m_pConeMesh->BuildVertexBuffer(d3dContext, m_pVolumetricLightMaterial);
-	auto& vbData = m_pConeMesh->GetVertexBufferData(inputLayoutID);
-	m_pConeVB = vbData.pVertexBuffer;
-	m_VertexStride = vbData.VertexStride;
 
 	m_pConeMesh->BuildIndexBuffer(d3dContext);
 	m_pConeIB = m_pConeMesh->GetIndexBuffer();
@@ -46,26 +54,20 @@ void DeferredLightRenderer::DirectionalLightPass(const SceneContext& sceneContex
 		//Prepare Effect
 
 		//Ambient SRV > Already on Main RenderTarget
-		m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureDiffuse", gbufferSRVs[int(DeferredRenderer::eGBufferId::Diffuse)]);
-		m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureSpecular", gbufferSRVs[int(DeferredRenderer::eGBufferId::Specular)]);
-		m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureNormal", gbufferSRVs[int(DeferredRenderer::eGBufferId::Normal)]);
-		m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureDepth", gbufferSRVs[int(DeferredRenderer::eGBufferId::Depth)]);
-
-		m_pDirectionalLightMaterial->SetVariable_Matrix(L"gMatrixViewProjInv", sceneContext.pCamera->GetViewProjectionInverse());
-		m_pDirectionalLightMaterial->SetVariable_Vector(L"gEyePos", sceneContext.pCamera->GetTransform()->GetWorldPosition());
-		m_pDirectionalLightMaterial->SetVariable(L"gDirectionalLight", &light, 0, sizeof(Light) - 4);
+		m_DirectionalGBufferVars.Set(sceneContext, gbufferSRVs);
+		m_EVar_DirectionalLight.SetRaw(&light, 0, sizeof(Light) - 4);
 
 		// Realtime Shadow map
 		const auto& pShadowMapRenderer = ShadowMapRenderer::Get();
-		m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureShadowMap", pShadowMapRenderer->GetShadowMap());
-		m_pDirectionalLightMaterial->SetVariable_Matrix(L"gLightViewProj", pShadowMapRenderer->GetLightVP());
+		m_EVar_ShadowMap.Set(pShadowMapRenderer->GetShadowMap());
+		m_EVar_LightViewProj.Set(pShadowMapRenderer->GetLightVP());
 
 		// Baked shadow map
-		m_pDirectionalLightMaterial->SetVariable_Scalar(L"gUseBakedShadowMap", sceneContext.pLights->GetUseBakedShadows());
+		m_EVar_UseBakedShadowMap.Set(sceneContext.pLights->GetUseBakedShadows());
 		if (m_pDirectionalLightMaterial->IsBakedDirty())
 		{
-			m_pDirectionalLightMaterial->SetVariable_Matrix(L"gBakedLightViewProj", pShadowMapRenderer->GetBakedLightVP());
-			m_pDirectionalLightMaterial->SetVariable_Texture(L"gTextureBakedShadowMap", pShadowMapRenderer->GetBakedShadowMap());
+			m_EVar_BakedLightViewProj.Set(pShadowMapRenderer->GetBakedLightVP());
+			m_EVar_BakedShadowMap.Set(pShadowMapRenderer->GetBakedShadowMap());
 			m_pDirectionalLightMaterial->IsBakedDirty(false);
 		}
 
@@ -82,13 +84,7 @@ void DeferredLightRenderer::VolumetricLightPass(const SceneContext& sceneContext
 	//Prepare Effect
 
 	//Ambient SRV > Already on Main RenderTarget
-	m_pVolumetricLightMaterial->SetVariable_Texture(L"gTextureDiffuse", gbufferSRVs[int(DeferredRenderer::eGBufferId::Diffuse)]);
-	m_pVolumetricLightMaterial->SetVariable_Texture(L"gTextureSpecular", gbufferSRVs[int(DeferredRenderer::eGBufferId::Specular)]);
-	m_pVolumetricLightMaterial->SetVariable_Texture(L"gTextureNormal", gbufferSRVs[int(DeferredRenderer::eGBufferId::Normal)]);
-	m_pVolumetricLightMaterial->SetVariable_Texture(L"gTextureDepth", gbufferSRVs[int(DeferredRenderer::eGBufferId::Depth)]);
-	
-	m_pVolumetricLightMaterial->SetVariable_Matrix(L"gMatrixViewProjInv", sceneContext.pCamera->GetViewProjectionInverse());
-	m_pVolumetricLightMaterial->SetVariable_Vector(L"gEyePos", sceneContext.pCamera->GetTransform()->GetWorldPosition());
+	m_VolumetricGBufferVars.Set(sceneContext, gbufferSRVs);
 
 
 	//Iterate Lights & Render Volumes
@@ -122,21 +118,23 @@ void DeferredLightRenderer::DrawVolumetricLight(const SceneContext& sceneContext
 	const auto world = scale * rot * translation;
 	auto wvp = world * XMLoadFloat4x4(&sceneContext.pCamera->GetViewProjection());
 
-	m_pVolumetricLightMaterial->SetVariable_Matrix(L"gWorldViewProjection", reinterpret_cast<float*>(&wvp));
-	m_pVolumetricLightMaterial->SetVariable(L"gCurrentLight", &light, 0, sizeof(Light) - 4);
+	XMFLOAT4X4 wvpFloat{};
+	XMStoreFloat4x4(&wvpFloat, wvp);
+	m_EVar_WorldViewProjection.Set(wvpFloat);
+	m_EVar_CurrentLight.SetRaw(&light, 0, sizeof(Light) - 4);
 
 	const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
 	auto& techContext = m_pVolumetricLightMaterial->GetTechniqueContext();
 
 	// Set InputLayout
-	pDeviceContext->IASetInputLayout(techContext.pInputLayout);
+	pDeviceContext->IASetInputLayout(techContext.pStreamInputLayout);
 
-	// Set Vertex Buffer
-	UINT offset = 0;
-	pDeviceContext->IASetVertexBuffers(0, 1, light.type == LightType::Point ? &m_pSphereVB : &m_pConeVB, &m_VertexStride, &offset);
+	// Set Vertex Buffers
+	(light.type == LightType::Point ? m_pSphereMesh : m_pConeMesh)->SetVertexStreams(pDeviceContext, techContext.inputLayoutID);
 	
 	// Set Index Buffer
-	pDeviceContext->IASetIndexBuffer(light.type == LightType::Point ? m_pSphereIB : m_pConeIB, DXGI_FORMAT_R32_UINT, 0);
+	const MeshFilter* pLightMesh{ light.type == LightType::Point ? m_pSphereMesh : m_pConeMesh };
+	pDeviceContext->IASetIndexBuffer(light.type == LightType::Point ? m_pSphereIB : m_pConeIB, pLightMesh->GetIndexFormat(), 0);
 
 	// Set Primitive Topology
 	pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -163,4 +161,25 @@ void DeferredLightRenderer::CreateReadOnlyDSV(const D3D11Context& d3dContext, ID
 	descDSV.Flags = D3D11_DSV_READ_ONLY_DEPTH; // Depth is read only, stencil is read/write
 
 	HANDLE_ERROR(d3dContext.pDevice->CreateDepthStencilView(pDepthResource, &descDSV, &m_pReadOnlyDepthStencilView));
-}
\ No newline at end of file
+}
+
+void DeferredLightRenderer::GBufferVariables::Resolve(const BaseMaterial* pMaterial)
+{
+	diffuse = pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureDiffuse");
+	specular = pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureSpecular");
+	normal = pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureNormal");
+	depth = pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTextureDepth");
+	viewProjInv = pMaterial->GetVariableHandle<XMFLOAT4X4>(L"gMatrixViewProjInv");
+	eyePos = pMaterial->GetVariableHandle<XMFLOAT3>(L"gEyePos");
+}
+
+void DeferredLightRenderer::GBufferVariables::Set(const SceneContext& sceneContext, ID3D11ShaderResourceView* const gbufferSRVs[]) const
+{
+	diffuse.Set(gbufferSRVs[int(DeferredRenderer::eGBufferId::Diffuse)]);
+	specular.Set(gbufferSRVs[int(DeferredRenderer::eGBufferId::Specular)]);
+	normal.Set(gbufferSRVs[int(DeferredRenderer::eGBufferId::Normal)]);
+	depth.Set(gbufferSRVs[int(DeferredRenderer::eGBufferId::Depth)]);
+
+	viewProjInv.Set(sceneContext.pCamera->GetViewProjectionInverse());
+	eyePos.Set(sceneContext.pCamera->GetTransform()->GetWorldPosition());
+}
@@ -77,23 +77,39 @@ public:
 	void CreateReadOnlyDSV(const D3D11Context& d3dContext, ID3D11Resource* pDepthResource, DXGI_FORMAT format);
 
 private:
+	//GBuffer & camera variables, shared by both light passes
+	struct GBufferVariables
+	{
+		MaterialVariable<ID3D11ShaderResourceView*> diffuse{}, specular{}, normal{}, depth{};
+		MaterialVariable<XMFLOAT4X4> viewProjInv{};
+		MaterialVariable<XMFLOAT3> eyePos{};
+
+		void Resolve(const BaseMaterial* pMaterial);
+		void Set(const SceneContext& sceneContext, ID3D11ShaderResourceView* const gbufferSRVs[]) const;
+	};
 
 	//Read-Only DSV (Depth ReadOnly, Stencil Read/Write)
 	ID3D11DepthStencilView* m_pReadOnlyDepthStencilView{};
 
 	//Directional LightPass (Directional Light)
 	DirectionalLightMaterial* m_pDirectionalLightMaterial{};
+	GBufferVariables m_DirectionalGBufferVars{};
+	MaterialVariable<Light> m_EVar_DirectionalLight{};
+	MaterialVariable<ID3D11ShaderResourceView*> m_EVar_ShadowMap{}, m_EVar_BakedShadowMap{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_LightViewProj{}, m_EVar_BakedLightViewProj{};
+	MaterialVariable<bool> m_EVar_UseBakedShadowMap{};
 
 	//Volumetric LightPass (Point & Spot Lights)
 	VolumetricLightMaterial* m_pVolumetricLightMaterial{};
+	GBufferVariables m_VolumetricGBufferVars{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_WorldViewProjection{};
+	MaterialVariable<Light> m_EVar_CurrentLight{};
 
 	MeshFilter* m_pSphereMesh{}; //Point Lights
-	ID3D11Buffer* m_pSphereVB{}, * m_pSphereIB{}; //Sphere Vertex/IndexBuffer
+	ID3D11Buffer* m_pSphereIB{}; //Sphere IndexBuffer
 
 	MeshFilter* m_pConeMesh{}; //Spot Lights
-	ID3D11Buffer* m_pConeVB{}, * m_pConeIB{}; //Cone Vertex/IndexBuffer
-
-	UINT m_VertexStride{}; //Sphere & Cone VertexStride
+	ID3D11Buffer* m_pConeIB{}; //Cone IndexBuffer
 
 	void DrawVolumetricLight(const SceneContext& sceneContext, const Light& light) const;
 };
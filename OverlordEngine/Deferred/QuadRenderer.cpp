@@ -65,11 +65,12 @@ void QuadRenderer::Initialize()
 
 	//Quad Material
 	m_pMaterial = MaterialManager::Get()->CreateMaterial<QuadMaterial>();
+	m_EVar_Texture = m_pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gTexture");
 }
 
 void QuadRenderer::Draw(ID3D11ShaderResourceView* pSRV, const Quad& dim, QuadMode mode)
 {
-	m_pMaterial->SetVariable_Texture(L"gTexture", pSRV);
+	m_EVar_Texture.Set(pSRV);
 	Draw(m_pMaterial, dim, mode);
 
 	ID3D11ShaderResourceView* pEmptySRV[] = { nullptr };
@@ -62,6 +62,7 @@ private:
 	void Draw(const BaseMaterial* pMaterial, const Quad& dim, QuadMode mode);
 
 	QuadMaterial* m_pMaterial{};
+	MaterialVariable<ID3D11ShaderResourceView*> m_EVar_Texture{};
 	ID3D11Buffer* m_pStaticVB{};
 	ID3D11Buffer* m_pDynamicVB{};
 
@@ -0,0 +1,354 @@
+#include "stdafx.h"
+#include "RenderQueue.h"
+
+RenderQueue::~RenderQueue()
+{
+	SafeRelease(m_pInstanceBuffer);
+	SafeRelease(m_pBonePaletteSRV);
+	SafeRelease(m_pBonePaletteBuffer);
+}
+
+RenderQueue::StateChanges& RenderQueue::StateChanges::operator+=(const StateChanges& other)
+{
+	materials += other.materials;
+	techniques += other.techniques;
+	inputLayouts += other.inputLayouts;
+	vertexBuffers += other.vertexBuffers;
+	indexBuffers += other.indexBuffers;
+	return *this;
+}
+
+UINT64 RenderQueue::MakeKey(UINT pass, UINT materialId, UINT techniqueId, UINT meshId, float depth)
+{
+	//Positive floats compare like their bit patterns, the top 20 bits (below the sign) keep the order
+	UINT depthBits{};
+	if (depth > 0.f)
+	{
+		UINT bits{};
+		std::memcpy(&bits, &depth, sizeof(bits));
+		depthBits = bits >> 11;
+	}
+
+	//pass [60, 64) | material [44, 60) | technique [36, 44) | mesh [20, 36) | depth [0, 20)
+	return (static_cast<UINT64>(pass & 0xF) << 60) |
+		(static_cast<UINT64>(materialId & 0xFFFF) << 44) |
+		(static_cast<UINT64>(techniqueId & 0xFF) << 36) |
+		(static_cast<UINT64>(meshId & 0xFFFF) << 20) |
+		static_cast<UINT64>(depthBits & 0xFFFFF);
+}
+
+UINT RenderQueue::MakeMeshKey(UINT meshId, UINT subMeshId)
+{
+	//Fibonacci hashing, the top 16 bits of the product depend on every input bit
+	const UINT64 id{ (static_cast<UINT64>(meshId) << 8) | (subMeshId & 0xFF) };
+	return static_cast<UINT>((id * 0x9E3779B97F4A7C15ull) >> 48);
+}
+
+void RenderQueue::Sort()
+{
+	const UINT count{ static_cast<UINT>(m_Items.size()) };
+	m_SortEntries.resize(count);
+	m_SortScratch.resize(count);
+	for (UINT i{}; i < count; ++i)
+	{
+		m_SortEntries[i] = { m_Items[i].key, i };
+	}
+
+	//LSD, one histogram per byte
+	for (UINT shift{}; shift < 64; shift += 8)
+	{
+		UINT histogram[256]{};
+		for (const SortEntry& entry : m_SortEntries)
+		{
+			++histogram[(entry.key >> shift) & 0xFF];
+		}
+
+		if (count == 0 || histogram[(m_SortEntries[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		UINT offset{};
+		for (UINT& bucket : histogram)
+		{
+			const UINT bucketCount{ bucket };
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for (const SortEntry& entry : m_SortEntries)
+		{
+			m_SortScratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+		}
+
+		m_SortEntries.swap(m_SortScratch);
+	}
+
+	m_Commands.resize(count);
+	for (UINT i{}; i < count; ++i)
+	{
+		m_Commands[i] = m_SortEntries[i].item;
+	}
+
+	m_IsSorted = true;
+}
+
+void RenderQueue::BuildBatches(bool allowInstancing)
+{
+	if (!m_IsSorted)
+		Sort();
+
+	m_Batches.clear();
+	m_Instances.clear();
+	m_BonePalette.clear();
+	m_InstancedBatchCount = 0;
+
+	const UINT count{ static_cast<UINT>(m_Commands.size()) };
+	for (UINT command{}; command < count;)
+	{
+		const DrawItem& first{ m_Items[m_Commands[command]] };
+
+		//Equal keys are adjacent after the sort, the run ends at the first item that can't share the draw
+		UINT runEnd{ command + 1 };
+		if (allowInstancing && first.pInstancedTechnique)
+		{
+			while (runEnd < count && CanInstance(first, m_Items[m_Commands[runEnd]]))
+				++runEnd;
+		}
+
+		Batch batch{ command, runEnd - command, 0, runEnd - command > 1 };
+		if (batch.isInstanced)
+		{
+			batch.firstInstance = static_cast<UINT>(m_Instances.size());
+			for (UINT instance{ command }; instance < runEnd; ++instance)
+			{
+				const DrawItem& item{ m_Items[m_Commands[instance]] };
+				InstanceData& data{ m_Instances.emplace_back() };
+				data.world = item.world;
+				data.boneOffset = static_cast<UINT>(m_BonePalette.size());
+
+				if (item.boneCount > 0)
+					m_BonePalette.insert(m_BonePalette.end(), item.pBones, item.pBones + item.boneCount);
+			}
+
+			++m_InstancedBatchCount;
+		}
+
+		m_Batches.emplace_back(batch);
+		command = runEnd;
+	}
+}
+
+void RenderQueue::Submit(const SceneContext& sceneContext)
+{
+	BuildBatches(sceneContext.settings.instancing);
+
+	const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
+	pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	if (!m_Instances.empty())
+		UploadInstances(sceneContext);
+
+	m_SubmittedChanges = {};
+	BoundState previous{};
+	bool hasPrevious{};
+	UINT passCount{};
+	for (const Batch& batch : m_Batches)
+	{
+		const DrawItem& item{ m_Items[m_Commands[batch.firstCommand]] };
+		const BoundState state{ GetState(item, batch.isInstanced) };
+		const StateChanges changes{ Compare(hasPrevious ? &previous : nullptr, state) };
+		m_SubmittedChanges += changes;
+
+		//Per object variables, uploaded by the pass Apply below (instanced batches only use the shared ones)
+		item.pMaterial->UpdateEffectVariables(sceneContext, item.pModel);
+		//Bone palette straight to the shared effect, it isn't an instance parameter (the SRV is recreated when the palette grows)
+		if (batch.isInstanced && item.boneCount > 0)
+			item.pMaterial->GetBonePaletteVariable().Set(m_pBonePaletteSRV);
+
+		if (changes.inputLayouts)
+			pDeviceContext->IASetInputLayout(state.pInputLayout);
+
+		if (changes.vertexBuffers)
+		{
+			constexpr UINT positionStride{ sizeof(XMFLOAT3) };
+			const UINT offset{};
+			pDeviceContext->IASetVertexBuffers(MeshFilter::PositionSlot, 1, &state.pPositionBuffer, &positionStride, &offset);
+			pDeviceContext->IASetVertexBuffers(MeshFilter::AttributeSlot, 1, &state.pVertexBuffer, &state.vertexStride, &offset);
+		}
+
+		if (changes.indexBuffers)
+			pDeviceContext->IASetIndexBuffer(state.pIndexBuffer, state.indexFormat, 0);
+
+		if (changes.techniques)
+		{
+			D3DX11_TECHNIQUE_DESC techDesc{};
+			state.pTechnique->GetDesc(&techDesc);
+			passCount = techDesc.Passes;
+		}
+
+		for (UINT p{}; p < passCount; ++p)
+		{
+			state.pTechnique->GetPassByIndex(p)->Apply(0, pDeviceContext);
+			if (batch.isInstanced)
+				pDeviceContext->DrawIndexedInstanced(item.indexCount, batch.commandCount, 0, 0, batch.firstInstance);
+			else
+				pDeviceContext->DrawIndexed(item.indexCount, 0, 0);
+		}
+
+		previous = state;
+		hasPrevious = true;
+	}
+
+	//Slot 1 is only valid for the layouts built from an instanced technique
+	if (!m_Instances.empty())
+	{
+		ID3D11Buffer* pNullBuffer{};
+		const UINT zero{};
+		pDeviceContext->IASetVertexBuffers(1, 1, &pNullBuffer, &zero, &zero);
+	}
+}
+
+void RenderQueue::UploadInstances(const SceneContext& sceneContext)
+{
+	const auto pDevice = sceneContext.d3dContext.pDevice;
+	const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
+
+	//Instance stream (grows, never shrinks)
+	const UINT instanceCount{ static_cast<UINT>(m_Instances.size()) };
+	if (!m_pInstanceBuffer || instanceCount > m_InstanceCapacity)
+	{
+		SafeRelease(m_pInstanceBuffer);
+		m_InstanceCapacity = std::max(instanceCount, m_InstanceCapacity * 2);
+
+		D3D11_BUFFER_DESC bufferDesc{};
+		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+		bufferDesc.ByteWidth = sizeof(InstanceData) * m_InstanceCapacity;
+		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bufferDesc.MiscFlags = 0;
+
+		HANDLE_ERROR(pDevice->CreateBuffer(&bufferDesc, nullptr, &m_pInstanceBuffer));
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mappedResource{};
+	HANDLE_ERROR(pDeviceContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource));
+	std::memcpy(mappedResource.pData, m_Instances.data(), sizeof(InstanceData) * instanceCount);
+	pDeviceContext->Unmap(m_pInstanceBuffer, 0);
+
+	const UINT stride{ sizeof(InstanceData) };
+	const UINT offset{};
+	pDeviceContext->IASetVertexBuffers(1, 1, &m_pInstanceBuffer, &stride, &offset);
+
+	if (m_BonePalette.empty())
+		return;
+
+	//Bone palette, read as Buffer<float4> (four rows per bone)
+	const UINT boneCount{ static_cast<UINT>(m_BonePalette.size()) };
+	if (!m_pBonePaletteBuffer || boneCount > m_BonePaletteCapacity)
+	{
+		SafeRelease(m_pBonePaletteSRV);
+		SafeRelease(m_pBonePaletteBuffer);
+		m_BonePaletteCapacity = std::max(boneCount, m_BonePaletteCapacity * 2);
+
+		D3D11_BUFFER_DESC bufferDesc{};
+		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+		bufferDesc.ByteWidth = sizeof(XMFLOAT4X4) * m_BonePaletteCapacity;
+		bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bufferDesc.MiscFlags = 0;
+
+		HANDLE_ERROR(pDevice->CreateBuffer(&bufferDesc, nullptr, &m_pBonePaletteBuffer));
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+		srvDesc.Buffer.FirstElement = 0;
+		srvDesc.Buffer.NumElements = m_BonePaletteCapacity * 4;
+
+		HANDLE_ERROR(pDevice->CreateShaderResourceView(m_pBonePaletteBuffer, &srvDesc, &m_pBonePaletteSRV));
+	}
+
+	HANDLE_ERROR(pDeviceContext->Map(m_pBonePaletteBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource));
+	std::memcpy(mappedResource.pData, m_BonePalette.data(), sizeof(XMFLOAT4X4) * boneCount);
+	pDeviceContext->Unmap(m_pBonePaletteBuffer, 0);
+}
+
+void RenderQueue::Clear()
+{
+	m_Items.clear();
+	m_Commands.clear();
+	m_Batches.clear();
+	m_Instances.clear();
+	m_BonePalette.clear();
+	m_IsSorted = false;
+}
+
+RenderQueue::StateChanges RenderQueue::CountStateChanges() const
+{
+	StateChanges total{};
+	BoundState previous{};
+	bool hasPrevious{};
+	const auto countItem = [&](const DrawItem& item)
+	{
+		const BoundState state{ GetState(item, false) };
+		total += Compare(hasPrevious ? &previous : nullptr, state);
+		previous = state;
+		hasPrevious = true;
+	};
+
+	if (m_IsSorted)
+	{
+		for (const UINT command : m_Commands)
+		{
+			countItem(m_Items[command]);
+		}
+	}
+	else
+	{
+		for (const DrawItem& item : m_Items)
+		{
+			countItem(item);
+		}
+	}
+
+	return total;
+}
+
+RenderQueue::BoundState RenderQueue::GetState(const DrawItem& item, bool isInstanced)
+{
+	return {
+		item.pMaterial,
+		isInstanced ? item.pInstancedTechnique : item.pTechnique,
+		isInstanced ? item.pInstancedInputLayout : item.pInputLayout,
+		item.pPositionBuffer,
+		item.pVertexBuffer,
+		item.vertexStride,
+		item.pIndexBuffer,
+		item.indexFormat };
+}
+
+RenderQueue::StateChanges RenderQueue::Compare(const BoundState* pPrevious, const BoundState& state)
+{
+	if (!pPrevious)
+		return { 1, 1, 1, 1, 1 };
+
+	StateChanges changes{};
+	changes.materials = pPrevious->pMaterial != state.pMaterial ? 1 : 0;
+	changes.techniques = pPrevious->pTechnique != state.pTechnique ? 1 : 0;
+	changes.inputLayouts = pPrevious->pInputLayout != state.pInputLayout ? 1 : 0;
+	changes.vertexBuffers = pPrevious->pPositionBuffer != state.pPositionBuffer || pPrevious->pVertexBuffer != state.pVertexBuffer || pPrevious->vertexStride != state.vertexStride ? 1 : 0;
+	changes.indexBuffers = pPrevious->pIndexBuffer != state.pIndexBuffer ? 1 : 0;
+	return changes;
+}
+
+bool RenderQueue::CanInstance(const DrawItem& first, const DrawItem& item)
+{
+	//Same submesh (buffers and range) drawn with the same material, skinned instances need the same palette size
+	return item.pMaterial == first.pMaterial &&
+		item.pInstancedTechnique == first.pInstancedTechnique &&
+		item.pPositionBuffer == first.pPositionBuffer &&
+		item.pVertexBuffer == first.pVertexBuffer &&
+		item.vertexStride == first.vertexStride &&
+		item.pIndexBuffer == first.pIndexBuffer &&
+		item.indexCount == first.indexCount &&
+		item.boneCount == first.boneCount;
+}
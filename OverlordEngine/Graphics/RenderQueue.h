@@ -0,0 +1,137 @@
+#pragma once
+
+//Draw items collected during the scene traversal, sorted on a 64-bit key and submitted with redundant state binds skipped
+//Key (msb > lsb): pass (4) | material (16) | technique (8) | mesh (16) | depth (20)
+//Fields are truncated to their width, the elision compares the actual state so a collision only costs a rebind
+//Consecutive draws of the same submesh with the same material are merged into one instanced draw (see BuildBatches)
+class RenderQueue final
+{
+public:
+	struct DrawItem
+	{
+		UINT64 key{};
+		BaseMaterial* pMaterial{};
+		const ModelComponent* pModel{}; //Per object variables (BaseMaterial::UpdateEffectVariables)
+		ID3DX11EffectTechnique* pTechnique{};
+		ID3D11InputLayout* pInputLayout{}; //MeshFilter streams (MaterialTechniqueContext::pStreamInputLayout)
+		ID3D11Buffer* pPositionBuffer{}; //MeshFilter::PositionSlot
+		ID3D11Buffer* pVertexBuffer{}; //MeshFilter::AttributeSlot
+		UINT vertexStride{};
+		ID3D11Buffer* pIndexBuffer{};
+		DXGI_FORMAT indexFormat{ DXGI_FORMAT_R32_UINT }; //Fixed per buffer, not compared
+		UINT indexCount{};
+
+		//Instancing (optional, the material's "Instanced" technique)
+		XMFLOAT4X4 world{};
+		ID3DX11EffectTechnique* pInstancedTechnique{};
+		ID3D11InputLayout* pInstancedInputLayout{};
+		const XMFLOAT4X4* pBones{}; //Skinned only, copied to the bone palette
+		UINT boneCount{};
+	};
+
+	//Vertex buffer slot 1 (INSTANCE_WORLD0..3, INSTANCE_BONES)
+	struct InstanceData
+	{
+		XMFLOAT4X4 world;
+		UINT boneOffset; //First bone of this instance in the bone palette (gBonePalette)
+		UINT padding[3];
+	};
+
+	//Commands drawn with one call, instanced batches cover two or more commands
+	struct Batch
+	{
+		UINT firstCommand;
+		UINT commandCount;
+		UINT firstInstance;
+		bool isInstanced;
+	};
+
+	//Binds needed to submit the command list (first command binds everything)
+	struct StateChanges
+	{
+		UINT materials{};
+		UINT techniques{};
+		UINT inputLayouts{};
+		UINT vertexBuffers{};
+		UINT indexBuffers{};
+
+		UINT GetTotal() const { return materials + techniques + inputLayouts + vertexBuffers + indexBuffers; }
+		StateChanges& operator+=(const StateChanges& other);
+	};
+
+	RenderQueue() = default;
+	~RenderQueue();
+	RenderQueue(const RenderQueue& other) = delete;
+	RenderQueue(RenderQueue&& other) noexcept = delete;
+	RenderQueue& operator=(const RenderQueue& other) = delete;
+	RenderQueue& operator=(RenderQueue&& other) noexcept = delete;
+
+	//Lower passes are submitted first, depth sorts front to back (view space, negative == 0)
+	//Each id keeps its low bits (pass 4, material 16, technique 8, mesh 16), larger ids wrap and share a key with a lower one
+	static UINT64 MakeKey(UINT pass, UINT materialId, UINT techniqueId, UINT meshId, float depth);
+	//16-bit mesh field of a submesh: MeshFilter ids keep growing over a session and submeshes go up to 256, both are hashed
+	//so a collision is a random pair of live submeshes instead of every mesh 1024 loads apart
+	static UINT MakeMeshKey(UINT meshId, UINT subMeshId);
+
+	void Add(const DrawItem& item) { m_Items.emplace_back(item); }
+	//Radix sort (stable, 8 bits per pass, passes where every key shares the digit are skipped)
+	void Sort();
+	//Groups the sorted commands into draw calls and fills the instance stream and bone palette (CPU only)
+	void BuildBatches(bool allowInstancing);
+	void Submit(const SceneContext& sceneContext);
+	void Clear();
+
+	//Headless inspection, the command list is the item order of the last Sort (insertion order before that)
+	const std::vector<DrawItem>& GetItems() const { return m_Items; }
+	const std::vector<UINT>& GetCommands() const { return m_Commands; }
+	const std::vector<Batch>& GetBatches() const { return m_Batches; }
+	const std::vector<InstanceData>& GetInstances() const { return m_Instances; }
+	const std::vector<XMFLOAT4X4>& GetBonePalette() const { return m_BonePalette; }
+	UINT GetInstancedBatchCount() const { return m_InstancedBatchCount; }
+	StateChanges CountStateChanges() const;
+	const StateChanges& GetSubmittedChanges() const { return m_SubmittedChanges; }
+
+private:
+	struct SortEntry
+	{
+		UINT64 key;
+		UINT item;
+	};
+
+	//Pipeline state of one draw call
+	struct BoundState
+	{
+		BaseMaterial* pMaterial;
+		ID3DX11EffectTechnique* pTechnique;
+		ID3D11InputLayout* pInputLayout;
+		ID3D11Buffer* pPositionBuffer;
+		ID3D11Buffer* pVertexBuffer;
+		UINT vertexStride;
+		ID3D11Buffer* pIndexBuffer;
+		DXGI_FORMAT indexFormat;
+	};
+
+	static BoundState GetState(const DrawItem& item, bool isInstanced);
+	static StateChanges Compare(const BoundState* pPrevious, const BoundState& state);
+	static bool CanInstance(const DrawItem& first, const DrawItem& item);
+
+	void UploadInstances(const SceneContext& sceneContext);
+
+	std::vector<DrawItem> m_Items{};
+	std::vector<UINT> m_Commands{};
+	std::vector<SortEntry> m_SortEntries{}, m_SortScratch{};
+	StateChanges m_SubmittedChanges{};
+	bool m_IsSorted{};
+
+	//Instancing
+	std::vector<Batch> m_Batches{};
+	std::vector<InstanceData> m_Instances{};
+	std::vector<XMFLOAT4X4> m_BonePalette{};
+	UINT m_InstancedBatchCount{};
+
+	ID3D11Buffer* m_pInstanceBuffer{};
+	UINT m_InstanceCapacity{};
+	ID3D11Buffer* m_pBonePaletteBuffer{};
+	ID3D11ShaderResourceView* m_pBonePaletteSRV{};
+	UINT m_BonePaletteCapacity{};
+};
@@ -38,6 +38,9 @@ void ShadowMapRenderer::Initialize()
 	//	- We want to store the TechniqueContext (struct that contains information about the Technique & InputLayout required for rendering) for both techniques in the m_GeneratorTechniqueContexts array.
 	//	- Use the ShadowGeneratorType enum to retrieve the correct TechniqueContext by ID, and also use that ID to store it inside the array (see BaseMaterial::GetTechniqueContext)
 	m_pShadowMapGenerator = MaterialManager::Get()->CreateMaterial<ShadowMapMaterial>();
+	m_EVar_LightViewProj = m_pShadowMapGenerator->GetVariableHandle<XMFLOAT4X4>(L"gLightViewProj");
+	m_EVar_World = m_pShadowMapGenerator->GetVariableHandle<XMFLOAT4X4>(L"gWorld");
+	m_EVar_Bones = m_pShadowMapGenerator->GetVariableHandle<XMFLOAT4X4>(L"gBones");
 
 	m_GeneratorTechniqueContexts[(int)ShadowGeneratorType::Static]
 		= m_pShadowMapGenerator->GetTechniqueContext((int)ShadowGeneratorType::Static);
@@ -100,9 +103,10 @@ void ShadowMapRenderer::Begin(const SceneContext& sceneContext)
 	// Update light VP
 	CalculateLightVP(sceneContext);
 	CalculateBakedLightVP(sceneContext);
+	CalculateCasterFrustum(sceneContext);
 
 	// 3. Update this matrix (m_LightVP) on the ShadowMapMaterial effect, or m_BakedLightVP when baking shadows
-	m_pShadowMapGenerator->SetVariable_Matrix(L"gLightViewProj", reinterpret_cast<const float*>(bakeShadowMap ? &m_BakedLightVP : &m_LightVP));
+	m_EVar_LightViewProj.Set(bakeShadowMap ? m_BakedLightVP : m_LightVP);
 
 	// 4. Set the Main Game RenderTarget to m_pShadowRenderTarget (OverlordGame::SetRenderTarget) - Hint: every Singleton object has access to the GameContext...
 	m_GameContext.pGame->SetRenderTarget(bakeShadowMap ? m_pBakedShadowRenderTarget : m_pShadowRenderTarget);
@@ -121,13 +125,23 @@ void ShadowMapRenderer::DrawMesh(const SceneContext& sceneContext, MeshFilter* p
 	//3. Set the relevant variables on the ShadowMapMaterial
 	//		- world of the mesh
 	//		- if animated, the boneTransforms
+	//Caster culling, before any effect variable is set (skinned meshes leave their bind pose bounds, they are always drawn)
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	++frameStats.shadowCasters;
+	if (m_IsCullingCasters && !pMeshFilter->HasAnimations())
+	{
+		if (!m_HasCasterVolume || !m_CasterFrustum.Intersects(pMeshFilter->GetBounds(), XMLoadFloat4x4(&meshWorld)))
+			return;
+	}
+	++frameStats.shadowCastersDrawn;
+
 	int shadowGenType = static_cast<int>(pMeshFilter->HasAnimations() ? ShadowGeneratorType::Skinned : ShadowGeneratorType::Static);
 
 	const auto& techniqueContext = m_GeneratorTechniqueContexts[shadowGenType];
-	m_pShadowMapGenerator->SetVariable_Matrix(L"gWorld", reinterpret_cast<const float*>(&meshWorld));
+	m_EVar_World.Set(meshWorld);
 
 	if (pMeshFilter->HasAnimations())
-		m_pShadowMapGenerator->SetVariable_MatrixArray(L"gBones", &meshBones[0]._11, (UINT)meshBones.size());
+		m_EVar_Bones.SetArray(meshBones.data(), static_cast<UINT>(meshBones.size()));
 
 	//4. Setup Pipeline for Drawing (Similar to ModelComponent::Draw, but for our ShadowMapMaterial)
 	//	- Set InputLayout (see TechniqueContext)
@@ -140,21 +154,18 @@ void ShadowMapRenderer::DrawMesh(const SceneContext& sceneContext, MeshFilter* p
 	const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
 
 	//Set Inputlayout
-	pDeviceContext->IASetInputLayout(techniqueContext.pInputLayout);
+	pDeviceContext->IASetInputLayout(techniqueContext.pStreamInputLayout);
 
 	//Set Primitive Topology
 	pDeviceContext->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	for (const auto& subMesh : pMeshFilter->GetMeshes())
 	{
-		//Set Vertex Buffer
-		const UINT offset = 0;
-		const auto& vertexBufferData = pMeshFilter->GetVertexBufferData(techniqueContext.inputLayoutID, subMesh.id);
-		pDeviceContext->IASetVertexBuffers(0, 1, &vertexBufferData.pVertexBuffer, &vertexBufferData.VertexStride,
-			&offset);
+		//Set Vertex Buffers (the static generator only reads the shared position stream)
+		pMeshFilter->SetVertexStreams(pDeviceContext, techniqueContext.inputLayoutID, subMesh.id);
 
 		//Set Index Buffer
-		pDeviceContext->IASetIndexBuffer(subMesh.buffers.pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		pDeviceContext->IASetIndexBuffer(subMesh.buffers.pIndexBuffer, subMesh.buffers.indexFormat, 0);
 
 		m_pShadowMapGenerator->SetTechnique(shadowGenType);
 
@@ -222,7 +233,8 @@ void ShadowMapRenderer::CalculateLightVP(const SceneContext& sceneContext)
 	if (!dirLight.isDirty) return;
 
 	// Projection
-	const auto projection = XMMatrixOrthographicLH(sceneContext.aspectRatio * m_ViewWidth, m_ViewHeight, 0.1f, 400.f);
+	const float width{ sceneContext.aspectRatio * m_ViewWidth };
+	const auto projection = XMMatrixOrthographicLH(width, m_ViewHeight, 0.1f, 400.f);
 
 	// View
 	const auto lightDir = XMLoadFloat4(&dirLight.direction);
@@ -230,6 +242,11 @@ void ShadowMapRenderer::CalculateLightVP(const SceneContext& sceneContext)
 	const XMMATRIX view = XMMatrixLookAtLH(lightPos, lightPos + lightDir, XMVectorSet(0.f, 1.f, 0.f, 0.f));
 	XMStoreFloat4x4(&m_LightVP, XMMatrixMultiply(view, projection));
 
+	// Volume in light view space (caster culling)
+	XMStoreFloat4x4(&m_LightView, view);
+	m_LightVolumeMin = { -width * .5f, -m_ViewHeight * .5f, 0.1f };
+	m_LightVolumeMax = { width * .5f, m_ViewHeight * .5f, 400.f };
+
 	dirLight.isDirty = false;
 }
 
@@ -250,6 +267,55 @@ void ShadowMapRenderer::CalculateBakedLightVP(const SceneContext& sceneContext)
 	dirLight.isDirty = false;
 }
 
+void ShadowMapRenderer::CalculateCasterFrustum(const SceneContext& sceneContext)
+{
+	m_IsCullingCasters = sceneContext.settings.shadowCasterCulling;
+	m_HasCasterVolume = true;
+	if (!m_IsCullingCasters) return;
+
+	// Baked shadows cover the whole light volume, not only what the camera sees
+	if (sceneContext.pLights->GetBakeShadows())
+	{
+		m_CasterFrustum = CullingFrustum{ m_BakedLightVP };
+		return;
+	}
+
+	if (!sceneContext.pCamera)
+	{
+		m_CasterFrustum = CullingFrustum{ m_LightVP };
+		return;
+	}
+
+	// Camera frustum corners in light view space (the light view is affine, the divide can happen after it)
+	const XMMATRIX lightView{ XMLoadFloat4x4(&m_LightView) };
+	const XMMATRIX toLightView{ XMMatrixMultiply(XMLoadFloat4x4(&sceneContext.pCamera->GetViewProjectionInverse()), lightView) };
+
+	XMVECTOR min{ XMVectorReplicate(FLT_MAX) };
+	XMVECTOR max{ XMVectorReplicate(-FLT_MAX) };
+	for (int corner{}; corner < 8; ++corner)
+	{
+		const XMVECTOR clip{ XMVectorSet(corner & 1 ? 1.f : -1.f, corner & 2 ? 1.f : -1.f, corner & 4 ? 1.f : 0.f, 1.f) };
+		const XMVECTOR point{ XMVector3TransformCoord(clip, toLightView) };
+		min = XMVectorMin(min, point);
+		max = XMVectorMax(max, point);
+	}
+
+	// Receivers are inside the camera frustum, clipped to the light volume
+	// Their casters can be anywhere between them and the light, so the volume is extended back to the light's near plane
+	XMFLOAT3 casterMin{}, casterMax{};
+	XMStoreFloat3(&casterMin, XMVectorMax(min, XMLoadFloat3(&m_LightVolumeMin)));
+	XMStoreFloat3(&casterMax, XMVectorMin(max, XMLoadFloat3(&m_LightVolumeMax)));
+	casterMin.z = m_LightVolumeMin.z;
+
+	m_HasCasterVolume = casterMin.x < casterMax.x && casterMin.y < casterMax.y && casterMin.z < casterMax.z;
+	if (!m_HasCasterVolume) return;
+
+	const XMMATRIX projection{ XMMatrixOrthographicOffCenterLH(casterMin.x, casterMax.x, casterMin.y, casterMax.y, casterMin.z, casterMax.z) };
+	XMFLOAT4X4 casterViewProjection{};
+	XMStoreFloat4x4(&casterViewProjection, XMMatrixMultiply(lightView, projection));
+	m_CasterFrustum = CullingFrustum{ casterViewProjection };
+}
+
 void ShadowMapRenderer::Debug_DrawDepthSRV(const XMFLOAT2& position, const XMFLOAT2& scale, const XMFLOAT2& pivot) const
 {
 	if (m_pShadowRenderTarget->HasDepthSRV())
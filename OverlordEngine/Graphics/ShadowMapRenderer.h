@@ -24,6 +24,9 @@ public:
 	const XMFLOAT4X4& GetLightVP() const { return m_LightVP; }
 	const XMFLOAT4X4& GetBakedLightVP() const { return m_BakedLightVP; }
 
+	//Volume the casters of the current shadow pass are culled against (see DrawMesh)
+	const CullingFrustum& GetCasterFrustum() const { return m_CasterFrustum; }
+
 	void SetViewWidthHeight(float width, float height) { m_ViewWidth = width; m_ViewHeight = height; }
 
 	void Debug_DrawDepthSRV(const XMFLOAT2& position = { 0.f,0.f }, const XMFLOAT2& scale = { 1.f,1.f }, const XMFLOAT2& pivot = {0.f,0.f}) const;
@@ -46,6 +49,13 @@ private:
 	//Light ViewProjection (perspective used to render ShadowMap)
 	XMFLOAT4X4 m_LightVP{}, m_BakedLightVP{};
 
+	//Caster culling, light view and the orthographic volume in light view space (real time shadow map)
+	XMFLOAT4X4 m_LightView{};
+	XMFLOAT3 m_LightVolumeMin{}, m_LightVolumeMax{};
+	CullingFrustum m_CasterFrustum{};
+	bool m_HasCasterVolume{}; //False when the light volume misses the camera frustum, every caster is culled
+	bool m_IsCullingCasters{};
+
 	//Shadow Generator is responsible of drawing all shadow casting meshes to the ShadowMap
 	//There are two techniques, one for static (non-skinned) meshes, and another for skinned meshes (with bones, blendIndices, blendWeights)
 	enum class ShadowGeneratorType
@@ -55,6 +65,7 @@ private:
 	};
 
 	ShadowMapMaterial* m_pShadowMapGenerator{ nullptr };
+	MaterialVariable<XMFLOAT4X4> m_EVar_LightViewProj{}, m_EVar_World{}, m_EVar_Bones{};
 
 	//Information about each technique (static/skinned) is stored in a MaterialTechniqueContext structure
 	//This information is automatically create by the Material class, we only store it in a local array for fast retrieval 
@@ -65,5 +76,6 @@ private:
 
 	void CalculateLightVP(const SceneContext& sceneContext);
 	void CalculateBakedLightVP(const SceneContext& sceneContext);
+	void CalculateCasterFrustum(const SceneContext& sceneContext);
 };
 
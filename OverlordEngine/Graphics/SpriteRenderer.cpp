@@ -3,7 +3,8 @@
 
 void SpriteRenderer::Initialize()
 {
-	//Effect
+	//Effect (pinned, the renderer can be created while a scene is active)
+	ContentScope::Active pinned{ nullptr };
 	m_pEffect = ContentManager::Load<ID3DX11Effect>(L"Effects/SpriteRenderer.fx");
 	m_pTechnique = m_pEffect->GetTechniqueByIndex(0);
 	EffectHelper::BuildInputLayout(m_GameContext.d3dContext.pDevice, m_pTechnique, &m_pInputLayout);
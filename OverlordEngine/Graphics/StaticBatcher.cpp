@@ -0,0 +1,320 @@
+#include "stdafx.h"
+#include "StaticBatcher.h"
+
+namespace
+{
+	struct Part
+	{
+		const ModelComponent* pModel;
+		const SubMeshFilter* pSubMesh;
+		BaseMaterial* pMaterial;
+		XMFLOAT4X4 world;
+		BoundingBox bounds; //World space
+		XMINT3 cell;
+	};
+
+	//Elements wider than the source (e.g. float4 POSITION) keep the zeroed tail
+	template<typename T>
+	void WriteElement(char* pDestination, const T& value, UINT size)
+	{
+		std::memcpy(pDestination, &value, std::min(size, static_cast<UINT>(sizeof(T))));
+	}
+
+	bool IsStaticChain(const GameObject* pObject)
+	{
+		//Inactive objects aren't drawn, a static root makes the whole subtree static (see GameScene::RootDraw, shadow pass)
+		bool isStatic{};
+		for (; pObject; pObject = pObject->GetParent())
+		{
+			if (!pObject->GetIsActive())
+				return false;
+
+			isStatic |= pObject->GetIsShadowMapStatic();
+		}
+
+		return isStatic;
+	}
+}
+
+StaticBatcher::~StaticBatcher()
+{
+	Release();
+}
+
+bool StaticBatcher::CanBatch(const ModelComponent* pModel)
+{
+	//Skinned meshes are deformed on the GPU, their vertices can't be baked
+	if (!pModel->m_pMeshFilter || pModel->m_pAnimator || !pModel->m_pDefaultMaterial || !IsStaticChain(pModel->GetGameObject()))
+		return false;
+
+	//Baking needs the CPU attribute arrays (MeshFilter::ReleaseCpuData)
+	if (pModel->m_pMeshFilter->IsCpuDataReleased())
+		return false;
+
+	for (const SubMeshFilter& subMesh : pModel->m_pMeshFilter->GetMeshes())
+	{
+		if (subMesh.positions.empty() || subMesh.indices.empty())
+			return false;
+	}
+
+	return true;
+}
+
+void StaticBatcher::Build(GameScene* pScene)
+{
+	const auto start = std::chrono::steady_clock::now();
+	Release();
+	m_pScene = pScene;
+
+	//GATHER (one part per submesh)
+	std::vector<Part> parts{};
+	pScene->ForEachComponent<ModelComponent>([&](ModelComponent* pModel)
+	{
+		pModel->m_IsStaticBatched = CanBatch(pModel);
+		if (!pModel->m_IsStaticBatched)
+			return;
+
+		++m_Stats.models;
+		const XMFLOAT4X4& world{ pModel->GetTransform()->GetWorld() };
+		for (const SubMeshFilter& subMesh : pModel->m_pMeshFilter->GetMeshes())
+		{
+			Part& part{ parts.emplace_back() };
+			part.pModel = pModel;
+			part.pSubMesh = &subMesh;
+			part.pMaterial = subMesh.id < pModel->m_Materials.size() && pModel->m_Materials[subMesh.id] ? pModel->m_Materials[subMesh.id] : pModel->m_pDefaultMaterial;
+			part.world = world;
+			subMesh.bounds.Transform(part.bounds, XMLoadFloat4x4(&world));
+			part.cell = {
+				static_cast<int>(std::floor(part.bounds.Center.x / m_ChunkSize)),
+				static_cast<int>(std::floor(part.bounds.Center.y / m_ChunkSize)),
+				static_cast<int>(std::floor(part.bounds.Center.z / m_ChunkSize)) };
+
+			//Own buffers of the submesh, still used by the shadow pass
+			const MaterialTechniqueContext& techniqueContext{ part.pMaterial->GetTechniqueContext() };
+			const int vertexBufferId{ pModel->m_pMeshFilter->GetVertexBufferId(techniqueContext.inputLayoutID, subMesh.id) };
+			if (vertexBufferId >= 0)
+				m_Stats.sourceBytes += subMesh.buffers.vertexbuffers[vertexBufferId].BufferSize;
+			m_Stats.sourceBytes += sizeof(XMFLOAT3) * subMesh.vertexCount; //Shared position stream
+			m_Stats.sourceBytes += sizeof(UINT) * subMesh.indexCount;
+		}
+	});
+
+	m_Stats.subMeshes = static_cast<UINT>(parts.size());
+
+	//Material, then cell (a chunk is a contiguous run)
+	std::ranges::sort(parts, [](const Part& a, const Part& b)
+	{
+		if (a.pMaterial != b.pMaterial)
+			return a.pMaterial->GetMaterialId() < b.pMaterial->GetMaterialId();
+
+		return std::tie(a.cell.x, a.cell.y, a.cell.z) < std::tie(b.cell.x, b.cell.y, b.cell.z);
+	});
+
+	const auto pDevice = pScene->GetSceneContext().d3dContext.pDevice;
+	for (size_t groupStart{}; groupStart < parts.size();)
+	{
+		BaseMaterial* pMaterial{ parts[groupStart].pMaterial };
+		size_t groupEnd{ groupStart + 1 };
+		while (groupEnd < parts.size() && parts[groupEnd].pMaterial == pMaterial)
+			++groupEnd;
+
+		const MaterialTechniqueContext& techniqueContext{ pMaterial->GetTechniqueContext() };
+		const UINT stride{ techniqueContext.inputLayoutSize };
+
+		UINT vertexCount{}, indexCount{};
+		for (size_t i{ groupStart }; i < groupEnd; ++i)
+		{
+			vertexCount += parts[i].pSubMesh->vertexCount;
+			indexCount += parts[i].pSubMesh->indexCount;
+		}
+
+		Group group{ pMaterial, parts[groupStart].pModel, nullptr, nullptr, stride, techniqueContext.inputLayoutID, {} };
+
+		//BAKE (world transform applied to the vertices, same layout as MeshFilter::BuildVertexBuffer)
+		std::vector<char> vertices(static_cast<size_t>(stride) * vertexCount);
+		std::vector<UINT> indices{};
+		indices.reserve(indexCount);
+
+		UINT baseVertex{};
+		for (size_t i{ groupStart }; i < groupEnd; ++i)
+		{
+			const Part& part{ parts[i] };
+			const SubMeshFilter& subMesh{ *part.pSubMesh };
+
+			//New chunk when the cell changes
+			if (i == groupStart || part.cell.x != parts[i - 1].cell.x || part.cell.y != parts[i - 1].cell.y || part.cell.z != parts[i - 1].cell.z)
+				group.chunks.push_back({ part.bounds, static_cast<UINT>(indices.size()), 0 });
+			else
+				BoundingBox::CreateMerged(group.chunks.back().bounds, group.chunks.back().bounds, part.bounds);
+
+			const XMMATRIX world{ XMLoadFloat4x4(&part.world) };
+			char* pVertex{ vertices.data() + static_cast<size_t>(baseVertex) * stride };
+			for (UINT v{}; v < subMesh.vertexCount; ++v)
+			{
+				for (const ILDescription& ilDescription : techniqueContext.pInputLayoutDescriptions)
+				{
+					const bool hasElement{ subMesh.HasElement(ilDescription.SemanticType) };
+					switch (ilDescription.SemanticType)
+					{
+					case ILSemantic::POSITION:
+					{
+						XMFLOAT3 position{};
+						XMStoreFloat3(&position, XMVector3TransformCoord(XMLoadFloat3(&subMesh.positions[v]), world));
+						WriteElement(pVertex, position, ilDescription.Offset);
+						break;
+					}
+					case ILSemantic::NORMAL:
+					case ILSemantic::TANGENT:
+					case ILSemantic::BINORMAL:
+					{
+						//Same as the shaders (direction * world, normalized)
+						const std::vector<XMFLOAT3>& directions{ ilDescription.SemanticType == ILSemantic::NORMAL ? subMesh.normals :
+							ilDescription.SemanticType == ILSemantic::TANGENT ? subMesh.tangents : subMesh.binormals };
+
+						XMFLOAT3 direction{};
+						if (hasElement)
+							XMStoreFloat3(&direction, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&directions[v]), world)));
+						WriteElement(pVertex, direction, ilDescription.Offset);
+						break;
+					}
+					case ILSemantic::COLOR:
+						WriteElement(pVertex, hasElement ? subMesh.colors[v] : XMFLOAT4{ 1.f, 0.f, 0.f, 1.f }, ilDescription.Offset);
+						break;
+					case ILSemantic::TEXCOORD:
+						WriteElement(pVertex, hasElement ? subMesh.texCoords[v] : XMFLOAT2{}, ilDescription.Offset);
+						break;
+					case ILSemantic::BLENDINDICES:
+						WriteElement(pVertex, hasElement ? subMesh.blendIndices[v] : XMFLOAT4{}, ilDescription.Offset);
+						break;
+					case ILSemantic::BLENDWEIGHTS:
+						WriteElement(pVertex, hasElement ? subMesh.blendWeights[v] : XMFLOAT4{}, ilDescription.Offset);
+						break;
+					default:
+						HANDLE_ERROR(L"Unsupported SemanticType!");
+						break;
+					}
+
+					pVertex += ilDescription.Offset;
+				}
+			}
+
+			//Mirrored transforms flip the winding
+			const bool isMirrored{ XMVectorGetX(XMMatrixDeterminant(world)) < 0.f };
+			for (size_t index{}; index + 2 < subMesh.indices.size(); index += 3)
+			{
+				indices.push_back(baseVertex + subMesh.indices[index]);
+				indices.push_back(baseVertex + subMesh.indices[isMirrored ? index + 2 : index + 1]);
+				indices.push_back(baseVertex + subMesh.indices[isMirrored ? index + 1 : index + 2]);
+			}
+
+			group.chunks.back().indexCount = static_cast<UINT>(indices.size()) - group.chunks.back().startIndex;
+			baseVertex += subMesh.vertexCount;
+		}
+
+		//UPLOAD
+		D3D11_BUFFER_DESC bd{};
+		bd.Usage = D3D11_USAGE_IMMUTABLE;
+		bd.ByteWidth = static_cast<UINT>(vertices.size());
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.CPUAccessFlags = 0;
+		bd.MiscFlags = 0;
+
+		D3D11_SUBRESOURCE_DATA initData{};
+		initData.pSysMem = vertices.data();
+		HANDLE_ERROR(pDevice->CreateBuffer(&bd, &initData, &group.pVertexBuffer))
+
+		bd.ByteWidth = static_cast<UINT>(sizeof(UINT) * indices.size());
+		bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		initData.pSysMem = indices.data();
+		HANDLE_ERROR(pDevice->CreateBuffer(&bd, &initData, &group.pIndexBuffer))
+
+		m_Stats.chunks += static_cast<UINT>(group.chunks.size());
+		m_Stats.vertices += vertexCount;
+		m_Stats.indices += static_cast<UINT>(indices.size());
+		m_Stats.batchBytes += vertices.size() + sizeof(UINT) * indices.size();
+
+		m_Groups.emplace_back(std::move(group));
+		groupStart = groupEnd;
+	}
+
+	m_Stats.groups = static_cast<UINT>(m_Groups.size());
+	m_Stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	m_IsBuilt = true;
+
+	Logger::LogInfo(L"StaticBatcher::Build > {} models, {} submeshes > {} batches, {} chunks | {:.2f} MB batched ({:.2f} MB source) | {:.2f} ms",
+		m_Stats.models, m_Stats.subMeshes, m_Stats.groups, m_Stats.chunks,
+		m_Stats.batchBytes / (1024.f * 1024.f), m_Stats.sourceBytes / (1024.f * 1024.f), m_Stats.buildMs);
+}
+
+bool StaticBatcher::HasStaleLayout() const
+{
+	return std::ranges::any_of(m_Groups, [](const Group& group) { return group.pMaterial->GetTechniqueContext().inputLayoutID != group.inputLayoutID; });
+}
+
+void StaticBatcher::Draw(const SceneContext& sceneContext)
+{
+	if (!m_IsBuilt)
+		return;
+
+	//Technique switched after this frame's build check (user Draw), baked again before anything is skipped
+	if (HasStaleLayout())
+		Build(m_pScene);
+
+	static const XMFLOAT4X4 identity{ 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	const bool isCulling{ sceneContext.settings.frustumCulling && sceneContext.pCamera };
+	const auto pDeviceContext = sceneContext.d3dContext.pDeviceContext;
+	pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	for (const Group& group : m_Groups)
+	{
+		const MaterialTechniqueContext& techniqueContext{ group.pMaterial->GetTechniqueContext() };
+
+		m_VisibleChunks.clear();
+		for (UINT i{}; i < static_cast<UINT>(group.chunks.size()); ++i)
+		{
+			if (!isCulling || sceneContext.pCamera->GetCullingFrustum().Intersects(group.chunks[i].bounds))
+				m_VisibleChunks.push_back(i);
+		}
+
+		frameStats.staticChunksDrawn += static_cast<UINT>(m_VisibleChunks.size());
+		frameStats.staticChunksCulled += static_cast<UINT>(group.chunks.size() - m_VisibleChunks.size());
+		if (m_VisibleChunks.empty())
+			continue;
+
+		//Vertices are in world space, other model variables come from the group's first model (see header)
+		group.pMaterial->UpdateEffectVariables(sceneContext, identity, group.pModel);
+
+		pDeviceContext->IASetInputLayout(techniqueContext.pInputLayout);
+
+		const UINT offset{};
+		pDeviceContext->IASetVertexBuffers(0, 1, &group.pVertexBuffer, &group.vertexStride, &offset);
+		pDeviceContext->IASetIndexBuffer(group.pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+
+		D3DX11_TECHNIQUE_DESC techDesc{};
+		techniqueContext.pTechnique->GetDesc(&techDesc);
+		for (UINT p{}; p < techDesc.Passes; ++p)
+		{
+			techniqueContext.pTechnique->GetPassByIndex(p)->Apply(0, pDeviceContext);
+			for (const UINT chunk : m_VisibleChunks)
+			{
+				pDeviceContext->DrawIndexed(group.chunks[chunk].indexCount, group.chunks[chunk].startIndex, 0);
+			}
+		}
+	}
+}
+
+void StaticBatcher::Release()
+{
+	for (Group& group : m_Groups)
+	{
+		SafeRelease(group.pVertexBuffer);
+		SafeRelease(group.pIndexBuffer);
+	}
+
+	m_Groups.clear();
+	m_pScene = nullptr;
+	m_Stats = {};
+	m_IsBuilt = false;
+}
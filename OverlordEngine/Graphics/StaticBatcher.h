@@ -0,0 +1,72 @@
+#pragma once
+
+//Pre-transformed geometry of the static ModelComponents of a scene (GameObject::GetIsShadowMapStatic)
+//Submeshes sharing a material are merged into one vertex & index buffer, split into spatial chunks (index ranges) that are culled on their own
+//Opt-in (SceneSettings::staticBatching), built on the first frame of the scene and rebuilt when a batched model moves, is removed or changes material
+//Batched models keep their own buffers (shadow pass, switching the batcher off), deactivating one needs an Invalidate
+//A group is drawn with the model variables of its first model (OnUpdateModelVariables, the world is BaseMaterial::GetDrawWorld),
+//so any other per model state a material derives from the model has to be the same for every model sharing it
+class StaticBatcher final
+{
+public:
+	struct Stats
+	{
+		UINT models{};
+		UINT subMeshes{}; //Draw calls without batching
+		UINT groups{}; //One per material
+		UINT chunks{}; //Draw calls with batching (before culling)
+		UINT vertices{};
+		UINT indices{};
+		UINT64 batchBytes{}; //Vertex & index buffers of the batches
+		UINT64 sourceBytes{}; //Buffers of the batched submeshes (kept alive)
+		float buildMs{};
+	};
+
+	StaticBatcher() = default;
+	~StaticBatcher();
+	StaticBatcher(const StaticBatcher& other) = delete;
+	StaticBatcher(StaticBatcher&& other) noexcept = delete;
+	StaticBatcher& operator=(const StaticBatcher& other) = delete;
+	StaticBatcher& operator=(StaticBatcher&& other) noexcept = delete;
+
+	void Build(GameScene* pScene);
+	void Draw(const SceneContext& sceneContext);
+	void Release();
+
+	void Invalidate() { m_IsBuilt = false; }
+	bool NeedsBuild() const { return !m_IsBuilt || HasStaleLayout(); }
+
+	//World space edge of a chunk cell (next Build)
+	void SetChunkSize(float chunkSize) { m_ChunkSize = chunkSize; }
+	const Stats& GetStats() const { return m_Stats; }
+
+	static bool CanBatch(const ModelComponent* pModel);
+
+private:
+	struct Chunk
+	{
+		BoundingBox bounds;
+		UINT startIndex;
+		UINT indexCount;
+	};
+
+	struct Group
+	{
+		BaseMaterial* pMaterial;
+		const ModelComponent* pModel; //Model variables of the material (OnUpdateModelVariables)
+		ID3D11Buffer* pVertexBuffer;
+		ID3D11Buffer* pIndexBuffer;
+		UINT vertexStride;
+		UINT inputLayoutID; //Technique of the material at build time
+		std::vector<Chunk> chunks;
+	};
+
+	bool HasStaleLayout() const; //A material switched to a technique with another vertex layout since the build
+
+	GameScene* m_pScene{}; //Of the last build
+	std::vector<Group> m_Groups{};
+	std::vector<UINT> m_VisibleChunks{};
+	Stats m_Stats{};
+	float m_ChunkSize{ 64.f };
+	bool m_IsBuilt{};
+};
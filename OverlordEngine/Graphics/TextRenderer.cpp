@@ -11,7 +11,8 @@ void TextRenderer::Initialize()
 {
 	TODO_W7(L"Complete TextRenderer.fx")
 
-	//Effect
+	//Effect (pinned, the renderer can be created while a scene is active)
+	ContentScope::Active pinned{ nullptr };
 	m_pEffect = ContentManager::Load<ID3DX11Effect>(L"Effects/TextRenderer.fx");
 	m_pTechnique = m_pEffect->GetTechniqueByIndex(0);
 	EffectHelper::BuildInputLayout(m_GameContext.d3dContext.pDevice, m_pTechnique, &m_pInputLayout);
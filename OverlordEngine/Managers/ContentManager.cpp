@@ -4,16 +4,22 @@
 std::vector<BaseLoader*> ContentManager::m_Loaders = std::vector<BaseLoader*>();
 GameContext ContentManager::m_GameContext = {};
 bool ContentManager::m_IsInitialized = false;
+UINT64 ContentManager::m_BudgetBytes = 0;
+ContentPack ContentManager::m_Pack{};
 
 void ContentManager::Release()
 {
-	for(BaseLoader *ldr:m_Loaders)
+	//Detached first, scopes released from here on (dependencies, scenes destroyed later) find no loader
+	std::vector<BaseLoader*> loaders{};
+	loaders.swap(m_Loaders);
+
+	for(BaseLoader *ldr:loaders)
 	{	
 		ldr->Unload();
 		SafeDelete(ldr);
 	}
 
-	m_Loaders.clear();
+	m_Pack.Close();
 }
 
 void ContentManager::Initialize(const GameContext& gameContext)
@@ -22,6 +28,10 @@ void ContentManager::Initialize(const GameContext& gameContext)
 	{
 		m_GameContext = gameContext;
 		m_IsInitialized = true;
+		m_BudgetBytes = gameContext.contentBudgetBytes;
+
+		if (!gameContext.contentPack.empty())
+			OpenPack(gameContext.contentPack);
 
 		AddLoader(new EffectLoader);
 		AddLoader(new MeshFilterLoader);
@@ -47,6 +57,111 @@ void ContentManager::AddLoader(BaseLoader* loader)
 	loader->Initialize(m_GameContext);
 }
 
+bool ContentManager::OpenPack(const fs::path& packFile)
+{
+	m_Pack.Close();
+
+	std::error_code error{};
+	if (!fs::exists(packFile, error))
+		return false;
+
+	if (!m_Pack.Open(packFile))
+		return false;
+
+	Logger::LogInfo(L"ContentManager > Content pack \"{}\" opened ({} assets)", packFile.wstring(), m_Pack.GetEntryCount());
+	return true;
+}
+
+void ContentManifest::AddMesh(const std::wstring& meshFile, const std::vector<std::wstring>& layoutEffects, bool releaseCpuData)
+{
+	m_Requests.emplace_back([meshFile, options = MeshFilterLoader::LoadOptions{ layoutEffects, releaseCpuData }]() mutable
+	{
+		ContentManager::Load<MeshFilter>(meshFile, &options);
+	});
+}
+
+void ContentManager::Trim()
+{
+	UINT evictions{};
+	const UINT64 startBytes{ GetResidentBytes() };
+
+	for (BaseLoader* pLoader : m_Loaders)
+	{
+		const UINT64 budgetBytes{ pLoader->GetBudget() };
+		while (budgetBytes > 0 && pLoader->GetResidentBytes() > budgetBytes && pLoader->EvictOldest())
+		{
+			++evictions;
+		}
+	}
+
+	//Evicting an asset can leave its dependencies unreferenced, they are candidates for the next iteration
+	while (m_BudgetBytes > 0 && GetResidentBytes() > m_BudgetBytes)
+	{
+		BaseLoader* pOldestLoader{};
+		UINT64 oldestUse{ ULLONG_MAX };
+		for (BaseLoader* pLoader : m_Loaders)
+		{
+			const UINT64 lastUse{ pLoader->GetOldestUnreferenced() };
+			if (lastUse != 0 && lastUse < oldestUse)
+			{
+				oldestUse = lastUse;
+				pOldestLoader = pLoader;
+			}
+		}
+
+		if (!pOldestLoader || !pOldestLoader->EvictOldest())
+			break;
+
+		++evictions;
+	}
+
+	if (evictions > 0)
+	{
+		constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+		const UINT64 residentBytes{ GetResidentBytes() };
+		const UINT64 evictedBytes{ startBytes > residentBytes ? startBytes - residentBytes : 0 }; //Workers may have loaded content meanwhile
+		Logger::LogInfo(L"ContentManager > Evicted {} assets ({:.1f} MB), {:.1f} MB resident", evictions, static_cast<float>(evictedBytes) * toMB, static_cast<float>(residentBytes) * toMB);
+	}
+}
+
+std::vector<ContentManager::Residency> ContentManager::GetResidency()
+{
+	std::vector<Residency> residency{};
+	residency.reserve(m_Loaders.size());
+
+	for (const BaseLoader* pLoader : m_Loaders)
+	{
+		residency.push_back({ pLoader->GetType().name(), pLoader->GetResidency() });
+	}
+
+	return residency;
+}
+
+UINT64 ContentManager::GetResidentBytes()
+{
+	UINT64 residentBytes{};
+	for (const BaseLoader* pLoader : m_Loaders)
+	{
+		residentBytes += pLoader->GetResidentBytes();
+	}
+
+	return residentBytes;
+}
+
+void ContentManager::ReleaseReference(BaseLoader* pLoader, size_t pathHash, ContentScope* pScope)
+{
+	if (std::ranges::find(m_Loaders, pLoader) != m_Loaders.end())
+		pLoader->ReleaseReference(pathHash, pScope);
+}
+
+ContentLoadInfo ContentManager::GetLoadInfo(const std::wstring& assetFile, void* pUserData, const std::source_location& location)
+{
+	auto fullPath = GetFullAssetPath(assetFile);
+	ASSERT_IF(!m_Pack.Contains(assetFile) && !fs::exists(fullPath), LogString(L"File not found!\n\nAsset: {}\n\nFull Path: {}", location), assetFile, fullPath.wstring())
+
+	return { std::move(fullPath), assetFile, pUserData };
+}
+
 fs::path ContentManager::GetFullAssetPath(const std::wstring& assetSubPath)
 {
 	if(m_GameContext.contentRoot.empty())
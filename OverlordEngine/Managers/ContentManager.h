@@ -1,9 +1,16 @@
 #pragma once
 #include "Content/ContentLoader.h"
+#include "Content/ContentPack.h"
 
 class ContentManager
 {
 public:
+	struct Residency
+	{
+		std::string typeName{};
+		BaseLoader::ResidencyStats stats{};
+	};
+
 	ContentManager(const ContentManager& other) = delete;
 	ContentManager(ContentManager&& other) noexcept = delete;
 	ContentManager& operator=(const ContentManager& other) = delete;
@@ -13,33 +20,102 @@ public:
 	static void AddLoader(BaseLoader* loader);
 	static fs::path GetFullAssetPath(const std::wstring& subPath);
 
+	//Requests of an asset that is still loading (on any thread) wait for that load instead of loading it again
+	//The asset is referenced by the active ContentScope of the calling thread (pinned without one)
 	template<class T> 
 	static T* Load(const std::wstring& assetFile, void* pUserData = nullptr, const std::source_location& location = std::source_location::current())
 	{
-		const type_info& ti = typeid(T);
-		for(BaseLoader* loader:m_Loaders)
-		{
-			const type_info& loadertype = loader->GetType();
-			if(loadertype == ti)
-			{
-				const auto fullPath = GetFullAssetPath(assetFile);
-				ASSERT_IF(!fs::exists(fullPath), LogString(L"File not found!\n\nAsset: {}\n\nFull Path: {}", location), assetFile, fullPath.wstring())
-
-				return (static_cast<ContentLoader<T>*>(loader))->GetContent({ fullPath, assetFile, pUserData });
-			}
-		}
+		ContentLoader<T>* pLoader{ FindLoader<T>() };
+		return pLoader ? pLoader->GetContent(GetLoadInfo(assetFile, pUserData, location)) : nullptr;
+	}
 
-		return nullptr;
+	//Loads on the JobSystem, ContentHandle::Get returns the asset (pUserData has to outlive the load)
+	template<class T>
+	static ContentHandle<T> LoadAsync(const std::wstring& assetFile, void* pUserData = nullptr, const std::source_location& location = std::source_location::current())
+	{
+		ContentLoader<T>* pLoader{ FindLoader<T>() };
+		return pLoader ? pLoader->GetContentAsync(GetLoadInfo(assetFile, pUserData, location)) : ContentHandle<T>{};
 	}
 
 	static void Release();
 
+	//Memory budgets, 0 == unlimited. Unreferenced content is evicted least recently used first once a budget is exceeded (see Trim)
+	static void SetBudget(UINT64 budgetBytes) { m_BudgetBytes = budgetBytes; } //All types together (GameContext::contentBudgetBytes)
+	template<class T>
+	static void SetBudget(UINT64 budgetBytes)
+	{
+		if (ContentLoader<T>* pLoader{ FindLoader<T>() })
+			pLoader->SetBudget(budgetBytes);
+	}
+
+	//Main thread (SceneManager::Update), per type budgets first, then the global budget across all types
+	static void Trim();
+	static std::vector<Residency> GetResidency();
+	static UINT64 GetResidentBytes();
+	static UINT64 GetBudget() { return m_BudgetBytes; }
+
+	static void ReleaseReference(BaseLoader* pLoader, size_t pathHash, ContentScope* pScope); //ContentScope::Release
+
+	//Content pack (GameContext::contentPack), loaders read packed assets out of it and fall back to the loose files (thread safe)
+	static bool IsPacked(const std::wstring& assetSubPath) { return m_Pack.Contains(assetSubPath); }
+	static bool ReadPacked(const std::wstring& assetSubPath, ContentBlob& blob) { return m_Pack.Read(assetSubPath, blob); }
+	static const ContentPack& GetPack() { return m_Pack; }
+	static fs::path GetPackFile() { return fs::path{ m_GameContext.contentPack }; }
+	//Main thread while nothing loads (the current pack is unmapped), a missing file leaves the loose files only
+	static bool OpenPack(const fs::path& packFile);
+	static void ClosePack() { m_Pack.Close(); }
+
 private:
 	ContentManager() = default;
 	~ContentManager() = default;
 
+	template<class T>
+	static ContentLoader<T>* FindLoader()
+	{
+		const type_info& ti = typeid(T);
+		for (BaseLoader* loader : m_Loaders)
+		{
+			if (loader->GetType() == ti)
+				return static_cast<ContentLoader<T>*>(loader);
+		}
+
+		return nullptr;
+	}
+
+	static ContentLoadInfo GetLoadInfo(const std::wstring& assetFile, void* pUserData, const std::source_location& location);
+
 	static std::vector<BaseLoader*> m_Loaders;
 	static GameContext m_GameContext;
 	static bool m_IsInitialized;
+	static UINT64 m_BudgetBytes;
+	static ContentPack m_Pack;
+};
+
+//Assets a scene requests up front (see GameScene::DeclareContent)
+//Every request is loaded as a separate job by SceneManager::LoadGameSceneAsync, the content cache is shared with ContentManager::Load
+class ContentManifest final
+{
+public:
+	ContentManifest() = default;
+	~ContentManifest() = default;
+	ContentManifest(const ContentManifest& other) = delete;
+	ContentManifest(ContentManifest&& other) noexcept = delete;
+	ContentManifest& operator=(const ContentManifest& other) = delete;
+	ContentManifest& operator=(ContentManifest&& other) noexcept = delete;
+
+	template<class T>
+	void Add(const std::wstring& assetFile)
+	{
+		m_Requests.emplace_back([assetFile]() { ContentManager::Load<T>(assetFile); });
+	}
+
+	//Mesh with its vertex buffers built by the loading job, one layout per effect (see MeshFilterLoader::LoadOptions)
+	void AddMesh(const std::wstring& meshFile, const std::vector<std::wstring>& layoutEffects, bool releaseCpuData = false);
+
+	const std::vector<std::function<void()>>& GetRequests() const { return m_Requests; }
+	void Clear() { m_Requests.clear(); }
+
+private:
+	std::vector<std::function<void()>> m_Requests{};
 };
 
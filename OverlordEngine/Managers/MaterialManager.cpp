@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "MaterialManager.h"
 
+thread_local std::vector<UINT>* MaterialManager::Scope::m_pActive{};
+
 MaterialManager::~MaterialManager()
 {
 	//Delete Model Materials
@@ -40,6 +42,42 @@ BaseMaterial* MaterialManager::GetMaterial(UINT materialId) const
 	return nullptr;
 }
 
+void MaterialManager::DeleteMaterials(std::vector<UINT>& materialIds)
+{
+	for (const UINT materialId : materialIds)
+	{
+		RemoveMaterial(materialId, true);
+	}
+
+	materialIds.clear();
+}
+
+MaterialManager::MemoryStats MaterialManager::GetMemoryStats() const
+{
+	MemoryStats stats{};
+	stats.createMs = m_CreateMs;
+
+	std::unordered_map<ID3DX11Effect*, UINT64> effectBytes{};
+	for (const auto pMaterial : m_Materials)
+	{
+		if (!pMaterial || !pMaterial->GetEffect()) continue;
+
+		auto it = effectBytes.find(pMaterial->GetEffect());
+		if (it == effectBytes.end())
+		{
+			it = effectBytes.emplace(pMaterial->GetEffect(), EffectHelper::GetConstantBufferBytes(pMaterial->GetEffect())).first;
+			stats.effectBytes += it->second;
+		}
+
+		++stats.materials;
+		stats.clonedEffectBytes += it->second;
+		stats.parameterBytes += pMaterial->GetParameterBytes();
+	}
+
+	stats.effects = static_cast<UINT>(effectBytes.size());
+	return stats;
+}
+
 PostProcessingMaterial* MaterialManager::GetMaterial_Post(UINT materialId) const
 {
 	PostProcessingMaterial* pBase{};
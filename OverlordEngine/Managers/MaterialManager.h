@@ -10,6 +10,35 @@ public:
 	MaterialManager& operator=(const MaterialManager& other) = delete;
 	MaterialManager& operator=(MaterialManager&& other) noexcept = delete;
 
+	struct MemoryStats
+	{
+		UINT materials{};
+		UINT effects{}; //Shared effects, one per material type in use
+		UINT64 effectBytes{}; //Constant buffers of the shared effects (EffectHelper::GetConstantBufferBytes)
+		UINT64 clonedEffectBytes{}; //Same with an effect clone per material instance
+		UINT64 parameterBytes{}; //Instance parameter blocks
+		float createMs{}; //Every BaseMaterial creation so far
+	};
+
+	//Materials created on the calling thread while a scope is active are recorded in its list (the materials a scene owns,
+	//see GameScene::RootUninitialize), nullptr == not recorded (materials shared across scenes, kept until shutdown)
+	class Scope final
+	{
+	public:
+		explicit Scope(std::vector<UINT>* pMaterialIds) : m_pPrevious(m_pActive) { m_pActive = pMaterialIds; }
+		~Scope() { m_pActive = m_pPrevious; }
+		Scope(const Scope& other) = delete;
+		Scope(Scope&& other) noexcept = delete;
+		Scope& operator=(const Scope& other) = delete;
+		Scope& operator=(Scope&& other) noexcept = delete;
+
+	private:
+		friend MaterialManager;
+		std::vector<UINT>* m_pPrevious{};
+
+		static thread_local std::vector<UINT>* m_pActive;
+	};
+
 	template<typename T>
 	std::enable_if<std::is_base_of_v<BaseMaterial, T>, T>::type*
 	CreateMaterial();
@@ -31,6 +60,10 @@ public:
 	void RemoveMaterial(UINT materialId, bool deleteObj = false);
 	void RemoveMaterial(BaseMaterial* pMaterial, bool deleteObj = false);
 	void RemoveMaterial(PostProcessingMaterial* pMaterial, bool deleteObj = false);
+	void DeleteMaterials(std::vector<UINT>& materialIds); //Deletes the materials of a scope & clears the list
+
+	//Walks the materials (BaseMaterial only)
+	MemoryStats GetMemoryStats() const;
 
 protected:
 	void Initialize() override {};
@@ -51,12 +84,14 @@ private:
 
 	std::vector<BaseMaterial*> m_Materials{};
 	std::vector<PostProcessingMaterial*> m_MaterialsPP{};
+	float m_CreateMs{};
 };
 
 template <typename T>
 std::enable_if<std::is_base_of_v<BaseMaterial, T>, T>::type*
 MaterialManager::CreateMaterial()
 {
+	const auto start = std::chrono::steady_clock::now();
 	auto pMaterial = new T();
 
 	UINT newMaterialId{ UINT_MAX};
@@ -76,9 +111,13 @@ MaterialManager::CreateMaterial()
 	}
 	else m_Materials[newMaterialId] = pMaterial;
 
+	if (Scope::m_pActive)
+		Scope::m_pActive->push_back(newMaterialId);
+
 	pMaterial->SetMaterialName(StringUtil::utf8_decode(typeid(T).name()));
 	pMaterial->Initialize(m_GameContext.d3dContext, newMaterialId);
 
+	m_CreateMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 	return pMaterial;
 }
 
@@ -105,6 +144,9 @@ MaterialManager::CreateMaterial()
 	}
 	else m_MaterialsPP[newMaterialId] = pMaterial;
 
+	if (Scope::m_pActive)
+		Scope::m_pActive->push_back(ToPPID(newMaterialId));
+
 	pMaterial->InitializeBase(m_GameContext, ToPPID(newMaterialId)); //Todo: Fix Virtual Overload Initialize
 
 	return pMaterial;
@@ -142,6 +142,7 @@ PxScene* PhysXManager::CreateScene(GameScene* pScene)
 	sceneDesc.cudaContextManager = m_pCudaContextManager;
 	sceneDesc.filterShader = OverlordSimulationFilterShader;
 	sceneDesc.userData = pScene;
+	sceneDesc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS; //Render interpolation (PhysxProxy::CaptureActivePoses)
 	// sceneDesc.contactModifyCallback = &gWheelContactModifyCallback;
 	// sceneDesc.ccdContactModifyCallback = &gWheelCCDContactModifyCallback;
 	// sceneDesc.flags |= PxSceneFlag::eENABLE_CCD;
@@ -1,18 +1,40 @@
 #include "stdafx.h"
 #include "SceneManager.h"
 #include <algorithm>
+#include <psapi.h>
+
+namespace
+{
+	long long GetPrivateBytes()
+	{
+		PROCESS_MEMORY_COUNTERS_EX counters{};
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+			return 0;
+
+		return static_cast<long long>(counters.PrivateUsage);
+	}
+}
 
 
 void SceneManager::Initialize()
 {
+	//Other scenes are initialized on their first activation
 	for (GameScene* pScene : m_pScenes)
 	{
-		pScene->RootInitialize(m_GameContext);
+		if (pScene->m_Residency == SceneResidency::Preload)
+			InitializeScene(pScene);
 	}
 } 
 
 SceneManager::~SceneManager()
 {
+	//Content jobs are finished by now (the JobSystem is destroyed first)
+	SafeDelete(m_pLoadingScene);
+	for (auto& pendingLoad : m_PendingLoads)
+	{
+		SafeDelete(pendingLoad.first);
+	}
+
 	for (GameScene* scene : m_pScenes)
 	{
 		SafeDelete(scene);
@@ -27,8 +49,9 @@ void SceneManager::AddGameScene(GameScene* pScene)
 	{
 		m_pScenes.push_back(pScene);
 
-		if (m_IsInitialized) {
-			pScene->RootInitialize(m_GameContext);
+		if (m_IsInitialized && pScene->m_Residency == SceneResidency::Preload)
+		{
+			InitializeScene(pScene);
 			pScene->RootPostInitialize();
 		}
 
@@ -37,6 +60,128 @@ void SceneManager::AddGameScene(GameScene* pScene)
 	}
 }
 
+void SceneManager::LoadGameSceneAsync(GameScene* pScene, bool activateWhenLoaded)
+{
+	if (pScene == m_pLoadingScene || std::ranges::find(m_pScenes, pScene) != m_pScenes.end())
+	{
+		Logger::LogWarning(L"SceneManager::LoadGameSceneAsync > Scene is already added or loading");
+		return;
+	}
+
+	m_PendingLoads.emplace_back(pScene, activateWhenLoaded);
+	if (!m_pLoadingScene)
+		BeginLoading();
+}
+
+float SceneManager::GetLoadProgress() const
+{
+	if (!m_pLoadingScene)
+		return 0.f;
+
+	if (m_LoadStage == LoadStage::Content)
+	{
+		const size_t requestCount{ m_LoadManifest.GetRequests().size() };
+		const float contentProgress{ requestCount > 0 ? static_cast<float>(m_LoadedRequests.load()) / static_cast<float>(requestCount) : 1.f };
+		return contentProgress * m_ContentProgressWeight;
+	}
+
+	return m_ContentProgressWeight + m_pLoadingScene->GetInitializeProgress() * (1.f - m_ContentProgressWeight);
+}
+
+void SceneManager::BeginLoading()
+{
+	if (m_PendingLoads.empty())
+		return;
+
+	std::tie(m_pLoadingScene, m_ActivateWhenLoaded) = m_PendingLoads.front();
+	m_PendingLoads.pop_front();
+
+	m_LoadStage = LoadStage::Content;
+	m_LoadedRequests = 0;
+	m_LoadStartBytes = GetPrivateBytes();
+	m_pLoadingScene->m_SceneStats.initializeMs = 0.f;
+	m_LoadManifest.Clear();
+	m_pLoadingScene->DeclareContent(m_LoadManifest);
+	m_LoadStart = std::chrono::steady_clock::now();
+
+	//The requests are referenced by the scene
+	JobSystem* pJobSystem{ m_GameContext.pJobSystem };
+	ContentScope* pContentScope{ &m_pLoadingScene->m_ContentScope };
+	if (m_GameContext.serialContentLoading)
+	{
+		pJobSystem->Run([this, pContentScope]()
+		{
+			ContentScope::Active contentScope{ pContentScope };
+			for (const auto& request : m_LoadManifest.GetRequests())
+			{
+				request();
+				m_LoadedRequests.fetch_add(1);
+			}
+		}, &m_LoadCounter);
+		return;
+	}
+
+	for (const auto& request : m_LoadManifest.GetRequests())
+	{
+		pJobSystem->Run([this, &request, pContentScope]()
+		{
+			ContentScope::Active contentScope{ pContentScope };
+			request();
+			m_LoadedRequests.fetch_add(1);
+		}, &m_LoadCounter);
+	}
+}
+
+void SceneManager::UpdateLoading()
+{
+	if (!m_pLoadingScene)
+		return;
+
+	if (m_LoadStage == LoadStage::Content && !m_LoadCounter.IsDone())
+		return;
+
+	//Main thread time only (content is loaded on the workers)
+	SceneStats& stats{ m_pLoadingScene->m_SceneStats };
+	const auto start = std::chrono::steady_clock::now();
+
+	bool isDone{};
+	if (m_LoadStage == LoadStage::Content)
+	{
+		//Measured up to the frame that notices, accurate to a frame
+		const std::chrono::duration<float, std::milli> contentDuration = start - m_LoadStart;
+		stats.contentMs = contentDuration.count();
+		Logger::LogInfo(L"SceneManager > Content of \"{}\" loaded in {:.1f} ms ({} requests, {})", m_pLoadingScene->m_SceneName, stats.contentMs,
+			m_LoadManifest.GetRequests().size(), m_GameContext.serialContentLoading ? L"serial" : L"parallel");
+
+		//User Initialize can't be split, it gets a frame of its own (content is cached by now)
+		m_pLoadingScene->RootBeginInitialize(m_GameContext);
+		m_LoadStage = LoadStage::Initialize;
+	}
+	else if (m_pLoadingScene->RootContinueInitialize(m_LoadBudgetMs))
+	{
+		m_pLoadingScene->RootPostInitialize();
+		isDone = true;
+	}
+
+	const std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - start;
+	stats.initializeMs += duration.count();
+
+	if (!isDone)
+		return;
+
+	stats.initializeBytes = GetPrivateBytes() - m_LoadStartBytes;
+	++stats.initializeCount;
+	Logger::LogInfo(L"SceneManager > Loaded \"{}\" in the background ({:.1f} ms main thread, {:.1f} MB)", m_pLoadingScene->m_SceneName, stats.initializeMs, static_cast<float>(stats.initializeBytes) / (1024.f * 1024.f));
+
+	//Only fully initialized scenes are visible to the manager, the swap itself happens at the start of the next Update
+	m_pScenes.push_back(m_pLoadingScene);
+	if (m_ActivateWhenLoaded || (m_ActiveScene == nullptr && m_NewActiveScene == nullptr))
+		m_NewActiveScene = m_pLoadingScene;
+
+	m_pLoadingScene = nullptr;
+	BeginLoading();
+}
+
 void SceneManager::RemoveGameScene(GameScene* pScene, bool deleteObject)
 {
 	const auto it = std::ranges::find(m_pScenes, pScene);
@@ -104,22 +249,62 @@ void SceneManager::PostInitialize() const
 {
 	for (GameScene* pScene : m_pScenes)
 	{
-		pScene->RootPostInitialize();
+		if (pScene->m_IsInitialized)
+			pScene->RootPostInitialize();
 	}
 }
 
+void SceneManager::InitializeScene(GameScene* pScene)
+{
+	const long long startBytes{ GetPrivateBytes() };
+	const auto start = std::chrono::steady_clock::now();
+
+	pScene->RootInitialize(m_GameContext);
+
+	const std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - start;
+	SceneStats& stats{ pScene->m_SceneStats };
+	stats.initializeMs = duration.count();
+	stats.initializeBytes = GetPrivateBytes() - startBytes;
+	++stats.initializeCount;
+
+	Logger::LogInfo(L"SceneManager > Initialized \"{}\" in {:.1f} ms ({:.1f} MB)", pScene->m_SceneName, stats.initializeMs, static_cast<float>(stats.initializeBytes) / (1024.f * 1024.f));
+}
+
+void SceneManager::UnloadScene(GameScene* pScene)
+{
+	const long long startBytes{ GetPrivateBytes() };
+
+	pScene->RootUninitialize();
+	++pScene->m_SceneStats.unloadCount;
+
+	Logger::LogInfo(L"SceneManager > Unloaded \"{}\" ({:.1f} MB released)", pScene->m_SceneName, static_cast<float>(startBytes - GetPrivateBytes()) / (1024.f * 1024.f));
+}
+
 void SceneManager::Update()
 {
+	UpdateLoading();
+	ContentManager::Trim(); //Content released by unloaded scenes, over budget only
+
 	if (m_NewActiveScene != nullptr)
 	{
 		if (m_NewActiveScene != m_ActiveScene)
 		{
 			//Deactivate the current active scene
 			if (m_ActiveScene != nullptr)
+			{
 				m_ActiveScene->RootOnSceneDeactivated();
 
-			//Set New Scene
+				if (m_ActiveScene->m_Residency == SceneResidency::Unload)
+					UnloadScene(m_ActiveScene);
+			}
+
+			//Set New Scene (lazy initialization on first activation)
 			m_ActiveScene = m_NewActiveScene;
+			if (!m_ActiveScene->m_IsInitialized)
+			{
+				InitializeScene(m_ActiveScene);
+				m_ActiveScene->RootPostInitialize();
+			}
 
 			//Active the new scene and reset SceneTimer
 			m_ActiveScene->RootOnSceneActivated();
@@ -136,7 +321,7 @@ void SceneManager::Update()
 		return;
 	}
 
-	ASSERT_IF(m_ActiveScene == nullptr, L"No Active Scene Set!")
+	ASSERT_IF(m_ActiveScene == nullptr && !IsLoading(), L"No Active Scene Set!")
 }
 
 void SceneManager::Draw() const
@@ -12,7 +12,15 @@ public:
 	void SetActiveGameScene(const std::wstring& sceneName);
 	void NextScene();
 	void PreviousScene();
+
+	//Background loading: content requests run on the JobSystem, scene initialization is time-sliced on the main thread
+	//The scene is added (and activated) only once it is fully initialized, loads are queued
+	void LoadGameSceneAsync(GameScene* pScene, bool activateWhenLoaded = true);
+	bool IsLoading() const { return m_pLoadingScene != nullptr; }
+	float GetLoadProgress() const; //[0,1] of the scene that is currently loading
+	void SetLoadBudget(float budgetMs) { m_LoadBudgetMs = budgetMs; } //Main thread time per frame spent on initialization
 	GameScene* GetActiveScene() const { return m_ActiveScene; }
+	const std::vector<GameScene*>& GetScenes() const { return m_pScenes; }
 	const SceneContext& GetActiveSceneContext() const { return m_ActiveScene->GetSceneContext(); }
 	SceneSettings& GetActiveSceneSettings() const { return m_ActiveScene->GetSceneSettings(); }
 
@@ -28,10 +36,37 @@ private:
 	void PostInitialize() const;
 	void WindowStateChanged(int state, bool active) const;
 	void Update();
+	//Synchronous initialize/release according to the scene's SceneResidency (measured in its SceneStats)
+	void InitializeScene(GameScene* pScene);
+	void UnloadScene(GameScene* pScene);
+	void UpdateLoading();
+	void BeginLoading();
 	void Draw() const;
 	void OnGUI() const;
 
 	std::vector<GameScene*> m_pScenes{};
 	GameScene* m_ActiveScene{}, * m_NewActiveScene{};
+
+#pragma region Loading
+	enum class LoadStage
+	{
+		Content,
+		Initialize
+	};
+
+	//Share of the progress bar taken by the content requests (the rest is initialization)
+	static constexpr float m_ContentProgressWeight{ 0.7f };
+
+	std::deque<std::pair<GameScene*, bool>> m_PendingLoads{};
+	GameScene* m_pLoadingScene{};
+	bool m_ActivateWhenLoaded{};
+	LoadStage m_LoadStage{};
+	ContentManifest m_LoadManifest{};
+	JobSystem::Counter m_LoadCounter{};
+	std::atomic<UINT> m_LoadedRequests{};
+	std::chrono::steady_clock::time_point m_LoadStart{};
+	long long m_LoadStartBytes{};
+	float m_LoadBudgetMs{ 4.f };
+#pragma endregion
 };
 
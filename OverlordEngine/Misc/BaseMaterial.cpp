@@ -6,7 +6,8 @@ std::map<std::string, BaseMaterial::eRootVariable> BaseMaterial::m_RootVariableS
 		{"world", eRootVariable::WORLD},
 		{"view", eRootVariable::VIEW},
 		{"viewinverse", eRootVariable::VIEW_INVERSE},
-		{"worldviewprojection", eRootVariable::WORLD_VIEW_PROJECTION}
+		{"worldviewprojection", eRootVariable::WORLD_VIEW_PROJECTION},
+		{"viewprojection", eRootVariable::VIEW_PROJECTION}
 };
 
 BaseMaterial::~BaseMaterial()
@@ -14,21 +15,31 @@ BaseMaterial::~BaseMaterial()
 	SafeRelease(m_pEffect);
 }
 
-void BaseMaterial::_baseInitialize(ID3DX11Effect* pRootEffect, UINT materialId)
+void BaseMaterial::_baseInitialize(ID3DX11Effect* pSharedEffect, UINT materialId)
 {
 	if (m_IsInitialized) return;
 
 	m_MaterialId = materialId;
-	pRootEffect->CloneEffect(0, &m_pEffect);
 
-	//Update Technique Pointers
+	//Shared by the instances of the material type (techniques already point into it)
+	m_pEffect = pSharedEffect;
+	m_pEffect->AddRef();
+
 	const auto& techniqueCtxs = GetTechniques();
-	for(UINT techIndex{0}; techIndex < m_numTechniques; ++techIndex)
+
+	//Instanced variant of the default technique (see RenderQueue), only usable with the same vertex buffer layout
+	const auto instancedHash = std::hash<std::wstring>{}(L"Instanced");
+	if (techniqueCtxs.contains(instancedHash))
 	{
-		auto it = techniqueCtxs.begin();
-		std::advance(it, techIndex);
-		auto& ctx = const_cast<MaterialTechniqueContext&>(it->second);
-		ctx.pTechnique = m_pEffect->GetTechniqueByIndex(techIndex);
+		const auto& defaultCtx = techniqueCtxs.at(GetTechniqueHash(0));
+		m_InstancedTechniqueContext = techniqueCtxs.at(instancedHash);
+		m_InstancedTechniqueContext.pTechnique = m_pEffect->GetTechniqueByName("Instanced");
+		m_HasInstancedTechnique = m_InstancedTechniqueContext.inputLayoutID == defaultCtx.inputLayoutID && m_InstancedTechniqueContext.inputLayoutSize == defaultCtx.inputLayoutSize;
+
+		if (!m_HasInstancedTechnique)
+			Logger::LogWarning(L"Instanced technique of '{}' does not match the vertex layout of its default technique, instancing disabled", GetEffectName());
+		else
+			m_BonePaletteVariable = MaterialVariable<ID3D11ShaderResourceView*>{ m_pEffect->GetVariableByName("gBonePalette") };
 	}
 
 	//Retrieve Root Variables
@@ -50,41 +61,158 @@ void BaseMaterial::UpdateEffectVariables(const SceneContext& sceneContext, const
 
 	if (m_IsInitialized)
 	{
-		m_LastUpdateFrame = sceneContext.frameNumber;
-		m_LastUpdateID = pModelComponent->GetComponentId();
+		MakeCurrent();
 
-		//Update Root Variables
-		auto world = XMLoadFloat4x4(&pModelComponent->GetTransform()->GetWorld());
-		auto view = XMLoadFloat4x4(&sceneContext.pCamera->GetView());
+		auto& sharedState = GetSharedState();
+		sharedState.lastUpdateFrame = sceneContext.frameNumber;
+		sharedState.lastUpdateID = pModelComponent->GetComponentId();
 
-		if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD)])
-			m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&world));
+		const XMFLOAT4X4 world{ pModelComponent->GetTransform()->GetRenderWorld() };
+		m_pDrawWorld = &world;
+		UpdateRootVariables(sceneContext, world);
+		OnUpdateModelVariables(sceneContext, pModelComponent);
+		m_pDrawWorld = nullptr;
+	}
+}
 
-		if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW)])
-			m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&view));
+void BaseMaterial::UpdateEffectVariables(const SceneContext& sceneContext, const XMFLOAT4X4& world, const ModelComponent* pModelComponent)
+{
+	if (!m_IsInitialized) return;
 
-		if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD_VIEW_PROJECTION)])
-		{
-			const auto projection = XMLoadFloat4x4(&sceneContext.pCamera->GetProjection());
-			auto wvp = world * view * projection;
-			m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD_VIEW_PROJECTION)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&wvp));
-		}
+	MakeCurrent();
+
+	//The next model draw has to upload its own world again
+	auto& sharedState = GetSharedState();
+	sharedState.lastUpdateFrame = 0;
+	sharedState.lastUpdateID = 0;
+
+	m_pDrawWorld = &world;
+	UpdateRootVariables(sceneContext, world);
+	OnUpdateModelVariables(sceneContext, pModelComponent);
+	m_pDrawWorld = nullptr;
+}
+
+void BaseMaterial::UpdateRootVariables(const SceneContext& sceneContext, const XMFLOAT4X4& worldMatrix) const
+{
+	auto world = XMLoadFloat4x4(&worldMatrix);
+	auto view = XMLoadFloat4x4(&sceneContext.pCamera->GetView());
+
+	if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD)])
+		m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&world));
+
+	if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW)])
+		m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&view));
+
+	if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD_VIEW_PROJECTION)])
+	{
+		const auto projection = XMLoadFloat4x4(&sceneContext.pCamera->GetProjection());
+		auto wvp = world * view * projection;
+		m_RootVariableLUT[static_cast<UINT>(eRootVariable::WORLD_VIEW_PROJECTION)]->AsMatrix()->SetMatrix(reinterpret_cast<float*>(&wvp));
+	}
+
+	if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_PROJECTION)])
+		m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_PROJECTION)]->AsMatrix()->SetMatrix(&sceneContext.pCamera->GetViewProjection()._11);
+
+	if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_INVERSE)])
+	{
+		auto& viewInv = sceneContext.pCamera->GetViewInverse();
+		m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_INVERSE)]->AsMatrix()->SetMatrix(&viewInv._11);
+	}
+}
+
+bool BaseMaterial::NeedsUpdate(UINT frame, UINT id) const
+{
+	//Another instance of the type may have drawn (and uploaded its model) in between
+	const auto& sharedState = GetSharedState();
+	if (sharedState.pCurrent != this) return true;
 
-		if (m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_INVERSE)])
+	if (sharedState.lastUpdateFrame == 0 && sharedState.lastUpdateID == 0) return true;
+	return sharedState.lastUpdateFrame != frame || sharedState.lastUpdateID != id;
+}
+
+void BaseMaterial::MakeCurrent() const
+{
+	auto& sharedState = GetSharedState();
+	if (sharedState.pCurrent == this) return;
+
+	sharedState.pCurrent = this;
+	sharedState.lastUpdateFrame = 0;
+	sharedState.lastUpdateID = 0;
+	++GameStats::GetFrameStats().materialSwitches;
+
+	//Every variable an instance of the type changed, this instance's value or the effect default
+	for (const auto& slot : sharedState.defaults.slots)
+	{
+		if (const auto pSlot = m_Parameters.Find(slot.pVariable))
+			m_Parameters.Apply(*pSlot);
+		else
+			sharedState.defaults.Apply(slot);
+	}
+}
+
+#pragma region ParameterBlock
+const BaseMaterial::ParameterBlock::Slot* BaseMaterial::ParameterBlock::Find(const ID3DX11EffectVariable* pVariable) const
+{
+	for (const auto& slot : slots)
+	{
+		if (slot.pVariable == pVariable) return &slot;
+	}
+
+	return nullptr;
+}
+
+void BaseMaterial::ParameterBlock::Capture(ID3DX11EffectVariable* pVariable)
+{
+	auto pSlot = const_cast<Slot*>(Find(pVariable));
+	if (!pSlot)
+	{
+		pSlot = &slots.emplace_back(Slot{ pVariable, nullptr, 0, 0, pVariable->AsShaderResource()->IsValid() });
+		if (!pSlot->isResource)
 		{
-			auto& viewInv = sceneContext.pCamera->GetViewInverse();
-			m_RootVariableLUT[static_cast<UINT>(eRootVariable::VIEW_INVERSE)]->AsMatrix()->SetMatrix(&viewInv._11);
+			D3DX11_EFFECT_TYPE_DESC typeDesc{};
+			pVariable->GetType()->GetDesc(&typeDesc);
+
+			pSlot->dataOffset = static_cast<UINT>(data.size());
+			pSlot->byteCount = typeDesc.UnpackedSize;
+			data.resize(data.size() + typeDesc.UnpackedSize);
 		}
+	}
 
-		OnUpdateModelVariables(sceneContext, pModelComponent);
+	if (pSlot->isResource)
+	{
+		//Referenced (GetResource adds one), the content manager can evict a texture the material still binds (see ContentManager::Trim)
+		ID3D11ShaderResourceView* pSRV{};
+		pVariable->AsShaderResource()->GetResource(&pSRV);
+		SafeRelease(pSlot->pSRV);
+		pSlot->pSRV = pSRV;
+		return;
 	}
+
+	HANDLE_ERROR(pVariable->GetRawValue(data.data() + pSlot->dataOffset, 0, pSlot->byteCount));
 }
 
-bool BaseMaterial::NeedsUpdate(UINT frame, UINT id) const
+void BaseMaterial::ParameterBlock::Clear()
 {
-	if (m_LastUpdateFrame == 0 && m_LastUpdateID == 0) return true;
-	return m_LastUpdateFrame != frame || m_LastUpdateID != id;
+	for (Slot& slot : slots)
+	{
+		SafeRelease(slot.pSRV);
+	}
+
+	slots.clear();
+	data.clear();
+}
+
+void BaseMaterial::ParameterBlock::Apply(const Slot& slot) const
+{
+	if (slot.isResource)
+	{
+		HANDLE_ERROR(slot.pVariable->AsShaderResource()->SetResource(slot.pSRV));
+		return;
+	}
+
+	HANDLE_ERROR(slot.pVariable->SetRawValue(data.data() + slot.dataOffset, 0, slot.byteCount));
 }
+#pragma endregion
 
 ID3DX11EffectVariable* BaseMaterial::GetVariable(const std::wstring& varName) const
 {
@@ -99,7 +227,7 @@ void BaseMaterial::SetVariable(const std::wstring& varName, const void* pData, u
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->SetRawValue(pData, byteOffset, byteCount));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->SetRawValue(pData, byteOffset, byteCount); });
 		return;
 	}
 
@@ -110,7 +238,7 @@ void BaseMaterial::SetVariable_Scalar(const std::wstring& varName, float scalar)
 {
 	if(const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsScalar()->SetFloat(scalar));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsScalar()->SetFloat(scalar); });
 		return;
 	}
 
@@ -121,7 +249,7 @@ void BaseMaterial::SetVariable_Scalar(const std::wstring& varName, bool scalar)
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsScalar()->SetBool(scalar));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsScalar()->SetBool(scalar); });
 		return;
 	}
 
@@ -131,7 +259,7 @@ void BaseMaterial::SetVariable_Scalar(const std::wstring& varName, int scalar) c
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsScalar()->SetInt(scalar));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsScalar()->SetInt(scalar); });
 		return;
 	}
 
@@ -147,7 +275,7 @@ void BaseMaterial::SetVariable_Matrix(const std::wstring& varName, const float*
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsMatrix()->SetMatrix(pData));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsMatrix()->SetMatrix(pData); });
 		return;
 	}
 
@@ -158,7 +286,7 @@ void BaseMaterial::SetVariable_MatrixArray(const std::wstring& varName, const fl
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsMatrix()->SetMatrixArray(pData, 0, count));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsMatrix()->SetMatrixArray(pData, 0, count); });
 		return;
 	}
 
@@ -179,7 +307,7 @@ void BaseMaterial::SetVariable_Vector(const std::wstring& varName, const float*
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsVector()->SetFloatVector(pData));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsVector()->SetFloatVector(pData); });
 		return;
 	}
 
@@ -190,7 +318,7 @@ void BaseMaterial::SetVariable_VectorArray(const std::wstring& varName, const fl
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsVector()->SetFloatVectorArray(pData, 0, count));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsVector()->SetFloatVectorArray(pData, 0, count); });
 		return;
 	}
 
@@ -201,7 +329,7 @@ void BaseMaterial::SetVariable_Texture(const std::wstring& varName, ID3D11Shader
 {
 	if (const auto pShaderVariable = GetVariable(varName))
 	{
-		HANDLE_ERROR(pShaderVariable->AsShaderResource()->SetResource(pSRV));
+		WriteParameter(pShaderVariable, [&] { return pShaderVariable->AsShaderResource()->SetResource(pSRV); });
 		return;
 	}
 
@@ -231,11 +359,9 @@ void BaseMaterial::SetTechnique(const std::wstring& techName)
 void BaseMaterial::SetTechnique(int index)
 {
 	auto& techniques = GetTechniques();
-	if(techniques.size() > index)
+	if(index >= 0 && techniques.size() > static_cast<size_t>(index))
 	{
-		auto it = techniques.begin();
-		std::advance(it, index);
-		m_TechniqueContext = it->second;
+		m_TechniqueContext = techniques.at(GetTechniqueHash(index));
 		m_TechniqueContext.pTechnique = m_pEffect->GetTechniqueByIndex(index);
 		return;
 	}
@@ -246,12 +372,26 @@ void BaseMaterial::SetTechnique(int index)
 const MaterialTechniqueContext& BaseMaterial::GetTechniqueContext(int index) const
 {
 	auto& techniques = GetTechniques();
-	ASSERT_IF_(techniques.size() <= index);
+	ASSERT_IF_(index < 0 || techniques.size() <= static_cast<size_t>(index));
+
+	return techniques.at(GetTechniqueHash(index));
+}
+
+const MaterialTechniqueContext* BaseMaterial::GetInstancedTechniqueContext() const
+{
+	//Only while the default technique is active, the instanced one replaces it
+	if (!m_HasInstancedTechnique || m_TechniqueContext.pTechnique != m_pEffect->GetTechniqueByIndex(0))
+		return nullptr;
 
-	auto it = techniques.begin();
-	std::advance(it, index);
+	return &m_InstancedTechniqueContext;
+}
 
-	return it->second;
+size_t BaseMaterial::GetTechniqueHash(UINT index) const
+{
+	//Indices follow the effect's technique order, the contexts are stored by name
+	D3DX11_TECHNIQUE_DESC techDesc{};
+	m_pEffect->GetTechniqueByIndex(index)->GetDesc(&techDesc);
+	return std::hash<std::wstring>{}(StringUtil::utf8_decode(techDesc.Name));
 }
 
 void BaseMaterial::DrawImGui()
@@ -264,6 +404,9 @@ void BaseMaterial::DrawImGui()
 
 	if (ImGui::Begin(title.c_str(), &m_DrawImGui))
 	{
+		//Show (and edit) this instance's values
+		MakeCurrent();
+
 		D3DX11_EFFECT_DESC effectDesc{};
 		m_pEffect->GetDesc(&effectDesc);
 
@@ -287,7 +430,7 @@ void BaseMaterial::DrawImGui()
 				pVariable->AsScalar()->GetBool(&value);
 				if (ImGui::Checkbox(variableDesc.Name, &value))
 				{
-					pVariable->AsScalar()->SetBool(value);
+					WriteParameter(pVariable, [&] { return pVariable->AsScalar()->SetBool(value); });
 				}
 			}
 			break;
@@ -297,7 +440,7 @@ void BaseMaterial::DrawImGui()
 				pVariable->AsScalar()->GetInt(&value);
 				if (ImGui::DragInt(variableDesc.Name, &value, 0.1f))
 				{
-					pVariable->AsScalar()->SetInt(value);
+					WriteParameter(pVariable, [&] { return pVariable->AsScalar()->SetInt(value); });
 				}
 			}
 			break;
@@ -308,7 +451,7 @@ void BaseMaterial::DrawImGui()
 					float value{};
 					pVariable->AsScalar()->GetFloat(&value);
 					if (ImGui::DragFloat(variableDesc.Name, &value, 0.1f))
-						pVariable->AsScalar()->SetFloat(value);
+						WriteParameter(pVariable, [&] { return pVariable->AsScalar()->SetFloat(value); });
 				}
 				else if (effectTypeDesc.Class == D3D_SVC_VECTOR)
 				{
@@ -322,7 +465,7 @@ void BaseMaterial::DrawImGui()
 					case 4: changed = isColor ? ImGui::ColorEdit4(variableDesc.Name, &value[0], ImGuiColorEditFlags_NoInputs) : ImGui::DragFloat3(variableDesc.Name, &value[0], 0.1f); break;
 					}
 
-					if (changed) pVariable->AsVector()->SetFloatVector(&value[0]);
+					if (changed) WriteParameter(pVariable, [&] { return pVariable->AsVector()->SetFloatVector(&value[0]); });
 				}
 			}
 			break;
@@ -354,7 +497,7 @@ void BaseMaterial::DrawImGui()
 					if (fs::exists(ContentManager::GetFullAssetPath(filepath)))
 					{
 						const auto pTextureData = ContentManager::Load<TextureData>(filepath);
-						pVariable->AsShaderResource()->SetResource(pTextureData->GetShaderResourceView());
+						WriteParameter(pVariable, [&] { return pVariable->AsShaderResource()->SetResource(pTextureData->GetShaderResourceView()); });
 					}
 				}
 			}
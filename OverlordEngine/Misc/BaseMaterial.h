@@ -13,13 +13,21 @@ public:
 	virtual void Initialize(const D3D11Context& d3d11Context, UINT materialId) = 0;
 
 	const MaterialTechniqueContext& GetTechniqueContext() const { return m_TechniqueContext; }
-	const MaterialTechniqueContext& GetTechniqueContext(int index) const;
+	const MaterialTechniqueContext& GetTechniqueContext(int index) const; //Index in the effect's technique order
+	//Technique named "Instanced" (per instance world matrix stream, see RenderQueue), nullptr if the effect has none or the default technique isn't active
+	const MaterialTechniqueContext* GetInstancedTechniqueContext() const;
+	//gBonePalette of the instanced technique (skinned instances, see RenderQueue), invalid if the effect has none
+	const MaterialVariable<ID3D11ShaderResourceView*>& GetBonePaletteVariable() const { return m_BonePaletteVariable; }
 
 	UINT GetMaterialId() const { return m_MaterialId; }
 	bool HasValidMaterialId() const { return m_MaterialId != UINT_MAX; }
 	bool IsValid() const { return HasValidMaterialId() && m_IsInitialized; }
 
 	ID3DX11EffectVariable* GetVariable(const std::wstring& varName) const;
+	//Typed handle, resolve once (InitializeEffectVariables or after creation) and keep it, the SetVariable_* name lookups are the slow path
+	//Handle writes go straight to the shared effect (not kept per instance), use them for values set before every draw
+	template<typename T>
+	MaterialVariable<T> GetVariableHandle(const std::wstring& varName) const;
 
 	void SetVariable(const std::wstring& varName, const void* pData, uint32_t byteOffset, uint32_t byteCount) const;
 	void SetVariable_Scalar(const std::wstring& varName, float scalar) const;
@@ -42,10 +50,17 @@ public:
 	void SetMaterialName(const std::wstring& name) { m_MaterialName = name; m_MaterialNameUtf8 = StringUtil::utf8_encode(name); }
 
 	void UpdateEffectVariables(const SceneContext& sceneContext, const ModelComponent* pModelComponent);
+	//Geometry that isn't drawn with the model's own transform (StaticBatcher, pre-transformed), always uploaded
+	void UpdateEffectVariables(const SceneContext& sceneContext, const XMFLOAT4X4& world, const ModelComponent* pModelComponent);
 	void UpdateEffectVariables(const SceneContext& sceneContext, const RenderTarget* pSourceTarget);
 
 	void DrawImGui();
 
+	//Effect shared by every instance of the material type (Material<T>)
+	ID3DX11Effect* GetEffect() const { return m_pEffect; }
+	//Values this instance set through SetVariable_* (re-applied when it takes over the shared effect)
+	UINT64 GetParameterBytes() const { return m_Parameters.GetBytes(); }
+
 protected:
 #pragma region BaseVariables (preset variable by semantic)
 	enum class eRootVariable
@@ -54,6 +69,7 @@ protected:
 		VIEW,
 		VIEW_INVERSE,
 		WORLD_VIEW_PROJECTION,
+		VIEW_PROJECTION,
 
 		COUNT //@End
 	};
@@ -62,18 +78,65 @@ protected:
 	ID3DX11EffectVariable* m_RootVariableLUT[static_cast<UINT>(eRootVariable::COUNT)]{};
 #pragma endregion
 
+#pragma region SharedEffect
+	//Effect variable values, raw as in the constant buffer (resources referenced, see Capture)
+	struct ParameterBlock
+	{
+		ParameterBlock() = default;
+		~ParameterBlock() { Clear(); }
+		ParameterBlock(const ParameterBlock& other) = delete;
+		ParameterBlock(ParameterBlock&& other) noexcept = delete;
+		ParameterBlock& operator=(const ParameterBlock& other) = delete;
+		ParameterBlock& operator=(ParameterBlock&& other) noexcept = delete;
+
+		struct Slot
+		{
+			ID3DX11EffectVariable* pVariable;
+			ID3D11ShaderResourceView* pSRV;
+			UINT dataOffset;
+			UINT byteCount;
+			bool isResource;
+		};
+
+		std::vector<Slot> slots{};
+		std::vector<uint8_t> data{};
+
+		const Slot* Find(const ID3DX11EffectVariable* pVariable) const;
+		void Capture(ID3DX11EffectVariable* pVariable); //Current value of the effect
+		void Apply(const Slot& slot) const;
+		void Clear();
+		UINT64 GetBytes() const { return data.size() + slots.size() * sizeof(Slot); }
+	};
+
+	//One per material type, the instances take turns on the effect
+	struct SharedEffectState
+	{
+		const BaseMaterial* pCurrent{}; //Instance whose parameters are in the effect
+		UINT lastUpdateFrame{};
+		UINT lastUpdateID{};
+		ParameterBlock defaults{}; //Values before the first instance changed them (every variable any instance set)
+	};
+
+	virtual SharedEffectState& GetSharedState() const = 0;
+#pragma endregion
+
 	virtual const std::map<size_t, UINT>& GetVariableIndexLUT() const = 0;
 	virtual int GetRootVariableIndex(eRootVariable rootVariable) const = 0;
 	virtual const std::map<size_t, MaterialTechniqueContext>& GetTechniques() const = 0;
 	virtual const std::wstring& GetEffectName() const = 0;
 
 	//Internal Material Implementation
-	void _baseInitialize(ID3DX11Effect* pRootEffect, UINT materialId);
+	void _baseInitialize(ID3DX11Effect* pSharedEffect, UINT materialId);
 
 	virtual void InitializeEffectVariables() = 0;
 	virtual void OnUpdateModelVariables(const SceneContext& /*sceneContext*/, const ModelComponent* /*pModel*/) const {};
+	//World the geometry is drawn with (identity for pre-transformed StaticBatcher groups), valid in OnUpdateModelVariables
+	const XMFLOAT4X4& GetDrawWorld() const { return *m_pDrawWorld; }
 
 	MaterialTechniqueContext m_TechniqueContext{};
+	MaterialTechniqueContext m_InstancedTechniqueContext{};
+	bool m_HasInstancedTechnique{};
+	MaterialVariable<ID3D11ShaderResourceView*> m_BonePaletteVariable{};
 	UINT m_numTechniques{};
 	std::wstring m_MaterialName;
 	std::string m_MaterialNameUtf8;
@@ -84,8 +147,38 @@ private:
 	bool m_DrawImGui{};
 
 	ID3DX11Effect* m_pEffect{};
+	mutable ParameterBlock m_Parameters{};
+	const XMFLOAT4X4* m_pDrawWorld{};
 
+	size_t GetTechniqueHash(UINT index) const;
+	void UpdateRootVariables(const SceneContext& sceneContext, const XMFLOAT4X4& world) const;
 	bool NeedsUpdate(UINT frame, UINT id) const;
-	UINT m_LastUpdateFrame{};
-	UINT m_LastUpdateID{};
+
+	//Loads this instance's parameters (or the defaults) into the shared effect
+	void MakeCurrent() const;
+	//Shared effect write that is kept in the instance parameters
+	template<typename TSetter>
+	void WriteParameter(ID3DX11EffectVariable* pVariable, TSetter setter) const;
 };
+
+template<typename TSetter>
+void BaseMaterial::WriteParameter(ID3DX11EffectVariable* pVariable, TSetter setter) const
+{
+	MakeCurrent();
+
+	auto& defaults = GetSharedState().defaults;
+	if (!defaults.Find(pVariable)) defaults.Capture(pVariable);
+
+	HANDLE_ERROR(setter());
+	m_Parameters.Capture(pVariable);
+}
+
+template<typename T>
+MaterialVariable<T> BaseMaterial::GetVariableHandle(const std::wstring& varName) const
+{
+	MaterialVariable<T> handle{ GetVariable(varName) };
+	if (!handle.IsValid())
+		Logger::LogWarning(L"Shader variable \'{}\' not found (or type mismatch) for \'{}\'", varName, GetEffectName());
+
+	return handle;
+}
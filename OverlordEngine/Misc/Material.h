@@ -15,15 +15,25 @@ public:
 
 	~Material() override
 	{
+		if (m_SharedState.pCurrent == this)
+			m_SharedState.pCurrent = nullptr;
+
 		--m_References;
 		if(m_References <= 0)
 		{
+			SafeRelease(m_pSharedEffect);
+			m_SharedState.pCurrent = nullptr;
+			m_SharedState.defaults.Clear();
+			m_SharedState.lastUpdateFrame = 0;
+			m_SharedState.lastUpdateID = 0;
+
 			m_VariableIndexLUT.clear();
 
 			for(auto& pair:m_Techniques)
 			{
 				//SafeRelease(pair.second.pTechnique);
 				SafeRelease(pair.second.pInputLayout);
+				SafeRelease(pair.second.pStreamInputLayout);
 				pair.second.inputLayoutID = 0;
 				pair.second.inputLayoutSize = 0;
 				pair.second.pInputLayoutDescriptions.clear();
@@ -44,20 +54,24 @@ public:
 	{
 		if (!m_EffectInstanceLoaded)
 		{
-			//Load Effect
+			//Load Effect (pinned, the shared effect outlives the scene that created the first instance)
+			ContentScope::Active pinned{ nullptr };
 			m_pRootEffect = ContentManager::Load<ID3DX11Effect>(m_EffectFile);
 
+			//One copy for every instance of this type (the root effect is shared with other types loading the same file)
+			HANDLE_ERROR(m_pRootEffect->CloneEffect(0, &m_pSharedEffect));
+
 			//EFFECT VARIABLES
 			//(Load)
 			D3DX11_EFFECT_DESC effectDesc{};
-			m_pRootEffect->GetDesc(&effectDesc);
+			m_pSharedEffect->GetDesc(&effectDesc);
 
 			m_VariableIndexLUT.clear();
 			std::fill_n(m_RootVariableIndexLUT, static_cast<UINT>(eRootVariable::COUNT), -1);
 
 			for (UINT i{ 0 }; i < effectDesc.GlobalVariables; ++i)
 			{
-				const auto pVariable = m_pRootEffect->GetVariableByIndex(i);
+				const auto pVariable = m_pSharedEffect->GetVariableByIndex(i);
 				D3DX11_EFFECT_VARIABLE_DESC variableDesc{};
 				pVariable->GetDesc(&variableDesc);
 
@@ -83,7 +97,7 @@ public:
 
 			for (UINT i{ 0 }; i < m_numTechniques; ++i)
 			{
-				const auto pTechnique = m_pRootEffect->GetTechniqueByIndex(i);
+				const auto pTechnique = m_pSharedEffect->GetTechniqueByIndex(i);
 				D3DX11_TECHNIQUE_DESC techDesc{};
 				pTechnique->GetDesc(&techDesc);
 
@@ -91,7 +105,7 @@ public:
 				MaterialTechniqueContext techCtx{};
 				techCtx.pTechnique = pTechnique;
 
-				EffectHelper::BuildInputLayout(d3d11Context.pDevice, pTechnique, &techCtx.pInputLayout, techCtx.pInputLayoutDescriptions, techCtx.inputLayoutSize, techCtx.inputLayoutID);
+				EffectHelper::BuildInputLayout(d3d11Context.pDevice, pTechnique, &techCtx.pInputLayout, techCtx.pInputLayoutDescriptions, techCtx.inputLayoutSize, techCtx.inputLayoutID, &techCtx.pStreamInputLayout);
 
 				//Add to map
 				auto techniqueHash = std::hash < std::wstring >{}(StringUtil::utf8_decode(techDesc.Name));
@@ -101,7 +115,7 @@ public:
 			m_EffectInstanceLoaded = true;
 		}
 
-		_baseInitialize(m_pRootEffect, materialId);
+		_baseInitialize(m_pSharedEffect, materialId);
 		SetTechnique(0);
 
 		InitializeEffectVariables();
@@ -112,6 +126,7 @@ protected:
 	int GetRootVariableIndex(eRootVariable rootVariable) const override { return m_RootVariableIndexLUT[static_cast<size_t>(rootVariable)]; }
 	const std::map<size_t, MaterialTechniqueContext>& GetTechniques() const override { return m_Techniques; }
 	const std::wstring& GetEffectName() const override { return m_EffectFile; }
+	SharedEffectState& GetSharedState() const override { return m_SharedState; }
 
 private:
 	static int m_References;
@@ -121,6 +136,8 @@ private:
 	static int m_RootVariableIndexLUT[];
 
 	static ID3DX11Effect* m_pRootEffect;
+	static ID3DX11Effect* m_pSharedEffect;
+	static SharedEffectState m_SharedState;
 	static std::wstring m_EffectFile;
 };
 
@@ -128,6 +145,8 @@ template<class T> bool Material<T>::m_EffectInstanceLoaded{};
 template<class T> int Material<T>::m_References{0};
 template<class T> std::wstring Material<T>::m_EffectFile{};
 template<class T> ID3DX11Effect* Material<T>::m_pRootEffect{};
+template<class T> ID3DX11Effect* Material<T>::m_pSharedEffect{};
+template<class T> BaseMaterial::SharedEffectState Material<T>::m_SharedState{};
 template<class T> std::map<size_t, UINT> Material<T>::m_VariableIndexLUT{};
 template<class T> int Material<T>::m_RootVariableIndexLUT[static_cast<UINT>(eRootVariable::COUNT)]{};
 template<class T> std::map<size_t, MaterialTechniqueContext> Material<T>::m_Techniques{};
@@ -0,0 +1,116 @@
+#pragma once
+
+//Typed effect variable of a material (BaseMaterial::GetVariableHandle)
+//Resolved once when the material is created, setting it skips the name hash & LUT lookup of BaseMaterial::SetVariable_*
+//Instances of a material type share one effect, a write isn't kept in the instance parameters (BaseMaterial::MakeCurrent)
+//so handles are meant for values that are set before every draw
+//An invalid handle (variable not found or type mismatch) ignores every Set
+
+#pragma region Traits
+//Raw (structs), written with SetRawValue
+template<typename T>
+struct MaterialVariableTraits
+{
+	using Interface = ID3DX11EffectVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable; }
+	static HRESULT Set(Interface* pVariable, const T& value) { return pVariable->SetRawValue(&value, 0, sizeof(T)); }
+};
+
+template<>
+struct MaterialVariableTraits<XMFLOAT4X4>
+{
+	using Interface = ID3DX11EffectMatrixVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsMatrix(); }
+	static HRESULT Set(Interface* pVariable, const XMFLOAT4X4& value) { return pVariable->SetMatrix(&value._11); }
+	static HRESULT SetArray(Interface* pVariable, const XMFLOAT4X4* pData, UINT count) { return pVariable->SetMatrixArray(&pData->_11, 0, count); }
+};
+
+template<>
+struct MaterialVariableTraits<float>
+{
+	using Interface = ID3DX11EffectScalarVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsScalar(); }
+	static HRESULT Set(Interface* pVariable, float value) { return pVariable->SetFloat(value); }
+	static HRESULT SetArray(Interface* pVariable, const float* pData, UINT count) { return pVariable->SetFloatArray(pData, 0, count); }
+};
+
+template<>
+struct MaterialVariableTraits<int>
+{
+	using Interface = ID3DX11EffectScalarVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsScalar(); }
+	static HRESULT Set(Interface* pVariable, int value) { return pVariable->SetInt(value); }
+	static HRESULT SetArray(Interface* pVariable, const int* pData, UINT count) { return pVariable->SetIntArray(pData, 0, count); }
+};
+
+template<>
+struct MaterialVariableTraits<bool>
+{
+	using Interface = ID3DX11EffectScalarVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsScalar(); }
+	static HRESULT Set(Interface* pVariable, bool value) { return pVariable->SetBool(value); }
+};
+
+//Vectors, the effect reads as many components as the shader variable declares
+template<typename TVector>
+struct MaterialVectorTraits
+{
+	using Interface = ID3DX11EffectVectorVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsVector(); }
+	static HRESULT Set(Interface* pVariable, const TVector& value) { return pVariable->SetFloatVector(&value.x); }
+};
+
+template<> struct MaterialVariableTraits<XMFLOAT2> : MaterialVectorTraits<XMFLOAT2> {};
+template<> struct MaterialVariableTraits<XMFLOAT3> : MaterialVectorTraits<XMFLOAT3> {};
+template<> struct MaterialVariableTraits<XMFLOAT4> : MaterialVectorTraits<XMFLOAT4>
+{
+	static HRESULT SetArray(Interface* pVariable, const XMFLOAT4* pData, UINT count) { return pVariable->SetFloatVectorArray(&pData->x, 0, count); }
+};
+
+template<>
+struct MaterialVariableTraits<ID3D11ShaderResourceView*>
+{
+	using Interface = ID3DX11EffectShaderResourceVariable;
+	static Interface* Get(ID3DX11EffectVariable* pVariable) { return pVariable->AsShaderResource(); }
+	static HRESULT Set(Interface* pVariable, ID3D11ShaderResourceView* pSRV) { return pVariable->SetResource(pSRV); }
+};
+#pragma endregion
+
+template<typename T>
+class MaterialVariable final
+{
+public:
+	using Traits = MaterialVariableTraits<T>;
+
+	MaterialVariable() = default;
+	explicit MaterialVariable(ID3DX11EffectVariable* pVariable)
+	{
+		if (!pVariable) return;
+
+		//The typed interface of a mismatching type is the effect's invalid variable
+		const auto pTyped = Traits::Get(pVariable);
+		if (pTyped->IsValid()) m_pVariable = pTyped;
+	}
+
+	bool IsValid() const { return m_pVariable != nullptr; }
+
+	void Set(const T& value) const
+	{
+		if (m_pVariable) { HANDLE_ERROR(Traits::Set(m_pVariable, value)); }
+	}
+
+	//Matrix, float, int & XMFLOAT4 arrays
+	void SetArray(const T* pData, UINT count) const
+	{
+		if (m_pVariable) { HANDLE_ERROR(Traits::SetArray(m_pVariable, pData, count)); }
+	}
+
+	//Partial write (e.g. a C++ struct with trailing padding the shader struct doesn't have)
+	void SetRaw(const void* pData, UINT byteOffset, UINT byteCount) const
+	{
+		if (m_pVariable) { HANDLE_ERROR(m_pVariable->SetRawValue(pData, byteOffset, byteCount)); }
+	}
+
+private:
+	typename Traits::Interface* m_pVariable{};
+};
@@ -1,9 +1,11 @@
 #include "stdafx.h"
 #include "MeshFilter.h"
-XMFLOAT4 MeshFilter::m_DefaultColor = XMFLOAT4(1, 0, 0, 1);
-XMFLOAT4 MeshFilter::m_DefaultFloat4 = XMFLOAT4(0, 0, 0, 0);
-XMFLOAT3 MeshFilter::m_DefaultFloat3 = XMFLOAT3(0, 0, 0);
-XMFLOAT2 MeshFilter::m_DefaultFloat2 = XMFLOAT2(0, 0);
+std::atomic<UINT> MeshFilter::m_NextMeshId{};
+
+MeshFilter::MeshFilter():
+	m_MeshId(m_NextMeshId.fetch_add(1, std::memory_order_relaxed))
+{
+}
 
 MeshFilter::~MeshFilter()
 {
@@ -14,6 +16,45 @@ MeshFilter::~MeshFilter()
 	m_Meshes.clear();
 }
 
+void MeshFilter::ComputeBounds()
+{
+	XMVECTOR min{ XMVectorReplicate(FLT_MAX) };
+	XMVECTOR max{ XMVectorReplicate(-FLT_MAX) };
+	bool hasPositions{};
+
+	for (auto& subMesh : m_Meshes)
+	{
+		if (subMesh.positions.empty())
+		{
+			subMesh.bounds = BoundingBox{ {}, {} };
+			continue;
+		}
+
+		XMVECTOR subMeshMin{ XMVectorReplicate(FLT_MAX) };
+		XMVECTOR subMeshMax{ XMVectorReplicate(-FLT_MAX) };
+		for (const XMFLOAT3& position : subMesh.positions)
+		{
+			const XMVECTOR point{ XMLoadFloat3(&position) };
+			subMeshMin = XMVectorMin(subMeshMin, point);
+			subMeshMax = XMVectorMax(subMeshMax, point);
+		}
+
+		BoundingBox::CreateFromPoints(subMesh.bounds, subMeshMin, subMeshMax);
+
+		min = XMVectorMin(min, subMeshMin);
+		max = XMVectorMax(max, subMeshMax);
+		hasPositions = true;
+	}
+
+	if (!hasPositions)
+	{
+		m_Bounds = BoundingBox{ {}, {} };
+		return;
+	}
+
+	BoundingBox::CreateFromPoints(m_Bounds, min, max);
+}
+
 void MeshFilter::BuildIndexBuffer(const SceneContext& sceneContext)
 {
 	BuildIndexBuffer(sceneContext.d3dContext);
@@ -24,7 +65,9 @@ void MeshFilter::BuildIndexBuffer(const D3D11Context& d3dContext)
 	for (auto& subMesh : m_Meshes)
 	{
 		if (subMesh.buffers.pIndexBuffer)
-			SafeRelease(subMesh.buffers.pIndexBuffer);
+			continue;
+
+		subMesh.buffers.indexFormat = DXGI_FORMAT_R32_UINT;
 
 		D3D11_BUFFER_DESC bd = {};
 		bd.Usage = D3D11_USAGE_IMMUTABLE;
@@ -54,10 +97,18 @@ int MeshFilter::GetVertexBufferId(UINT inputLayoutId, UINT8 subMeshId) const
 
 void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions)
 {
-	for (auto i{ 0 }; i < m_Meshes.size(); ++i)
+	BuildVertexBuffer(sceneContext.d3dContext, inputLayoutID, inputLayoutSize, inputLayoutDescriptions, sceneContext.pJobSystem);
+}
+
+void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, JobSystem* pJobSystem)
+{
+	std::vector<PendingVertexBuffer> pending{};
+	for (UINT i{}; i < m_Meshes.size(); ++i)
 	{
-		BuildVertexBuffer(sceneContext, inputLayoutID, inputLayoutSize, inputLayoutDescriptions, static_cast<UINT8>(i));
+		AddPendingVertexBuffer(pending, inputLayoutID, inputLayoutSize, inputLayoutDescriptions, static_cast<UINT8>(i));
 	}
+
+	BuildPendingVertexBuffers(d3dContext, pending, pJobSystem);
 }
 
 void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, UINT8 subMeshId)
@@ -67,126 +118,196 @@ void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, UINT inputL
 
 void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, UINT8 subMeshId)
 {
-	ASSERT_IF_(subMeshId >= m_Meshes.size())
+	std::vector<PendingVertexBuffer> pending{};
+	AddPendingVertexBuffer(pending, inputLayoutID, inputLayoutSize, inputLayoutDescriptions, subMeshId);
+	BuildPendingVertexBuffers(d3dContext, pending, nullptr);
+}
 
-		auto& subMesh = m_Meshes[subMeshId];
+void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId)
+{
+	BuildVertexBuffer(sceneContext.d3dContext, pMaterial, subMeshId);
+}
+
+void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId, UINT8 techIndex)
+{
+	auto& techiqueContext = pMaterial->GetTechniqueContext(techIndex);
+	BuildVertexBuffer(sceneContext.d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, subMeshId);
+}
 
-	//Check if VertexBufferInfo already exists with requested InputLayout
+void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, BaseMaterial* pMaterial, UINT8 subMeshId)
+{
+	auto& techiqueContext = pMaterial->GetTechniqueContext();
+	return BuildVertexBuffer(d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, subMeshId);
+}
+
+void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial)
+{
+	auto& techiqueContext = pMaterial->GetTechniqueContext();
+	BuildVertexBuffer(sceneContext.d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, sceneContext.pJobSystem);
+}
+
+void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, BaseMaterial* pMaterial)
+{
+	auto& techiqueContext = pMaterial->GetTechniqueContext();
+	BuildVertexBuffer(d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, nullptr);
+}
+
+void MeshFilter::BuildVertexBuffers(const SceneContext& sceneContext, const std::vector<BaseMaterial*>& subMeshMaterials)
+{
+	ASSERT_IF(subMeshMaterials.size() > m_Meshes.size(), L"More materials ({}) than submeshes ({})", subMeshMaterials.size(), m_Meshes.size())
+
+	std::vector<PendingVertexBuffer> pending{};
+	for (UINT i{}; i < subMeshMaterials.size(); ++i)
+	{
+		if (!subMeshMaterials[i]) continue;
+
+		auto& techniqueContext = subMeshMaterials[i]->GetTechniqueContext();
+		AddPendingVertexBuffer(pending, techniqueContext.inputLayoutID, techniqueContext.inputLayoutSize, techniqueContext.pInputLayoutDescriptions, static_cast<UINT8>(i));
+	}
+
+	BuildPendingVertexBuffers(sceneContext.d3dContext, pending, sceneContext.pJobSystem);
+}
+
+void MeshFilter::AddPendingVertexBuffer(std::vector<PendingVertexBuffer>& pending, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, UINT8 subMeshId) const
+{
+	ASSERT_IF_(subMeshId >= m_Meshes.size())
+
+	//Check if VertexBufferInfo already exists (or is about to) with requested InputLayout
 	if (GetVertexBufferId(inputLayoutID, subMeshId) >= 0)
 		return;
 
-	VertexBufferData data;
-	data.VertexStride = inputLayoutSize;
+	if (std::ranges::any_of(pending, [&](const PendingVertexBuffer& other) { return other.subMeshId == subMeshId && other.data.InputLayoutID == inputLayoutID; }))
+		return;
+
+	const auto& subMesh = m_Meshes[subMeshId];
+
+	PendingVertexBuffer vertexBuffer{};
+	vertexBuffer.subMeshId = subMeshId;
+	vertexBuffer.pInterleaver = &VertexInterleaver::Get(inputLayoutID, inputLayoutSize, inputLayoutDescriptions);
+
+	VertexBufferData& data = vertexBuffer.data;
+	data.VertexStride = vertexBuffer.pInterleaver->GetStride();
+	data.LayoutStride = inputLayoutSize;
 	data.VertexCount = subMesh.vertexCount;
 	data.BufferSize = data.VertexStride * subMesh.vertexCount;
 	data.IndexCount = subMesh.indexCount;
+	data.InputLayoutID = inputLayoutID;
 
-	void* pDataLocation = malloc(data.BufferSize);
-	if (pDataLocation == nullptr)
+	if (data.BufferSize > 0)
 	{
-		Logger::LogWarning(L"Failed to allocate the required memory!");
-		return;
-	}
+		if (m_IsCpuDataReleased)
+		{
+			HANDLE_ERROR(L"Mesh \"{}\" released its CPU vertex data, can't build a vertex buffer for input layout {}!", m_MeshName, inputLayoutID)
+			return;
+		}
 
-	data.pDataStart = pDataLocation;
-	data.InputLayoutID = inputLayoutID;
+		vertexBuffer.pInterleaver->LogMissingElements(subMesh, m_MeshName);
 
-	for (UINT i = 0; i < subMesh.vertexCount; ++i)
-	{
-		for (UINT j = 0; j < inputLayoutDescriptions.size(); ++j)
+		//Zeroed when some elements are wider than their stream (the tail isn't written)
+		data.pDataStart = vertexBuffer.pInterleaver->HasPadding() ? calloc(data.BufferSize, 1) : malloc(data.BufferSize);
+		if (data.pDataStart == nullptr)
 		{
-			const auto& ilDescription = inputLayoutDescriptions[j];
-
-			if (i == 0 && !subMesh.HasElement(ilDescription.SemanticType))
-			{
-				std::wstring name = EffectHelper::GetIlSemanticName(ilDescription.SemanticType);
-				Logger::LogWarning(L"Mesh \"{}\" has no vertex {} data, using a default value!", m_MeshName.c_str(), name.c_str());
-			}
-
-			switch (ilDescription.SemanticType)
-			{
-			case ILSemantic::POSITION:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.positions[i] : &m_DefaultFloat3, ilDescription.Offset);
-				break;
-			case ILSemantic::NORMAL:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.normals[i] : &m_DefaultFloat3, ilDescription.Offset);
-				break;
-			case ILSemantic::COLOR:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.colors[i] : &m_DefaultColor, ilDescription.Offset);
-				break;
-			case ILSemantic::TEXCOORD:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.texCoords[i] : &m_DefaultFloat2, ilDescription.Offset);
-				break;
-			case ILSemantic::TANGENT:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.tangents[i] : &m_DefaultFloat3, ilDescription.Offset);
-				break;
-			case ILSemantic::BINORMAL:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.binormals[i] : &m_DefaultFloat3, ilDescription.Offset);
-				break;
-			case ILSemantic::BLENDINDICES:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.blendIndices[i] : &m_DefaultFloat4, ilDescription.Offset);
-				break;
-			case ILSemantic::BLENDWEIGHTS:
-				memcpy(pDataLocation, subMesh.HasElement(ilDescription.SemanticType) ? &subMesh.blendWeights[i] : &m_DefaultFloat4, ilDescription.Offset);
-				break;
-			default:
-				HANDLE_ERROR(L"Unsupported SemanticType!");
-				break;
-			}
-
-			pDataLocation = static_cast<char*>(pDataLocation) + ilDescription.Offset;
+			Logger::LogWarning(L"Failed to allocate the required memory!");
+			return;
 		}
 	}
 
-	//fill a buffer description to copy the vertexdata into graphics memory
-	D3D11_BUFFER_DESC bd = {};
-	bd.Usage = D3D11_USAGE_DEFAULT;
-	bd.ByteWidth = data.BufferSize;
-	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-	bd.CPUAccessFlags = 0;
-	bd.MiscFlags = 0;
+	pending.push_back(vertexBuffer);
+}
 
-	D3D11_SUBRESOURCE_DATA initData{};
-	initData.pSysMem = data.pDataStart;
+void MeshFilter::BuildPendingVertexBuffers(const D3D11Context& d3dContext, std::vector<PendingVertexBuffer>& pending, JobSystem* pJobSystem)
+{
+	if (pending.empty())
+		return;
 
-	//create a ID3D10Buffer in graphics memory containing the vertex info
-	d3dContext.pDevice->CreateBuffer(&bd, &initData, &data.pVertexBuffer);
+	//INTERLEAVE
+	//Jobs of at most m_VerticesPerJob vertices, a single large submesh is split as well
+	struct Range
+	{
+		const PendingVertexBuffer* pVertexBuffer;
+		UINT begin;
+		UINT end;
+	};
 
-	subMesh.buffers.vertexbuffers.push_back(data);
-}
+	std::vector<Range> ranges{};
+	for (const auto& vertexBuffer : pending)
+	{
+		if (!vertexBuffer.data.pDataStart) continue; //Position only layout
+		const UINT vertexCount{ vertexBuffer.data.VertexCount };
+		for (UINT begin{}; begin < vertexCount; begin += m_VerticesPerJob)
+		{
+			ranges.push_back({ &vertexBuffer, begin, std::min(begin + m_VerticesPerJob, vertexCount) });
+		}
+	}
 
-void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId)
-{
-	BuildVertexBuffer(sceneContext.d3dContext, pMaterial, subMeshId);
-}
+	const auto interleave = [this, &ranges](UINT begin, UINT end)
+	{
+		for (UINT i{ begin }; i < end; ++i)
+		{
+			const Range& range = ranges[i];
+			const PendingVertexBuffer& vertexBuffer = *range.pVertexBuffer;
+			vertexBuffer.pInterleaver->Interleave(m_Meshes[vertexBuffer.subMeshId], vertexBuffer.data.pDataStart, range.begin, range.end);
+		}
+	};
 
-void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId, UINT8 techIndex)
-{
-	auto& techiqueContext = pMaterial->GetTechniqueContext(techIndex);
-	if (techIndex == 1)
+	if (pJobSystem && ranges.size() > 1)
+		pJobSystem->ParallelFor(static_cast<UINT>(ranges.size()), interleave, 1);
+	else
+		interleave(0, static_cast<UINT>(ranges.size()));
+
+	//UPLOAD
+	for (auto& vertexBuffer : pending)
 	{
+		VertexBufferData& data = vertexBuffer.data;
+		SubMeshFilter& subMesh = m_Meshes[vertexBuffer.subMeshId];
+
+		if (!subMesh.buffers.pPositionBuffer)
+			BuildPositionBuffer(d3dContext, subMesh);
 
+		if (data.pDataStart)
+		{
+			//fill a buffer description to copy the vertexdata into graphics memory
+			D3D11_BUFFER_DESC bd = {};
+			bd.Usage = D3D11_USAGE_IMMUTABLE;
+			bd.ByteWidth = data.BufferSize;
+			bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+			bd.CPUAccessFlags = 0;
+			bd.MiscFlags = 0;
+
+			D3D11_SUBRESOURCE_DATA initData{};
+			initData.pSysMem = data.pDataStart;
+
+			//create a ID3D10Buffer in graphics memory containing the vertex info
+			HANDLE_ERROR(d3dContext.pDevice->CreateBuffer(&bd, &initData, &data.pVertexBuffer))
+
+			//Nothing reads the CPU copy after the upload
+			free(data.pDataStart);
+			data.pDataStart = nullptr;
+		}
+
+		subMesh.buffers.vertexbuffers.push_back(data);
 	}
-	BuildVertexBuffer(sceneContext.d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, subMeshId);
 }
 
-void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, BaseMaterial* pMaterial, UINT8 subMeshId)
+void MeshFilter::BuildPositionBuffer(const D3D11Context& d3dContext, SubMeshFilter& subMesh)
 {
-	auto& techiqueContext = pMaterial->GetTechniqueContext();
-	return BuildVertexBuffer(d3dContext, techiqueContext.inputLayoutID, techiqueContext.inputLayoutSize, techiqueContext.pInputLayoutDescriptions, subMeshId);
-}
+	if (subMesh.vertexCount == 0)
+		return;
 
-void MeshFilter::BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial)
-{
-	BuildVertexBuffer(sceneContext.d3dContext, pMaterial);
-}
+	//Missing positions are zero (same default as the interleaved layouts had)
+	std::vector<XMFLOAT3> defaultPositions{};
+	if (subMesh.positions.size() < subMesh.vertexCount)
+		defaultPositions.resize(subMesh.vertexCount);
 
-void MeshFilter::BuildVertexBuffer(const D3D11Context& d3dContext, BaseMaterial* pMaterial)
-{
-	for (auto i{ 0 }; i < m_Meshes.size(); ++i)
-	{
-		BuildVertexBuffer(d3dContext, pMaterial, static_cast<UINT8>(i));
-	}
+	D3D11_BUFFER_DESC bd = {};
+	bd.Usage = D3D11_USAGE_IMMUTABLE;
+	bd.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT3)) * subMesh.vertexCount;
+	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA initData{};
+	initData.pSysMem = defaultPositions.empty() ? subMesh.positions.data() : defaultPositions.data();
+
+	HANDLE_ERROR(d3dContext.pDevice->CreateBuffer(&bd, &initData, &subMesh.buffers.pPositionBuffer))
 }
 
 const VertexBufferData& MeshFilter::GetVertexBufferData(UINT inputLayoutId, UINT8 subMeshId) const
@@ -211,8 +332,7 @@ const VertexBufferData& MeshFilter::GetVertexBufferData(const SceneContext& scen
 		Logger::LogWarning(L"No VertexBufferInformation for this material found! Building matching VertexBufferInformation (Performance Issue).");
 		BuildVertexBuffer(sceneContext, pMaterial, subMeshId);
 
-		//Return last created vertexbufferinformation
-		return m_Meshes[subMeshId].buffers.vertexbuffers.back();
+		return GetVertexBufferData(techniqueContext.inputLayoutID, subMeshId);
 	}
 
 	return m_Meshes[subMeshId].buffers.vertexbuffers[possibleBuffer];
@@ -223,3 +343,71 @@ ID3D11Buffer* MeshFilter::GetIndexBuffer(UINT8 subMeshId) const
 	ASSERT_IF_(subMeshId >= m_Meshes.size());
 	return m_Meshes[subMeshId].buffers.pIndexBuffer;
 }
+
+DXGI_FORMAT MeshFilter::GetIndexFormat(UINT8 subMeshId) const
+{
+	ASSERT_IF_(subMeshId >= m_Meshes.size());
+	return m_Meshes[subMeshId].buffers.indexFormat;
+}
+
+ID3D11Buffer* MeshFilter::GetPositionBuffer(UINT8 subMeshId) const
+{
+	ASSERT_IF_(subMeshId >= m_Meshes.size());
+	return m_Meshes[subMeshId].buffers.pPositionBuffer;
+}
+
+void MeshFilter::SetVertexStreams(ID3D11DeviceContext* pDeviceContext, UINT inputLayoutId, UINT8 subMeshId) const
+{
+	const VertexBufferData& vertexBufferData = GetVertexBufferData(inputLayoutId, subMeshId);
+
+	constexpr UINT positionStride{ sizeof(XMFLOAT3) };
+	constexpr UINT offset{};
+	ID3D11Buffer* pPositionBuffer{ m_Meshes[subMeshId].buffers.pPositionBuffer };
+	pDeviceContext->IASetVertexBuffers(PositionSlot, 1, &pPositionBuffer, &positionStride, &offset);
+	pDeviceContext->IASetVertexBuffers(AttributeSlot, 1, &vertexBufferData.pVertexBuffer, &vertexBufferData.VertexStride, &offset);
+}
+
+void MeshFilter::ReleaseCpuData()
+{
+	//Positions stay for bounds, picking & position only layouts, indices for the index buffer rebuilds
+	for (auto& subMesh : m_Meshes)
+	{
+		std::vector<XMFLOAT3>{}.swap(subMesh.normals);
+		std::vector<XMFLOAT3>{}.swap(subMesh.tangents);
+		std::vector<XMFLOAT3>{}.swap(subMesh.binormals);
+		std::vector<XMFLOAT2>{}.swap(subMesh.texCoords);
+		std::vector<XMFLOAT4>{}.swap(subMesh.colors);
+		std::vector<XMFLOAT4>{}.swap(subMesh.blendIndices);
+		std::vector<XMFLOAT4>{}.swap(subMesh.blendWeights);
+	}
+
+	m_IsCpuDataReleased = true;
+}
+
+MeshFilter::MemoryStats MeshFilter::GetMemoryStats() const
+{
+	MemoryStats stats{};
+	for (const auto& subMesh : m_Meshes)
+	{
+		stats.cpuBytes += subMesh.positions.capacity() * sizeof(XMFLOAT3) + subMesh.normals.capacity() * sizeof(XMFLOAT3) +
+			subMesh.tangents.capacity() * sizeof(XMFLOAT3) + subMesh.binormals.capacity() * sizeof(XMFLOAT3) +
+			subMesh.texCoords.capacity() * sizeof(XMFLOAT2) + subMesh.colors.capacity() * sizeof(XMFLOAT4) +
+			subMesh.blendIndices.capacity() * sizeof(XMFLOAT4) + subMesh.blendWeights.capacity() * sizeof(XMFLOAT4) +
+			subMesh.indices.capacity() * sizeof(UINT);
+
+		if (subMesh.buffers.pPositionBuffer)
+			stats.positionBytes += static_cast<UINT64>(subMesh.vertexCount) * sizeof(XMFLOAT3);
+
+		if (subMesh.buffers.pIndexBuffer)
+			stats.indexBytes += static_cast<UINT64>(subMesh.indexCount) * (subMesh.buffers.indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(USHORT) : sizeof(UINT));
+
+		for (const VertexBufferData& data : subMesh.buffers.vertexbuffers)
+		{
+			stats.attributeBytes += data.BufferSize;
+			stats.interleavedBytes += static_cast<UINT64>(data.LayoutStride) * data.VertexCount;
+			++stats.layouts;
+		}
+	}
+
+	return stats;
+}
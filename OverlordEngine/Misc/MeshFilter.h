@@ -1,6 +1,9 @@
 #pragma once
+class VertexInterleaver;
 
 #pragma region MeshFilter Helper Structs
+//Attribute stream of one input layout (MeshFilter::AttributeSlot), positions are shared (SubMeshBuffers::pPositionBuffer)
+//pVertexBuffer is nullptr for position only layouts (e.g. the static shadow generator)
 struct VertexBufferData
 {
 	VertexBufferData() :
@@ -8,14 +11,16 @@ struct VertexBufferData
 		pVertexBuffer(nullptr),
 		BufferSize(0),
 		VertexStride(0),
+		LayoutStride(0),
 		VertexCount(0),
 		IndexCount(0),
 		InputLayoutID(0) {}
 
-	void* pDataStart;
+	void* pDataStart; //CPU copy, freed once uploaded
 	ID3D11Buffer* pVertexBuffer;
 	UINT BufferSize;
 	UINT VertexStride;
+	UINT LayoutStride; //Whole input layout, position included (memory report)
 	UINT VertexCount;
 	UINT IndexCount;
 	UINT InputLayoutID;
@@ -45,8 +50,10 @@ struct AnimationClip
 
 struct SubMeshBuffers
 {
+	ID3D11Buffer* pPositionBuffer{}; //MeshFilter::PositionSlot, shared by all input layouts (XMFLOAT3)
 	std::vector<VertexBufferData> vertexbuffers{};
 	ID3D11Buffer* pIndexBuffer{};
+	DXGI_FORMAT indexFormat{ DXGI_FORMAT_R32_UINT }; //Cooked meshes (.ovmc) can have 16-bit indices
 
 	bool HasVertexBuffer(UINT inputLayoutId) const
 	{
@@ -76,7 +83,9 @@ struct SubMeshBuffers
 		}
 
 		vertexbuffers.clear();
+		SafeRelease(pPositionBuffer)
 		SafeRelease(pIndexBuffer)
+		indexFormat = DXGI_FORMAT_R32_UINT;
 	}
 };
 
@@ -89,6 +98,8 @@ struct SubMeshFilter
 	UINT indexCount{};
 	UINT uvChannelCount{};
 
+	BoundingBox bounds{}; //Object space (bind pose for skinned meshes)
+
 	ILSemantic layoutElements{ ILSemantic::NONE };
 
 	std::vector<XMFLOAT3> positions{};
@@ -133,31 +144,71 @@ struct SubMeshFilter
 class MeshFilter final
 {
 public:
-	MeshFilter() = default;
+	//Vertex stream slots of MaterialTechniqueContext::pStreamInputLayout (slot 1 is the RenderQueue instance stream)
+	static constexpr UINT PositionSlot{ 0 };
+	static constexpr UINT AttributeSlot{ 2 };
+
+	struct MemoryStats
+	{
+		UINT64 cpuBytes{}; //Vertex & index arrays of the submeshes
+		UINT64 positionBytes{}; //Shared position streams
+		UINT64 attributeBytes{}; //Attribute streams of all layouts
+		UINT64 indexBytes{};
+		UINT64 interleavedBytes{}; //The same layouts as one fully interleaved buffer each (positions copied per layout)
+		UINT layouts{};
+	};
+
+	MeshFilter();
 	~MeshFilter();
 	MeshFilter(const MeshFilter& other) = delete;
 	MeshFilter(MeshFilter&& other) noexcept = delete;
 	MeshFilter& operator=(const MeshFilter& other) = delete;
 	MeshFilter& operator=(MeshFilter&& other) noexcept = delete;
 
+	const std::wstring& GetMeshName() const { return m_MeshName; }
 	const std::vector<SubMeshFilter>& GetMeshes() const { return m_Meshes; }
 	UINT GetMeshCount() const { return static_cast<UINT>(m_Meshes.size()); }
 	const std::vector<AnimationClip>& GetAnimationClips() const { return m_AnimationClips; }
 	bool HasAnimations() const { return m_HasAnimations; }
+	USHORT GetBoneCount() const { return m_BoneCount; }
 
 	int GetVertexBufferId(UINT inputLayoutId, UINT8 subMeshId) const;
 
+	//All submeshes, interleaved in parallel when a JobSystem is given (see VertexInterleaver)
 	void BuildVertexBuffer(const SceneContext& sceneContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions);
+	void BuildVertexBuffer(const D3D11Context& d3dContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, JobSystem* pJobSystem);
 
 	void BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial);
 	void BuildVertexBuffer(const D3D11Context& d3dContext, BaseMaterial* pMaterial);
 
+	//One material per submesh (nullptr entries are skipped), all submeshes in one parallel build
+	void BuildVertexBuffers(const SceneContext& sceneContext, const std::vector<BaseMaterial*>& subMeshMaterials);
+
+	//Submeshes that already have one (cooked meshes, other ModelComponents) are skipped
 	void BuildIndexBuffer(const SceneContext& sceneContext);
 	void BuildIndexBuffer(const D3D11Context& d3dContext);
 
 	const VertexBufferData& GetVertexBufferData(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId = 0);
 	const VertexBufferData& GetVertexBufferData(UINT inputLayoutId, UINT8 subMeshId = 0) const;
 	ID3D11Buffer* GetIndexBuffer(UINT8 subMeshId = 0) const;
+	DXGI_FORMAT GetIndexFormat(UINT8 subMeshId = 0) const;
+	ID3D11Buffer* GetPositionBuffer(UINT8 subMeshId = 0) const;
+
+	//Binds the position & attribute stream of a built layout, draw with MaterialTechniqueContext::pStreamInputLayout
+	void SetVertexStreams(ID3D11DeviceContext* pDeviceContext, UINT inputLayoutId, UINT8 subMeshId = 0) const;
+
+	//Frees the CPU attribute arrays once every layout the mesh is drawn with is built (positions & indices are kept)
+	//Layouts with attributes can't be built afterwards, the StaticBatcher skips the mesh
+	void ReleaseCpuData();
+	bool IsCpuDataReleased() const { return m_IsCpuDataReleased; }
+
+	MemoryStats GetMemoryStats() const;
+
+	//Object space bounds of all submeshes (bind pose for skinned meshes)
+	const BoundingBox& GetBounds() const { return m_Bounds; }
+
+	//Unique per loaded mesh (render queue sort keys)
+	UINT GetMeshId() const { return m_MeshId; }
 
 	UINT GetIndexCount(UINT8 subMeshId = 0) const { return m_Meshes[subMeshId].indexCount; }
 	UINT GetVertexCount(UINT8 subMeshId = 0) const { return m_Meshes[subMeshId].vertexCount; }
@@ -166,6 +217,20 @@ private:
 	friend class MeshFilterLoader; //TODO: Resolve Friend Classes
 	friend class ModelComponent;
 	friend class ModelAnimator;
+	friend class MeshCooker;
+
+	struct PendingVertexBuffer
+	{
+		UINT8 subMeshId{};
+		const VertexInterleaver* pInterleaver{};
+		VertexBufferData data{};
+	};
+
+	void ComputeBounds();
+
+	void AddPendingVertexBuffer(std::vector<PendingVertexBuffer>& pending, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, UINT8 subMeshId) const;
+	void BuildPendingVertexBuffers(const D3D11Context& d3dContext, std::vector<PendingVertexBuffer>& pending, JobSystem* pJobSystem);
+	static void BuildPositionBuffer(const D3D11Context& d3dContext, SubMeshFilter& subMesh);
 
 	void BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId);
 	void BuildVertexBuffer(const SceneContext& sceneContext, BaseMaterial* pMaterial, UINT8 subMeshId, UINT8 techIndex);
@@ -175,15 +240,18 @@ private:
 	void BuildVertexBuffer(const D3D11Context& d3dContext, UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions, UINT8 subMeshId);
 
 	std::wstring m_MeshName{};
+	UINT m_MeshId{};
 	std::vector<SubMeshFilter> m_Meshes{};
+	BoundingBox m_Bounds{};
 
 	std::vector<AnimationClip> m_AnimationClips{};
 	bool m_HasAnimations{};
 	USHORT m_BoneCount{};
+	bool m_IsCpuDataReleased{};
+
+	//Vertices per parallel interleave job, large submeshes are split
+	static constexpr UINT m_VerticesPerJob{ 16384 };
 
-	static XMFLOAT4 m_DefaultColor;
-	static XMFLOAT4 m_DefaultFloat4;
-	static XMFLOAT3 m_DefaultFloat3;
-	static XMFLOAT2 m_DefaultFloat2;
+	static std::atomic<UINT> m_NextMeshId; //Meshes are loaded on worker threads too
 };
 
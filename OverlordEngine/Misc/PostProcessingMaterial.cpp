@@ -29,7 +29,8 @@ void PostProcessingMaterial::InitializeBase(const GameContext& gameContext, UINT
 	m_MaterialId = materialId;
 	m_GameContext = gameContext;
 
-	//Load Base Effect
+	//Load Base Effect (pinned, materials aren't released with the scene)
+	ContentScope::Active pinned{ nullptr };
 	m_pBaseEffect = ContentManager::Load<ID3DX11Effect>(m_EffectFile);
 	m_pBaseTechnique = m_pBaseEffect->GetTechniqueByIndex(0);
 
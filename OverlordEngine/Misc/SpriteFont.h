@@ -44,6 +44,7 @@ public:
 	short GetSize() const { return m_FontDesc.fontSize; }
 	bool HasMetric(const wchar_t& character) const { return m_FontDesc.metrics.contains(character); };
 	const FontMetric& GetMetric(const wchar_t& character) const { return m_FontDesc.metrics.at(character); };
+	size_t GetMetricCount() const { return m_FontDesc.metrics.size(); }
 
 private:
 	SpriteFontDesc m_FontDesc;
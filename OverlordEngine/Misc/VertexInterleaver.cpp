@@ -0,0 +1,167 @@
+#include "stdafx.h"
+#include "VertexInterleaver.h"
+
+std::mutex VertexInterleaver::m_CacheMutex{};
+std::unordered_map<UINT, std::vector<std::unique_ptr<VertexInterleaver>>> VertexInterleaver::m_Cache{};
+
+namespace
+{
+	//Values of missing streams (MeshFilter used red for missing colors)
+	const XMFLOAT4 g_DefaultColor{ 1.f, 0.f, 0.f, 1.f };
+	const XMFLOAT4 g_DefaultZero{ 0.f, 0.f, 0.f, 0.f };
+
+	//Constant size, the memcpy compiles to a few moves
+	template<UINT Size>
+	void CopyElement(BYTE* pDestination, UINT destinationStride, const BYTE* pSource, UINT sourceStride, UINT /*size*/, UINT count)
+	{
+		for (UINT i{}; i < count; ++i, pDestination += destinationStride, pSource += sourceStride)
+		{
+			std::memcpy(pDestination, pSource, Size);
+		}
+	}
+
+	void CopyElementAnySize(BYTE* pDestination, UINT destinationStride, const BYTE* pSource, UINT sourceStride, UINT size, UINT count)
+	{
+		for (UINT i{}; i < count; ++i, pDestination += destinationStride, pSource += sourceStride)
+		{
+			std::memcpy(pDestination, pSource, size);
+		}
+	}
+
+	UINT GetStreamStride(ILSemantic semantic)
+	{
+		switch (semantic)
+		{
+		case ILSemantic::NORMAL:
+		case ILSemantic::TANGENT:
+		case ILSemantic::BINORMAL:
+			return sizeof(XMFLOAT3);
+		case ILSemantic::TEXCOORD:
+			return sizeof(XMFLOAT2);
+		case ILSemantic::COLOR:
+		case ILSemantic::BLENDINDICES:
+		case ILSemantic::BLENDWEIGHTS:
+			return sizeof(XMFLOAT4);
+		default:
+			HANDLE_ERROR(L"Unsupported SemanticType!");
+			return 0;
+		}
+	}
+}
+
+VertexInterleaver::VertexInterleaver(UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions):
+	m_Descriptions(inputLayoutDescriptions),
+	m_LayoutSize(inputLayoutSize)
+{
+	//ILDescription::Offset holds the size of the element, elements are packed in declaration order
+	UINT layoutSize{};
+	for (const ILDescription& ilDescription : inputLayoutDescriptions)
+	{
+		layoutSize += ilDescription.Offset;
+		if (ilDescription.SemanticType == ILSemantic::POSITION)
+			continue;
+
+		Element element{};
+		element.semantic = ilDescription.SemanticType;
+		element.offset = m_Stride;
+		element.streamStride = GetStreamStride(ilDescription.SemanticType);
+		element.size = std::min(ilDescription.Offset, element.streamStride);
+		element.pDefault = ilDescription.SemanticType == ILSemantic::COLOR ? &g_DefaultColor : &g_DefaultZero;
+
+		switch (element.size)
+		{
+		case 4: element.pCopy = &CopyElement<4>; break;
+		case 8: element.pCopy = &CopyElement<8>; break;
+		case 12: element.pCopy = &CopyElement<12>; break;
+		case 16: element.pCopy = &CopyElement<16>; break;
+		default: element.pCopy = &CopyElementAnySize; break;
+		}
+
+		m_HasPadding |= element.size < ilDescription.Offset;
+		m_Elements.push_back(element);
+
+		m_Stride += ilDescription.Offset;
+	}
+
+	ASSERT_IF(layoutSize != m_LayoutSize, L"Input layout elements ({} bytes) don't match the layout size ({} bytes)", layoutSize, m_LayoutSize)
+}
+
+const VertexInterleaver& VertexInterleaver::Get(UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions)
+{
+	std::lock_guard lock{ m_CacheMutex };
+
+	auto& interleavers = m_Cache[inputLayoutID];
+	for (const auto& pInterleaver : interleavers)
+	{
+		if (pInterleaver->IsLayout(inputLayoutSize, inputLayoutDescriptions))
+			return *pInterleaver;
+	}
+
+	return *interleavers.emplace_back(std::make_unique<VertexInterleaver>(inputLayoutSize, inputLayoutDescriptions));
+}
+
+bool VertexInterleaver::IsLayout(UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions) const
+{
+	return inputLayoutSize == m_LayoutSize && std::ranges::equal(inputLayoutDescriptions, m_Descriptions, [](const ILDescription& a, const ILDescription& b)
+	{
+		return a.SemanticType == b.SemanticType && a.Offset == b.Offset;
+	});
+}
+
+const BYTE* VertexInterleaver::GetStream(const SubMeshFilter& subMesh, ILSemantic semantic)
+{
+	if (!subMesh.HasElement(semantic))
+		return nullptr;
+
+	switch (semantic)
+	{
+	case ILSemantic::NORMAL: return reinterpret_cast<const BYTE*>(subMesh.normals.data());
+	case ILSemantic::TANGENT: return reinterpret_cast<const BYTE*>(subMesh.tangents.data());
+	case ILSemantic::BINORMAL: return reinterpret_cast<const BYTE*>(subMesh.binormals.data());
+	case ILSemantic::TEXCOORD: return reinterpret_cast<const BYTE*>(subMesh.texCoords.data());
+	case ILSemantic::COLOR: return reinterpret_cast<const BYTE*>(subMesh.colors.data());
+	case ILSemantic::BLENDINDICES: return reinterpret_cast<const BYTE*>(subMesh.blendIndices.data());
+	case ILSemantic::BLENDWEIGHTS: return reinterpret_cast<const BYTE*>(subMesh.blendWeights.data());
+	default: return nullptr;
+	}
+}
+
+void VertexInterleaver::Interleave(const SubMeshFilter& subMesh, void* pBuffer) const
+{
+	if (m_HasPadding)
+		std::memset(pBuffer, 0, static_cast<size_t>(m_Stride) * subMesh.vertexCount);
+
+	Interleave(subMesh, pBuffer, 0, subMesh.vertexCount);
+}
+
+void VertexInterleaver::Interleave(const SubMeshFilter& subMesh, void* pBuffer, UINT begin, UINT end) const
+{
+	BYTE* const pVertices{ static_cast<BYTE*>(pBuffer) };
+
+	for (UINT blockBegin{ begin }; blockBegin < end; blockBegin += m_BlockSize)
+	{
+		const UINT count{ std::min(m_BlockSize, end - blockBegin) };
+		BYTE* const pBlock{ pVertices + static_cast<size_t>(blockBegin) * m_Stride };
+
+		for (const Element& element : m_Elements)
+		{
+			const BYTE* pStream{ GetStream(subMesh, element.semantic) };
+			if (pStream)
+				element.pCopy(pBlock + element.offset, m_Stride, pStream + static_cast<size_t>(blockBegin) * element.streamStride, element.streamStride, element.size, count);
+			else
+				element.pCopy(pBlock + element.offset, m_Stride, static_cast<const BYTE*>(element.pDefault), 0, element.size, count);
+		}
+	}
+}
+
+void VertexInterleaver::LogMissingElements(const SubMeshFilter& subMesh, const std::wstring& meshName) const
+{
+	for (const ILDescription& ilDescription : m_Descriptions)
+	{
+		if (subMesh.HasElement(ilDescription.SemanticType))
+			continue;
+
+		const std::wstring& name = EffectHelper::GetIlSemanticName(ilDescription.SemanticType);
+		Logger::LogWarning(L"Mesh \"{}\" has no vertex {} data, using a default value!", meshName, name);
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+struct SubMeshFilter;
+
+//Writes the attribute stream of a submesh, every layout element but POSITION interleaved (see MeshFilter::BuildVertexBuffer)
+//Positions are a separate stream shared by all layouts (MeshFilter::PositionSlot), a position only layout has an empty attribute stream
+//Generated once per input layout: every element becomes a copy op with a kernel specialised on its size, no per vertex switch
+//Elements wider than their stream (e.g. float4 NORMAL) keep a zeroed tail, missing streams are filled with a default value
+class VertexInterleaver final
+{
+public:
+	VertexInterleaver(UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions);
+	~VertexInterleaver() = default;
+	VertexInterleaver(const VertexInterleaver& other) = delete;
+	VertexInterleaver(VertexInterleaver&& other) noexcept = delete;
+	VertexInterleaver& operator=(const VertexInterleaver& other) = delete;
+	VertexInterleaver& operator=(VertexInterleaver&& other) noexcept = delete;
+
+	//Cached per input layout ID (generated on first use), safe to call from worker threads
+	static const VertexInterleaver& Get(UINT inputLayoutID, UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions);
+
+	//Writes vertices [begin, end) of the submesh, pBuffer is the start of the whole buffer (vertexCount * stride bytes)
+	//Ranges of the same buffer can be written from different threads
+	void Interleave(const SubMeshFilter& subMesh, void* pBuffer, UINT begin, UINT end) const;
+	void Interleave(const SubMeshFilter& subMesh, void* pBuffer) const;
+
+	void LogMissingElements(const SubMeshFilter& subMesh, const std::wstring& meshName) const;
+
+	UINT GetStride() const { return m_Stride; } //Attribute stream bytes per vertex (0 == position only layout)
+	bool HasPadding() const { return m_HasPadding; } //Buffer has to be zeroed before interleaving
+
+private:
+	//pSource advances by sourceStride per vertex (0 == one default value for all vertices)
+	using CopyFunction = void(*)(BYTE* pDestination, UINT destinationStride, const BYTE* pSource, UINT sourceStride, UINT size, UINT count);
+
+	struct Element
+	{
+		ILSemantic semantic{};
+		UINT offset{}; //In the vertex
+		UINT size{}; //Copied bytes (layout element clamped to the stream element)
+		UINT streamStride{};
+		const void* pDefault{};
+		CopyFunction pCopy{};
+	};
+
+	//Vertices per block, all elements of a block are written before the next one (keeps the destination in cache)
+	static constexpr UINT m_BlockSize{ 512 };
+
+	std::vector<ILDescription> m_Descriptions{};
+	std::vector<Element> m_Elements{};
+	UINT m_LayoutSize{}; //Whole layout, position included
+	UINT m_Stride{};
+	bool m_HasPadding{};
+
+	bool IsLayout(UINT inputLayoutSize, const std::vector<ILDescription>& inputLayoutDescriptions) const;
+	static const BYTE* GetStream(const SubMeshFilter& subMesh, ILSemantic semantic);
+
+	//The layout ID only holds the semantics, layouts with different element sizes share an ID
+	static std::mutex m_CacheMutex;
+	static std::unordered_map<UINT, std::vector<std::unique_ptr<VertexInterleaver>>> m_Cache;
+};
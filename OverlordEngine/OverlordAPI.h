@@ -4,12 +4,17 @@
 #include "Utils/Macros.h"
 
 #include "Utils/BinaryReader.h"
+#include "Utils/BinaryWriter.h"
+#include "Utils/Lz4.h"
 #include "Utils/Utils.h"
 #include "Utils/Singleton.h"
+#include "Utils/SmallVector.h"
+#include "Utils/PoolAllocator.h"
 
 #include "Utils/EffectHelper.h"
 #include "Utils/ImguiHelper.h"
 #include "Utils/MathHelper.h"
+#include "Utils/CullingFrustum.h"
 #include "Utils/PhysxHelper.h"
 #include "Utils/VertexHelper.h"
 
@@ -18,9 +23,12 @@
 #include "Base/OverlordGame.h"
 #include "Base/GameTime.h"
 #include "Base/GameStats.h"
+#include "Base/JobSystem.h"
 #include "Base/Logger.h"
 #include "Base/IInteractable.h"
 
+#include "Misc/MaterialVariable.h" //Cached by the components & renderers below
+
 #include "Managers/ContentManager.h"
 #include "Managers/InputManager.h"
 #include "Managers/LightManager.h"
@@ -30,6 +38,7 @@
 #include "Managers/PhysXManager.h"
 #include "Managers/EventSystem.h"
 
+#include "Components/ComponentTypeRegistry.h"
 #include "Components/BaseComponent.h"
 #include "Components/TransformComponent.h"
 #include "Components/CameraComponent.h"
@@ -43,21 +52,27 @@
 #include "Components/TimerComponent.h" // Custom
 #include "Components/ButtonComponent.h" // Custom
 
+#include "Content/ContentScope.h"
 #include "Content/ContentLoader.h"
+#include "Content/ContentPack.h"
 #include "Content/EffectLoader.h"
 #include "Content/MeshFilterLoader.h"
+#include "Content/MeshCooker.h"
 #include "Content/PxMeshLoader.h"
 #include "Content/SpriteFontLoader.h"
 #include "Content/TextureDataLoader.h"
 
 #include "Graphics/ShadowMapRenderer.h" //Week 8
 #include "Graphics/DebugRenderer.h"
+#include "Graphics/RenderQueue.h"
+#include "Graphics/StaticBatcher.h"
 #include "Graphics/SpriteRenderer.h" //Week 4
 #include "Graphics/TextRenderer.h" //Week 5
 
 #include "Misc/BaseMaterial.h"
 #include "Misc/Material.h"
 #include "Misc/MeshFilter.h"
+#include "Misc/VertexInterleaver.h"
 #include "Misc/ModelAnimator.h" //Week 7
 #include "Misc/RenderTarget.h"
 #include "Misc/SpriteFont.h" //Week 4
@@ -69,6 +84,8 @@
 #include "PhysX/PhysxErrorCallback.h"
 #include "PhysX/PhysxProxy.h"
 
+#include "Scenegraph/TransformHierarchy.h"
+#include "Scenegraph/BoundingVolumeHierarchy.h"
 #include "Scenegraph/GameObject.h"
 #include "SceneGraph/GameScene.h"
 
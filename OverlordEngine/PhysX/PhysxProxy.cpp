@@ -7,6 +7,8 @@ float PhysxProxy::m_PhysXStepTime{0.f};
 
 PhysxProxy::~PhysxProxy()
 {
+	FetchResults();
+
 	if (m_pControllerManager != nullptr)
 		m_pControllerManager->release();
 	if (m_pPhysxScene != nullptr)
@@ -21,6 +23,7 @@ void PhysxProxy::Initialize(GameScene* pParent)
 		return;
 	}
 
+	m_pScene = pParent;
 	m_pPhysxScene = PhysXManager::Get()->CreateScene(pParent);
 	ASSERT_IF(!m_pPhysxScene, L"Failed to create physx scene!")
 
@@ -37,28 +40,22 @@ void PhysxProxy::Initialize(GameScene* pParent)
 	m_IsInitialized = true;
 }
 
-void PhysxProxy::Update(const SceneContext& sceneContext) const
+void PhysxProxy::Update(const SceneContext& sceneContext)
 {
-	if (sceneContext.pGameTime->IsRunning() && sceneContext.pGameTime->GetElapsed() > 0)
+	if (!sceneContext.settings.asyncPhysics)
 	{
-		if (m_PhysXFrameStepping)
+		float stepTime{};
+		const UINT steps{ ConsumeSteps(sceneContext, stepTime) };
+		if (steps > 0)
 		{
-			if (m_PhysXStepTime > 0.f)
-			{
-				m_pPhysxScene->simulate(m_PhysXStepTime);
-				m_pPhysxScene->fetchResults(true);
-				m_PhysXStepTime = 0.f;
-			}
-			else if (m_PhysXStepTime < 0.f)
+			const auto start = std::chrono::steady_clock::now();
+			for (UINT i{}; i < steps; ++i)
 			{
-				m_pPhysxScene->simulate(sceneContext.pGameTime->GetElapsed());
-				m_pPhysxScene->fetchResults(true);
+				Step(stepTime);
 			}
-		}
-		else
-		{
-			m_pPhysxScene->simulate(sceneContext.pGameTime->GetElapsed());
-			m_pPhysxScene->fetchResults(true);
+
+			const std::chrono::duration<float, std::milli> stepDuration = std::chrono::steady_clock::now() - start;
+			GameStats::GetFrameStats().physicsWaitMs = stepDuration.count();
 		}
 	}
 
@@ -67,13 +64,160 @@ void PhysxProxy::Update(const SceneContext& sceneContext) const
 	if (m_pPhysxScene->getScenePvdClient())
 	{
 		const auto pCameraTransform = sceneContext.pCamera->GetTransform();
+		const XMFLOAT3 cameraPosition{ pCameraTransform->GetWorldPosition() };
+		const XMFLOAT3 cameraForward{ pCameraTransform->GetForward() };
 		XMFLOAT3 cameraTarget{};
-		XMStoreFloat3(&cameraTarget ,XMLoadFloat3(& pCameraTransform->GetWorldPosition()) + (XMLoadFloat3(&pCameraTransform->GetForward()) * 10.f));
+		XMStoreFloat3(&cameraTarget ,XMLoadFloat3(&cameraPosition) + (XMLoadFloat3(&cameraForward) * 10.f));
 		m_pPhysxScene->getScenePvdClient()->updateCamera("SceneCam", PhysxHelper::ToPxVec3(pCameraTransform->GetWorldPosition()), PhysxHelper::ToPxVec3(pCameraTransform->GetUp()), PhysxHelper::ToPxVec3(cameraTarget));
 	}
 #endif
 }
 
+void PhysxProxy::Simulate(const SceneContext& sceneContext)
+{
+	if (m_IsSimulating)
+		return;
+
+	float stepTime{};
+	const UINT steps{ ConsumeSteps(sceneContext, stepTime) };
+	if (steps == 0)
+		return;
+
+	//Catch-up steps block, only the last one overlaps with the next frame
+	for (UINT i{ 1 }; i < steps; ++i)
+	{
+		Step(stepTime);
+	}
+
+	FixedUpdate(stepTime);
+	m_pPhysxScene->simulate(stepTime);
+	m_SimulateStart = std::chrono::steady_clock::now();
+	m_IsSimulating = true;
+}
+
+void PhysxProxy::FetchResults()
+{
+	if (!m_IsSimulating)
+		return;
+
+	//Overlap == time the main thread spent on other work since the kick, wait == remaining simulation time
+	const auto fetchStart = std::chrono::steady_clock::now();
+	m_pPhysxScene->fetchResults(true);
+	m_IsSimulating = false;
+	CaptureActivePoses();
+
+	const auto fetchEnd = std::chrono::steady_clock::now();
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	frameStats.physicsOverlapMs = std::chrono::duration<float, std::milli>(fetchStart - m_SimulateStart).count();
+	frameStats.physicsWaitMs = std::chrono::duration<float, std::milli>(fetchEnd - fetchStart).count();
+}
+
+void PhysxProxy::EnsureNotSimulating()
+{
+	if (!m_IsSimulating)
+		return;
+
+#ifdef _DEBUG
+	Logger::LogDebug(L"PhysxProxy::EnsureNotSimulating > Scene access before the physics sync point, fetching results early");
+#endif
+
+	++GameStats::GetFrameStats().physicsEarlySyncs;
+	FetchResults();
+}
+
+UINT PhysxProxy::ConsumeSteps(const SceneContext& sceneContext, float& stepTime)
+{
+	const float elapsed{ sceneContext.pGameTime->GetElapsed() };
+	if (!sceneContext.pGameTime->IsRunning() || elapsed <= 0)
+		return 0;
+
+	//Debug frame stepping, explicit (variable) steps
+	if (m_PhysXFrameStepping)
+	{
+		if (m_PhysXStepTime > 0.f)
+		{
+			stepTime = m_PhysXStepTime;
+			m_PhysXStepTime = 0.f;
+			return 1;
+		}
+
+		if (m_PhysXStepTime < 0.f)
+		{
+			stepTime = elapsed;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (m_FixedTimeStep <= 0.f)
+	{
+		stepTime = elapsed;
+		return 1;
+	}
+
+	stepTime = m_FixedTimeStep;
+	m_Accumulator += elapsed;
+
+	UINT steps{ static_cast<UINT>(m_Accumulator / m_FixedTimeStep) };
+	if (steps > m_MaxSubSteps)
+	{
+		//Can't catch up (frame spike/breakpoint), drop the backlog instead of simulating it
+		steps = m_MaxSubSteps;
+		m_Accumulator = std::fmod(m_Accumulator, m_FixedTimeStep);
+	}
+	else
+	{
+		m_Accumulator -= steps * m_FixedTimeStep;
+	}
+
+	return steps;
+}
+
+void PhysxProxy::FixedUpdate(float stepTime)
+{
+	//Controllers are moved by the user code (no active actor list), their pose before the step is the interpolation start
+	for (PxU32 i{}; i < m_pControllerManager->getNbControllers(); ++i)
+	{
+		if (const auto pController = static_cast<ControllerComponent*>(m_pControllerManager->getController(i)->getUserData()))
+			pController->BeginStep();
+	}
+
+	m_pScene->RootFixedUpdate(stepTime);
+}
+
+void PhysxProxy::Step(float stepTime)
+{
+	FixedUpdate(stepTime);
+	m_pPhysxScene->simulate(stepTime);
+	m_pPhysxScene->fetchResults(true);
+	CaptureActivePoses();
+}
+
+void PhysxProxy::CaptureActivePoses()
+{
+	++m_StepIndex;
+	++GameStats::GetFrameStats().physicsSteps;
+
+	//Only actors that moved during the step (PxSceneFlag::eENABLE_ACTIVE_ACTORS)
+	const ComponentTypeId rigidBodyTypeId{ ComponentTypeRegistry::GetTypeId<RigidBodyComponent>() };
+
+	PxU32 actorCount{};
+	PxActor** ppActors{ m_pPhysxScene->getActiveActors(actorCount) };
+	for (PxU32 i{}; i < actorCount; ++i)
+	{
+		const auto pComponent = static_cast<BaseComponent*>(ppActors[i]->userData);
+		if (pComponent && pComponent->GetComponentTypeId() == rigidBodyTypeId)
+			static_cast<RigidBodyComponent*>(pComponent)->CapturePose(m_StepIndex);
+	}
+
+	for (PxU32 i{}; i < m_pControllerManager->getNbControllers(); ++i)
+	{
+		if (const auto pController = static_cast<ControllerComponent*>(m_pControllerManager->getController(i)->getUserData()))
+			pController->CapturePose(m_StepIndex);
+	}
+}
+
 void PhysxProxy::Draw(const SceneContext& sceneContext) const
 {
 	if (sceneContext.settings.drawPhysXDebug)
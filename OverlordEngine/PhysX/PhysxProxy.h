@@ -24,8 +24,28 @@ public:
 	static void EnablePhysXFrameStepping(bool enable) { m_PhysXFrameStepping = enable; }
 	static void NextPhysXFrame(float time = 0.03f) { m_PhysXStepTime = time; }
 	void Initialize(GameScene* pParent);
-	void Update(const SceneContext& sceneContext) const;
+	void Update(const SceneContext& sceneContext); //Synchronous step(s) (simulate + blocking fetch)
 	void Draw(const SceneContext& sceneContext) const;
+
+	//Asynchronous stepping (SceneSettings::asyncPhysics)
+	//Simulate is kicked at the end of frame N, FetchResults is the sync point in frame N+1 (see GameScene::RootUpdate)
+	//Until the sync point:
+	//	- Reads (poses, velocities, controller positions, scene queries) return the state from before the step
+	//	- Actor writes (forces, velocities, poses, kinematic targets) are buffered by PhysX and applied after the fetch
+	//	- Character controller moves and adding/removing actors are not allowed, they call EnsureNotSimulating (early sync)
+	void Simulate(const SceneContext& sceneContext);
+	void FetchResults();
+	void EnsureNotSimulating();
+	bool IsSimulating() const { return m_IsSimulating; }
+
+	//Fixed timestep (accumulator), 0 == step with the frame's elapsed time
+	//Frames that need more than maxSubSteps steps drop the remaining time (no spiral of death)
+	void SetFixedTimeStep(float fixedTimeStep, UINT maxSubSteps = 4) { m_FixedTimeStep = fixedTimeStep; m_MaxSubSteps = maxSubSteps; m_Accumulator = 0.f; }
+	float GetFixedTimeStep() const { return m_FixedTimeStep; }
+
+	//Render interpolation between the previous and the latest step (see RigidBodyComponent::GetRenderPose)
+	float GetInterpolationAlpha() const { return m_FixedTimeStep > 0.f && !m_PhysXFrameStepping ? m_Accumulator / m_FixedTimeStep : 1.f; }
+	UINT GetStepIndex() const { return m_StepIndex; }
 	bool Raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal distance,
 	             PxRaycastCallback& hitCall,
 	             PxHitFlags hitFlags = PxHitFlags(PxHitFlag::eDEFAULT),
@@ -41,11 +61,25 @@ private:
 	void onAdvance(const PxRigidBody* const* /*bodyBuffer*/, const PxTransform* /*poseBuffer*/, const PxU32 /*count*/) override {};
 	void onTrigger(PxTriggerPair* pairs, PxU32 count) override;
 
+	UINT ConsumeSteps(const SceneContext& sceneContext, float& stepTime);
+	void FixedUpdate(float stepTime); //GameScene::RootFixedUpdate of a step
+	void Step(float stepTime);
+	void CaptureActivePoses();
+
+	GameScene* m_pScene{};
 	PxScene* m_pPhysxScene{};
 	PxControllerManager* m_pControllerManager{};
 	bool m_DrawPhysx{};
 	bool m_IsInitialized{};
 
+	bool m_IsSimulating{};
+	std::chrono::time_point<std::chrono::steady_clock> m_SimulateStart{};
+
+	float m_FixedTimeStep{ 1.f / 60.f };
+	UINT m_MaxSubSteps{ 4 };
+	float m_Accumulator{};
+	UINT m_StepIndex{};
+
 	//Static debug variables
 	static bool m_PhysXFrameStepping;
 	static float m_PhysXStepTime;
@@ -18,8 +18,12 @@ void FollowCamera::Update(const SceneContext& sceneContext)
 {
 	if (m_pCamera->IsActive())
 	{
-		const auto targetTransform{ m_pTarget->GetTransform() };
-		const auto targetPos{ XMLoadFloat3(&targetTransform->GetPosition()) };
+		//Follows the pose the target is drawn with (interpolated between physics steps)
+		const XMFLOAT4X4 targetWorld{ m_pTarget->GetTransform()->GetRenderWorld() };
+		const XMMATRIX targetRenderWorld{ XMLoadFloat4x4(&targetWorld) };
+		const auto targetPos{ targetRenderWorld.r[3] };
+		XMFLOAT3 targetForward{};
+		XMStoreFloat3(&targetForward, XMVector3Normalize(targetRenderWorld.r[2]));
 		const auto speed{ std::clamp(std::powf(m_pVehicle->computeForwardSpeed() * 0.075f, 2.f), 0.f, m_MaxLookAhead) };
 
 		const auto offset
@@ -40,7 +44,7 @@ void FollowCamera::Update(const SceneContext& sceneContext)
 					targetPos,
 					XMVectorMultiply
 					(
-						XMLoadFloat3(&targetTransform->GetForward()),
+						XMLoadFloat3(&targetForward),
 						XMVectorSet(speed, speed, speed, 0.f)
 					)
 				),
@@ -49,9 +49,12 @@ void FreeCamera::Update(const SceneContext& sceneContext)
 		}
 
 		//CALCULATE TRANSFORMS
-		const auto forward = XMLoadFloat3(&GetTransform()->GetForward());
-		const auto right = XMLoadFloat3(&GetTransform()->GetRight());
-		auto currPos = XMLoadFloat3(&GetTransform()->GetPosition());
+		const XMFLOAT3 transformForward{ GetTransform()->GetForward() };
+		const XMFLOAT3 transformRight{ GetTransform()->GetRight() };
+		const XMFLOAT3 transformPosition{ GetTransform()->GetPosition() };
+		const auto forward = XMLoadFloat3(&transformForward);
+		const auto right = XMLoadFloat3(&transformRight);
+		auto currPos = XMLoadFloat3(&transformPosition);
 		const auto elapsedTime = sceneContext.pGameTime->GetElapsed();
 
 		currPos += forward * move.y * currSpeed * elapsedTime;
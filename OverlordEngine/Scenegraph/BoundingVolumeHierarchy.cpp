@@ -0,0 +1,349 @@
+#include "stdafx.h"
+#include "BoundingVolumeHierarchy.h"
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin):
+	m_Margin(margin)
+{
+}
+
+UINT BoundingVolumeHierarchy::CreateProxy(const BoundingBox& bounds, void* pUserData)
+{
+	const UINT proxy{ AllocateNode() };
+	Node& node{ m_Nodes[proxy] };
+	node.height = 0;
+	node.pUserData = pUserData;
+	SetFatBounds(proxy, bounds);
+
+	InsertLeaf(proxy);
+	++m_Stats.proxyCount;
+
+	return proxy;
+}
+
+void BoundingVolumeHierarchy::DestroyProxy(UINT proxy)
+{
+	ASSERT_IF(proxy >= m_Nodes.size() || !m_Nodes[proxy].IsLeaf() || m_Nodes[proxy].height != 0, L"BoundingVolumeHierarchy::DestroyProxy > Invalid proxy ({})", proxy);
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--m_Stats.proxyCount;
+}
+
+bool BoundingVolumeHierarchy::MoveProxy(UINT proxy, const BoundingBox& bounds)
+{
+	ASSERT_IF(proxy >= m_Nodes.size() || !m_Nodes[proxy].IsLeaf() || m_Nodes[proxy].height != 0, L"BoundingVolumeHierarchy::MoveProxy > Invalid proxy ({})", proxy);
+
+	//Still inside the fat bounds, the tree doesn't change
+	const XMFLOAT3 min{ bounds.Center.x - bounds.Extents.x, bounds.Center.y - bounds.Extents.y, bounds.Center.z - bounds.Extents.z };
+	const XMFLOAT3 max{ bounds.Center.x + bounds.Extents.x, bounds.Center.y + bounds.Extents.y, bounds.Center.z + bounds.Extents.z };
+	if (Contains(m_Nodes[proxy], min, max))
+	{
+		++m_Stats.refits;
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	SetFatBounds(proxy, bounds);
+	InsertLeaf(proxy);
+
+	++m_Stats.reinserts;
+	return true;
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+	m_Nodes.clear();
+	m_Root = m_NullNode;
+	m_FreeList = m_NullNode;
+	m_Stats = {};
+}
+
+BoundingBox BoundingVolumeHierarchy::GetFatBounds(UINT proxy) const
+{
+	const Node& node{ m_Nodes[proxy] };
+
+	BoundingBox bounds{};
+	BoundingBox::CreateFromPoints(bounds, XMLoadFloat3(&node.min), XMLoadFloat3(&node.max));
+	return bounds;
+}
+
+float BoundingVolumeHierarchy::ComputeCost() const
+{
+	if (m_Root == m_NullNode)
+		return 0.f;
+
+	const float rootArea{ Area(m_Nodes[m_Root].min, m_Nodes[m_Root].max) };
+	if (rootArea <= 0.f)
+		return 0.f;
+
+	float totalArea{};
+	for (const Node& node : m_Nodes)
+	{
+		if (node.height > 0)
+			totalArea += Area(node.min, node.max);
+	}
+
+	return totalArea / rootArea;
+}
+
+#pragma region Helpers
+float BoundingVolumeHierarchy::Area(const XMFLOAT3& min, const XMFLOAT3& max)
+{
+	const float dx{ max.x - min.x }, dy{ max.y - min.y }, dz{ max.z - min.z };
+	return 2.f * (dx * dy + dy * dz + dz * dx);
+}
+
+void BoundingVolumeHierarchy::Union(const Node& a, const Node& b, XMFLOAT3& min, XMFLOAT3& max)
+{
+	min = { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) };
+	max = { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) };
+}
+
+bool BoundingVolumeHierarchy::Contains(const Node& outer, const XMFLOAT3& min, const XMFLOAT3& max)
+{
+	return outer.min.x <= min.x && outer.min.y <= min.y && outer.min.z <= min.z &&
+		max.x <= outer.max.x && max.y <= outer.max.y && max.z <= outer.max.z;
+}
+
+void BoundingVolumeHierarchy::SetFatBounds(UINT leaf, const BoundingBox& bounds)
+{
+	Node& node{ m_Nodes[leaf] };
+	node.min = { bounds.Center.x - bounds.Extents.x - m_Margin, bounds.Center.y - bounds.Extents.y - m_Margin, bounds.Center.z - bounds.Extents.z - m_Margin };
+	node.max = { bounds.Center.x + bounds.Extents.x + m_Margin, bounds.Center.y + bounds.Extents.y + m_Margin, bounds.Center.z + bounds.Extents.z + m_Margin };
+}
+#pragma endregion
+
+#pragma region Node Pool
+UINT BoundingVolumeHierarchy::AllocateNode()
+{
+	if (m_FreeList == m_NullNode)
+	{
+		m_Nodes.emplace_back();
+		++m_Stats.nodeCount;
+		return static_cast<UINT>(m_Nodes.size() - 1);
+	}
+
+	const UINT node{ m_FreeList };
+	m_FreeList = m_Nodes[node].parent;
+	m_Nodes[node] = {};
+	++m_Stats.nodeCount;
+	return node;
+}
+
+void BoundingVolumeHierarchy::FreeNode(UINT node)
+{
+	m_Nodes[node] = {};
+	m_Nodes[node].parent = m_FreeList;
+	m_FreeList = node;
+	--m_Stats.nodeCount;
+}
+#pragma endregion
+
+#pragma region Tree Maintenance
+void BoundingVolumeHierarchy::InsertLeaf(UINT leaf)
+{
+	if (m_Root == m_NullNode)
+	{
+		m_Root = leaf;
+		m_Nodes[leaf].parent = m_NullNode;
+		m_Stats.height = 0;
+		return;
+	}
+
+	//Find the best sibling (surface area heuristic, descend while it is cheaper than pairing with the current node)
+	const Node leafNode{ m_Nodes[leaf] };
+	UINT sibling{ m_Root };
+	while (!m_Nodes[sibling].IsLeaf())
+	{
+		const Node& node{ m_Nodes[sibling] };
+
+		XMFLOAT3 combinedMin{}, combinedMax{};
+		Union(node, leafNode, combinedMin, combinedMax);
+		const float area{ Area(node.min, node.max) };
+		const float combinedArea{ Area(combinedMin, combinedMax) };
+
+		//Cost of creating a new parent here, and the extra cost pushed down onto the children
+		const float cost{ 2.f * combinedArea };
+		const float inheritanceCost{ 2.f * (combinedArea - area) };
+
+		const auto childCost = [&](UINT child)
+		{
+			const Node& childNode{ m_Nodes[child] };
+			XMFLOAT3 min{}, max{};
+			Union(childNode, leafNode, min, max);
+			if (childNode.IsLeaf())
+				return Area(min, max) + inheritanceCost;
+
+			return Area(min, max) - Area(childNode.min, childNode.max) + inheritanceCost;
+		};
+
+		const float cost1{ childCost(node.child1) };
+		const float cost2{ childCost(node.child2) };
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		sibling = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	//New parent for the sibling and the leaf
+	const UINT oldParent{ m_Nodes[sibling].parent };
+	const UINT newParent{ AllocateNode() };
+	{
+		Node& parentNode{ m_Nodes[newParent] };
+		parentNode.parent = oldParent;
+		parentNode.pUserData = nullptr;
+		Union(m_Nodes[sibling], m_Nodes[leaf], parentNode.min, parentNode.max);
+		parentNode.height = m_Nodes[sibling].height + 1;
+		parentNode.child1 = sibling;
+		parentNode.child2 = leaf;
+	}
+
+	if (oldParent != m_NullNode)
+	{
+		if (m_Nodes[oldParent].child1 == sibling)
+			m_Nodes[oldParent].child1 = newParent;
+		else
+			m_Nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		m_Root = newParent;
+	}
+
+	m_Nodes[sibling].parent = newParent;
+	m_Nodes[leaf].parent = newParent;
+
+	RefitAncestors(m_Nodes[leaf].parent);
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf(UINT leaf)
+{
+	if (leaf == m_Root)
+	{
+		m_Root = m_NullNode;
+		m_Stats.height = 0;
+		return;
+	}
+
+	//The parent is replaced by the sibling
+	const UINT parent{ m_Nodes[leaf].parent };
+	const UINT grandParent{ m_Nodes[parent].parent };
+	const UINT sibling{ m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1 };
+
+	if (grandParent != m_NullNode)
+	{
+		if (m_Nodes[grandParent].child1 == parent)
+			m_Nodes[grandParent].child1 = sibling;
+		else
+			m_Nodes[grandParent].child2 = sibling;
+
+		m_Nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		RefitAncestors(grandParent);
+	}
+	else
+	{
+		m_Root = sibling;
+		m_Nodes[sibling].parent = m_NullNode;
+		FreeNode(parent);
+		m_Stats.height = static_cast<UINT>(m_Nodes[m_Root].height);
+	}
+
+	m_Nodes[leaf].parent = m_NullNode;
+}
+
+void BoundingVolumeHierarchy::RefitAncestors(UINT node)
+{
+	//Walk back to the root, rebalancing and refitting every ancestor
+	while (node != m_NullNode)
+	{
+		node = Balance(node);
+
+		Node& current{ m_Nodes[node] };
+		const Node& child1{ m_Nodes[current.child1] };
+		const Node& child2{ m_Nodes[current.child2] };
+
+		current.height = 1 + std::max(child1.height, child2.height);
+		Union(child1, child2, current.min, current.max);
+
+		node = current.parent;
+	}
+
+	m_Stats.height = static_cast<UINT>(m_Nodes[m_Root].height);
+}
+
+UINT BoundingVolumeHierarchy::Balance(UINT a)
+{
+	//Tree rotation (AVL style), promotes the higher grandchild when the children differ by more than one level
+	const Node& node{ m_Nodes[a] };
+	if (node.IsLeaf() || node.height < 2)
+		return a;
+
+	const UINT b{ node.child1 };
+	const UINT c{ node.child2 };
+	const int balance{ m_Nodes[c].height - m_Nodes[b].height };
+
+	//Rotates 'up' above a, the lower child of 'up' takes its place under a
+	const auto rotate = [this, a](UINT up, UINT other)
+	{
+		Node& nodeA{ m_Nodes[a] };
+		Node& nodeUp{ m_Nodes[up] };
+		const UINT f{ nodeUp.child1 };
+		const UINT g{ nodeUp.child2 };
+
+		//Swap a and up
+		nodeUp.child1 = a;
+		nodeUp.parent = nodeA.parent;
+		nodeA.parent = up;
+
+		if (nodeUp.parent != m_NullNode)
+		{
+			if (m_Nodes[nodeUp.parent].child1 == a)
+				m_Nodes[nodeUp.parent].child1 = up;
+			else
+				m_Nodes[nodeUp.parent].child2 = up;
+		}
+		else
+		{
+			m_Root = up;
+		}
+
+		const bool isUpFirst{ nodeA.child1 == up };
+		const auto replace = [&](UINT keep, UINT move)
+		{
+			nodeUp.child2 = keep;
+			if (isUpFirst)
+				nodeA.child1 = move;
+			else
+				nodeA.child2 = move;
+			m_Nodes[move].parent = a;
+
+			Union(m_Nodes[other], m_Nodes[move], nodeA.min, nodeA.max);
+			Union(nodeA, m_Nodes[keep], nodeUp.min, nodeUp.max);
+
+			nodeA.height = 1 + std::max(m_Nodes[other].height, m_Nodes[move].height);
+			nodeUp.height = 1 + std::max(nodeA.height, m_Nodes[keep].height);
+		};
+
+		if (m_Nodes[f].height > m_Nodes[g].height)
+			replace(f, g);
+		else
+			replace(g, f);
+	};
+
+	if (balance > 1)
+	{
+		rotate(c, b);
+		return c;
+	}
+
+	if (balance < -1)
+	{
+		rotate(b, c);
+		return b;
+	}
+
+	return a;
+}
+#pragma endregion
@@ -0,0 +1,246 @@
+#pragma once
+
+//Dynamic AABB tree (scene spatial index, owned by a GameScene)
+//Leaves store a fattened AABB, moving a proxy only touches the tree when it leaves its fat bounds
+//(the leaf is reinserted and the ancestors are refitted/rebalanced on the way up)
+//Query results are conservative (fat bounds), callers do their own exact test if needed
+class BoundingVolumeHierarchy final
+{
+public:
+	static constexpr UINT InvalidProxy{ UINT_MAX };
+
+	struct Stats
+	{
+		UINT proxyCount{};
+		UINT nodeCount{};
+		UINT height{};
+		UINT reinserts{}; //MoveProxy calls that changed the tree (since ResetStats)
+		UINT refits{}; //MoveProxy calls that stayed inside the fat bounds (since ResetStats)
+	};
+
+	explicit BoundingVolumeHierarchy(float margin = 0.1f);
+	~BoundingVolumeHierarchy() = default;
+	BoundingVolumeHierarchy(const BoundingVolumeHierarchy& other) = delete;
+	BoundingVolumeHierarchy(BoundingVolumeHierarchy&& other) noexcept = delete;
+	BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy& other) = delete;
+	BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&& other) noexcept = delete;
+
+	UINT CreateProxy(const BoundingBox& bounds, void* pUserData);
+	void DestroyProxy(UINT proxy);
+	//Returns true if the proxy had to be reinserted
+	bool MoveProxy(UINT proxy, const BoundingBox& bounds);
+	void Clear();
+
+	void* GetUserData(UINT proxy) const { return m_Nodes[proxy].pUserData; }
+	BoundingBox GetFatBounds(UINT proxy) const;
+
+#pragma region Queries
+	//func(void* pUserData) for every proxy whose fat bounds overlap the volume
+	template<typename Func>
+	void QueryAABB(const BoundingBox& bounds, Func func) const;
+
+	template<typename Func>
+	void QuerySphere(const BoundingSphere& sphere, Func func) const;
+
+	//Planes extracted from a (row-vector, D3D clip space) view projection matrix (see CullingFrustum), fully contained subtrees are not tested further
+	template<typename Func>
+	void QueryFrustum(const XMFLOAT4X4& viewProjection, Func func) const;
+
+	//func(void* pUserData, float distance) for every proxy hit within maxDistance (unordered), distance == entry distance of its fat bounds
+	//The callback returns the new max distance (clips the remaining traversal), a negative value keeps the current one
+	template<typename Func>
+	void Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, Func func) const;
+#pragma endregion
+
+	const Stats& GetStats() const { return m_Stats; }
+	void ResetStats() { m_Stats.reinserts = 0; m_Stats.refits = 0; }
+
+	//Sum of the internal node surface areas relative to the root (tree quality, lower is better)
+	float ComputeCost() const;
+
+private:
+	static constexpr UINT m_NullNode{ UINT_MAX };
+
+	struct Node
+	{
+		XMFLOAT3 min{};
+		UINT parent{ m_NullNode }; //Next free node while on the free list
+		XMFLOAT3 max{};
+		int height{ -1 }; //Leaf == 0, free == -1
+		UINT child1{ m_NullNode };
+		UINT child2{ m_NullNode };
+		void* pUserData{};
+
+		bool IsLeaf() const { return child1 == m_NullNode; }
+	};
+
+	static float Area(const XMFLOAT3& min, const XMFLOAT3& max);
+	static void Union(const Node& a, const Node& b, XMFLOAT3& min, XMFLOAT3& max);
+	static bool Contains(const Node& outer, const XMFLOAT3& min, const XMFLOAT3& max);
+
+	UINT AllocateNode();
+	void FreeNode(UINT node);
+	void InsertLeaf(UINT leaf);
+	void RemoveLeaf(UINT leaf);
+	void RefitAncestors(UINT node);
+	UINT Balance(UINT node);
+	void SetFatBounds(UINT leaf, const BoundingBox& bounds);
+
+	std::vector<Node> m_Nodes{};
+	UINT m_Root{ m_NullNode };
+	UINT m_FreeList{ m_NullNode };
+	float m_Margin{};
+	Stats m_Stats{};
+};
+
+#pragma region Query Implementations
+template <typename Func>
+void BoundingVolumeHierarchy::QueryAABB(const BoundingBox& bounds, Func func) const
+{
+	if (m_Root == m_NullNode)
+		return;
+
+	const XMFLOAT3 min{ bounds.Center.x - bounds.Extents.x, bounds.Center.y - bounds.Extents.y, bounds.Center.z - bounds.Extents.z };
+	const XMFLOAT3 max{ bounds.Center.x + bounds.Extents.x, bounds.Center.y + bounds.Extents.y, bounds.Center.z + bounds.Extents.z };
+
+	SmallVector<UINT, 64> stack{};
+	stack.push_back(m_Root);
+	while (!stack.empty())
+	{
+		const Node& node{ m_Nodes[stack.back()] };
+		stack.pop_back();
+
+		if (node.max.x < min.x || node.min.x > max.x ||
+			node.max.y < min.y || node.min.y > max.y ||
+			node.max.z < min.z || node.min.z > max.z)
+			continue;
+
+		if (node.IsLeaf())
+		{
+			func(node.pUserData);
+			continue;
+		}
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+}
+
+template <typename Func>
+void BoundingVolumeHierarchy::QuerySphere(const BoundingSphere& sphere, Func func) const
+{
+	if (m_Root == m_NullNode)
+		return;
+
+	const XMFLOAT3& center{ sphere.Center };
+	const float radiusSq{ sphere.Radius * sphere.Radius };
+
+	SmallVector<UINT, 64> stack{};
+	stack.push_back(m_Root);
+	while (!stack.empty())
+	{
+		const Node& node{ m_Nodes[stack.back()] };
+		stack.pop_back();
+
+		//Squared distance from the center to the box
+		const float dx{ std::max({ node.min.x - center.x, 0.f, center.x - node.max.x }) };
+		const float dy{ std::max({ node.min.y - center.y, 0.f, center.y - node.max.y }) };
+		const float dz{ std::max({ node.min.z - center.z, 0.f, center.z - node.max.z }) };
+		if (dx * dx + dy * dy + dz * dz > radiusSq)
+			continue;
+
+		if (node.IsLeaf())
+		{
+			func(node.pUserData);
+			continue;
+		}
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+}
+
+template <typename Func>
+void BoundingVolumeHierarchy::QueryFrustum(const XMFLOAT4X4& viewProjection, Func func) const
+{
+	if (m_Root == m_NullNode)
+		return;
+
+	const CullingFrustum frustum{ viewProjection };
+
+	struct Entry
+	{
+		UINT node;
+		bool isInside; //Subtree is fully inside the frustum, no more plane tests
+	};
+
+	SmallVector<Entry, 64> stack{};
+	stack.push_back({ m_Root, false });
+	while (!stack.empty())
+	{
+		const auto [nodeIndex, isInside] = stack.back();
+		stack.pop_back();
+		const Node& node{ m_Nodes[nodeIndex] };
+
+		bool isContained{ isInside };
+		if (!isInside)
+		{
+			const XMFLOAT3 center{ (node.min.x + node.max.x) * .5f, (node.min.y + node.max.y) * .5f, (node.min.z + node.max.z) * .5f };
+			const XMFLOAT3 extents{ (node.max.x - node.min.x) * .5f, (node.max.y - node.min.y) * .5f, (node.max.z - node.min.z) * .5f };
+
+			const ContainmentType containment{ frustum.Test(center, extents) };
+			if (containment == DISJOINT)
+				continue;
+
+			isContained = containment == CONTAINS;
+		}
+
+		if (node.IsLeaf())
+		{
+			func(node.pUserData);
+			continue;
+		}
+
+		stack.push_back({ node.child1, isContained });
+		stack.push_back({ node.child2, isContained });
+	}
+}
+
+template <typename Func>
+void BoundingVolumeHierarchy::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, Func func) const
+{
+	if (m_Root == m_NullNode)
+		return;
+
+	//Slab test, a zero direction component gives +-inf (the origin has to be inside that slab)
+	const XMFLOAT3 inverse{ 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+
+	SmallVector<UINT, 64> stack{};
+	stack.push_back(m_Root);
+	while (!stack.empty())
+	{
+		const Node& node{ m_Nodes[stack.back()] };
+		stack.pop_back();
+
+		const float tx1{ (node.min.x - origin.x) * inverse.x }, tx2{ (node.max.x - origin.x) * inverse.x };
+		const float ty1{ (node.min.y - origin.y) * inverse.y }, ty2{ (node.max.y - origin.y) * inverse.y };
+		const float tz1{ (node.min.z - origin.z) * inverse.z }, tz2{ (node.max.z - origin.z) * inverse.z };
+
+		const float tEnter{ std::max({ std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), 0.f }) };
+		const float tExit{ std::min({ std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), maxDistance }) };
+		if (tEnter > tExit)
+			continue;
+
+		if (node.IsLeaf())
+		{
+			const float newMaxDistance{ func(node.pUserData, tEnter) };
+			if (newMaxDistance >= 0.f)
+				maxDistance = newMaxDistance;
+			continue;
+		}
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+}
+#pragma endregion
@@ -7,6 +7,7 @@ GameObject::GameObject(bool isShadowMapStatic):
 	m_pTransform(new TransformComponent{}),
 	m_IsShadowMapStatic(isShadowMapStatic)
 {
+	m_ComponentSlots.fill(UINT8_MAX);
 	AddComponent(m_pTransform);
 }
 GameObject::~GameObject()
@@ -68,7 +69,7 @@ void GameObject::RootPostInitialize(const SceneContext& sceneContext)
 
 void GameObject::RootUpdate(const SceneContext& sceneContext)
 {
-	if (!m_IsActive) return;
+	if (!m_IsActive || m_IsFrozen) return;
 
 	//User-Object Update
 	Update(sceneContext);
@@ -85,6 +86,32 @@ void GameObject::RootUpdate(const SceneContext& sceneContext)
 		pChild->RootUpdate(sceneContext);
 	}
 }
+
+void GameObject::RootObjectUpdate(const SceneContext& sceneContext)
+{
+	if (!m_IsActive || m_IsFrozen) return;
+
+	//User-Object Update
+	Update(sceneContext);
+
+	//Root-Object Update
+	for (GameObject* pChild : m_pChildren)
+	{
+		pChild->RootObjectUpdate(sceneContext);
+	}
+}
+
+bool GameObject::IsUpdateEnabled() const
+{
+	for (const GameObject* pObject = this; pObject; pObject = pObject->m_pParentObject)
+	{
+		if (!pObject->m_IsActive || pObject->m_IsFrozen)
+			return false;
+	}
+
+	return true;
+}
+
 void GameObject::RootDraw(const SceneContext& sceneContext)
 {
 	if (!m_IsActive) return;
@@ -219,6 +246,10 @@ void GameObject::AddChild_(GameObject* pObject)
 	pObject->m_pParentObject = this;
 	m_pChildren.push_back(pObject);
 
+	//Children of a frozen object are frozen as well
+	if (m_IsFrozen)
+		pObject->SetFrozen(true);
+
 	//Signal object (Attached to parent)
 	pObject->OnParentAttach(this); 
 
@@ -260,7 +291,7 @@ void GameObject::RemoveChild(GameObject* obj, bool deleteObject)
 void GameObject::AddComponent_(BaseComponent* pComponent)
 {
 #if _DEBUG
-	if (typeid(*pComponent) == typeid(TransformComponent) && HasComponent<TransformComponent>())
+	if (typeid(*pComponent) == typeid(TransformComponent) && HasComponentType(ComponentTypeRegistry::GetTypeId<TransformComponent>()))
 	{
 		Logger::LogWarning(L"GameObject::AddComponent > GameObject can contain only one TransformComponent!");
 		return;
@@ -279,6 +310,16 @@ void GameObject::AddComponent_(BaseComponent* pComponent)
 	m_pComponents.push_back(pComponent);
 	pComponent->m_pGameObject = this;	
 
+	//Register type (slow path, once per component)
+	const ComponentTypeId typeId{ ComponentTypeRegistry::GetTypeId(typeid(*pComponent)) };
+	pComponent->m_TypeId = typeId;
+	if (!HasComponentType(typeId))
+	{
+		ASSERT_IF(m_pComponents.size() > UINT8_MAX, L"GameObject::AddComponent > Too many components on a single GameObject");
+		m_ComponentMask |= 1ull << typeId;
+		m_ComponentSlots[typeId] = static_cast<uint8_t>(m_pComponents.size() - 1);
+	}
+
 	//Signal Component (Attached to GameObject)
 	pComponent->OnOwnerAttach(this);
 
@@ -289,7 +330,7 @@ void GameObject::AddComponent_(BaseComponent* pComponent)
 
 void GameObject::RemoveComponent(BaseComponent* pComponent, bool deleteObject)
 {
-	auto it = find(m_pComponents.begin(), m_pComponents.end(), pComponent);
+	const auto it = std::ranges::find(m_pComponents, pComponent);
 
 #if _DEBUG
 	if(it == m_pComponents.end())
@@ -307,6 +348,11 @@ void GameObject::RemoveComponent(BaseComponent* pComponent, bool deleteObject)
 
 	m_pComponents.erase(it);
 	pComponent->m_pGameObject = nullptr;
+	RebuildComponentLookup();
+
+	//Remove from the scene-wide component index
+	if (GameScene* pScene = GetScene())
+		pScene->UnregisterComponent(pComponent);
 
 	//Signal about GameObject detach
 	pComponent->OnOwnerDetach(this); 
@@ -317,6 +363,22 @@ void GameObject::RemoveComponent(BaseComponent* pComponent, bool deleteObject)
 	}
 }
 
+void GameObject::RebuildComponentLookup()
+{
+	m_ComponentMask = 0;
+	m_ComponentSlots.fill(UINT8_MAX);
+
+	for (size_t i{}; i < m_pComponents.size(); ++i)
+	{
+		const ComponentTypeId typeId{ m_pComponents[i]->m_TypeId };
+		if (!HasComponentType(typeId))
+		{
+			m_ComponentMask |= 1ull << typeId;
+			m_ComponentSlots[typeId] = static_cast<uint8_t>(i);
+		}
+	}
+}
+
 void GameObject::OnTrigger(GameObject* pTriggerObject, GameObject* pOtherObject, PxTriggerAction action) const
 {
 	if(m_OnTriggerCallback)
@@ -333,6 +395,16 @@ GameScene* GameObject::GetScene() const
 	return m_pParentScene;
 }
 
+void GameObject::SetFrozen(bool frozen)
+{
+	m_IsFrozen = frozen;
+
+	for (GameObject* pChild : m_pChildren)
+	{
+		pChild->SetFrozen(frozen);
+	}
+}
+
 void GameObject::SetOnTriggerCallBack(PhysicsCallback callback)
 {
 	m_OnTriggerCallback = callback;
@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <array>
 
 enum class PxTriggerAction
 {
@@ -19,6 +20,10 @@ public:
 	GameObject& operator=(const GameObject& other) = delete;
 	GameObject& operator=(GameObject&& other) noexcept = delete;
 
+	//Allocated from the current scene's PoolAllocator (see GameScene)
+	static void* operator new(size_t size) { return PoolAllocator::AllocateObject(size); }
+	static void operator delete(void* pObject) { PoolAllocator::FreeObject(pObject); }
+
 	template<typename T>
 	std::enable_if_t<std::is_base_of_v<GameObject, T>, T*>
 	AddChild(T* pObject)
@@ -46,7 +51,12 @@ public:
 
 	bool GetIsShadowMapStatic() const { return m_IsShadowMapStatic; }
 
+	//Frozen subtrees are static: skipped by the update walk, transforms can't change
+	void SetFrozen(bool frozen);
+	bool GetIsFrozen() const { return m_IsFrozen; }
+
 	TransformComponent* GetTransform() const { return m_pTransform; }
+	bool HasComponentType(ComponentTypeId typeId) const { return (m_ComponentMask & (1ull << typeId)) != 0; }
 
 	GameScene* GetScene() const;
 	GameObject* GetParent() const { return m_pParentObject; }
@@ -63,19 +73,17 @@ public:
 	template <class T>
 	T* GetComponent(bool searchChildren = false)
 	{
-		const type_info& ti = typeid(T);
-		for (auto* component : m_pComponents)
-		{
-			if (component && typeid(*component) == ti)
-				return static_cast<T*>(component);
-		}
+		//Direct slot lookup (type mask)
+		const ComponentTypeId typeId{ ComponentTypeRegistry::GetTypeId<T>() };
+		if (HasComponentType(typeId))
+			return static_cast<T*>(m_pComponents[m_ComponentSlots[typeId]]);
 
 		if (searchChildren)
 		{
 			for (auto* child : m_pChildren)
 			{
-				if (child->GetComponent<T>(searchChildren) != nullptr)
-					return child->GetComponent<T>(searchChildren);
+				if (T* pComponent = child->GetComponent<T>(searchChildren))
+					return pComponent;
 			}
 		}
 
@@ -85,13 +93,17 @@ public:
 	template <class T>
 	std::vector<T*> GetComponents(bool searchChildren = false)
 	{
-		const type_info& ti = typeid(T);
+		const ComponentTypeId typeId{ ComponentTypeRegistry::GetTypeId<T>() };
 		std::vector<T*> components;
 
-		for (auto* component : m_pComponents)
+		//Start at the first component of this type
+		if (HasComponentType(typeId))
 		{
-			if (component && typeid(*component) == ti)
-				components.push_back(static_cast<T*>(component));
+			for (size_t i{ m_ComponentSlots[typeId] }; i < m_pComponents.size(); ++i)
+			{
+				if (m_pComponents[i]->GetComponentTypeId() == typeId)
+					components.push_back(static_cast<T*>(m_pComponents[i]));
+			}
 		}
 
 		if (searchChildren)
@@ -99,9 +111,7 @@ public:
 			for (auto* child : m_pChildren)
 			{
 				auto childComponents = child->GetComponents<T>(searchChildren);
-
-				for (auto* childComp : childComponents)
-					components.push_back(static_cast<T*>(childComp));
+				components.insert(components.end(), childComponents.begin(), childComponents.end());
 			}
 		}
 
@@ -152,6 +162,8 @@ private:
 	void RootInitialize(const SceneContext& sceneContext);
 	void RootPostInitialize(const SceneContext& sceneContext);
 	void RootUpdate(const SceneContext& sceneContext);
+	void RootObjectUpdate(const SceneContext& sceneContext); //GameObject::Update only (components are updated per type)
+	bool IsUpdateEnabled() const; //Active & not frozen, including all parents
 	void RootDraw(const SceneContext& sceneContext);
 	void RootPostDraw(const SceneContext& sceneContext); //TODO: collapse in single Draw with context
 	void RootShadowMapDraw(const SceneContext& sceneContext) const; //TODO: collapse in single Draw with context
@@ -160,11 +172,16 @@ private:
 
 	void AddChild_(GameObject* pObject);
 	void AddComponent_(BaseComponent* pComponent);
+	void RebuildComponentLookup();
+
+	SmallVector<GameObject*, 4> m_pChildren{};
+	SmallVector<BaseComponent*, 4> m_pComponents{};
 
-	std::vector<GameObject*> m_pChildren{};
-	std::vector<BaseComponent*> m_pComponents{};
+	//Component lookup, bit/slot per ComponentTypeId (slot == first component of that type)
+	uint64_t m_ComponentMask{};
+	std::array<uint8_t, ComponentTypeRegistry::MaxComponentTypes> m_ComponentSlots{};
 
-	bool m_IsInitialized{}, m_IsActive{}, m_IsShadowMapStatic{};
+	bool m_IsInitialized{}, m_IsActive{}, m_IsShadowMapStatic{}, m_IsFrozen{};
 	GameScene* m_pParentScene{};
 	GameObject* m_pParentObject{};
 	TransformComponent* m_pTransform{};
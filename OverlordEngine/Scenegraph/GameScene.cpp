@@ -1,25 +1,84 @@
 #include "stdafx.h"
 #include "GameScene.h"
 
+class GameScene::ActiveScope final
+{
+public:
+	explicit ActiveScope(GameScene& scene) :
+		m_AllocatorScope(scene.m_pAllocator),
+		m_ContentScope(&scene.m_ContentScope),
+		m_MaterialScope(&scene.m_MaterialIds)
+	{
+	}
+	~ActiveScope() = default;
+	ActiveScope(const ActiveScope& other) = delete;
+	ActiveScope(ActiveScope&& other) noexcept = delete;
+	ActiveScope& operator=(const ActiveScope& other) = delete;
+	ActiveScope& operator=(ActiveScope&& other) noexcept = delete;
+
+private:
+	PoolAllocator::Scope m_AllocatorScope;
+	ContentScope::Active m_ContentScope;
+	MaterialManager::Scope m_MaterialScope;
+};
+
 GameScene::GameScene(std::wstring sceneName):
-	m_SceneName(std::move(sceneName))
+	m_SceneName(std::move(sceneName)),
+	m_pTransformHierarchy(new TransformHierarchy()),
+	m_pSpatialIndex(new BoundingVolumeHierarchy()),
+	m_pRenderQueue(new RenderQueue()),
+	m_pStaticBatcher(new StaticBatcher()),
+	m_pAllocator(new PoolAllocator())
 {
 }
 
 GameScene::~GameScene()
 {
+	ReleaseSceneGraph();
+
+	SafeDelete(m_pTransformHierarchy);
+	SafeDelete(m_pRenderQueue);
+	SafeDelete(m_pStaticBatcher);
+	ReleaseAllocator();
+}
+
+void GameScene::ReleaseSceneGraph()
+{
+	//Actors can't be released while the scene is simulating
+	if (m_pPhysxProxy)
+		m_pPhysxProxy->FetchResults();
+
 	SafeDelete(m_SceneContext.pGameTime);
 	SafeDelete(m_SceneContext.pInput);
 	SafeDelete(m_SceneContext.pLights);
 
+	//Pooled objects are released in bulk (slabs) instead of being returned one by one
+	m_pAllocator->BeginTeardown();
+
+	//Released as a whole, ModelComponents don't remove their proxies one by one
+	SafeDelete(m_pSpatialIndex);
+	m_pStaticBatcher->Release();
+
 	for (auto pChild : m_pChildren)
 	{
 		SafeDelete(pChild);
 	}
+	m_pChildren.clear();
 
 	SafeDelete(m_pPhysxProxy);
 }
 
+void GameScene::ReleaseAllocator()
+{
+	//Objects that were moved to another scene still live in this allocator's slabs
+	if (m_pAllocator->GetStats().liveAllocations > 0)
+	{
+		Logger::LogWarning(L"GameScene::ReleaseAllocator > {} pooled objects outlive scene \"{}\", allocator is leaked", m_pAllocator->GetStats().liveAllocations, m_SceneName);
+		m_pAllocator = nullptr;
+	}
+	SafeDelete(m_pAllocator);
+}
+
 void GameScene::AddChild_(GameObject* pObject)
 {
 #if _DEBUG
@@ -67,13 +126,57 @@ void GameScene::RemoveChild(GameObject* pObject, bool deleteObject)
 	}		
 }
 
+const std::vector<BaseComponent*>& GameScene::GetComponentsOfType(ComponentTypeId typeId) const
+{
+	static const std::vector<BaseComponent*> empty{};
+	return typeId < m_ComponentIndex.size() ? m_ComponentIndex[typeId] : empty;
+}
+
+void GameScene::RegisterComponent(BaseComponent* pComponent)
+{
+	if (pComponent->m_SceneIndex != UINT_MAX)
+		return;
+
+	const ComponentTypeId typeId{ pComponent->m_TypeId };
+	if (typeId >= m_ComponentIndex.size())
+		m_ComponentIndex.resize(typeId + 1);
+
+	auto& components = m_ComponentIndex[typeId];
+	pComponent->m_SceneIndex = static_cast<UINT>(components.size());
+	components.push_back(pComponent);
+}
+
+void GameScene::UnregisterComponent(BaseComponent* pComponent)
+{
+	if (pComponent->m_SceneIndex == UINT_MAX)
+		return;
+
+	//Swap & pop
+	auto& components = m_ComponentIndex[pComponent->m_TypeId];
+	BaseComponent* pLast{ components.back() };
+	components[pComponent->m_SceneIndex] = pLast;
+	pLast->m_SceneIndex = pComponent->m_SceneIndex;
+	components.pop_back();
+
+	pComponent->m_SceneIndex = UINT_MAX;
+}
+
 void GameScene::RootInitialize(const GameContext& gameContext)
 {
 	if (m_IsInitialized)
 		return;
 
+	RootBeginInitialize(gameContext);
+	RootContinueInitialize(FLT_MAX);
+}
+
+void GameScene::RootBeginInitialize(const GameContext& gameContext)
+{
+	const ActiveScope activeScope{ *this };
+
 	//SET Reference to OverlordGame
 	m_pGame = gameContext.pGame;
+	m_SceneContext.pJobSystem = gameContext.pJobSystem;
 
 	//SET SceneContext
 	m_SceneContext.windowWidth = static_cast<float>(gameContext.windowWidth);
@@ -105,17 +208,94 @@ void GameScene::RootInitialize(const GameContext& gameContext)
 	//User-Scene Initialize
 	Initialize();
 
-	//Root-Scene Initialize
-	for (const auto pChild : m_pChildren)
+	m_InitializeCursor = 0;
+}
+
+bool GameScene::RootContinueInitialize(float budgetMs)
+{
+	if (m_IsInitialized)
+		return true;
+
+	const ActiveScope activeScope{ *this };
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto isOverBudget = [&start, budgetMs, this]()
+	{
+		const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() >= budgetMs && (m_InitializeCursor < m_pChildren.size() || m_FinalizeCursor < m_pPendingModels.size());
+	};
+
+	//Root-Scene Initialize (children added during initialization are appended, the index stays valid)
+	//Children attached by the user Initialize are initialized already (GameObject::RootOnSceneAttach)
+	while (m_InitializeCursor < m_pChildren.size())
+	{
+		m_pChildren[m_InitializeCursor++]->RootInitialize(m_SceneContext);
+		if (isOverBudget())
+			return false;
+	}
+
+	//GPU finalize, the bulk of the work (index & vertex buffers, shadow map layouts)
+	while (m_FinalizeCursor < m_pPendingModels.size())
 	{
-		pChild->RootInitialize(m_SceneContext);
+		if (ModelComponent* pModel = m_pPendingModels[m_FinalizeCursor++])
+			pModel->BuildGpuResources(m_SceneContext);
+
+		if (isOverBudget())
+			return false;
 	}
 
+	m_pPendingModels.clear();
+	m_FinalizeCursor = 0;
 	m_IsInitialized = true;
+	return true;
+}
+
+void GameScene::CancelGpuFinalize(ModelComponent* pModel)
+{
+	std::ranges::replace(m_pPendingModels, pModel, nullptr);
+}
+
+void GameScene::RootUninitialize()
+{
+	if (!m_IsInitialized)
+		return;
+
+	ReleaseSceneGraph();
+	m_ContentScope.Release(); //Evictable from now on, unless another scene references it
+	MaterialManager::Get()->DeleteMaterials(m_MaterialIds); //Created again by the user Initialize
+
+	//Fresh hierarchy & allocator for the next initialization (TransformComponents unregistered with the children)
+	SafeDelete(m_pTransformHierarchy);
+	m_pTransformHierarchy = new TransformHierarchy();
+	m_pSpatialIndex = new BoundingVolumeHierarchy();
+	ReleaseAllocator();
+	m_pAllocator = new PoolAllocator();
+
+	m_ComponentIndex.clear();
+	m_PostProcessingMaterials.clear(); //Re-added by the user Initialize
+	m_pDefaultCamera = nullptr;
+	m_pActiveCamera = nullptr;
+	m_SceneContext.pCamera = nullptr;
+
+	m_InitializeCursor = 0;
+	m_pPendingModels.clear();
+	m_FinalizeCursor = 0;
+	m_IsInitialized = false;
+}
+
+float GameScene::GetInitializeProgress() const
+{
+	if (m_IsInitialized)
+		return 1.f;
+
+	const size_t workCount{ m_pChildren.size() + m_pPendingModels.size() };
+	return workCount == 0 ? 0.f : static_cast<float>(m_InitializeCursor + m_FinalizeCursor) / static_cast<float>(workCount);
 }
 
 void GameScene::RootPostInitialize()
 {
+	const ActiveScope activeScope{ *this };
+
 	//Root-Scene Initialize
 	for (const auto pChild : m_pChildren)
 	{
@@ -127,6 +307,8 @@ void GameScene::RootPostInitialize()
 
 void GameScene::RootUpdate()
 {
+	const ActiveScope activeScope{ *this };
+
 	m_SceneContext.pGameTime->Update();
 	m_SceneContext.pInput->Update();
 	m_SceneContext.pCamera = m_pActiveCamera;
@@ -137,16 +319,117 @@ void GameScene::RootUpdate()
 	SoundManager::Get()->GetSystem()->update();
 #pragma warning(pop)
 
-	//User-Scene Update
+	const auto updateStart = std::chrono::steady_clock::now();
+
+	//User-Scene Update (async physics: runs before the sync point, see PhysxProxy)
 	Update();
 
+	//Physics sync point, results of the step kicked at the end of the previous frame
+	m_pPhysxProxy->FetchResults();
+
+	//Synchronous steps (FixedUpdate included) before the hierarchy update, the objects pick up this frame's poses
+	m_pPhysxProxy->Update(m_SceneContext);
+
 	//Root-Scene Update
-	for (const auto pChild : m_pChildren)
+	if (m_SceneContext.settings.updateComponentsByType)
+	{
+		for (const auto pChild : m_pChildren)
+		{
+			pChild->RootObjectUpdate(m_SceneContext);
+		}
+
+		UpdateComponentBuckets();
+	}
+	else
 	{
-		pChild->RootUpdate(m_SceneContext);
+		for (const auto pChild : m_pChildren)
+		{
+			pChild->RootUpdate(m_SceneContext);
+		}
 	}
 
-	m_pPhysxProxy->Update(m_SceneContext);
+	const std::chrono::duration<float, std::milli> updateDuration = std::chrono::steady_clock::now() - updateStart;
+	GameStats::GetFrameStats().sceneUpdateMs = updateDuration.count();
+
+	//Resolve World Transforms (changed slots only)
+	m_pTransformHierarchy->Update();
+
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	frameStats.transformsRecomputed = m_pTransformHierarchy->GetRecomputedCount();
+	frameStats.transformsRegistered = m_pTransformHierarchy->GetSize();
+
+	//Refit the bounds of the models that moved
+	UpdateSpatialIndex();
+
+	//Active camera has to use this frame's transforms
+	m_pActiveCamera->UpdateMatrices(m_SceneContext);
+}
+
+void GameScene::RootFixedUpdate(float fixedTimeStep)
+{
+	const ActiveScope activeScope{ *this };
+
+	FixedUpdate(fixedTimeStep);
+}
+
+void GameScene::UpdateSpatialIndex()
+{
+	const ComponentTypeId modelTypeId{ ComponentTypeRegistry::GetTypeId<ModelComponent>() };
+
+	m_pSpatialIndex->ResetStats();
+	for (const UINT slot : m_pTransformHierarchy->GetDirtySlots())
+	{
+		GameObject* pObject{ m_pTransformHierarchy->GetOwner(slot)->GetGameObject() };
+		if (!pObject->HasComponentType(modelTypeId))
+			continue;
+
+		//Starts at the first component of that type (no allocation, unlike GetComponents)
+		for (size_t i{ pObject->m_ComponentSlots[modelTypeId] }; i < pObject->m_pComponents.size(); ++i)
+		{
+			if (pObject->m_pComponents[i]->GetComponentTypeId() != modelTypeId)
+				continue;
+
+			const auto pModel = static_cast<ModelComponent*>(pObject->m_pComponents[i]);
+			if (pModel->m_SpatialProxy != BoundingVolumeHierarchy::InvalidProxy)
+				m_pSpatialIndex->MoveProxy(pModel->m_SpatialProxy, pModel->GetWorldBounds());
+
+			//Baked vertices are stale
+			if (pModel->m_IsStaticBatched)
+				m_pStaticBatcher->Invalidate();
+		}
+	}
+
+	FrameStats& frameStats{ GameStats::GetFrameStats() };
+	frameStats.spatialRefits = m_pSpatialIndex->GetStats().refits;
+	frameStats.spatialReinserts = m_pSpatialIndex->GetStats().reinserts;
+}
+
+void GameScene::UpdateComponentBuckets()
+{
+	//Ordering contract (SceneSettings::updateComponentsByType)
+	//1. GameObject::Update of every active object, in scenegraph order (parents before children)
+	//2. TransformComponent bucket (physics <> transform sync)
+	//3. Remaining buckets in ComponentTypeId order (== order in which the types were first used)
+	//Order within a bucket is unspecified, components added during the pass may be updated the next frame
+	const ComponentTypeId transformTypeId{ ComponentTypeRegistry::GetTypeId<TransformComponent>() };
+	UpdateComponentBucket(transformTypeId);
+
+	for (ComponentTypeId typeId{}; typeId < m_ComponentIndex.size(); ++typeId)
+	{
+		if (typeId != transformTypeId)
+			UpdateComponentBucket(typeId);
+	}
+}
+
+void GameScene::UpdateComponentBucket(ComponentTypeId typeId)
+{
+	//Index based, components can be added/removed by an Update call
+	for (size_t i{}; i < m_ComponentIndex[typeId].size(); ++i)
+	{
+		BaseComponent* pComponent{ m_ComponentIndex[typeId][i] };
+		if (pComponent->GetGameObject()->IsUpdateEnabled())
+			pComponent->Update(m_SceneContext);
+	}
 }
 
 void GameScene::RootDraw()
@@ -173,6 +456,11 @@ void GameScene::RootDraw()
 #pragma endregion
 
 #pragma region USER PASS
+	//Static batches, built on the first frame of the constructed scene (world transforms are resolved by then)
+	//Rebuilt after an invalidation or when switched on at runtime, the batched models skip their own draw from here on
+	if (m_SceneContext.settings.staticBatching && m_pStaticBatcher->NeedsBuild())
+		m_pStaticBatcher->Build(this);
+
 	// DEFERRED BEGIN
 	DeferredRenderer::Get()->Begin(m_SceneContext);
 
@@ -187,6 +475,24 @@ void GameScene::RootDraw()
 		pChild->RootDraw(m_SceneContext);
 	}
 
+	if (m_SceneContext.settings.staticBatching)
+		m_pStaticBatcher->Draw(m_SceneContext);
+
+	//Queued draws (sorted rendering)
+	if (!m_pRenderQueue->GetItems().empty())
+	{
+		m_pRenderQueue->Sort();
+		m_pRenderQueue->Submit(m_SceneContext);
+
+		FrameStats& frameStats{ GameStats::GetFrameStats() };
+		frameStats.queuedDraws = static_cast<UINT>(m_pRenderQueue->GetItems().size());
+		frameStats.stateChanges = m_pRenderQueue->GetSubmittedChanges().GetTotal();
+		frameStats.drawCalls = static_cast<UINT>(m_pRenderQueue->GetBatches().size());
+		frameStats.instancedBatches = m_pRenderQueue->GetInstancedBatchCount();
+
+		m_pRenderQueue->Clear();
+	}
+
 	// DEFERRED END
 	DeferredRenderer::Get()->End(m_SceneContext);
 
@@ -245,10 +551,16 @@ void GameScene::RootDraw()
 	SpriteRenderer::Get()->Draw(m_SceneContext);
 	TextRenderer::Get()->Draw(m_SceneContext);
 #pragma endregion
+
+	//Kick the physics step, overlaps with GUI/present and the next frame up to the sync point
+	if (m_SceneContext.settings.asyncPhysics)
+		m_pPhysxProxy->Simulate(m_SceneContext);
 }
 
 void GameScene::RootOnSceneActivated()
 {
+	const ActiveScope activeScope{ *this };
+
 	//Start Timer
 	m_SceneContext.pGameTime->Start();
 	OnSceneActivated();
@@ -256,6 +568,8 @@ void GameScene::RootOnSceneActivated()
 
 void GameScene::RootOnSceneDeactivated()
 {
+	m_pPhysxProxy->FetchResults();
+
 	//Stop Timer
 	m_SceneContext.pGameTime->Stop();
 	OnSceneDeactivated();
@@ -263,6 +577,8 @@ void GameScene::RootOnSceneDeactivated()
 
 void GameScene::RootOnGUI()
 {
+	const ActiveScope activeScope{ *this };
+
 	if (!m_SceneContext.settings.showInfoOverlay)
 		return;
 
@@ -303,6 +619,103 @@ void GameScene::RootOnGUI()
 			ImGui::Dummy(ImVec2{ 0,10.f });
 			ImGui::PopFont();
 #pragma endregion
+#pragma region Frame Stats
+			ImGui::PushFont(ImguiFonts::pFont_DIN_Black_16);
+			if (ImGui::CollapsingHeader("Frame Stats"))
+			{
+				const FrameStats& frameStats{ GameStats::GetFrameStats() };
+				ImGui::PushFont(nullptr);
+				ImGui::Text("Update %.3f ms (%s)", frameStats.sceneUpdateMs, m_SceneContext.settings.updateComponentsByType ? "per type" : "tree walk");
+				ImGui::Text("Transforms %u / %u", frameStats.transformsRecomputed, frameStats.transformsRegistered);
+
+				const BoundingVolumeHierarchy::Stats& spatialStats{ m_pSpatialIndex->GetStats() };
+				ImGui::Text("BVH %u models, height %u (%u refits, %u reinserts)", spatialStats.proxyCount, spatialStats.height, frameStats.spatialRefits, frameStats.spatialReinserts);
+				ImGui::Text("Meshes %u drawn, %u culled (%s)", frameStats.meshesVisible, frameStats.meshesCulled, m_SceneContext.settings.frustumCulling ? "frustum" : "off");
+				if (m_SceneContext.settings.sortedRendering)
+				{
+					ImGui::Text("Queue %u draws, %u state changes", frameStats.queuedDraws, frameStats.stateChanges);
+					ImGui::Text("Draw calls %u (%u instanced)", frameStats.drawCalls, frameStats.instancedBatches);
+				}
+				if (m_SceneContext.settings.staticBatching)
+				{
+					const StaticBatcher::Stats& batchStats{ m_pStaticBatcher->GetStats() };
+					ImGui::Text("Static batches %u submeshes > %u chunks (%u drawn, %u culled)", batchStats.subMeshes, batchStats.chunks, frameStats.staticChunksDrawn, frameStats.staticChunksCulled);
+					ImGui::Text("Static memory %.2f MB batched, %.2f MB source", batchStats.batchBytes / (1024.f * 1024.f), batchStats.sourceBytes / (1024.f * 1024.f));
+				}
+				const MaterialManager::MemoryStats materialStats{ MaterialManager::Get()->GetMemoryStats() };
+				ImGui::Text("Materials %u instances, %u effects (%u switches)", materialStats.materials, materialStats.effects, frameStats.materialSwitches);
+				ImGui::Text("Shadow casters %u drawn / %u submitted (%s)", frameStats.shadowCastersDrawn, frameStats.shadowCasters, m_SceneContext.settings.shadowCasterCulling ? "culled" : "off");
+
+				if (m_SceneContext.settings.asyncPhysics)
+					ImGui::Text("Physics wait %.3f ms | overlap %.3f ms (%u early)", frameStats.physicsWaitMs, frameStats.physicsOverlapMs, frameStats.physicsEarlySyncs);
+				else
+					ImGui::Text("Physics wait %.3f ms (sync)", frameStats.physicsWaitMs);
+				ImGui::Text("Physics %u steps (alpha %.2f)", frameStats.physicsSteps, m_pPhysxProxy->GetInterpolationAlpha());
+
+				const PoolAllocator::Stats& poolStats{ m_pAllocator->GetStats() };
+				ImGui::Text("Pool %u live (%u allocs, %u frees, %u heap)", poolStats.liveAllocations, poolStats.allocations, poolStats.deallocations, poolStats.heapFallbacks);
+				ImGui::Text("Pool %u slabs (%.1f KB)", poolStats.slabCount, static_cast<float>(poolStats.slabBytes) / 1024.f);
+
+				if (m_SceneContext.pJobSystem)
+				{
+					const auto& workerStats = m_SceneContext.pJobSystem->GetStats();
+					for (size_t i{}; i < workerStats.size(); ++i)
+					{
+						const JobSystem::WorkerStats& stats = workerStats[i];
+						const std::string label{ i == 0 ? "Main" : std::format("Worker {}", i) };
+						ImGui::ProgressBar(stats.utilisation, ImVec2{ 100.f, 0.f });
+						ImGui::SameLine();
+						ImGui::Text("%s (%u jobs, %u stolen)", label.c_str(), stats.jobsExecuted, stats.jobsStolen);
+					}
+				}
+				ImGui::Dummy(ImVec2{ 0,10.f });
+				ImGui::PopFont(); //Default
+			}
+			ImGui::PopFont(); //DIN_Black_16
+#pragma endregion
+#pragma region Scenes
+			ImGui::PushFont(ImguiFonts::pFont_DIN_Black_16);
+			if (ImGui::CollapsingHeader("Scenes"))
+			{
+				ImGui::PushFont(nullptr);
+				constexpr const char* residencyNames[]{ "keep warm", "unload", "preload" };
+				for (const GameScene* pScene : SceneManager::Get()->GetScenes())
+				{
+					const SceneStats& stats{ pScene->m_SceneStats };
+					ImGui::Text("%s%s", pScene == this ? "> " : "", StringUtil::utf8_encode(pScene->m_SceneName).c_str());
+					ImGui::Text("   %s, %s", residencyNames[static_cast<int>(pScene->m_Residency)], pScene->m_IsInitialized ? "resident" : "unloaded");
+					if (stats.initializeCount > 0)
+						ImGui::Text("   Init %.1f ms, %.1f MB (x%u, %u unloads)", stats.initializeMs, static_cast<float>(stats.initializeBytes) / (1024.f * 1024.f), stats.initializeCount, stats.unloadCount);
+					if (stats.contentMs > 0.f)
+						ImGui::Text("   Content %.1f ms (background)", stats.contentMs);
+				}
+				ImGui::Dummy(ImVec2{ 0,10.f });
+				ImGui::PopFont(); //Default
+			}
+			ImGui::PopFont(); //DIN_Black_16
+#pragma endregion
+#pragma region Content
+			ImGui::PushFont(ImguiFonts::pFont_DIN_Black_16);
+			if (ImGui::CollapsingHeader("Content"))
+			{
+				ImGui::PushFont(nullptr);
+				constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+				const UINT64 budgetBytes{ ContentManager::GetBudget() };
+				const std::string budget{ budgetBytes > 0 ? std::format("{:.0f} MB", static_cast<float>(budgetBytes) * toMB) : "unlimited" };
+				ImGui::Text("%.1f MB resident (budget %s)", static_cast<float>(ContentManager::GetResidentBytes()) * toMB, budget.c_str());
+				ImGui::Text("Scene references: %u", static_cast<UINT>(m_ContentScope.GetReferenceCount()));
+				for (const ContentManager::Residency& residency : ContentManager::GetResidency())
+				{
+					const BaseLoader::ResidencyStats& stats{ residency.stats };
+					ImGui::Text("%s", residency.typeName.c_str());
+					ImGui::Text("   %u assets, %.2f MB (%u unreferenced, %.2f MB | %u pinned | %u evicted)", stats.assets, static_cast<float>(stats.bytes) * toMB,
+						stats.unreferenced, static_cast<float>(stats.unreferencedBytes) * toMB, stats.pinned, stats.evictions);
+				}
+				ImGui::Dummy(ImVec2{ 0,10.f });
+				ImGui::PopFont(); //Default
+			}
+			ImGui::PopFont(); //DIN_Black_16
+#pragma endregion
 #pragma region Scene Settings
 			ImGui::PushFont(ImguiFonts::pFont_DIN_Black_16);
 			if (ImGui::CollapsingHeader("Scene Settings", ImGuiTreeNodeFlags_DefaultOpen))
@@ -310,6 +723,13 @@ void GameScene::RootOnGUI()
 				ImGui::PushFont(nullptr);
 				ImGui::ColorEdit3("Clear Color", reinterpret_cast<float*>(&m_SceneContext.settings.clearColor), ImGuiColorEditFlags_NoInputs);
 				ImGui::Checkbox("V-Sync", &m_SceneContext.settings.vSyncEnabled);
+				ImGui::Checkbox("Update Components By Type", &m_SceneContext.settings.updateComponentsByType);
+				ImGui::Checkbox("Async Physics", &m_SceneContext.settings.asyncPhysics);
+				ImGui::Checkbox("Frustum Culling", &m_SceneContext.settings.frustumCulling);
+				ImGui::Checkbox("Shadow Caster Culling", &m_SceneContext.settings.shadowCasterCulling);
+				ImGui::Checkbox("Sorted Rendering", &m_SceneContext.settings.sortedRendering);
+				ImGui::Checkbox("Instancing", &m_SceneContext.settings.instancing);
+				ImGui::Checkbox("Static Batching", &m_SceneContext.settings.staticBatching);
 				ImGui::Dummy(ImVec2{ 0,10.f });
 
 				if (!DebugRenderer::IsEnabled())
@@ -3,8 +3,23 @@
 class PostProcessingMaterial;
 class BaseMaterial;
 class PhysxProxy;
+class TransformHierarchy;
+class BoundingVolumeHierarchy;
+class RenderQueue;
+class StaticBatcher;
+class PoolAllocator;
+class ContentManifest;
 class CameraComponent;
 class GameObject;
+class ModelComponent;
+
+//What happens to a scene while it isn't the active one (see SceneManager)
+enum class SceneResidency
+{
+	KeepWarm, //Initialized on first activation, kept afterwards
+	Unload, //Initialized on every activation, released again on deactivation
+	Preload //Initialized as soon as it is added to the SceneManager
+};
 
 class GameScene
 {
@@ -35,13 +50,55 @@ public:
 	void RemovePostProcessingEffect(PostProcessingMaterial* pMaterial);
 	void RemovePostProcessingEffect(UINT materialId);
 
+#pragma region Component Index
+	//All components of an exact type attached to this scene (no scenegraph traversal, includes inactive objects)
+	const std::vector<BaseComponent*>& GetComponentsOfType(ComponentTypeId typeId) const;
+
+	template<class T>
+	std::vector<T*> GetComponentsOfType() const
+	{
+		const auto& components = GetComponentsOfType(ComponentTypeRegistry::GetTypeId<T>());
+
+		std::vector<T*> result{};
+		result.reserve(components.size());
+		for (BaseComponent* pComponent : components)
+			result.push_back(static_cast<T*>(pComponent));
+
+		return result;
+	}
+
+	template<class T, typename Func>
+	void ForEachComponent(Func func) const
+	{
+		for (BaseComponent* pComponent : GetComponentsOfType(ComponentTypeRegistry::GetTypeId<T>()))
+			func(static_cast<T*>(pComponent));
+	}
+#pragma endregion
+
 	PhysxProxy* GetPhysxProxy() const { return m_pPhysxProxy; }
+	TransformHierarchy* GetTransformHierarchy() const { return m_pTransformHierarchy; }
+	//World bounds of every ModelComponent in the scene (user data == ModelComponent*), refitted after the transform update
+	BoundingVolumeHierarchy* GetSpatialIndex() const { return m_pSpatialIndex; }
+	PoolAllocator* GetAllocator() const { return m_pAllocator; }
+	//Draw items of the current frame, sorted and submitted after the user pass traversal
+	RenderQueue* GetRenderQueue() const { return m_pRenderQueue; }
+	//Merged static models (SceneSettings::staticBatching)
+	StaticBatcher* GetStaticBatcher() const { return m_pStaticBatcher; }
+
+	//Set before adding the scene to the SceneManager
+	void SetResidency(SceneResidency residency) { m_Residency = residency; }
+	SceneResidency GetResidency() const { return m_Residency; }
+	bool IsInitialized() const { return m_IsInitialized; }
+	const SceneStats& GetSceneStats() const { return m_SceneStats; }
+
 	void SetActiveCamera(CameraComponent* pCameraComponent);
 
 protected:
+	virtual void DeclareContent(ContentManifest& /*manifest*/) {}; //Assets loaded on worker threads before Initialize (SceneManager::LoadGameSceneAsync only)
 	virtual void Initialize() = 0;
 	virtual void PostInitialize() {};
 	virtual void Update() {};
+	virtual void FixedUpdate(float /*fixedTimeStep*/) {}; //Before every physics step (see PhysxProxy::SetFixedTimeStep)
 	virtual void Draw() {};
 	virtual void PostDraw() {};
 	virtual void ShadowDraw() {};
@@ -53,21 +110,59 @@ protected:
 	SceneContext m_SceneContext{};
 private:
 	friend class SceneManager;
+	friend class BaseComponent;
+	friend class GameObject;
+	friend class PhysxProxy;
+	friend class ModelComponent;
+
+	//Makes the scene's allocator, content scope & material list current for every Root* call that runs scene code (GameScene.cpp)
+	class ActiveScope;
+
+	void RegisterComponent(BaseComponent* pComponent);
+	void UnregisterComponent(BaseComponent* pComponent);
+
+	//ModelComponents initialized while the scene initializes build their GPU resources in RootContinueInitialize (within the budget)
+	void QueueGpuFinalize(ModelComponent* pModel) { m_pPendingModels.push_back(pModel); }
+	void CancelGpuFinalize(ModelComponent* pModel);
 
 	void RootInitialize(const GameContext& /*gameContext*/);
+	//Staged initialize (background loading): setup + user Initialize, then the children & the GPU finalize within a time budget
+	void RootBeginInitialize(const GameContext& gameContext);
+	bool RootContinueInitialize(float budgetMs);
+	float GetInitializeProgress() const;
+	void RootUninitialize(); //Releases the scenegraph, the next RootInitialize starts from scratch
+	void ReleaseSceneGraph();
+	void ReleaseAllocator();
 	void RootPostInitialize();
 	void RootUpdate();
+	void RootFixedUpdate(float fixedTimeStep);
 	void RootDraw();
 	void RootOnSceneActivated();
 	void RootOnSceneDeactivated();
 	void RootOnGUI();
 	void RootWindowStateChanged(int state, bool active) const;
+	void UpdateSpatialIndex();
+	void UpdateComponentBuckets();
+	void UpdateComponentBucket(ComponentTypeId typeId);
 
 	std::vector<GameObject*> m_pChildren{};
+	std::vector<std::vector<BaseComponent*>> m_ComponentIndex{};
 	bool m_IsInitialized{};
+	size_t m_InitializeCursor{}; //Next root child to initialize (RootContinueInitialize)
+	std::vector<ModelComponent*> m_pPendingModels{}; //GPU finalize queue, nullptr == cancelled
+	size_t m_FinalizeCursor{};
+	SceneResidency m_Residency{ SceneResidency::KeepWarm };
+	SceneStats m_SceneStats{}; //Written by the SceneManager
 	std::wstring m_SceneName{};
 	CameraComponent* m_pDefaultCamera{}, * m_pActiveCamera{};
 	PhysxProxy* m_pPhysxProxy{};
+	TransformHierarchy* m_pTransformHierarchy{};
+	BoundingVolumeHierarchy* m_pSpatialIndex{};
+	RenderQueue* m_pRenderQueue{};
+	StaticBatcher* m_pStaticBatcher{};
+	PoolAllocator* m_pAllocator{}; //GameObjects & components created while this scene is initializing/updating
+	ContentScope m_ContentScope{}; //Content loaded while this scene is initializing/updating & its ContentManifest, released on RootUninitialize
+	std::vector<UINT> m_MaterialIds{}; //Materials created while this scene is initializing/updating, deleted on RootUninitialize
 
 	std::vector<PostProcessingMaterial*> m_PostProcessingMaterials{};
 	OverlordGame* m_pGame{};
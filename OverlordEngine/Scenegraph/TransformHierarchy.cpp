@@ -0,0 +1,290 @@
+#include "stdafx.h"
+#include "TransformHierarchy.h"
+
+UINT TransformHierarchy::Register(TransformComponent* pTransform, UINT parentSlot)
+{
+	ASSERT_NULL(pTransform, L"TransformHierarchy::Register > TransformComponent is NULL");
+	ASSERT_IF(parentSlot != InvalidSlot && parentSlot >= GetSlotCount(), L"TransformHierarchy::Register > Invalid parent slot ({})", parentSlot);
+
+	//Appending keeps parent-before-child order (parents are always registered first)
+	const UINT slot{ GetSlotCount() };
+	Resize(slot + 1);
+
+	m_Parents[slot] = parentSlot;
+	m_pOwners[slot] = pTransform;
+	m_LocalPositions[slot] = XMFLOAT3A{ pTransform->m_Position.x, pTransform->m_Position.y, pTransform->m_Position.z };
+	m_LocalRotations[slot] = XMFLOAT4A{ pTransform->m_Rotation.x, pTransform->m_Rotation.y, pTransform->m_Rotation.z, pTransform->m_Rotation.w };
+	m_LocalScales[slot] = XMFLOAT3A{ pTransform->m_Scale.x, pTransform->m_Scale.y, pTransform->m_Scale.z };
+	m_FirstChildren[slot] = InvalidSlot;
+	m_HasRenderPose[slot] = 0;
+	LinkChild(slot);
+
+	UpdateSlot(slot);
+	m_Dirty[slot] = 1;
+	m_DirtySlots.push_back(slot);
+
+	return slot;
+}
+
+void TransformHierarchy::Unregister(UINT slot)
+{
+	ASSERT_IF(slot >= GetSlotCount() || m_pOwners[slot] == nullptr, L"TransformHierarchy::Unregister > Invalid slot ({})", slot);
+
+	//The subtree goes with it, a child of a released slot would become a root (its world jumps)
+	//Descendants are detached here, their own OnSceneDetach/destructor finds them unregistered already
+	m_SubtreeStack.push_back(slot);
+	while (!m_SubtreeStack.empty())
+	{
+		const UINT current{ m_SubtreeStack.back() };
+		m_SubtreeStack.pop_back();
+
+		//Released before, together with its own subtree
+		TransformComponent* pOwner{ m_pOwners[current] };
+		if (!pOwner)
+			continue;
+
+		//Hand the current state back to the component (detached state)
+		pOwner->m_Position = m_LocalPositions[current];
+		pOwner->m_Rotation = m_LocalRotations[current];
+		pOwner->m_Scale = m_LocalScales[current];
+		pOwner->m_World = m_Worlds[current];
+		pOwner->m_WorldPosition = m_WorldPositions[current];
+		pOwner->m_WorldRotation = m_WorldRotations[current];
+		pOwner->m_WorldScale = m_WorldScales[current];
+		pOwner->m_Forward = m_Forwards[current];
+		pOwner->m_Up = m_Ups[current];
+		pOwner->m_Right = m_Rights[current];
+		pOwner->m_IsTransformChanged = m_Changed[current];
+		pOwner->m_pHierarchy = nullptr;
+		pOwner->m_Slot = InvalidSlot;
+
+		//Slot is released on the next Update (compaction)
+		m_pOwners[current] = nullptr;
+		m_Changed[current] = TransformChanged::NONE;
+		++m_FreeCount;
+
+		for (UINT child{ m_FirstChildren[current] }; child != InvalidSlot; child = m_NextSiblings[child])
+			m_SubtreeStack.push_back(child);
+	}
+}
+
+void TransformHierarchy::MarkChanged(UINT slot, TransformChanged changed)
+{
+	if (m_Changed[slot] == TransformChanged::NONE)
+		m_ChangedSlots.push_back(slot);
+
+	m_Changed[slot] |= changed;
+}
+
+void TransformHierarchy::SetRenderPose(UINT slot, const XMFLOAT3& position, const XMFLOAT4& rotation)
+{
+	const XMVECTOR renderPosition{ XMLoadFloat3(&position) };
+	const XMVECTOR renderRotation{ XMLoadFloat4(&rotation) };
+	const bool hasRenderPose{ !XMVector3Equal(renderPosition, XMLoadFloat3A(&m_LocalPositions[slot])) || !XMVector4Equal(renderRotation, XMLoadFloat4A(&m_LocalRotations[slot])) };
+
+	//Unchanged since the last call, nothing to recompute
+	if (!hasRenderPose && !m_HasRenderPose[slot])
+		return;
+	if (hasRenderPose && m_HasRenderPose[slot] && XMVector3Equal(renderPosition, XMLoadFloat3A(&m_RenderPositions[slot])) && XMVector4Equal(renderRotation, XMLoadFloat4A(&m_RenderRotations[slot])))
+		return;
+
+	m_HasRenderPose[slot] = hasRenderPose;
+	XMStoreFloat3A(&m_RenderPositions[slot], renderPosition);
+	XMStoreFloat4A(&m_RenderRotations[slot], renderRotation);
+	MarkChanged(slot, TransformChanged::RENDER_POSE);
+}
+
+void TransformHierarchy::Update()
+{
+	//Reset last frame's dirty state
+	for (const UINT slot : m_DirtySlots)
+	{
+		if (slot < GetSlotCount())
+			m_Dirty[slot] = 0;
+	}
+	m_DirtySlots.clear();
+
+	if (m_FreeCount > 0)
+		Compact();
+
+	if (m_ChangedSlots.empty())
+		return;
+
+	//Ascending order == parents before children, a slot that was already reached through an ancestor is skipped
+	std::ranges::sort(m_ChangedSlots);
+	for (const UINT slot : m_ChangedSlots)
+	{
+		if (!m_Dirty[slot])
+			UpdateSubtree(slot);
+	}
+
+	m_ChangedSlots.clear();
+}
+
+void TransformHierarchy::UpdateSubtree(UINT slot)
+{
+	m_SubtreeStack.push_back(slot);
+	while (!m_SubtreeStack.empty())
+	{
+		const UINT current{ m_SubtreeStack.back() };
+		m_SubtreeStack.pop_back();
+
+		UpdateSlot(current);
+		m_Dirty[current] = 1;
+		m_DirtySlots.push_back(current);
+
+		for (UINT child{ m_FirstChildren[current] }; child != InvalidSlot; child = m_NextSiblings[child])
+			m_SubtreeStack.push_back(child);
+	}
+}
+
+void TransformHierarchy::UpdateSlot(UINT slot)
+{
+	const XMVECTOR localPosition{ XMLoadFloat3A(&m_LocalPositions[slot]) };
+	const XMVECTOR localRotation{ XMLoadFloat4A(&m_LocalRotations[slot]) };
+	const XMVECTOR localScale{ XMLoadFloat3A(&m_LocalScales[slot]) };
+
+	//S * R * T
+	XMMATRIX world{ XMMatrixAffineTransformation(localScale, g_XMZero, localRotation, localPosition) };
+	XMVECTOR worldRotation{ localRotation };
+	XMVECTOR worldScale{ localScale };
+
+	//World rotation/scale are composed from the local components (no decompose)
+	//Note: non-uniform parent scale combined with child rotation (shear) is not represented in the world scale
+	const UINT parent{ m_Parents[slot] };
+	const bool hasParentRenderWorld{ parent != InvalidSlot && m_HasRenderWorld[parent] };
+	XMMATRIX renderWorld{};
+	if (m_HasRenderPose[slot])
+		renderWorld = XMMatrixAffineTransformation(localScale, g_XMZero, XMLoadFloat4A(&m_RenderRotations[slot]), XMLoadFloat3A(&m_RenderPositions[slot]));
+	else if (hasParentRenderWorld)
+		renderWorld = world;
+
+	if (parent != InvalidSlot)
+	{
+		world *= XMLoadFloat4x4A(&m_Worlds[parent]);
+		worldRotation = XMQuaternionMultiply(localRotation, XMLoadFloat4A(&m_WorldRotations[parent]));
+		worldScale = XMVectorMultiply(localScale, XMLoadFloat3A(&m_WorldScales[parent]));
+	}
+
+	//Only slots drawn differently from their world (a render pose on the slot or an ancestor) store a render world
+	m_HasRenderWorld[slot] = m_HasRenderPose[slot] || hasParentRenderWorld;
+	if (m_HasRenderWorld[slot])
+	{
+		if (parent != InvalidSlot)
+			renderWorld *= XMLoadFloat4x4A(hasParentRenderWorld ? &m_RenderWorlds[parent] : &m_Worlds[parent]);
+
+		XMStoreFloat4x4A(&m_RenderWorlds[slot], renderWorld);
+	}
+
+	XMStoreFloat4x4A(&m_Worlds[slot], world);
+	XMStoreFloat3A(&m_WorldPositions[slot], world.r[3]);
+	XMStoreFloat4A(&m_WorldRotations[slot], worldRotation);
+	XMStoreFloat3A(&m_WorldScales[slot], worldScale);
+
+	const XMVECTOR forward{ XMVector3Rotate(g_XMIdentityR2, worldRotation) };
+	const XMVECTOR right{ XMVector3Rotate(g_XMIdentityR0, worldRotation) };
+	XMStoreFloat3A(&m_Forwards[slot], forward);
+	XMStoreFloat3A(&m_Rights[slot], right);
+	XMStoreFloat3A(&m_Ups[slot], XMVector3Cross(forward, right));
+
+	m_Changed[slot] = TransformChanged::NONE;
+}
+
+void TransformHierarchy::LinkChild(UINT slot)
+{
+	m_NextSiblings[slot] = InvalidSlot;
+
+	if (const UINT parent{ m_Parents[slot] }; parent != InvalidSlot)
+	{
+		m_NextSiblings[slot] = m_FirstChildren[parent];
+		m_FirstChildren[parent] = slot;
+	}
+}
+
+void TransformHierarchy::Compact()
+{
+	//Stable compaction, relative order (and thus parent-before-child) is preserved
+	const UINT size{ GetSlotCount() };
+	std::vector<UINT> remap(size, InvalidSlot);
+
+	UINT target{};
+	for (UINT slot{}; slot < size; ++slot)
+	{
+		if (!m_pOwners[slot])
+			continue;
+
+		remap[slot] = target;
+
+		//Unregister releases whole subtrees, a live slot never has a released parent
+		const UINT parent{ m_Parents[slot] };
+		ASSERT_IF(parent != InvalidSlot && remap[parent] == InvalidSlot, L"TransformHierarchy::Compact > Slot {} outlived its parent slot {}", slot, parent);
+
+		if (target != slot)
+		{
+			m_Parents[target] = parent == InvalidSlot ? InvalidSlot : remap[parent];
+			m_pOwners[target] = m_pOwners[slot];
+			m_Changed[target] = m_Changed[slot];
+			m_Dirty[target] = m_Dirty[slot];
+			m_LocalPositions[target] = m_LocalPositions[slot];
+			m_LocalRotations[target] = m_LocalRotations[slot];
+			m_LocalScales[target] = m_LocalScales[slot];
+			m_Worlds[target] = m_Worlds[slot];
+			m_WorldPositions[target] = m_WorldPositions[slot];
+			m_WorldRotations[target] = m_WorldRotations[slot];
+			m_WorldScales[target] = m_WorldScales[slot];
+			m_Forwards[target] = m_Forwards[slot];
+			m_Ups[target] = m_Ups[slot];
+			m_Rights[target] = m_Rights[slot];
+			m_HasRenderPose[target] = m_HasRenderPose[slot];
+			m_HasRenderWorld[target] = m_HasRenderWorld[slot];
+			m_RenderPositions[target] = m_RenderPositions[slot];
+			m_RenderRotations[target] = m_RenderRotations[slot];
+			m_RenderWorlds[target] = m_RenderWorlds[slot];
+
+			m_pOwners[target]->m_Slot = target;
+		}
+
+		++target;
+	}
+
+	Resize(target);
+	m_FreeCount = 0;
+
+	//Rebuild child links
+	for (UINT slot{}; slot < target; ++slot)
+		m_FirstChildren[slot] = InvalidSlot;
+	for (UINT slot{ target }; slot-- > 0;)
+		LinkChild(slot);
+
+	//Remap pending changes (released slots are dropped)
+	std::erase_if(m_ChangedSlots, [&remap](UINT& slot)
+	{
+		slot = remap[slot];
+		return slot == InvalidSlot;
+	});
+}
+
+void TransformHierarchy::Resize(UINT size)
+{
+	m_Parents.resize(size, InvalidSlot);
+	m_FirstChildren.resize(size, InvalidSlot);
+	m_NextSiblings.resize(size, InvalidSlot);
+	m_pOwners.resize(size, nullptr);
+	m_Changed.resize(size, TransformChanged::NONE);
+	m_Dirty.resize(size, 0);
+	m_LocalPositions.resize(size);
+	m_LocalRotations.resize(size);
+	m_LocalScales.resize(size);
+	m_Worlds.resize(size);
+	m_WorldPositions.resize(size);
+	m_WorldRotations.resize(size);
+	m_WorldScales.resize(size);
+	m_Forwards.resize(size);
+	m_Ups.resize(size);
+	m_Rights.resize(size);
+	m_HasRenderPose.resize(size, 0);
+	m_HasRenderWorld.resize(size, 0);
+	m_RenderPositions.resize(size);
+	m_RenderRotations.resize(size);
+	m_RenderWorlds.resize(size);
+}
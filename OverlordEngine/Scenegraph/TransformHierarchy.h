@@ -0,0 +1,96 @@
+#pragma once
+
+class TransformComponent;
+
+//Scene-owned SoA store of all TransformComponents
+//Slots are kept in parent-before-child order, so world transforms can be resolved in a single pass
+//Only slots that were marked as changed (and their descendants) are visited
+class TransformHierarchy
+{
+public:
+	static constexpr UINT InvalidSlot{ UINT_MAX };
+
+	TransformHierarchy() = default;
+	~TransformHierarchy() = default;
+	TransformHierarchy(const TransformHierarchy& other) = delete;
+	TransformHierarchy(TransformHierarchy&& other) noexcept = delete;
+	TransformHierarchy& operator=(const TransformHierarchy& other) = delete;
+	TransformHierarchy& operator=(TransformHierarchy&& other) noexcept = delete;
+
+	UINT Register(TransformComponent* pTransform, UINT parentSlot);
+	void Unregister(UINT slot); //Releases the slot's subtree as well, the descendants keep their last state (detached)
+
+	//Resolves the world transform of every changed slot (and its descendants)
+	void Update();
+	void MarkChanged(UINT slot, TransformChanged changed);
+	//Pose the slot is drawn with instead of its local one (physics interpolation), the local transform stays authoritative
+	//A pose equal to the local one clears it, the descendants of a render posed slot follow its render world
+	void SetRenderPose(UINT slot, const XMFLOAT3& position, const XMFLOAT4& rotation);
+
+	UINT GetSize() const { return static_cast<UINT>(m_Parents.size()) - m_FreeCount; }
+	UINT GetRecomputedCount() const { return static_cast<UINT>(m_DirtySlots.size()); }
+	//Slots recomputed by the last Update
+	const std::vector<UINT>& GetDirtySlots() const { return m_DirtySlots; }
+	TransformComponent* GetOwner(UINT slot) const { return m_pOwners[slot]; }
+
+#pragma region Slot Accessors
+	//References into the slot arrays, only valid until the next Register (growth) or Update (compaction), don't keep them
+	XMFLOAT3& GetLocalPosition(UINT slot) { return m_LocalPositions[slot]; }
+	XMFLOAT4& GetLocalRotation(UINT slot) { return m_LocalRotations[slot]; }
+	XMFLOAT3& GetLocalScale(UINT slot) { return m_LocalScales[slot]; }
+
+	const XMFLOAT3& GetLocalPosition(UINT slot) const { return m_LocalPositions[slot]; }
+	const XMFLOAT4& GetLocalRotation(UINT slot) const { return m_LocalRotations[slot]; }
+	const XMFLOAT3& GetLocalScale(UINT slot) const { return m_LocalScales[slot]; }
+	TransformChanged GetChanged(UINT slot) const { return m_Changed[slot]; }
+	const XMFLOAT4X4& GetWorld(UINT slot) const { return m_Worlds[slot]; }
+	const XMFLOAT4X4& GetRenderWorld(UINT slot) const { return m_HasRenderWorld[slot] ? m_RenderWorlds[slot] : m_Worlds[slot]; }
+	const XMFLOAT3& GetWorldPosition(UINT slot) const { return m_WorldPositions[slot]; }
+	const XMFLOAT4& GetWorldRotation(UINT slot) const { return m_WorldRotations[slot]; }
+	const XMFLOAT3& GetWorldScale(UINT slot) const { return m_WorldScales[slot]; }
+	const XMFLOAT3& GetForward(UINT slot) const { return m_Forwards[slot]; }
+	const XMFLOAT3& GetUp(UINT slot) const { return m_Ups[slot]; }
+	const XMFLOAT3& GetRight(UINT slot) const { return m_Rights[slot]; }
+	bool IsDirty(UINT slot) const { return m_Dirty[slot] != 0; }
+#pragma endregion
+
+private:
+	UINT GetSlotCount() const { return static_cast<UINT>(m_Parents.size()); }
+	void UpdateSlot(UINT slot);
+	void UpdateSubtree(UINT slot);
+	void Compact();
+	void Resize(UINT size);
+	void LinkChild(UINT slot);
+
+	//Hierarchy
+	std::vector<UINT> m_Parents{};
+	std::vector<UINT> m_FirstChildren{}, m_NextSiblings{};
+	std::vector<TransformComponent*> m_pOwners{};
+	std::vector<TransformChanged> m_Changed{};
+	std::vector<uint8_t> m_Dirty{};
+
+	//Local (authoritative)
+	std::vector<XMFLOAT3A> m_LocalPositions{};
+	std::vector<XMFLOAT4A> m_LocalRotations{};
+	std::vector<XMFLOAT3A> m_LocalScales{};
+
+	//World (derived)
+	std::vector<XMFLOAT4X4A> m_Worlds{};
+	std::vector<XMFLOAT3A> m_WorldPositions{};
+	std::vector<XMFLOAT4A> m_WorldRotations{};
+	std::vector<XMFLOAT3A> m_WorldScales{};
+	std::vector<XMFLOAT3A> m_Forwards{}, m_Ups{}, m_Rights{};
+
+	//Render (physics interpolation, see SetRenderPose), m_RenderWorlds is only valid where m_HasRenderWorld is set
+	std::vector<uint8_t> m_HasRenderPose{}, m_HasRenderWorld{};
+	std::vector<XMFLOAT3A> m_RenderPositions{};
+	std::vector<XMFLOAT4A> m_RenderRotations{};
+	std::vector<XMFLOAT4X4A> m_RenderWorlds{};
+
+	//Change tracking (pushed by MarkChanged, consumed by Update)
+	std::vector<UINT> m_ChangedSlots{};
+	std::vector<UINT> m_DirtySlots{};
+	std::vector<UINT> m_SubtreeStack{};
+
+	UINT m_FreeCount{};
+};
@@ -8,8 +8,15 @@ BinaryReader::~BinaryReader(void)
 
 std::wstring BinaryReader::ReadLongString()
 {
-	ASSERT_IF(m_pReader == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+	ASSERT_IF(m_pReader == nullptr && m_pData == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
 	const auto stringLength = Read<UINT>();
+
+	//A corrupt length can't run past the end of the data (up to 4G reads)
+	if (stringLength > GetRemainingSize() / sizeof(wchar_t))
+	{
+		m_HasFailed = true;
+		return {};
+	}
 	
  std::wstringstream ss;
 	for(UINT i=0; i<stringLength; ++i)
@@ -22,7 +29,19 @@ std::wstring BinaryReader::ReadLongString()
 
 std::wstring BinaryReader::ReadNullString()
 {
-	ASSERT_IF(!m_pReader, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+	ASSERT_IF(!m_pReader && !m_pData, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+
+	if (m_pData)
+	{
+		const char* pStart{ m_pData + m_Position };
+		const auto pEnd = static_cast<const char*>(std::memchr(pStart, '\0', m_Size - m_Position));
+
+		//Unterminated strings run to the end of the file (same as getline)
+		const size_t length{ pEnd ? static_cast<size_t>(pEnd - pStart) : m_Size - m_Position };
+		m_Position += pEnd ? length + 1 : length;
+
+		return std::wstring(pStart, pStart + length);
+	}
 
 	if (m_pReader) {
 		std::string buff{};
@@ -37,7 +56,7 @@ std::wstring BinaryReader::ReadNullString()
 
 std::wstring BinaryReader::ReadString()
 {
-	ASSERT_IF(m_pReader == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+	ASSERT_IF(m_pReader == nullptr && m_pData == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
 	const int stringLength = (int)Read<char>();
 	
  std::wstringstream ss;
@@ -59,6 +78,10 @@ void BinaryReader::Open(const std::wstring& binaryFile)
 	{
 		m_pReader = temp;
 		m_Exists = true;
+
+		temp->seekg(0, std::ios::end);
+		m_Size = static_cast<size_t>(temp->tellg());
+		temp->seekg(0, std::ios::beg);
 	}
 	else
 	{
@@ -74,27 +97,181 @@ void BinaryReader::Open(char* s, UINT32 size)
 	std::string data(s, size);
 	m_pReader = new std::istringstream(data);
 	m_Exists = true;
+	m_Size = size;
+}
+
+void BinaryReader::OpenMapped(const std::wstring& binaryFile)
+{
+	Close();
+
+	m_hFile = CreateFileW(binaryFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_hFile == INVALID_HANDLE_VALUE)
+	{
+		Logger::LogWarning(L"Failed to open the file!\n\nFilepath: {}", binaryFile);
+		Close();
+		return;
+	}
+
+	//Empty files can't be mapped
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(m_hFile, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Logger::LogWarning(L"Failed to map the file, it is empty!\n\nFilepath: {}", binaryFile);
+		Close();
+		return;
+	}
+
+	m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMapping)
+		m_pData = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (!m_pData)
+	{
+		Logger::LogWarning(L"Failed to map the file! (error {})\n\nFilepath: {}", GetLastError(), binaryFile);
+		Close();
+		return;
+	}
+
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+	m_Position = 0;
+	m_Exists = true;
+}
+
+void BinaryReader::OpenView(const void* pData, size_t size)
+{
+	Close();
+
+	if (!pData || size == 0)
+	{
+		Logger::LogWarning(L"BinaryReader::OpenView > Empty view");
+		return;
+	}
+
+	m_pData = static_cast<const char*>(pData);
+	m_Size = size;
+	m_Position = 0;
+	m_Exists = true;
 }
 
 void BinaryReader::Close()
 {
 	SafeDelete(m_pReader);
+
+	//Views (OpenView) aren't owned
+	if (m_pData && m_hMapping)
+		UnmapViewOfFile(m_pData);
+	if (m_hMapping)
+		CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+
+	m_pData = nullptr;
+	m_hMapping = nullptr;
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_Size = 0;
+	m_Position = 0;
 	m_Exists = false;
+	m_HasFailed = false;
+}
+
+size_t BinaryReader::GetRemainingSize() const
+{
+	const INT64 position{ GetBufferPosition() };
+	if (position < 0 || static_cast<UINT64>(position) > m_Size)
+		return 0;
+
+	return m_Size - static_cast<size_t>(position);
+}
+
+bool BinaryReader::ReadBytes(void* pDestination, size_t size)
+{
+	if (m_pData)
+	{
+		if (size > m_Size - m_Position)
+		{
+			m_HasFailed = true;
+			return false;
+		}
+
+		std::memcpy(pDestination, m_pData + m_Position, size);
+		m_Position += size;
+		return true;
+	}
+
+	m_pReader->read(static_cast<char*>(pDestination), static_cast<std::streamsize>(size));
+	if (m_pReader->fail())
+	{
+		m_HasFailed = true;
+		return false;
+	}
+
+	return true;
 }
 
-int BinaryReader::GetBufferPosition() const
+const void* BinaryReader::ReadView(size_t size)
 {
+	if (!m_pData)
+	{
+		Logger::LogWarning(L"BinaryReader::ReadView > Only mapped files can be read without a copy (see OpenMapped)");
+		m_HasFailed = true;
+		return nullptr;
+	}
+
+	if (size > m_Size - m_Position)
+	{
+		m_HasFailed = true;
+		return nullptr;
+	}
+
+	const char* pView{ m_pData + m_Position };
+	m_Position += size;
+	return pView;
+}
+
+const void* BinaryReader::GetView(size_t offset, size_t size) const
+{
+	if (!m_pData)
+	{
+		Logger::LogWarning(L"BinaryReader::GetView > Only mapped files can be read without a copy (see OpenMapped)");
+		return nullptr;
+	}
+
+	if (offset > m_Size || size > m_Size - offset)
+		return nullptr;
+
+	return m_pData + offset;
+}
+
+INT64 BinaryReader::GetBufferPosition() const
+{
+	if (m_pData)
+	{
+		return static_cast<INT64>(m_Position);
+	}
+
 	if(m_pReader)
 	{
-		return int(m_pReader->tellg());
+		return static_cast<INT64>(m_pReader->tellg());
 	}
 
 	Logger::LogWarning(L"m_pReader doesn't exist");
 	return -1;
 }
 
-bool BinaryReader::SetBufferPosition(int pos)
+bool BinaryReader::SetBufferPosition(INT64 pos)
 {
+	if (m_pData)
+	{
+		if (pos < 0 || static_cast<UINT64>(pos) > m_Size)
+		{
+			m_HasFailed = true;
+			return false;
+		}
+
+		m_Position = static_cast<size_t>(pos);
+		return true;
+	}
+
 	if(m_pReader)
 	{
 		m_pReader->seekg(pos);
@@ -115,3 +292,25 @@ bool BinaryReader::MoveBufferPosition(int move)
 
 	return false;
 }
+
+bool BinaryReader::SkipBytes(UINT64 size)
+{
+	const INT64 currPos{ GetBufferPosition() };
+	if (currPos < 0 || size > GetRemainingSize())
+	{
+		m_HasFailed = true;
+		return false;
+	}
+
+	return SetBufferPosition(currPos + static_cast<INT64>(size));
+}
+
+bool BinaryReader::AlignBufferPosition(UINT alignment)
+{
+	const auto currPos = GetBufferPosition();
+	if (currPos < 0 || alignment == 0)
+		return false;
+
+	const UINT remainder{ static_cast<UINT>(currPos % alignment) };
+	return remainder == 0 || SetBufferPosition(currPos + (alignment - remainder));
+}
@@ -15,29 +15,77 @@ public:
 	template<class T>
 	T Read()
 	{
-		ASSERT_IF(m_pReader == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+		ASSERT_IF(m_pReader == nullptr && m_pData == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+
+		T value{};
+		if (m_pData)
+		{
+			ReadBytes(&value, sizeof(T));
+			return value;
+		}
 
-		T value;
 		m_pReader->read((char*)&value, sizeof(T));
 		return value;
 	}
 
+	//Bulk read (one copy) of count elements, fails without allocating when the data ends first
+	template<class T>
+	bool ReadArray(std::vector<T>& destination, size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ReadArray copies raw bytes");
+		ASSERT_IF(m_pReader == nullptr && m_pData == nullptr, L"BinaryReader doesn't exist!\nUnable to read binary data...");
+
+		destination.clear();
+		if (count > GetRemainingSize() / sizeof(T))
+		{
+			m_HasFailed = true;
+			return false;
+		}
+
+		destination.resize(count);
+		return ReadBytes(destination.data(), count * sizeof(T));
+	}
+
  std::wstring ReadString();
  std::wstring ReadLongString();
  std::wstring ReadNullString();
 
-	int GetBufferPosition() const;
-	bool SetBufferPosition(int pos);
+	//Mapped files only: the next size bytes in the mapped view without a copy (valid until Close), nullptr when the data ends first
+	const void* ReadView(size_t size);
+	//Mapped files only: size bytes at offset without moving the read position (concurrent calls are safe), nullptr out of bounds
+	const void* GetView(size_t offset, size_t size) const;
+
+	INT64 GetBufferPosition() const;
+	bool SetBufferPosition(INT64 pos);
+	size_t GetRemainingSize() const; //Bytes left to read (mapped, view or stream)
 	bool MoveBufferPosition(int move);
+	bool SkipBytes(UINT64 size); //Forward only, fails (HasFailed) when the data ends first
+	bool AlignBufferPosition(UINT alignment); //Skips the padding of BinaryWriter::AlignBufferPosition
 	bool Exists() const { return m_Exists; }
+	bool IsMapped() const { return m_pData != nullptr; }
+	bool HasFailed() const { return m_HasFailed; } //A read or seek went past the end of the data
 
 	void Open(const std::wstring& binaryFile);
 	void Open(char* s, UINT32 size);
+	//Maps the whole file read only, reads are copies out of the mapped view (bounds checked)
+	void OpenMapped(const std::wstring& binaryFile);
+	//Reads straight out of memory owned by the caller (e.g. a ContentPack entry), same as a mapped file (ReadView, GetView)
+	void OpenView(const void* pData, size_t size);
 	void Close();
 
 private: 
 
 	bool m_Exists{};
+	bool m_HasFailed{};
 	std::istream* m_pReader{nullptr};
+	size_t m_Size{}; //Stream or mapped view
+
+	//Mapped file (or view, without the handles)
+	HANDLE m_hFile{ INVALID_HANDLE_VALUE };
+	HANDLE m_hMapping{};
+	const char* m_pData{};
+	size_t m_Position{};
+
+	bool ReadBytes(void* pDestination, size_t size);
 };
 
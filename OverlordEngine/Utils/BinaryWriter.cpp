@@ -0,0 +1,115 @@
+#include "stdafx.h"
+#include "BinaryWriter.h"
+
+BinaryWriter::~BinaryWriter()
+{
+	Close();
+}
+
+void BinaryWriter::WriteBytes(const void* pSource, size_t size)
+{
+	ASSERT_IF(m_pWriter == nullptr, L"BinaryWriter doesn't exist!\nUnable to write binary data...");
+
+	if (size == 0)
+		return;
+
+	m_pWriter->write(static_cast<const char*>(pSource), static_cast<std::streamsize>(size));
+	if (m_pWriter->fail())
+		m_HasFailed = true;
+}
+
+void BinaryWriter::WriteString(const std::wstring& string)
+{
+	ASSERT_IF(string.size() > 127, L"String \"{}\" is too long for a BYTE length ({} characters)", string, string.size());
+
+	Write(static_cast<char>(string.size()));
+	for (const wchar_t character : string)
+	{
+		Write(static_cast<char>(character));
+	}
+}
+
+void BinaryWriter::WriteLongString(const std::wstring& string)
+{
+	Write(static_cast<UINT>(string.size()));
+	WriteBytes(string.data(), string.size() * sizeof(wchar_t));
+}
+
+void BinaryWriter::WriteNullString(const std::wstring& string)
+{
+	for (const wchar_t character : string)
+	{
+		Write(static_cast<char>(character));
+	}
+	Write('\0');
+}
+
+INT64 BinaryWriter::GetBufferPosition() const
+{
+	if (m_pWriter)
+	{
+		return static_cast<INT64>(m_pWriter->tellp());
+	}
+
+	Logger::LogWarning(L"m_pWriter doesn't exist");
+	return -1;
+}
+
+bool BinaryWriter::SetBufferPosition(INT64 pos)
+{
+	if (m_pWriter)
+	{
+		m_pWriter->seekp(pos);
+		m_HasFailed |= m_pWriter->fail();
+		return !m_pWriter->fail();
+	}
+
+	Logger::LogWarning(L"m_pWriter doesn't exist");
+	return false;
+}
+
+void BinaryWriter::AlignBufferPosition(UINT alignment)
+{
+	constexpr char padding[64]{};
+	ASSERT_IF(alignment == 0 || alignment > sizeof(padding), L"Unsupported alignment ({} bytes)", alignment);
+
+	const INT64 position{ GetBufferPosition() };
+	if (position < 0)
+		return;
+
+	const UINT remainder{ static_cast<UINT>(position % alignment) };
+	if (remainder != 0)
+		WriteBytes(padding, alignment - remainder);
+}
+
+void BinaryWriter::Open(const std::wstring& binaryFile)
+{
+	Close();
+	m_HasFailed = false;
+
+	auto temp = new std::ofstream();
+	temp->open(binaryFile, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (temp->is_open())
+	{
+		m_pWriter = temp;
+		m_Exists = true;
+	}
+	else
+	{
+		Logger::LogWarning(L"Failed to open the file for writing!\n\nFilepath: {}", binaryFile);
+		delete temp;
+		Close();
+	}
+}
+
+void BinaryWriter::Close()
+{
+	if (m_pWriter)
+	{
+		m_pWriter->close();
+		m_HasFailed |= m_pWriter->fail();
+	}
+
+	SafeDelete(m_pWriter);
+	m_Exists = false;
+}
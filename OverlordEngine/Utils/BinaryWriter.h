@@ -0,0 +1,50 @@
+#pragma once
+#include "Base/Logger.h"
+
+//Counterpart of BinaryReader, the string formats match its Read*String functions
+class BinaryWriter final
+{
+public:
+	BinaryWriter() = default;
+	~BinaryWriter();
+	BinaryWriter(const BinaryWriter& other) = delete;
+	BinaryWriter(BinaryWriter&& other) noexcept = delete;
+	BinaryWriter& operator=(const BinaryWriter& other) = delete;
+	BinaryWriter& operator=(BinaryWriter&& other) noexcept = delete;
+
+	template<class T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Write copies raw bytes");
+		WriteBytes(&value, sizeof(T));
+	}
+
+	//Bulk write (one copy) of all elements, read back with BinaryReader::ReadArray
+	template<class T>
+	void WriteArray(const std::vector<T>& source)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WriteArray copies raw bytes");
+		WriteBytes(source.data(), source.size() * sizeof(T));
+	}
+
+	void WriteBytes(const void* pSource, size_t size);
+
+	void WriteString(const std::wstring& string); //BYTE length, narrowed chars
+	void WriteLongString(const std::wstring& string); //UINT length, wchar_t
+	void WriteNullString(const std::wstring& string); //Narrowed chars, '\0' terminated
+
+	INT64 GetBufferPosition() const;
+	bool SetBufferPosition(INT64 pos); //Patching earlier data (e.g. block sizes), the next write continues from pos
+	//Zero padding up to the next multiple of alignment (BinaryReader::AlignBufferPosition skips it)
+	void AlignBufferPosition(UINT alignment);
+	bool Exists() const { return m_Exists; }
+	bool HasFailed() const { return m_HasFailed; } //A write or seek failed (disk full, file removed, ...)
+
+	void Open(const std::wstring& binaryFile);
+	void Close();
+
+private:
+	bool m_Exists{};
+	bool m_HasFailed{};
+	std::ofstream* m_pWriter{ nullptr };
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+//View frustum for visibility tests, built from a (row-vector, D3D clip space) view projection matrix
+//The planes are stored transposed (x, y, z and w of four planes per register), a box is tested against four planes per instruction
+class CullingFrustum final
+{
+public:
+	CullingFrustum() = default; //No planes, everything is visible
+	explicit CullingFrustum(const XMFLOAT4X4& viewProjection);
+
+	//World space box (center/extents)
+	ContainmentType Test(const XMFLOAT3& center, const XMFLOAT3& extents) const;
+	bool Intersects(const BoundingBox& bounds) const;
+
+	//Object space box, tested as the world space AABB that encloses the transformed box (conservative)
+	bool Intersects(const BoundingBox& localBounds, FXMMATRIX world) const;
+
+private:
+	ContainmentType Test(FXMVECTOR center, FXMVECTOR extents) const;
+
+	//Two groups of four planes (left, right, bottom, top | near, far, far, far)
+	XMFLOAT4 m_PlaneX[2]{}, m_PlaneY[2]{}, m_PlaneZ[2]{}, m_PlaneW[2]{};
+};
+
+#pragma region Implementation
+inline CullingFrustum::CullingFrustum(const XMFLOAT4X4& viewProjection)
+{
+	//Gribb/Hartmann, clip = v * M so the planes are built from the matrix columns (D3D: 0 <= z <= w)
+	const XMMATRIX matrix{ XMMatrixTranspose(XMLoadFloat4x4(&viewProjection)) };
+	const XMVECTOR farPlane{ XMPlaneNormalize(XMVectorSubtract(matrix.r[3], matrix.r[2])) };
+
+	const XMMATRIX groups[2]
+	{
+		XMMatrixTranspose(XMMATRIX{
+			XMPlaneNormalize(XMVectorAdd(matrix.r[3], matrix.r[0])), //Left
+			XMPlaneNormalize(XMVectorSubtract(matrix.r[3], matrix.r[0])), //Right
+			XMPlaneNormalize(XMVectorAdd(matrix.r[3], matrix.r[1])), //Bottom
+			XMPlaneNormalize(XMVectorSubtract(matrix.r[3], matrix.r[1])) }), //Top
+		XMMatrixTranspose(XMMATRIX{
+			XMPlaneNormalize(matrix.r[2]), //Near
+			farPlane, farPlane, farPlane })
+	};
+
+	for (int i{}; i < 2; ++i)
+	{
+		XMStoreFloat4(&m_PlaneX[i], groups[i].r[0]);
+		XMStoreFloat4(&m_PlaneY[i], groups[i].r[1]);
+		XMStoreFloat4(&m_PlaneZ[i], groups[i].r[2]);
+		XMStoreFloat4(&m_PlaneW[i], groups[i].r[3]);
+	}
+}
+
+inline ContainmentType CullingFrustum::Test(const XMFLOAT3& center, const XMFLOAT3& extents) const
+{
+	return Test(XMLoadFloat3(&center), XMLoadFloat3(&extents));
+}
+
+inline bool CullingFrustum::Intersects(const BoundingBox& bounds) const
+{
+	return Test(XMLoadFloat3(&bounds.Center), XMLoadFloat3(&bounds.Extents)) != DISJOINT;
+}
+
+inline bool CullingFrustum::Intersects(const BoundingBox& localBounds, FXMMATRIX world) const
+{
+	//Arvo, the world extents are the local extents projected onto the absolute basis vectors
+	const XMVECTOR center{ XMVector3Transform(XMLoadFloat3(&localBounds.Center), world) };
+	const XMVECTOR localExtents{ XMLoadFloat3(&localBounds.Extents) };
+
+	XMVECTOR extents{ XMVectorMultiply(XMVectorSplatX(localExtents), XMVectorAbs(world.r[0])) };
+	extents = XMVectorMultiplyAdd(XMVectorSplatY(localExtents), XMVectorAbs(world.r[1]), extents);
+	extents = XMVectorMultiplyAdd(XMVectorSplatZ(localExtents), XMVectorAbs(world.r[2]), extents);
+
+	return Test(center, extents) != DISJOINT;
+}
+
+inline ContainmentType CullingFrustum::Test(FXMVECTOR center, FXMVECTOR extents) const
+{
+	const XMVECTOR centerX{ XMVectorSplatX(center) }, centerY{ XMVectorSplatY(center) }, centerZ{ XMVectorSplatZ(center) };
+	const XMVECTOR extentsX{ XMVectorSplatX(extents) }, extentsY{ XMVectorSplatY(extents) }, extentsZ{ XMVectorSplatZ(extents) };
+
+	XMVECTOR isOutside{ XMVectorFalseInt() };
+	XMVECTOR isIntersecting{ XMVectorFalseInt() };
+	for (int i{}; i < 2; ++i)
+	{
+		const XMVECTOR planeX{ XMLoadFloat4(&m_PlaneX[i]) };
+		const XMVECTOR planeY{ XMLoadFloat4(&m_PlaneY[i]) };
+		const XMVECTOR planeZ{ XMLoadFloat4(&m_PlaneZ[i]) };
+		const XMVECTOR planeW{ XMLoadFloat4(&m_PlaneW[i]) };
+
+		//Signed distance of the center and the box radius projected on the plane normal (four planes)
+		const XMVECTOR distance{ XMVectorMultiplyAdd(planeX, centerX, XMVectorMultiplyAdd(planeY, centerY, XMVectorMultiplyAdd(planeZ, centerZ, planeW))) };
+		const XMVECTOR radius{ XMVectorMultiplyAdd(XMVectorAbs(planeX), extentsX, XMVectorMultiplyAdd(XMVectorAbs(planeY), extentsY, XMVectorMultiply(XMVectorAbs(planeZ), extentsZ))) };
+
+		isOutside = XMVectorOrInt(isOutside, XMVectorLess(distance, XMVectorNegate(radius)));
+		isIntersecting = XMVectorOrInt(isIntersecting, XMVectorLess(distance, radius));
+	}
+
+	if (XMVector4NotEqualInt(isOutside, XMVectorFalseInt()))
+		return DISJOINT;
+
+	return XMVector4NotEqualInt(isIntersecting, XMVectorFalseInt()) ? INTERSECTS : CONTAINS;
+}
+#pragma endregion
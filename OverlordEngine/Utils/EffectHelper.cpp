@@ -13,7 +13,7 @@ const std::wstring& EffectHelper::GetIlSemanticName(ILSemantic semantic)
 	return m_empty;
 }
 
-bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout, std::vector<ILDescription>& inputLayoutDescriptions, UINT& inputLayoutSize, UINT& inputLayoutID)
+bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout, std::vector<ILDescription>& inputLayoutDescriptions, UINT& inputLayoutSize, UINT& inputLayoutID, ID3D11InputLayout** pStreamInputLayout)
 {
 	D3DX11_PASS_SHADER_DESC passShaderDesc;
 	pTechnique->GetPassByIndex(0)->GetVertexShaderDesc(&passShaderDesc);
@@ -23,7 +23,9 @@ bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechniqu
 
 	D3D11_SIGNATURE_PARAMETER_DESC signParDesc;
 	std::vector<D3D11_INPUT_ELEMENT_DESC> layoutDesc;
+	std::vector<D3D11_INPUT_ELEMENT_DESC> streamLayoutDesc;
 	inputLayoutSize = 0;
+	UINT attributeSize{};
 
 	inputLayoutDescriptions.clear();
 	for (UINT i = 0; i < effectShaderDesc.NumInputSignatureEntries; ++i)
@@ -70,6 +72,19 @@ bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechniqu
 			break;
 		}
 
+		//Per instance stream (slot 1, see RenderQueue::InstanceData), not part of the mesh vertex buffer
+		if (strcmp(signParDesc.SemanticName, "INSTANCE_WORLD") == 0 || strcmp(signParDesc.SemanticName, "INSTANCE_BONES") == 0)
+		{
+			const UINT instanceOffset = strcmp(signParDesc.SemanticName, "INSTANCE_WORLD") == 0 ?
+				static_cast<UINT>(offsetof(RenderQueue::InstanceData, world) + signParDesc.SemanticIndex * sizeof(XMFLOAT4)) :
+				static_cast<UINT>(offsetof(RenderQueue::InstanceData, boneOffset));
+
+			D3D11_INPUT_ELEMENT_DESC instanceLayout = { signParDesc.SemanticName, signParDesc.SemanticIndex, ilDescription.Format, 1, instanceOffset, D3D11_INPUT_PER_INSTANCE_DATA, 1 };
+			layoutDesc.push_back(instanceLayout);
+			streamLayoutDesc.push_back(instanceLayout);
+			continue;
+		}
+
 		//Semantic Type
 		if (strcmp(signParDesc.SemanticName, "POSITION") == 0)ilDescription.SemanticType = ILSemantic::POSITION;
 		else if (strcmp(signParDesc.SemanticName, "NORMAL") == 0)ilDescription.SemanticType = ILSemantic::NORMAL;
@@ -98,6 +113,17 @@ bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechniqu
 		D3D11_INPUT_ELEMENT_DESC inputLayout = { signParDesc.SemanticName, signParDesc.SemanticIndex, ilDescription.Format, 0, inputLayoutSize, D3D11_INPUT_PER_VERTEX_DATA, 0 };
 		layoutDesc.push_back(inputLayout);
 
+		//Split streams, the shared position stream is float3 (missing components read as 0,0,0,1)
+		if (ilDescription.SemanticType == ILSemantic::POSITION)
+		{
+			streamLayoutDesc.push_back({ signParDesc.SemanticName, signParDesc.SemanticIndex, DXGI_FORMAT_R32G32B32_FLOAT, MeshFilter::PositionSlot, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		}
+		else
+		{
+			streamLayoutDesc.push_back({ signParDesc.SemanticName, signParDesc.SemanticIndex, ilDescription.Format, MeshFilter::AttributeSlot, attributeSize, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+			attributeSize += ilDescription.Offset;
+		}
+
 		//Increment Position
 		inputLayoutSize += ilDescription.Offset;
 	}
@@ -108,6 +134,11 @@ bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechniqu
 	pTechnique->GetPassByIndex(0)->GetDesc(&PassDesc);
 	HANDLE_ERROR(pDevice->CreateInputLayout(&layoutDesc[0], static_cast<UINT>(layoutDesc.size()), PassDesc.pIAInputSignature, PassDesc.IAInputSignatureSize, pInputLayout));
 
+	if (pStreamInputLayout)
+	{
+		HANDLE_ERROR(pDevice->CreateInputLayout(&streamLayoutDesc[0], static_cast<UINT>(streamLayoutDesc.size()), PassDesc.pIAInputSignature, PassDesc.IAInputSignatureSize, pStreamInputLayout));
+	}
+
 	return true;
 }
 
@@ -191,4 +222,25 @@ bool EffectHelper::BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechniqu
 	HANDLE_ERROR(pDevice->CreateInputLayout(&layoutDesc[0], static_cast<UINT>(layoutDesc.size()), PassDesc.pIAInputSignature, PassDesc.IAInputSignatureSize, pInputLayout))
 
 	return true; //redundant return...
-}
\ No newline at end of file
+}
+
+UINT64 EffectHelper::GetConstantBufferBytes(ID3DX11Effect* pEffect)
+{
+	D3DX11_EFFECT_DESC effectDesc{};
+	pEffect->GetDesc(&effectDesc);
+
+	UINT64 bytes{};
+	for (UINT i{}; i < effectDesc.ConstantBuffers; ++i)
+	{
+		ID3D11Buffer* pBuffer{};
+		if (FAILED(pEffect->GetConstantBufferByIndex(i)->GetConstantBuffer(&pBuffer)) || !pBuffer) continue;
+
+		D3D11_BUFFER_DESC bufferDesc{};
+		pBuffer->GetDesc(&bufferDesc);
+		bytes += bufferDesc.ByteWidth;
+
+		pBuffer->Release();
+	}
+
+	return bytes * 2;
+}
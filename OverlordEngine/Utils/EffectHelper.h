@@ -26,6 +26,7 @@ struct MaterialTechniqueContext
 {
 	ID3DX11EffectTechnique* pTechnique{};
 	ID3D11InputLayout* pInputLayout{};
+	ID3D11InputLayout* pStreamInputLayout{}; //MeshFilter streams, POSITION from slot 0 and the other elements from slot 2 (see MeshFilter::SetVertexStreams)
 	std::vector<ILDescription> pInputLayoutDescriptions{};
 	UINT inputLayoutSize{};
 	UINT inputLayoutID{};
@@ -40,10 +41,13 @@ public:
 	EffectHelper(EffectHelper&& other) noexcept = delete;
 	EffectHelper& operator=(const EffectHelper& other) = delete;
 	EffectHelper& operator=(EffectHelper&& other) noexcept = delete;
-	static bool BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout, std::vector<ILDescription>& inputLayoutDescriptions, UINT& inputLayoutSize, UINT& inputLayoutID);
+	//pStreamInputLayout (optional) reads the same elements from the split MeshFilter streams
+	static bool BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout, std::vector<ILDescription>& inputLayoutDescriptions, UINT& inputLayoutSize, UINT& inputLayoutID, ID3D11InputLayout** pStreamInputLayout = nullptr);
 	static bool BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout, UINT& inputLayoutSize);
 	static bool BuildInputLayout(ID3D11Device* pDevice, ID3DX11EffectTechnique* pTechnique, ID3D11InputLayout** pInputLayout);
 	static const std::wstring& GetIlSemanticName(ILSemantic semantic);
+	//Constant buffers of the effect, CPU copy & GPU buffer (a lower bound of what a clone costs)
+	static UINT64 GetConstantBufferBytes(ID3DX11Effect* pEffect);
 
 private:
 	static std::map<ILSemantic, std::wstring> create_map()
@@ -0,0 +1,183 @@
+#include "stdafx.h"
+#include "Lz4.h"
+
+namespace
+{
+	UINT32 Read32(const BYTE* pData)
+	{
+		UINT32 value{};
+		std::memcpy(&value, pData, sizeof(value));
+		return value;
+	}
+}
+
+size_t Lz4::GetCompressBound(size_t sourceSize)
+{
+	return sourceSize + sourceSize / 255 + 16;
+}
+
+size_t Lz4::Compress(const BYTE* pSource, size_t sourceSize, BYTE* pDestination, size_t capacity)
+{
+	ASSERT_IF(sourceSize > UINT32_MAX, L"Lz4::Compress > Blocks are limited to 4 GB ({} bytes)", sourceSize);
+
+	BYTE* pOutput{ pDestination };
+	const BYTE* pEnd{ pDestination + capacity };
+	size_t anchor{}; //First literal of the next sequence
+
+	if (sourceSize >= m_MatchStartLimit + 1)
+	{
+		//Last position seen per hash of 4 bytes, UINT32_MAX == empty
+		std::vector<UINT32> hashTable(size_t{ 1 } << m_HashLog, UINT32_MAX);
+
+		const size_t matchStartEnd{ sourceSize - m_MatchStartLimit };
+		const size_t matchEnd{ sourceSize - m_LastLiterals };
+
+		size_t position{};
+		while (position <= matchStartEnd)
+		{
+			const UINT32 sequence{ Read32(pSource + position) };
+			const UINT32 hash{ (sequence * 2654435761u) >> (32 - m_HashLog) };
+			const size_t candidate{ hashTable[hash] };
+			hashTable[hash] = static_cast<UINT32>(position);
+
+			if (candidate == UINT32_MAX || position - candidate > m_MaxOffset || Read32(pSource + candidate) != sequence)
+			{
+				++position;
+				continue;
+			}
+
+			size_t matchLength{ m_MinMatch };
+			while (position + matchLength < matchEnd && pSource[candidate + matchLength] == pSource[position + matchLength])
+			{
+				++matchLength;
+			}
+
+			//SEQUENCE
+			const size_t literalLength{ position - anchor };
+			if (pOutput >= pEnd) return 0;
+			BYTE* pToken{ pOutput++ };
+			*pToken = static_cast<BYTE>(std::min<size_t>(literalLength, 15) << 4 | std::min<size_t>(matchLength - m_MinMatch, 15));
+
+			pOutput = WriteLength(pOutput, pEnd, literalLength);
+			if (!pOutput || literalLength + 2 > static_cast<size_t>(pEnd - pOutput)) return 0;
+			std::memcpy(pOutput, pSource + anchor, literalLength);
+			pOutput += literalLength;
+
+			const size_t offset{ position - candidate };
+			*pOutput++ = static_cast<BYTE>(offset & 0xFF);
+			*pOutput++ = static_cast<BYTE>(offset >> 8);
+
+			pOutput = WriteLength(pOutput, pEnd, matchLength - m_MinMatch);
+			if (!pOutput) return 0;
+
+			position += matchLength;
+			anchor = position;
+		}
+	}
+
+	//LAST LITERALS
+	const size_t literalLength{ sourceSize - anchor };
+	if (pOutput >= pEnd) return 0;
+	*pOutput++ = static_cast<BYTE>(std::min<size_t>(literalLength, 15) << 4);
+
+	pOutput = WriteLength(pOutput, pEnd, literalLength);
+	if (!pOutput || literalLength > static_cast<size_t>(pEnd - pOutput)) return 0;
+	if (literalLength > 0)
+		std::memcpy(pOutput, pSource + anchor, literalLength);
+	pOutput += literalLength;
+
+	return static_cast<size_t>(pOutput - pDestination);
+}
+
+bool Lz4::Decompress(const BYTE* pSource, size_t sourceSize, BYTE* pDestination, size_t destinationSize)
+{
+	size_t input{};
+	size_t output{};
+
+	while (input < sourceSize)
+	{
+		const BYTE token{ pSource[input++] };
+
+		//LITERALS
+		size_t literalLength{ static_cast<size_t>(token >> 4) };
+		if (literalLength == 15 && !ReadLength(pSource, sourceSize, input, literalLength))
+			return false;
+
+		if (literalLength > sourceSize - input || literalLength > destinationSize - output)
+			return false;
+
+		if (literalLength > 0)
+			std::memcpy(pDestination + output, pSource + input, literalLength);
+		input += literalLength;
+		output += literalLength;
+
+		//The last sequence has no match
+		if (input == sourceSize)
+			break;
+
+		//MATCH
+		if (sourceSize - input < 2)
+			return false;
+
+		const size_t offset{ static_cast<size_t>(pSource[input]) | static_cast<size_t>(pSource[input + 1]) << 8 };
+		input += 2;
+		if (offset == 0 || offset > output)
+			return false;
+
+		size_t matchLength{ static_cast<size_t>(token & 0x0F) };
+		if (matchLength == 15 && !ReadLength(pSource, sourceSize, input, matchLength))
+			return false;
+		matchLength += m_MinMatch;
+
+		if (matchLength > destinationSize - output)
+			return false;
+
+		//Overlapping matches (offset < length) repeat the bytes written by this same copy
+		const BYTE* pMatch{ pDestination + output - offset };
+		if (offset >= matchLength)
+		{
+			std::memcpy(pDestination + output, pMatch, matchLength);
+		}
+		else
+		{
+			for (size_t i{}; i < matchLength; ++i)
+				pDestination[output + i] = pMatch[i];
+		}
+		output += matchLength;
+	}
+
+	return output == destinationSize;
+}
+
+BYTE* Lz4::WriteLength(BYTE* pDestination, const BYTE* pEnd, size_t length)
+{
+	if (length < 15)
+		return pDestination;
+
+	length -= 15;
+	while (length >= 255)
+	{
+		if (pDestination >= pEnd) return nullptr;
+		*pDestination++ = 255;
+		length -= 255;
+	}
+
+	if (pDestination >= pEnd) return nullptr;
+	*pDestination++ = static_cast<BYTE>(length);
+	return pDestination;
+}
+
+bool Lz4::ReadLength(const BYTE* pSource, size_t sourceSize, size_t& position, size_t& length)
+{
+	BYTE value{};
+	do
+	{
+		if (position >= sourceSize)
+			return false;
+
+		value = pSource[position++];
+		length += value;
+	} while (value == 255);
+
+	return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+//LZ4 block format (no frame header, sizes are stored by the caller), compressed content pack entries (see ContentPack)
+//Sequences: token (literal length << 4 | match length - 4), literals, UINT16 offset, length bytes of 255 above 15
+//Greedy single probe compressor (fast level), the decoder checks every length & offset against both buffers
+class Lz4 final
+{
+public:
+	Lz4() = delete;
+	~Lz4() = delete;
+	Lz4(const Lz4& other) = delete;
+	Lz4(Lz4&& other) noexcept = delete;
+	Lz4& operator=(const Lz4& other) = delete;
+	Lz4& operator=(Lz4&& other) noexcept = delete;
+
+	static size_t GetCompressBound(size_t sourceSize);
+	//Largest output a block of sourceSize bytes can decode to (a length byte adds at most 255 bytes)
+	static UINT64 GetDecompressBound(UINT64 sourceSize) { return sourceSize * 256; }
+
+	//Returns the compressed size, 0 when it doesn't fit in capacity (GetCompressBound always fits)
+	static size_t Compress(const BYTE* pSource, size_t sourceSize, BYTE* pDestination, size_t capacity);
+	//Fails on corrupt data or when the output isn't exactly destinationSize bytes
+	static bool Decompress(const BYTE* pSource, size_t sourceSize, BYTE* pDestination, size_t destinationSize);
+
+private:
+	static constexpr size_t m_MinMatch{ 4 };
+	static constexpr size_t m_LastLiterals{ 5 }; //The block always ends with literals
+	static constexpr size_t m_MatchStartLimit{ 12 }; //No match starts in the last 12 bytes
+	static constexpr size_t m_MaxOffset{ 65535 };
+	static constexpr UINT m_HashLog{ 16 };
+
+	static BYTE* WriteLength(BYTE* pDestination, const BYTE* pEnd, size_t length);
+	static bool ReadLength(const BYTE* pSource, size_t sourceSize, size_t& position, size_t& length);
+};
@@ -0,0 +1,122 @@
+#include "stdafx.h"
+#include "PoolAllocator.h"
+
+thread_local PoolAllocator* PoolAllocator::m_pCurrent{};
+
+PoolAllocator::PoolAllocator()
+{
+	for (size_t i{}; i < m_SizeClassCount; ++i)
+	{
+		m_Classes[i].pAllocator = this;
+		m_Classes[i].blockSize = sizeof(BlockHeader) + m_SizeClasses[i];
+	}
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	//Releasing the slabs while objects are still alive would leave dangling objects behind, leak instead
+	if (m_Stats.liveAllocations > 0)
+	{
+		Logger::LogWarning(L"PoolAllocator::~PoolAllocator > {} allocations are still alive, slabs are not released", m_Stats.liveAllocations);
+		return;
+	}
+
+	for (void* pSlab : m_Slabs)
+	{
+		::operator delete(pSlab, std::align_val_t{ alignof(BlockHeader) });
+	}
+}
+
+void* PoolAllocator::AllocateObject(size_t size)
+{
+	if (m_pCurrent)
+		return m_pCurrent->Allocate(size);
+
+	auto pHeader = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size, std::align_val_t{ alignof(BlockHeader) }));
+	pHeader->pOwner = nullptr;
+	return pHeader + 1;
+}
+
+void PoolAllocator::FreeObject(void* pObject)
+{
+	if (!pObject)
+		return;
+
+	BlockHeader* pHeader{ static_cast<BlockHeader*>(pObject) - 1 };
+	if (pHeader->pOwner)
+	{
+		pHeader->pOwner->pAllocator->Free(pHeader->pOwner, pHeader);
+		return;
+	}
+
+	::operator delete(pHeader, std::align_val_t{ alignof(BlockHeader) });
+}
+
+void* PoolAllocator::Allocate(size_t size)
+{
+	++m_Stats.allocations;
+	++m_Stats.liveAllocations;
+
+	//Smallest fitting size class
+	SizeClass* pSizeClass{};
+	for (size_t i{}; i < m_SizeClassCount; ++i)
+	{
+		if (size <= m_SizeClasses[i])
+		{
+			pSizeClass = &m_Classes[i];
+			break;
+		}
+	}
+
+	if (!pSizeClass)
+	{
+		++m_Stats.heapFallbacks;
+		--m_Stats.liveAllocations; //Heap allocations are not tracked by this allocator
+
+		auto pHeader = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size, std::align_val_t{ alignof(BlockHeader) }));
+		pHeader->pOwner = nullptr;
+		return pHeader + 1;
+	}
+
+	if (!pSizeClass->pFreeList)
+		AllocateSlab(*pSizeClass);
+
+	FreeBlock* pBlock{ pSizeClass->pFreeList };
+	pSizeClass->pFreeList = pBlock->pNext;
+
+	auto pHeader = reinterpret_cast<BlockHeader*>(pBlock);
+	pHeader->pOwner = pSizeClass;
+	return pHeader + 1;
+}
+
+void PoolAllocator::Free(SizeClass* pSizeClass, BlockHeader* pHeader)
+{
+	++m_Stats.deallocations;
+	--m_Stats.liveAllocations;
+
+	if (m_IsTearingDown)
+		return;
+
+	auto pBlock = reinterpret_cast<FreeBlock*>(pHeader);
+	pBlock->pNext = pSizeClass->pFreeList;
+	pSizeClass->pFreeList = pBlock;
+}
+
+void PoolAllocator::AllocateSlab(SizeClass& sizeClass)
+{
+	const size_t blockCount{ m_SlabSize / sizeClass.blockSize };
+	const size_t slabBytes{ blockCount * sizeClass.blockSize };
+
+	auto pSlab = static_cast<char*>(::operator new(slabBytes, std::align_val_t{ alignof(BlockHeader) }));
+	m_Slabs.push_back(pSlab);
+	++m_Stats.slabCount;
+	m_Stats.slabBytes += slabBytes;
+
+	//Thread the new blocks onto the free list (in address order)
+	for (size_t i{ blockCount }; i-- > 0;)
+	{
+		auto pBlock = reinterpret_cast<FreeBlock*>(pSlab + i * sizeClass.blockSize);
+		pBlock->pNext = sizeClass.pFreeList;
+		sizeClass.pFreeList = pBlock;
+	}
+}
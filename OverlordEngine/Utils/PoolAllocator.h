@@ -0,0 +1,88 @@
+#pragma once
+
+//Slab allocator with fixed size classes, owned by a GameScene
+//GameObjects and components are allocated from the allocator that is current on the calling thread (see Scope),
+//allocations without a current allocator (or larger than the biggest size class) fall back to the heap
+//Not thread-safe, a single allocator is only used by the thread that builds/updates its scene
+class PoolAllocator final
+{
+public:
+	struct Stats
+	{
+		UINT allocations{};
+		UINT deallocations{};
+		UINT liveAllocations{};
+		UINT heapFallbacks{};
+		UINT slabCount{};
+		size_t slabBytes{};
+	};
+
+	//Makes an allocator current for the lifetime of the scope (restores the previous one)
+	class Scope final
+	{
+	public:
+		explicit Scope(PoolAllocator* pAllocator) : m_pPrevious(m_pCurrent) { m_pCurrent = pAllocator; }
+		~Scope() { m_pCurrent = m_pPrevious; }
+		Scope(const Scope& other) = delete;
+		Scope(Scope&& other) noexcept = delete;
+		Scope& operator=(const Scope& other) = delete;
+		Scope& operator=(Scope&& other) noexcept = delete;
+
+	private:
+		PoolAllocator* m_pPrevious{};
+	};
+
+	PoolAllocator();
+	~PoolAllocator();
+	PoolAllocator(const PoolAllocator& other) = delete;
+	PoolAllocator(PoolAllocator&& other) noexcept = delete;
+	PoolAllocator& operator=(const PoolAllocator& other) = delete;
+	PoolAllocator& operator=(PoolAllocator&& other) noexcept = delete;
+
+	//Used by GameObject/BaseComponent operator new/delete
+	static void* AllocateObject(size_t size);
+	static void FreeObject(void* pObject);
+
+	static PoolAllocator* GetCurrent() { return m_pCurrent; }
+
+	//Frees become bookkeeping only, slabs are released in bulk when the allocator is destroyed
+	void BeginTeardown() { m_IsTearingDown = true; }
+
+	const Stats& GetStats() const { return m_Stats; }
+
+private:
+	static constexpr size_t m_SlabSize{ 64 * 1024 };
+	static constexpr size_t m_SizeClasses[]{ 64, 128, 192, 256, 384, 512, 768, 1024, 2048 };
+	static constexpr size_t m_SizeClassCount{ std::size(m_SizeClasses) };
+
+	struct SizeClass;
+
+	//Precedes every allocation (keeps the 16 byte alignment of the payload)
+	struct alignas(16) BlockHeader
+	{
+		SizeClass* pOwner; //nullptr == heap allocation
+	};
+
+	struct FreeBlock
+	{
+		FreeBlock* pNext;
+	};
+
+	struct SizeClass
+	{
+		PoolAllocator* pAllocator{};
+		size_t blockSize{};
+		FreeBlock* pFreeList{};
+	};
+
+	void* Allocate(size_t size);
+	void Free(SizeClass* pSizeClass, BlockHeader* pHeader);
+	void AllocateSlab(SizeClass& sizeClass);
+
+	static thread_local PoolAllocator* m_pCurrent;
+
+	SizeClass m_Classes[m_SizeClassCount]{};
+	std::vector<void*> m_Slabs{};
+	Stats m_Stats{};
+	bool m_IsTearingDown{};
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+//Vector with inline storage for the first N elements (no heap allocation for small lists)
+//Restricted to trivially copyable types (pointers, handles), elements are moved with memcpy
+template<typename T, size_t N>
+class SmallVector final
+{
+	static_assert(std::is_trivially_copyable_v<T>, "SmallVector only supports trivially copyable types");
+
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	SmallVector() = default;
+	~SmallVector()
+	{
+		if (m_pData != m_Inline)
+			delete[] m_pData;
+	}
+
+	SmallVector(const SmallVector& other) = delete;
+	SmallVector(SmallVector&& other) noexcept = delete;
+	SmallVector& operator=(const SmallVector& other) = delete;
+	SmallVector& operator=(SmallVector&& other) noexcept = delete;
+
+	void push_back(const T& value)
+	{
+		if (m_Size == m_Capacity)
+			Grow(m_Capacity * 2);
+
+		m_pData[m_Size++] = value;
+	}
+
+	void pop_back() { --m_Size; }
+
+	iterator erase(const_iterator position)
+	{
+		const size_t index{ static_cast<size_t>(position - m_pData) };
+		std::memmove(m_pData + index, m_pData + index + 1, (m_Size - index - 1) * sizeof(T));
+		--m_Size;
+		return m_pData + index;
+	}
+
+	void clear() { m_Size = 0; }
+	void reserve(size_t capacity) { if (capacity > m_Capacity) Grow(capacity); }
+
+	size_t size() const { return m_Size; }
+	size_t capacity() const { return m_Capacity; }
+	bool empty() const { return m_Size == 0; }
+	bool is_inline() const { return m_pData == m_Inline; }
+
+	T& operator[](size_t index) { return m_pData[index]; }
+	const T& operator[](size_t index) const { return m_pData[index]; }
+	T& back() { return m_pData[m_Size - 1]; }
+	const T& back() const { return m_pData[m_Size - 1]; }
+
+	iterator begin() { return m_pData; }
+	iterator end() { return m_pData + m_Size; }
+	const_iterator begin() const { return m_pData; }
+	const_iterator end() const { return m_pData + m_Size; }
+
+private:
+	void Grow(size_t capacity)
+	{
+		T* pData{ new T[capacity] };
+		std::memcpy(pData, m_pData, m_Size * sizeof(T));
+
+		if (m_pData != m_Inline)
+			delete[] m_pData;
+
+		m_pData = pData;
+		m_Capacity = capacity;
+	}
+
+	T m_Inline[N]{};
+	T* m_pData{ m_Inline };
+	size_t m_Size{};
+	size_t m_Capacity{ N };
+};
@@ -17,6 +17,13 @@
 // #define Deferred
 #define VelocityOverdrive
 
+/*BENCHMARK Content*/
+// #define Benchmarks
+
+/*TOOL Content*/
+// #define MeshCooking
+// #define ContentPacking
+
 #pragma region Lab/Milestone Includes
 #ifdef W3
 #include "Scenes/Week 3/MinionScene.h"
@@ -87,6 +94,27 @@
 #include "Scenes/Week 11/DeferredRenderingScene.h"
 #endif
 
+#ifdef Benchmarks
+#include "Scenes/Benchmarks/ComponentUpdateBenchmarkScene.h"
+#include "Scenes/Benchmarks/SceneTeardownBenchmarkScene.h"
+#include "Scenes/Benchmarks/JobSystemBenchmarkScene.h"
+#include "Scenes/Benchmarks/PhysicsOverlapBenchmarkScene.h"
+#include "Scenes/Benchmarks/SpatialIndexBenchmarkScene.h"
+#include "Scenes/Benchmarks/RenderQueueBenchmarkScene.h"
+#include "Scenes/Benchmarks/InstancingBenchmarkScene.h"
+#include "Scenes/Benchmarks/MaterialVariableBenchmarkScene.h"
+#include "Scenes/Benchmarks/VertexBufferBenchmarkScene.h"
+#include "Scenes/Benchmarks/MeshLoadBenchmarkScene.h"
+#endif
+
+#ifdef MeshCooking
+#include "Scenes/Tools/MeshCookerScene.h"
+#endif
+
+#ifdef ContentPacking
+#include "Scenes/Tools/ContentPackerScene.h"
+#endif
+
 #pragma endregion
 
 //Game is preparing
@@ -95,6 +123,8 @@ void MainGame::OnGamePreparing(GameContext& gameContext)
 	//Here you can change some game settings before engine initialize
 	gameContext.windowWidth = 1280;
 	gameContext.windowHeight = 720;
+	//gameContext.serialContentLoading = true; //Cold startup comparison, VO_GameScene content time is logged by the SceneManager
+	//gameContext.contentPack = L""; //Loose files only, startup comparison against the content pack (see ContentPackerScene)
 
 	//gameContext.windowTitle = L"GP2 - Milestone 1 (2023) | (2DAE15) Belmans Jef";
 	//gameContext.windowTitle = L"GP2 - Milestone 2 (2023) | (2DAE13) Belmans Jef";
@@ -166,12 +196,33 @@ void MainGame::Initialize()
 
 #ifdef VelocityOverdrive
 	SceneManager::Get()->AddGameScene(new VO_MenuScene());
-	SceneManager::Get()->AddGameScene(new VO_GameScene());
+	SceneManager::Get()->LoadGameSceneAsync(new VO_GameScene(), false); //Streams in while the menu is shown
 #endif // RacePace
 
 #ifdef Deferred
 		SceneManager::Get()->AddGameScene(new DeferredRenderingScene);
 #endif
+
+#ifdef Benchmarks
+	SceneManager::Get()->AddGameScene(new ComponentUpdateBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new SceneTeardownBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new JobSystemBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new PhysicsOverlapBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new SpatialIndexBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new RenderQueueBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new InstancingBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new MaterialVariableBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new VertexBufferBenchmarkScene());
+	SceneManager::Get()->AddGameScene(new MeshLoadBenchmarkScene());
+#endif
+
+#ifdef MeshCooking
+	SceneManager::Get()->AddGameScene(new MeshCookerScene());
+#endif
+
+#ifdef ContentPacking
+	SceneManager::Get()->AddGameScene(new ContentPackerScene());
+#endif
 }
 
 LRESULT MainGame::WindowProcedureHook(HWND /*hWnd*/, UINT message, WPARAM wParam, LPARAM lParam)
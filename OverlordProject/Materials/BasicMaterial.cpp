@@ -48,9 +48,10 @@ void BasicMaterial::UseTransparency(bool enable)
 
 void BasicMaterial::InitializeEffectVariables()
 {
+	m_EVar_LightDirection = GetVariableHandle<XMFLOAT4>(L"gLightDirection");
 }
 
 void BasicMaterial::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent*) const
 {
-	SetVariable_Vector(L"gLightDirection", sceneContext.pLights->GetDirectionalLight().direction);
+	m_EVar_LightDirection.Set(sceneContext.pLights->GetDirectionalLight().direction);
 }
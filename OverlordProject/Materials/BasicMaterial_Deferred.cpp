@@ -53,9 +53,10 @@ void BasicMaterial_Deferred::WriteToMask(bool enable)
 
 void BasicMaterial_Deferred::InitializeEffectVariables()
 {
+	m_EVar_LightDirection = GetVariableHandle<XMFLOAT4>(L"gLightDirection");
 }
 
 void BasicMaterial_Deferred::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent*) const
 {
-	SetVariable_Vector(L"gLightDirection", sceneContext.pLights->GetDirectionalLight().direction);
+	m_EVar_LightDirection.Set(sceneContext.pLights->GetDirectionalLight().direction);
 }
@@ -25,5 +25,8 @@ public:
 protected:
 	void InitializeEffectVariables() override;
 	void OnUpdateModelVariables(const SceneContext& /*sceneContext*/, const ModelComponent* /*pModel*/) const;
+
+private:
+	MaterialVariable<XMFLOAT4> m_EVar_LightDirection{};
 };
 
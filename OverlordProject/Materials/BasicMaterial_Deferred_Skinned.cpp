@@ -52,15 +52,16 @@ void BasicMaterial_Deferred_Skinned::WriteToMask(bool enable)
 
 void BasicMaterial_Deferred_Skinned::InitializeEffectVariables()
 {
-
+	m_EVar_LightDirection = GetVariableHandle<XMFLOAT4>(L"gLightDirection");
+	m_EVar_Bones = GetVariableHandle<XMFLOAT4X4>(L"gBones");
 }
 
 void BasicMaterial_Deferred_Skinned::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent* pModel) const
 {
-	SetVariable_Vector(L"gLightDirection", sceneContext.pLights->GetDirectionalLight().direction);
+	m_EVar_LightDirection.Set(sceneContext.pLights->GetDirectionalLight().direction);
 
 	auto anim = pModel->GetAnimator();
 	ASSERT_NULL_(anim);
-	auto boneTransforms = anim->GetBoneTransforms();
-	SetVariable_MatrixArray(L"gBones", &boneTransforms[0]._11, (UINT)boneTransforms.size());
+	const auto& boneTransforms = anim->GetBoneTransforms();
+	m_EVar_Bones.SetArray(boneTransforms.data(), static_cast<UINT>(boneTransforms.size()));
 }
\ No newline at end of file
@@ -24,4 +24,8 @@ public:
 protected:
 	void InitializeEffectVariables() override;
 	void OnUpdateModelVariables(const SceneContext&, const ModelComponent*) const;
+
+private:
+	MaterialVariable<XMFLOAT4> m_EVar_LightDirection{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_Bones{};
 };
\ No newline at end of file
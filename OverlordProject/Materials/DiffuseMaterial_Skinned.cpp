@@ -14,6 +14,7 @@ void DiffuseMaterial_Skinned::SetDiffuseTexture(const std::wstring& assetFile)
 
 void DiffuseMaterial_Skinned::InitializeEffectVariables()
 {
+	m_EVar_Bones = GetVariableHandle<XMFLOAT4X4>(L"gBones");
 }
 
 void DiffuseMaterial_Skinned::OnUpdateModelVariables(const SceneContext&, const ModelComponent* pModel) const
@@ -24,6 +25,6 @@ void DiffuseMaterial_Skinned::OnUpdateModelVariables(const SceneContext&, const
 	//Set the 'gBones' variable of the effect (MatrixArray) > BoneTransforms
 	auto anim = pModel->GetAnimator();
 	ASSERT_NULL_(anim);
-	auto boneTransforms = anim->GetBoneTransforms();
-	SetVariable_MatrixArray(L"gBones", &boneTransforms[0]._11, (UINT)boneTransforms.size());
+	const auto& boneTransforms = anim->GetBoneTransforms();
+	m_EVar_Bones.SetArray(boneTransforms.data(), static_cast<UINT>(boneTransforms.size()));
 }
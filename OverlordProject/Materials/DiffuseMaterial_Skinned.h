@@ -18,5 +18,6 @@ protected:
 
 private:
 	TextureData* m_pDiffuseTexture{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_Bones{};
 };
 
@@ -25,9 +25,15 @@ void DiffuseMaterial_Shadow::InitializeEffectVariables()
 {
 	const auto pShadowMapRenderer = ShadowMapRenderer::Get();
 	SetVariable_Texture(L"gBakedShadowMap", pShadowMapRenderer->GetBakedShadowMap());
+
+	m_EVar_ShadowMap = GetVariableHandle<ID3D11ShaderResourceView*>(L"gShadowMap");
+	m_EVar_WorldViewProj_Light = GetVariableHandle<XMFLOAT4X4>(L"gWorldViewProj_Light");
+	m_EVar_BakedWorldViewProj_Light = GetVariableHandle<XMFLOAT4X4>(L"gBakedWorldViewProj_Light");
+	m_EVar_LightDirection = GetVariableHandle<XMFLOAT4>(L"gLightDirection");
+	m_EVar_UseBakedShadows = GetVariableHandle<bool>(L"gUseBakedShadows");
 }
 
-void DiffuseMaterial_Shadow::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent* pModel) const
+void DiffuseMaterial_Shadow::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent*) const
 {
 	/*
 	 * TODO_W8
@@ -47,23 +53,23 @@ void DiffuseMaterial_Shadow::OnUpdateModelVariables(const SceneContext& sceneCon
 	XMFLOAT4X4 lWvp;
 	XMStoreFloat4x4(&lWvp, 
 		XMMatrixMultiply(
-			XMLoadFloat4x4(&pModel->GetTransform()->GetWorld()),
+			XMLoadFloat4x4(&GetDrawWorld()),
 			XMLoadFloat4x4(&pShadowMapRenderer->GetLightVP())
 		));
 
-	SetVariable_Texture(L"gShadowMap", pShadowMapRenderer->GetShadowMap());
-	SetVariable_Matrix(L"gWorldViewProj_Light", reinterpret_cast<const float*>(&lWvp));
-	SetVariable_Vector(L"gLightDirection", sceneContext.pLights->GetDirectionalLight().direction);
+	m_EVar_ShadowMap.Set(pShadowMapRenderer->GetShadowMap());
+	m_EVar_WorldViewProj_Light.Set(lWvp);
+	m_EVar_LightDirection.Set(sceneContext.pLights->GetDirectionalLight().direction);
 	
 	// BAKED SHADOWS
-	SetVariable_Scalar(L"gUseBakedShadows", sceneContext.pLights->GetUseBakedShadows());
+	m_EVar_UseBakedShadows.Set(sceneContext.pLights->GetUseBakedShadows());
 	XMStoreFloat4x4(&m_BakedLightWVP,
 		XMMatrixMultiply(
-			XMLoadFloat4x4(&pModel->GetTransform()->GetWorld()),
+			XMLoadFloat4x4(&GetDrawWorld()),
 			XMLoadFloat4x4(&pShadowMapRenderer->GetBakedLightVP())
 		));
 
-	SetVariable_Matrix(L"gBakedWorldViewProj_Light", reinterpret_cast<const float*>(&m_BakedLightWVP));
+	m_EVar_BakedWorldViewProj_Light.Set(m_BakedLightWVP);
 
 	// Rotates the shadows on the race track by 90 degrees for some fucking reason
 	// TODO: Fix this
@@ -15,6 +15,13 @@ void DiffuseMaterial_Shadow_Skinned::InitializeEffectVariables()
 {
 	const auto pShadowMapRenderer = ShadowMapRenderer::Get();
 	SetVariable_Texture(L"gBakedShadowMap", pShadowMapRenderer->GetBakedShadowMap());
+
+	m_EVar_ShadowMap = GetVariableHandle<ID3D11ShaderResourceView*>(L"gShadowMap");
+	m_EVar_WorldViewProj_Light = GetVariableHandle<XMFLOAT4X4>(L"gWorldViewProj_Light");
+	m_EVar_BakedWorldViewProj_Light = GetVariableHandle<XMFLOAT4X4>(L"gBakedWorldViewProj_Light");
+	m_EVar_LightDirection = GetVariableHandle<XMFLOAT4>(L"gLightDirection");
+	m_EVar_UseBakedShadows = GetVariableHandle<bool>(L"gUseBakedShadows");
+	m_EVar_Bones = GetVariableHandle<XMFLOAT4X4>(L"gBones");
 }
 
 void DiffuseMaterial_Shadow_Skinned::OnUpdateModelVariables(const SceneContext& sceneContext, const ModelComponent* pModel) const
@@ -39,27 +46,27 @@ void DiffuseMaterial_Shadow_Skinned::OnUpdateModelVariables(const SceneContext&
 	XMFLOAT4X4 lWvp;
 	XMStoreFloat4x4(&lWvp,
 		XMMatrixMultiply(
-			XMLoadFloat4x4(&pModel->GetTransform()->GetWorld()),
+			XMLoadFloat4x4(&GetDrawWorld()),
 			XMLoadFloat4x4(&pShadowMapRenderer->GetLightVP())
 		));
 
-	SetVariable_Matrix(L"gWorldViewProj_Light", reinterpret_cast<const float*>(&lWvp));
-	SetVariable_Texture(L"gShadowMap", pShadowMapRenderer->GetShadowMap());
-	SetVariable_Vector(L"gLightDirection", sceneContext.pLights->GetDirectionalLight().direction);
+	m_EVar_WorldViewProj_Light.Set(lWvp);
+	m_EVar_ShadowMap.Set(pShadowMapRenderer->GetShadowMap());
+	m_EVar_LightDirection.Set(sceneContext.pLights->GetDirectionalLight().direction);
 
 	// BAKED SHADOWS
-	SetVariable_Scalar(L"gUseBakedShadows", sceneContext.pLights->GetUseBakedShadows());
+	m_EVar_UseBakedShadows.Set(sceneContext.pLights->GetUseBakedShadows());
 	XMStoreFloat4x4(&m_BakedLightWVP,
 		XMMatrixMultiply(
-			XMLoadFloat4x4(&pModel->GetTransform()->GetWorld()),
+			XMLoadFloat4x4(&GetDrawWorld()),
 			XMLoadFloat4x4(&pShadowMapRenderer->GetBakedLightVP())
 		));
 
-	SetVariable_Matrix(L"gBakedWorldViewProj_Light", reinterpret_cast<const float*>(&m_BakedLightWVP));
+	m_EVar_BakedWorldViewProj_Light.Set(m_BakedLightWVP);
 
 	// BONES
 	auto anim = pModel->GetAnimator();
 	ASSERT_NULL_(anim);
-	auto boneTransforms = anim->GetBoneTransforms();
-	SetVariable_MatrixArray(L"gBones", &boneTransforms[0]._11, (UINT)boneTransforms.size());
+	const auto& boneTransforms = anim->GetBoneTransforms();
+	m_EVar_Bones.SetArray(boneTransforms.data(), static_cast<UINT>(boneTransforms.size()));
 }
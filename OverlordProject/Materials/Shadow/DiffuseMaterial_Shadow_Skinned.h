@@ -19,5 +19,11 @@ protected:
 private:
 	TextureData* m_pDiffuseTexture{};
 	mutable XMFLOAT4X4 m_BakedLightWVP{};
+
+	MaterialVariable<ID3D11ShaderResourceView*> m_EVar_ShadowMap{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_WorldViewProj_Light{}, m_EVar_BakedWorldViewProj_Light{};
+	MaterialVariable<XMFLOAT4> m_EVar_LightDirection{};
+	MaterialVariable<bool> m_EVar_UseBakedShadows{};
+	MaterialVariable<XMFLOAT4X4> m_EVar_Bones{};
 };
 
@@ -15,7 +15,8 @@ void BoneObject::AddBone(BoneObject* pBone)
 
 void BoneObject::CalculateBindPose()
 {
-	const auto invWorld{XMMatrixInverse(nullptr, XMLoadFloat4x4(&GetTransform()->GetWorld()))};
+	const XMFLOAT4X4 world{ GetTransform()->GetWorld() };
+	const auto invWorld{XMMatrixInverse(nullptr, XMLoadFloat4x4(&world))};
 	XMStoreFloat4x4(&m_BindPose, invWorld);
 
 	for(auto pChild : GetChildren<BoneObject>())
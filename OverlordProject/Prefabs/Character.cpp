@@ -64,8 +64,10 @@ void Character::Update(const SceneContext& sceneContext)
 		//Retrieve the TransformComponent
 		//Retrieve the forward & right vector (as XMVECTOR) from the TransformComponent
 		auto transform = GetTransform();
-		auto forward = XMLoadFloat3(&transform->GetForward());
-		auto right = XMLoadFloat3(&transform->GetRight());
+		const XMFLOAT3 transformForward{ transform->GetForward() };
+		const XMFLOAT3 transformRight{ transform->GetRight() };
+		auto forward = XMLoadFloat3(&transformForward);
+		auto right = XMLoadFloat3(&transformRight);
 
 		//***************
 		//CAMERA ROTATION
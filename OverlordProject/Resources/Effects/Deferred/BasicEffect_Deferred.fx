@@ -21,6 +21,8 @@ float4x4 gWorldViewProj : WORLDVIEWPROJECTION;
 float4x4 gViewInverse : VIEWINVERSE;
 // The World Matrix
 float4x4 gWorld : WORLD;
+// The View Projection Matrix (Instanced technique, the world matrix is part of the instance stream)
+float4x4 gViewProj : VIEWPROJECTION;
 bool gWriteToMask = true;
 
 //STATES
@@ -166,6 +168,20 @@ struct VS_Input
 	float2 TexCoord: TEXCOORD0;
 };
 
+// Same vertex layout as VS_Input, followed by the per instance stream (slot 1)
+struct VS_Input_Instanced
+{
+	float3 Position: POSITION;
+	float3 Normal: NORMAL;
+	float3 Tangent: TANGENT;
+	float3 Binormal: BINORMAL;
+	float2 TexCoord: TEXCOORD0;
+	float4 World0: INSTANCE_WORLD0;
+	float4 World1: INSTANCE_WORLD1;
+	float4 World2: INSTANCE_WORLD2;
+	float4 World3: INSTANCE_WORLD3;
+};
+
 struct VS_Output
 {
 	float4 Position: SV_POSITION;
@@ -200,6 +216,23 @@ VS_Output MainVS(VS_Input input)
 	return output;
 }
 
+// The instanced vertex shader
+VS_Output InstancedVS(VS_Input_Instanced input)
+{
+	VS_Output output = (VS_Output)0;
+
+	float4x4 world = float4x4(input.World0, input.World1, input.World2, input.World3);
+	output.Position = mul(mul(float4(input.Position, 1.0), world), gViewProj);
+
+	output.Normal = normalize(mul(input.Normal, (float3x3)world));
+	output.Tangent = normalize(mul(input.Tangent, (float3x3)world));
+	output.Binormal = normalize(mul(input.Binormal, (float3x3)world));
+
+	output.TexCoord = input.TexCoord;
+
+	return output;
+}
+
 // The main pixel shader
 PS_Output MainPS(VS_Output input)
 {
@@ -281,4 +314,18 @@ technique11 Default {
 		SetGeometryShader(NULL);
 		SetPixelShader(CompileShader(ps_4_0, MainPS()));
 	}
+}
+
+// Instanced Technique (RenderQueue, one draw for every instance of a submesh)
+technique11 Instanced {
+	pass p0
+{
+		SetDepthStencilState(gDepthState, 0);
+		SetRasterizerState(gRasterizerState);
+		SetBlendState(gBlendState, float4(0.0f, 0.0f, 0.0f, 0.0f), 0xFFFFFFFF);
+
+		SetVertexShader(CompileShader(vs_4_0, InstancedVS()));
+		SetGeometryShader(NULL);
+		SetPixelShader(CompileShader(ps_4_0, MainPS()));
+	}
 }
\ No newline at end of file
@@ -24,8 +24,13 @@ float4x4 gWorld : WORLD;
 // Whether or not to write to mask buffer
 bool gWriteToMask = true;
 
+// The View Projection Matrix (Instanced technique, the world matrix is part of the instance stream)
+float4x4 gViewProj : VIEWPROJECTION;
+
 // BONES
 float4x4 gBones[70] : BONES;
+// Bone palette of every instance (Instanced technique, four rows per bone)
+Buffer<float4> gBonePalette;
 
 //STATES
 //******
@@ -172,6 +177,23 @@ struct VS_Input
     float4 BlendWeights : BLENDWEIGHTS;
 };
 
+// Same vertex layout as VS_Input, followed by the per instance stream (slot 1)
+struct VS_Input_Instanced
+{
+    float3 Position : POSITION;
+    float3 Normal : NORMAL;
+    float3 Tangent : TANGENT;
+    float3 Binormal : BINORMAL;
+    float2 TexCoord : TEXCOORD0;
+    float4 BlendIndices : BLENDINDICES;
+    float4 BlendWeights : BLENDWEIGHTS;
+    float4 World0 : INSTANCE_WORLD0;
+    float4 World1 : INSTANCE_WORLD1;
+    float4 World2 : INSTANCE_WORLD2;
+    float4 World3 : INSTANCE_WORLD3;
+    uint BoneOffset : INSTANCE_BONES;
+};
+
 struct VS_Output
 {
     float4 Position : SV_POSITION;
@@ -221,6 +243,42 @@ VS_Output MainVS(VS_Input input)
     return output;
 }
 
+float4x4 GetPaletteBone(uint bone)
+{
+    uint row = bone * 4;
+    return float4x4(gBonePalette.Load(row), gBonePalette.Load(row + 1), gBonePalette.Load(row + 2), gBonePalette.Load(row + 3));
+}
+
+// The instanced vertex shader
+VS_Output InstancedVS(VS_Input_Instanced input)
+{
+    VS_Output output = (VS_Output) 0;
+
+    float4 transformedPosition = 0;
+    for (int i = 0; i < 4; i++)
+    {
+		// GET BONE INDEX
+        int boneIndex = (int) input.BlendIndices[i];
+        if (boneIndex < 0)
+            continue;
+
+        float4x4 bone = GetPaletteBone(input.BoneOffset + boneIndex);
+        transformedPosition += mul(float4(input.Position, 1.0f), bone) * input.BlendWeights[i];
+    }
+
+    transformedPosition.w = 1.f;
+    float4x4 world = float4x4(input.World0, input.World1, input.World2, input.World3);
+    output.Position = mul(mul(transformedPosition, world), gViewProj);
+
+    output.Normal = normalize(mul(input.Normal, (float3x3) world));
+    output.Tangent = normalize(mul(input.Tangent, (float3x3) world));
+    output.Binormal = normalize(mul(input.Binormal, (float3x3) world));
+
+    output.TexCoord = input.TexCoord;
+
+    return output;
+}
+
 // The main pixel shader
 PS_Output MainPS(VS_Output input)
 {
@@ -303,4 +361,19 @@ technique11 Default
         SetGeometryShader(NULL);
         SetPixelShader(CompileShader(ps_4_0, MainPS()));
     }
+}
+
+// Instanced Technique (RenderQueue, one draw for every instance of a submesh)
+technique11 Instanced
+{
+    pass p0
+    {
+        SetDepthStencilState(gDepthState, 0);
+        SetRasterizerState(gRasterizerState);
+        SetBlendState(gBlendState, float4(0.0f, 0.0f, 0.0f, 0.0f), 0xFFFFFFFF);
+
+        SetVertexShader(CompileShader(vs_4_0, InstancedVS()));
+        SetGeometryShader(NULL);
+        SetPixelShader(CompileShader(ps_4_0, MainPS()));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "ComponentUpdateBenchmarkScene.h"
+
+#pragma region Benchmark Components
+namespace
+{
+	//Three small, unrelated component types (interleaved per GameObject)
+	class SpinComponent final : public BaseComponent
+	{
+	protected:
+		void Initialize(const SceneContext&) override {}
+		void Update(const SceneContext& sceneContext) override
+		{
+			m_Angle += sceneContext.pGameTime->GetElapsed();
+			GetTransform()->Rotate(0.f, m_Angle, 0.f, false);
+		}
+
+	private:
+		float m_Angle{};
+	};
+
+	class OscillatorComponent final : public BaseComponent
+	{
+	protected:
+		void Initialize(const SceneContext&) override {}
+		void Update(const SceneContext& sceneContext) override
+		{
+			m_Value = std::sinf(sceneContext.pGameTime->GetTotal() + static_cast<float>(GetComponentId()));
+		}
+
+	private:
+		float m_Value{};
+	};
+
+	class CounterComponent final : public BaseComponent
+	{
+	protected:
+		void Initialize(const SceneContext&) override {}
+		void Update(const SceneContext&) override { ++m_Count; }
+
+	private:
+		UINT m_Count{};
+	};
+}
+#pragma endregion
+
+void ComponentUpdateBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	for (int root{}; root < m_RootCount; ++root)
+	{
+		const auto pRoot = AddChild(new GameObject());
+		pRoot->GetTransform()->Translate(static_cast<float>(root % 40) * 2.f, 0.f, static_cast<float>(root / 40) * 2.f);
+		pRoot->AddComponent(new SpinComponent());
+		pRoot->AddComponent(new OscillatorComponent());
+		pRoot->AddComponent(new CounterComponent());
+
+		for (int child{}; child < m_ChildrenPerRoot; ++child)
+		{
+			const auto pChild = pRoot->AddChild(new GameObject());
+			pChild->GetTransform()->Translate(0.f, static_cast<float>(child) * 0.5f, 0.f);
+			pChild->AddComponent(new OscillatorComponent());
+			pChild->AddComponent(new CounterComponent());
+			pChild->AddComponent(new SpinComponent());
+		}
+	}
+
+	StartBenchmark();
+}
+
+void ComponentUpdateBenchmarkScene::StartBenchmark()
+{
+	m_Stage = BenchmarkStage::WarmUp;
+	m_StageFrame = 0;
+	m_TreeWalkMs = 0.f;
+	m_BucketsMs = 0.f;
+	m_SceneContext.settings.updateComponentsByType = false;
+}
+
+void ComponentUpdateBenchmarkScene::PostDraw()
+{
+	//Sampled after this frame's update pass
+	const float updateMs{ GameStats::GetFrameStats().sceneUpdateMs };
+	++m_StageFrame;
+
+	switch (m_Stage)
+	{
+	case BenchmarkStage::WarmUp:
+		if (m_StageFrame >= m_WarmUpFrames)
+		{
+			m_Stage = BenchmarkStage::TreeWalk;
+			m_StageFrame = 0;
+		}
+		break;
+	case BenchmarkStage::TreeWalk:
+		m_TreeWalkMs += updateMs;
+		if (m_StageFrame >= m_MeasureFrames)
+		{
+			m_TreeWalkMs /= m_MeasureFrames;
+			m_Stage = BenchmarkStage::Buckets;
+			m_StageFrame = 0;
+			m_SceneContext.settings.updateComponentsByType = true;
+		}
+		break;
+	case BenchmarkStage::Buckets:
+		m_BucketsMs += updateMs;
+		if (m_StageFrame >= m_MeasureFrames)
+		{
+			m_BucketsMs /= m_MeasureFrames;
+			m_Stage = BenchmarkStage::Done;
+
+			Logger::LogInfo(L"[ComponentUpdateBenchmark] {} GameObjects > Tree Walk: {:.3f} ms | Per Type: {:.3f} ms | Speedup: {:.2f}x",
+				m_RootCount * (m_ChildrenPerRoot + 1), m_TreeWalkMs, m_BucketsMs, m_TreeWalkMs / m_BucketsMs);
+		}
+		break;
+	case BenchmarkStage::Done:
+		break;
+	}
+}
+
+void ComponentUpdateBenchmarkScene::OnGUI()
+{
+	ImGui::Text("GameObjects: %d", m_RootCount * (m_ChildrenPerRoot + 1));
+
+	if (m_Stage == BenchmarkStage::Done)
+	{
+		ImGui::Text("Tree Walk: %.3f ms", m_TreeWalkMs);
+		ImGui::Text("Per Type: %.3f ms", m_BucketsMs);
+		ImGui::Text("Speedup: %.2fx", m_TreeWalkMs / m_BucketsMs);
+	}
+	else
+	{
+		ImGui::Text("Measuring... (%s)", m_Stage == BenchmarkStage::Buckets ? "per type" : "tree walk");
+	}
+
+	if (ImGui::Button("Restart Benchmark"))
+		StartBenchmark();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+//Compares the per-GameObject tree walk against per-type component buckets (SceneSettings::updateComponentsByType)
+class ComponentUpdateBenchmarkScene final : public GameScene
+{
+public:
+	ComponentUpdateBenchmarkScene() :GameScene(L"ComponentUpdateBenchmarkScene") {}
+	~ComponentUpdateBenchmarkScene() override = default;
+	ComponentUpdateBenchmarkScene(const ComponentUpdateBenchmarkScene& other) = delete;
+	ComponentUpdateBenchmarkScene(ComponentUpdateBenchmarkScene&& other) noexcept = delete;
+	ComponentUpdateBenchmarkScene& operator=(const ComponentUpdateBenchmarkScene& other) = delete;
+	ComponentUpdateBenchmarkScene& operator=(ComponentUpdateBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void PostDraw() override;
+	void OnGUI() override;
+
+private:
+	enum class BenchmarkStage
+	{
+		WarmUp,
+		TreeWalk,
+		Buckets,
+		Done
+	};
+
+	static constexpr int m_RootCount{ 1000 };
+	static constexpr int m_ChildrenPerRoot{ 9 }; //10k GameObjects
+	static constexpr int m_WarmUpFrames{ 60 };
+	static constexpr int m_MeasureFrames{ 300 };
+
+	BenchmarkStage m_Stage{ BenchmarkStage::WarmUp };
+	int m_StageFrame{};
+	float m_TreeWalkMs{}, m_BucketsMs{};
+
+	void StartBenchmark();
+};
@@ -0,0 +1,196 @@
+#include "stdafx.h"
+#include <random>
+
+#include "InstancingBenchmarkScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	//Stand-in for a state object, only compared (never dereferenced)
+	template<typename T>
+	T* FakeHandle(UINT category, UINT index)
+	{
+		return reinterpret_cast<T*>(static_cast<uintptr_t>((category << 24 | index) + 1) * 16);
+	}
+
+	bool IsSameBatchState(const RenderQueue::DrawItem& a, const RenderQueue::DrawItem& b)
+	{
+		return a.pMaterial == b.pMaterial && a.pInstancedTechnique == b.pInstancedTechnique &&
+			a.pPositionBuffer == b.pPositionBuffer && a.pVertexBuffer == b.pVertexBuffer && a.pIndexBuffer == b.pIndexBuffer &&
+			a.indexCount == b.indexCount && a.boneCount == b.boneCount;
+	}
+}
+
+void InstancingBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunBenchmark();
+}
+
+void InstancingBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	for (const UINT drawCount : m_DrawCounts)
+	{
+		const Result& result = m_Results.emplace_back(Measure(drawCount));
+
+		Logger::LogInfo(L"[InstancingBenchmark] {} draws > {} draw calls ({} instanced batches, {} instances, {} palette bones) | Batching: {:.3f} ms | Errors: {}",
+			result.drawCount, result.drawCalls, result.instancedBatches, result.instances, result.paletteBones, result.batchMs, result.batchErrors);
+	}
+}
+
+InstancingBenchmarkScene::Result InstancingBenchmarkScene::Measure(UINT drawCount) const
+{
+	Result result{};
+	result.drawCount = drawCount;
+
+	//Fixed seed, every run uses the same items
+	std::mt19937 generator{ drawCount };
+	std::uniform_int_distribution<UINT> mesh{ 0, m_MeshCount - 1 };
+	std::uniform_int_distribution<UINT> material{ 0, m_MaterialsPerMesh - 1 };
+	std::uniform_int_distribution<UINT> pose{ 0, m_PoseCount - 1 };
+	std::uniform_real_distribution<float> position{ -250.f, 250.f };
+	std::uniform_real_distribution<float> depth{ -10.f, 500.f };
+
+	std::vector<XMFLOAT4X4> poses(m_PoseCount * m_BoneCount);
+	for (UINT i{}; i < static_cast<UINT>(poses.size()); ++i)
+	{
+		XMStoreFloat4x4(&poses[i], XMMatrixTranslation(static_cast<float>(i), 0.f, 0.f));
+	}
+
+	RenderQueue queue{};
+	for (UINT i{}; i < drawCount; ++i)
+	{
+		const UINT meshId{ mesh(generator) };
+		const UINT materialId{ meshId * m_MaterialsPerMesh + material(generator) };
+		const bool isSkinned{ meshId % 4 == 0 };
+
+		//Every 8th material has no instanced technique (custom effect)
+		const bool canInstance{ materialId % 8 != 7 };
+
+		RenderQueue::DrawItem item{};
+		item.key = RenderQueue::MakeKey(0, materialId, isSkinned ? 1 : 0, meshId, depth(generator));
+		item.pMaterial = FakeHandle<BaseMaterial>(0, materialId);
+		item.pTechnique = FakeHandle<ID3DX11EffectTechnique>(1, isSkinned ? 1 : 0);
+		item.pInputLayout = FakeHandle<ID3D11InputLayout>(2, isSkinned ? 1 : 0);
+		item.pPositionBuffer = FakeHandle<ID3D11Buffer>(5, meshId);
+		item.pVertexBuffer = FakeHandle<ID3D11Buffer>(3, meshId);
+		item.vertexStride = isSkinned ? 76 : 44;
+		item.pIndexBuffer = FakeHandle<ID3D11Buffer>(4, meshId);
+		item.indexCount = 300 + meshId * 3;
+
+		XMStoreFloat4x4(&item.world, XMMatrixTranslation(position(generator), 0.f, position(generator)));
+		if (canInstance)
+		{
+			item.pInstancedTechnique = FakeHandle<ID3DX11EffectTechnique>(5, isSkinned ? 1 : 0);
+			item.pInstancedInputLayout = FakeHandle<ID3D11InputLayout>(6, isSkinned ? 1 : 0);
+		}
+
+		if (isSkinned)
+		{
+			item.pBones = &poses[pose(generator) * m_BoneCount];
+			item.boneCount = m_BoneCount;
+		}
+
+		queue.Add(item);
+	}
+
+	queue.Sort();
+
+	//Warm, the queue keeps its capacity between frames
+	queue.BuildBatches(true);
+
+	const auto start = Clock::now();
+	queue.BuildBatches(true);
+	result.batchMs = ElapsedMs(start);
+
+	const auto& items = queue.GetItems();
+	const auto& commands = queue.GetCommands();
+	const auto& batches = queue.GetBatches();
+	const auto& instances = queue.GetInstances();
+	const auto& palette = queue.GetBonePalette();
+
+	result.drawCalls = static_cast<UINT>(batches.size());
+	result.instancedBatches = queue.GetInstancedBatchCount();
+	result.instances = static_cast<UINT>(instances.size());
+	result.paletteBones = static_cast<UINT>(palette.size());
+
+	//Validation
+	UINT nextCommand{};
+	for (UINT b{}; b < static_cast<UINT>(batches.size()); ++b)
+	{
+		const RenderQueue::Batch& batch{ batches[b] };
+		const RenderQueue::DrawItem& first{ items[commands[batch.firstCommand]] };
+
+		//Batches cover the command list in order
+		if (batch.firstCommand != nextCommand || batch.commandCount == 0)
+			++result.batchErrors;
+		nextCommand = batch.firstCommand + batch.commandCount;
+
+		if (!batch.isInstanced)
+		{
+			if (batch.commandCount != 1)
+				++result.batchErrors;
+		}
+		else
+		{
+			for (UINT i{}; i < batch.commandCount; ++i)
+			{
+				const RenderQueue::DrawItem& item{ items[commands[batch.firstCommand + i]] };
+				const RenderQueue::InstanceData& instance{ instances[batch.firstInstance + i] };
+
+				if (!item.pInstancedTechnique || !IsSameBatchState(first, item))
+					++result.batchErrors;
+
+				if (std::memcmp(&instance.world, &item.world, sizeof(XMFLOAT4X4)) != 0)
+					++result.batchErrors;
+
+				if (item.boneCount > 0 && (instance.boneOffset + item.boneCount > palette.size() ||
+					std::memcmp(&palette[instance.boneOffset], item.pBones, sizeof(XMFLOAT4X4) * item.boneCount) != 0))
+					++result.batchErrors;
+			}
+		}
+
+		//Adjacent batches that could have been one draw
+		if (b + 1 < batches.size())
+		{
+			const RenderQueue::DrawItem& last{ items[commands[nextCommand - 1]] };
+			const RenderQueue::DrawItem& next{ items[commands[nextCommand]] };
+			if (last.pInstancedTechnique && IsSameBatchState(last, next))
+				++result.batchErrors;
+		}
+	}
+
+	if (nextCommand != drawCount)
+		++result.batchErrors;
+
+	//Without instancing every command is a draw call
+	queue.BuildBatches(false);
+	if (queue.GetBatches().size() != drawCount || !queue.GetInstances().empty())
+		++result.batchErrors;
+
+	return result;
+}
+
+void InstancingBenchmarkScene::OnGUI()
+{
+	for (const Result& result : m_Results)
+	{
+		ImGui::Separator();
+		ImGui::Text("%u draws (%u meshes, %u materials)", result.drawCount, m_MeshCount, m_MeshCount * m_MaterialsPerMesh);
+		ImGui::Text("Draw calls %u > %u (%u instanced batches, %u instances)", result.drawCount, result.drawCalls, result.instancedBatches, result.instances);
+		ImGui::Text("Bone palette %u bones | Batching %.3f ms", result.paletteBones, result.batchMs);
+		ImGui::TextColored(result.batchErrors == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u batch errors", result.batchErrors);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+//Headless RenderQueue batching (fake draw items, nothing is submitted), every instanced batch is validated against its items
+class InstancingBenchmarkScene final : public GameScene
+{
+public:
+	InstancingBenchmarkScene() :GameScene(L"InstancingBenchmarkScene") {}
+	~InstancingBenchmarkScene() override = default;
+	InstancingBenchmarkScene(const InstancingBenchmarkScene& other) = delete;
+	InstancingBenchmarkScene(InstancingBenchmarkScene&& other) noexcept = delete;
+	InstancingBenchmarkScene& operator=(const InstancingBenchmarkScene& other) = delete;
+	InstancingBenchmarkScene& operator=(InstancingBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		UINT drawCount{};
+		UINT drawCalls{}; //Instancing on
+		UINT instancedBatches{};
+		UINT instances{};
+		UINT paletteBones{};
+		float batchMs{};
+		UINT batchErrors{}; //Mixed state, wrong instance data or bone offsets, missed merges
+	};
+
+	static constexpr UINT m_DrawCounts[]{ 1000, 10000, 50000 };
+	static constexpr UINT m_MeshCount{ 64 }; //Every 4th mesh is skinned
+	static constexpr UINT m_MaterialsPerMesh{ 2 };
+	static constexpr UINT m_BoneCount{ 40 };
+	static constexpr UINT m_PoseCount{ 16 }; //Bone palettes shared between the skinned items
+
+	std::vector<Result> m_Results{};
+
+	void RunBenchmark();
+	Result Measure(UINT drawCount) const;
+};
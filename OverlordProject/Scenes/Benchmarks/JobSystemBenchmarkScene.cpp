@@ -0,0 +1,213 @@
+#include "stdafx.h"
+#include "JobSystemBenchmarkScene.h"
+
+namespace
+{
+	float Work(UINT index)
+	{
+		const float x{ static_cast<float>(index) * 0.001f };
+		return std::sinf(x) * std::cosf(x) + std::sqrtf(x);
+	}
+}
+
+void JobSystemBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunSuite();
+}
+
+void JobSystemBenchmarkScene::RunSuite()
+{
+	m_Results.clear();
+	m_FailedCount = 0;
+
+	for (const UINT workerCount : m_WorkerCounts)
+	{
+		JobSystem jobSystem{ workerCount };
+		const std::string prefix{ std::format("[{} workers] ", jobSystem.GetWorkerCount()) };
+
+		TestRun(jobSystem, prefix);
+		TestParallelFor(jobSystem, prefix);
+		TestDependencies(jobSystem, prefix);
+		TestNestedJobs(jobSystem, prefix);
+		TestStress(jobSystem, prefix);
+	}
+
+	//Engine pool
+	MeasureSpeedup(*m_SceneContext.pJobSystem);
+
+	Logger::LogInfo(L"[JobSystemBenchmark] {} / {} tests passed | ParallelFor {} items > Serial: {:.3f} ms | Parallel: {:.3f} ms | Speedup: {:.2f}x",
+		m_Results.size() - m_FailedCount, m_Results.size(), m_ParallelForCount, m_SerialMs, m_ParallelMs, m_SerialMs / m_ParallelMs);
+}
+
+void JobSystemBenchmarkScene::Check(const std::string& name, bool passed)
+{
+	m_Results.emplace_back(TestResult{ name, passed });
+	if (!passed)
+	{
+		++m_FailedCount;
+		Logger::LogWarning(L"[JobSystemBenchmark] FAILED > {}", StringUtil::utf8_decode(name));
+	}
+}
+
+void JobSystemBenchmarkScene::TestRun(JobSystem& jobSystem, const std::string& prefix)
+{
+	constexpr UINT jobCount{ 10000 };
+	std::atomic<UINT> executed{};
+
+	JobSystem::Counter counter{};
+	for (UINT i{}; i < jobCount; ++i)
+	{
+		jobSystem.Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+	}
+	jobSystem.Wait(counter);
+
+	Check(prefix + "Run executes every job once", executed.load() == jobCount && counter.IsDone());
+}
+
+void JobSystemBenchmarkScene::TestParallelFor(JobSystem& jobSystem, const std::string& prefix)
+{
+	constexpr UINT count{ 100003 }; //Not a multiple of the batch size
+	std::vector<UINT> hits(count, 0);
+
+	jobSystem.ParallelFor(count, [&hits](UINT begin, UINT end)
+		{
+			for (UINT i{ begin }; i < end; ++i)
+				++hits[i];
+		});
+
+	Check(prefix + "ParallelFor visits every index once", std::ranges::all_of(hits, [](UINT hit) { return hit == 1; }));
+
+	//Explicit batch sizes (incl. a single batch)
+	for (const UINT batchSize : { 1u, 7u, count })
+	{
+		std::atomic<UINT> sum{};
+		jobSystem.ParallelFor(1000, [&sum](UINT begin, UINT end) { sum.fetch_add(end - begin); }, batchSize);
+		Check(prefix + std::format("ParallelFor batch size {}", batchSize), sum.load() == 1000);
+	}
+}
+
+void JobSystemBenchmarkScene::TestDependencies(JobSystem& jobSystem, const std::string& prefix)
+{
+	//A (many jobs) > B (many jobs) > C, every stage must see the previous stage completed
+	constexpr UINT stageJobs{ 256 };
+	std::atomic<UINT> stageA{}, stageB{};
+	std::atomic<bool> orderViolated{};
+
+	JobSystem::Counter counterA{}, counterB{}, counterC{};
+	for (UINT i{}; i < stageJobs; ++i)
+	{
+		jobSystem.Run([&stageA]() { stageA.fetch_add(1); }, &counterA);
+	}
+	for (UINT i{}; i < stageJobs; ++i)
+	{
+		jobSystem.Run([&]() {
+			if (stageA.load() != stageJobs) orderViolated = true;
+			stageB.fetch_add(1);
+			}, &counterB, &counterA);
+	}
+
+	bool cRan{};
+	jobSystem.Run([&]() {
+		if (stageB.load() != stageJobs) orderViolated = true;
+		cRan = true;
+		}, &counterC, &counterB);
+
+	jobSystem.Wait(counterC);
+
+	Check(prefix + "Dependencies respect stage order", !orderViolated.load() && cRan && counterA.IsDone() && counterB.IsDone());
+
+	//Dependency on an already finished counter runs immediately
+	bool lateRan{};
+	JobSystem::Counter lateCounter{};
+	jobSystem.Run([&lateRan]() { lateRan = true; }, &lateCounter, &counterA);
+	jobSystem.Wait(lateCounter);
+
+	Check(prefix + "Dependency on finished counter", lateRan);
+}
+
+void JobSystemBenchmarkScene::TestNestedJobs(JobSystem& jobSystem, const std::string& prefix)
+{
+	//Jobs spawning jobs (pushed onto the worker's own deque) and waiting inside a job
+	constexpr UINT parentCount{ 64 }, childCount{ 64 };
+	std::atomic<UINT> executed{};
+
+	JobSystem::Counter counter{};
+	for (UINT i{}; i < parentCount; ++i)
+	{
+		jobSystem.Run([&]() {
+			JobSystem::Counter childCounter{};
+			for (UINT j{}; j < childCount; ++j)
+			{
+				jobSystem.Run([&executed]() { executed.fetch_add(1); }, &childCounter);
+			}
+			jobSystem.Wait(childCounter);
+			}, &counter);
+	}
+	jobSystem.Wait(counter);
+
+	Check(prefix + "Nested jobs & waits", executed.load() == parentCount * childCount);
+}
+
+void JobSystemBenchmarkScene::TestStress(JobSystem& jobSystem, const std::string& prefix)
+{
+	//Many short rounds of fan-out/fan-in with a dependent reduction per round
+	bool passed{ true };
+	for (UINT round{}; round < m_StressRounds; ++round)
+	{
+		const UINT jobCount{ 100 + round * 20 };
+		std::vector<UINT> values(jobCount, 0);
+		UINT total{};
+
+		JobSystem::Counter fanOut{}, reduce{};
+		for (UINT i{}; i < jobCount; ++i)
+		{
+			jobSystem.Run([&values, i]() { values[i] = i; }, &fanOut);
+		}
+		jobSystem.Run([&values, &total]() {
+			for (const UINT value : values) total += value;
+			}, &reduce, &fanOut);
+
+		jobSystem.Wait(reduce);
+		passed &= total == jobCount * (jobCount - 1) / 2;
+	}
+
+	Check(prefix + std::format("Stress ({} rounds)", m_StressRounds), passed);
+}
+
+void JobSystemBenchmarkScene::MeasureSpeedup(JobSystem& jobSystem)
+{
+	using clock = std::chrono::high_resolution_clock;
+	std::vector<float> output(m_ParallelForCount);
+
+	auto start = clock::now();
+	for (UINT i{}; i < m_ParallelForCount; ++i)
+	{
+		output[i] = Work(i);
+	}
+	m_SerialMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+	start = clock::now();
+	jobSystem.ParallelFor(m_ParallelForCount, [&output](UINT begin, UINT end)
+		{
+			for (UINT i{ begin }; i < end; ++i)
+				output[i] = Work(i);
+		});
+	m_ParallelMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+}
+
+void JobSystemBenchmarkScene::OnGUI()
+{
+	ImGui::Text("Tests: %u / %u passed", static_cast<UINT>(m_Results.size()) - m_FailedCount, static_cast<UINT>(m_Results.size()));
+	for (const TestResult& result : m_Results)
+	{
+		ImGui::TextColored(result.passed ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%s %s", result.passed ? "PASS" : "FAIL", result.name.c_str());
+	}
+
+	ImGui::Text("ParallelFor (%u items) > Serial %.3f ms | Parallel %.3f ms | Speedup %.2fx", m_ParallelForCount, m_SerialMs, m_ParallelMs, m_SerialMs / m_ParallelMs);
+
+	if (ImGui::Button("Run Again"))
+		RunSuite();
+}
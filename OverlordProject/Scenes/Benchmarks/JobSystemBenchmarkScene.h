@@ -0,0 +1,42 @@
+#pragma once
+
+//Correctness/stress suite for the JobSystem (standalone pools with different worker counts) + parallel-for speedup
+class JobSystemBenchmarkScene final : public GameScene
+{
+public:
+	JobSystemBenchmarkScene() :GameScene(L"JobSystemBenchmarkScene") {}
+	~JobSystemBenchmarkScene() override = default;
+	JobSystemBenchmarkScene(const JobSystemBenchmarkScene& other) = delete;
+	JobSystemBenchmarkScene(JobSystemBenchmarkScene&& other) noexcept = delete;
+	JobSystemBenchmarkScene& operator=(const JobSystemBenchmarkScene& other) = delete;
+	JobSystemBenchmarkScene& operator=(JobSystemBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct TestResult
+	{
+		std::string name{};
+		bool passed{};
+	};
+
+	static constexpr UINT m_WorkerCounts[]{ 1, 3, 0 }; //0 == hardware
+	static constexpr UINT m_StressRounds{ 50 };
+	static constexpr UINT m_ParallelForCount{ 1 << 21 };
+
+	std::vector<TestResult> m_Results{};
+	UINT m_FailedCount{};
+	float m_SerialMs{}, m_ParallelMs{};
+
+	void RunSuite();
+	void Check(const std::string& name, bool passed);
+
+	void TestRun(JobSystem& jobSystem, const std::string& prefix);
+	void TestParallelFor(JobSystem& jobSystem, const std::string& prefix);
+	void TestDependencies(JobSystem& jobSystem, const std::string& prefix);
+	void TestNestedJobs(JobSystem& jobSystem, const std::string& prefix);
+	void TestStress(JobSystem& jobSystem, const std::string& prefix);
+	void MeasureSpeedup(JobSystem& jobSystem);
+};
@@ -0,0 +1,162 @@
+#include "stdafx.h"
+#include "MaterialVariableBenchmarkScene.h"
+
+#include "Materials/Shadow/DiffuseMaterial_Shadow_Skinned.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	XMFLOAT4X4 MakeMatrix(float value)
+	{
+		XMFLOAT4X4 matrix{};
+		XMStoreFloat4x4(&matrix, XMMatrixTranslation(value, value * 2.f, value * 3.f));
+		return matrix;
+	}
+
+	bool IsEqual(const XMFLOAT4X4& a, const XMFLOAT4X4& b)
+	{
+		return memcmp(&a, &b, sizeof(XMFLOAT4X4)) == 0;
+	}
+}
+
+void MaterialVariableBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	m_pMaterial = MaterialManager::Get()->CreateMaterial<DiffuseMaterial_Shadow_Skinned>();
+
+	m_Handles.worldViewProjLight = m_pMaterial->GetVariableHandle<XMFLOAT4X4>(L"gWorldViewProj_Light");
+	m_Handles.bakedWorldViewProjLight = m_pMaterial->GetVariableHandle<XMFLOAT4X4>(L"gBakedWorldViewProj_Light");
+	m_Handles.bones = m_pMaterial->GetVariableHandle<XMFLOAT4X4>(L"gBones");
+	m_Handles.lightDirection = m_pMaterial->GetVariableHandle<XMFLOAT4>(L"gLightDirection");
+	m_Handles.useBakedShadows = m_pMaterial->GetVariableHandle<bool>(L"gUseBakedShadows");
+	m_Handles.shadowMap = m_pMaterial->GetVariableHandle<ID3D11ShaderResourceView*>(L"gShadowMap");
+
+	RunBenchmark();
+}
+
+void MaterialVariableBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	for (const UINT updateCount : m_UpdateCounts)
+	{
+		const Result& result = m_Results.emplace_back(Measure(updateCount));
+
+		Logger::LogInfo(L"[MaterialVariableBenchmark] {} updates > Names: {:.3f} ms (lookups {:.3f} ms) | Handles: {:.3f} ms | Errors: {}",
+			result.updateCount, result.stringMs, result.lookupMs, result.handleMs, result.valueErrors);
+	}
+}
+
+MaterialVariableBenchmarkScene::Result MaterialVariableBenchmarkScene::Measure(UINT updateCount) const
+{
+	Result result{};
+	result.updateCount = updateCount;
+
+	std::vector<XMFLOAT4X4> bones(m_BoneCount);
+	for (UINT i{}; i < m_BoneCount; ++i)
+	{
+		bones[i] = MakeMatrix(static_cast<float>(i));
+	}
+
+	const XMFLOAT4 lightDirection{ -0.577f, -0.577f, 0.577f, 0.f };
+	ID3D11ShaderResourceView* pShadowMap{ ShadowMapRenderer::Get()->GetShadowMap() };
+
+	//Name lookups only
+	auto start = Clock::now();
+	size_t lookups{};
+	for (UINT i{}; i < updateCount; ++i)
+	{
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gWorldViewProj_Light"));
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gBakedWorldViewProj_Light"));
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gLightDirection"));
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gUseBakedShadows"));
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gShadowMap"));
+		lookups += reinterpret_cast<uintptr_t>(m_pMaterial->GetVariable(L"gBones"));
+	}
+	result.lookupMs = ElapsedMs(start);
+	if (lookups == 0) ++result.valueErrors; //Keeps the loop alive, every variable exists
+
+	//Slow path (BaseMaterial::SetVariable_*, as OnUpdateModelVariables did before the handles)
+	start = Clock::now();
+	for (UINT i{}; i < updateCount; ++i)
+	{
+		const XMFLOAT4X4 world{ MakeMatrix(static_cast<float>(i)) };
+		m_pMaterial->SetVariable_Matrix(L"gWorldViewProj_Light", &world._11);
+		m_pMaterial->SetVariable_Texture(L"gShadowMap", pShadowMap);
+		m_pMaterial->SetVariable_Vector(L"gLightDirection", lightDirection);
+		m_pMaterial->SetVariable_Scalar(L"gUseBakedShadows", (i & 1) == 0);
+		m_pMaterial->SetVariable_Matrix(L"gBakedWorldViewProj_Light", &world._11);
+		m_pMaterial->SetVariable_MatrixArray(L"gBones", &bones[0]._11, m_BoneCount);
+	}
+	result.stringMs = ElapsedMs(start);
+
+	//Cached handles
+	start = Clock::now();
+	for (UINT i{}; i < updateCount; ++i)
+	{
+		const XMFLOAT4X4 world{ MakeMatrix(static_cast<float>(i)) };
+		m_Handles.worldViewProjLight.Set(world);
+		m_Handles.shadowMap.Set(pShadowMap);
+		m_Handles.lightDirection.Set(lightDirection);
+		m_Handles.useBakedShadows.Set((i & 1) == 0);
+		m_Handles.bakedWorldViewProjLight.Set(world);
+		m_Handles.bones.SetArray(bones.data(), m_BoneCount);
+	}
+	result.handleMs = ElapsedMs(start);
+
+	//Validation, the last handle writes read back through the name lookup
+	const XMFLOAT4X4 lastWorld{ MakeMatrix(static_cast<float>(updateCount - 1)) };
+	XMFLOAT4X4 readMatrix{};
+
+	m_pMaterial->GetVariable(L"gWorldViewProj_Light")->AsMatrix()->GetMatrix(&readMatrix._11);
+	if (!IsEqual(readMatrix, lastWorld)) ++result.valueErrors;
+
+	m_pMaterial->GetVariable(L"gBakedWorldViewProj_Light")->AsMatrix()->GetMatrix(&readMatrix._11);
+	if (!IsEqual(readMatrix, lastWorld)) ++result.valueErrors;
+
+	std::vector<XMFLOAT4X4> readBones(m_BoneCount);
+	m_pMaterial->GetVariable(L"gBones")->AsMatrix()->GetMatrixArray(&readBones[0]._11, 0, m_BoneCount);
+	for (UINT i{}; i < m_BoneCount; ++i)
+	{
+		if (!IsEqual(readBones[i], bones[i])) ++result.valueErrors;
+	}
+
+	float readDirection[4]{};
+	m_pMaterial->GetVariable(L"gLightDirection")->AsVector()->GetFloatVector(readDirection);
+	if (readDirection[0] != lightDirection.x || readDirection[1] != lightDirection.y || readDirection[2] != lightDirection.z) ++result.valueErrors;
+
+	bool readBool{};
+	m_pMaterial->GetVariable(L"gUseBakedShadows")->AsScalar()->GetBool(&readBool);
+	if (readBool != ((updateCount - 1) % 2 == 0)) ++result.valueErrors;
+
+	ID3D11ShaderResourceView* pReadSRV{};
+	m_pMaterial->GetVariable(L"gShadowMap")->AsShaderResource()->GetResource(&pReadSRV);
+	if (pReadSRV != pShadowMap) ++result.valueErrors;
+	SafeRelease(pReadSRV);
+
+	return result;
+}
+
+void MaterialVariableBenchmarkScene::OnGUI()
+{
+	for (const Result& result : m_Results)
+	{
+		const float updates{ static_cast<float>(result.updateCount) };
+
+		ImGui::Separator();
+		ImGui::Text("%u model updates (6 variables, %u bones)", result.updateCount, m_BoneCount);
+		ImGui::Text("Names %.3f ms (%.1f ns/update, lookups %.3f ms)", result.stringMs, result.stringMs * 1e6f / updates, result.lookupMs);
+		ImGui::Text("Handles %.3f ms (%.1f ns/update) | x%.2f", result.handleMs, result.handleMs * 1e6f / updates, result.handleMs > 0.f ? result.stringMs / result.handleMs : 0.f);
+		ImGui::TextColored(result.valueErrors == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u value errors", result.valueErrors);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
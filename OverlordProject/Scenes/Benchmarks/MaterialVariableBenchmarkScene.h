@@ -0,0 +1,48 @@
+#pragma once
+class DiffuseMaterial_Shadow_Skinned;
+
+//Per draw parameter update of a skinned shadow material, name lookups (BaseMaterial::SetVariable_*) against cached handles (MaterialVariable)
+//Nothing is drawn, every handle write is read back through the slow path and validated
+class MaterialVariableBenchmarkScene final : public GameScene
+{
+public:
+	MaterialVariableBenchmarkScene() :GameScene(L"MaterialVariableBenchmarkScene") {}
+	~MaterialVariableBenchmarkScene() override = default;
+	MaterialVariableBenchmarkScene(const MaterialVariableBenchmarkScene& other) = delete;
+	MaterialVariableBenchmarkScene(MaterialVariableBenchmarkScene&& other) noexcept = delete;
+	MaterialVariableBenchmarkScene& operator=(const MaterialVariableBenchmarkScene& other) = delete;
+	MaterialVariableBenchmarkScene& operator=(MaterialVariableBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		UINT updateCount{};
+		float lookupMs{}; //Name hash & LUT lookup only (BaseMaterial::GetVariable)
+		float stringMs{};
+		float handleMs{};
+		UINT valueErrors{}; //Handle writes that don't read back
+	};
+
+	static constexpr UINT m_UpdateCounts[]{ 1000, 10000, 100000 };
+	static constexpr UINT m_BoneCount{ 40 };
+
+	//Variables of one model update (DiffuseMaterial_Shadow_Skinned::OnUpdateModelVariables)
+	struct Handles
+	{
+		MaterialVariable<XMFLOAT4X4> worldViewProjLight{}, bakedWorldViewProjLight{}, bones{};
+		MaterialVariable<XMFLOAT4> lightDirection{};
+		MaterialVariable<bool> useBakedShadows{};
+		MaterialVariable<ID3D11ShaderResourceView*> shadowMap{};
+	};
+
+	DiffuseMaterial_Shadow_Skinned* m_pMaterial{};
+	Handles m_Handles{};
+	std::vector<Result> m_Results{};
+
+	void RunBenchmark();
+	Result Measure(UINT updateCount) const;
+};
@@ -0,0 +1,272 @@
+#include "stdafx.h"
+#include "MeshLoadBenchmarkScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	template<typename T>
+	void ReadPerElement(BinaryReader& reader, std::vector<T>& destination, size_t count)
+	{
+		destination.reserve(count);
+		for (size_t i{}; i < count; ++i)
+			destination.emplace_back(reader.Read<T>());
+	}
+
+	//MeshFilterLoader before the bulk reads (one Read per element through std::ifstream)
+	//OVM 2.0 animation blocks are skipped, none of the meshes have them
+	std::vector<SubMeshFilter> ParsePerElement(const fs::path& filePath)
+	{
+		std::vector<SubMeshFilter> subMeshes{};
+
+		BinaryReader reader{};
+		reader.Open(filePath);
+		if (!reader.Exists())
+			return subMeshes;
+
+		const int versionMajor = reader.Read<char>();
+		const int versionMinor = reader.Read<char>();
+
+		if (versionMajor == 1 && versionMinor == 1)
+		{
+			SubMeshFilter& subMesh = subMeshes.emplace_back();
+			for (;;)
+			{
+				const auto blockId = reader.Read<char>();
+				if (blockId == 0) break;
+
+				const auto blockSize = reader.Read<UINT>();
+				switch (blockId)
+				{
+				case 1:
+					reader.ReadString();
+					subMesh.vertexCount = reader.Read<UINT>();
+					subMesh.indexCount = reader.Read<UINT>();
+					break;
+				case 2: ReadPerElement(reader, subMesh.positions, subMesh.vertexCount); break;
+				case 3: ReadPerElement(reader, subMesh.indices, subMesh.indexCount); break;
+				case 4: ReadPerElement(reader, subMesh.normals, subMesh.vertexCount); break;
+				case 5: ReadPerElement(reader, subMesh.binormals, subMesh.vertexCount); break;
+				case 6: ReadPerElement(reader, subMesh.tangents, subMesh.vertexCount); break;
+				case 7: ReadPerElement(reader, subMesh.colors, subMesh.vertexCount); break;
+				case 8: ReadPerElement(reader, subMesh.texCoords, subMesh.vertexCount); break;
+				case 9: ReadPerElement(reader, subMesh.blendIndices, subMesh.vertexCount); break;
+				case 10: ReadPerElement(reader, subMesh.blendWeights, subMesh.vertexCount); break;
+				case 11:
+				{
+					const auto clipCount = reader.Read<USHORT>();
+					for (USHORT clip{}; clip < clipCount; ++clip)
+					{
+						reader.ReadString();
+						reader.Read<float>();
+						reader.Read<float>();
+
+						const auto keyCount = reader.Read<USHORT>();
+						for (USHORT key{}; key < keyCount; ++key)
+						{
+							reader.Read<float>();
+
+							std::vector<XMFLOAT4X4> boneTransforms{};
+							ReadPerElement(reader, boneTransforms, reader.Read<USHORT>());
+						}
+					}
+				}
+				break;
+				default:
+					reader.SkipBytes(blockSize);
+					break;
+				}
+			}
+		}
+		else if (versionMajor == 2 && versionMinor == 0)
+		{
+			for (;;)
+			{
+				const auto blockId = reader.Read<BYTE>();
+				if (blockId == 0) break;
+
+				const auto blockSize = reader.Read<UINT32>();
+				if (blockId == 1)
+				{
+					reader.ReadString();
+					continue;
+				}
+
+				if (blockId != 2)
+				{
+					reader.SkipBytes(blockSize);
+					continue;
+				}
+
+				const auto meshCount = reader.Read<BYTE>();
+				for (BYTE meshId{}; meshId < meshCount; ++meshId)
+				{
+					SubMeshFilter& subMesh = subMeshes.emplace_back();
+					reader.Read<BYTE>();
+					reader.ReadString();
+					subMesh.vertexCount = reader.Read<UINT32>();
+					subMesh.indexCount = reader.Read<UINT32>();
+					subMesh.uvChannelCount = reader.Read<UINT32>();
+
+					for (;;)
+					{
+						const auto meshBlockId = reader.Read<BYTE>();
+						if (meshBlockId == 0) break;
+
+						reader.Read<UINT32>();
+						switch (meshBlockId)
+						{
+						case 1: ReadPerElement(reader, subMesh.positions, subMesh.vertexCount); break;
+						case 2: ReadPerElement(reader, subMesh.indices, subMesh.indexCount); break;
+						case 3: ReadPerElement(reader, subMesh.normals, subMesh.vertexCount); break;
+						case 4: ReadPerElement(reader, subMesh.binormals, subMesh.vertexCount); break;
+						case 5: ReadPerElement(reader, subMesh.tangents, subMesh.vertexCount); break;
+						case 6: ReadPerElement(reader, subMesh.colors, subMesh.vertexCount); break;
+						case 7: ReadPerElement(reader, subMesh.texCoords, static_cast<size_t>(subMesh.vertexCount) * subMesh.uvChannelCount); break;
+						case 8: ReadPerElement(reader, subMesh.blendIndices, subMesh.vertexCount); break;
+						case 9: ReadPerElement(reader, subMesh.blendWeights, subMesh.vertexCount); break;
+						default: break;
+						}
+					}
+				}
+			}
+		}
+
+		return subMeshes;
+	}
+
+	template<typename T>
+	bool IsSame(const std::vector<T>& a, const std::vector<T>& b)
+	{
+		return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+	}
+
+	UINT CountMismatches(const std::vector<SubMeshFilter>& reference, const MeshFilter* pMeshFilter)
+	{
+		if (!pMeshFilter || pMeshFilter->GetMeshes().size() != reference.size())
+			return 1;
+
+		UINT mismatches{};
+		for (size_t i{}; i < reference.size(); ++i)
+		{
+			const SubMeshFilter& expected{ reference[i] };
+			const SubMeshFilter& subMesh{ pMeshFilter->GetMeshes()[i] };
+
+			mismatches += IsSame(expected.positions, subMesh.positions) ? 0 : 1;
+			mismatches += IsSame(expected.normals, subMesh.normals) ? 0 : 1;
+			mismatches += IsSame(expected.tangents, subMesh.tangents) ? 0 : 1;
+			mismatches += IsSame(expected.binormals, subMesh.binormals) ? 0 : 1;
+			mismatches += IsSame(expected.texCoords, subMesh.texCoords) ? 0 : 1;
+			mismatches += IsSame(expected.colors, subMesh.colors) ? 0 : 1;
+			mismatches += IsSame(expected.blendIndices, subMesh.blendIndices) ? 0 : 1;
+			mismatches += IsSame(expected.blendWeights, subMesh.blendWeights) ? 0 : 1;
+			mismatches += IsSame(expected.indices, subMesh.indices) ? 0 : 1;
+		}
+
+		return mismatches;
+	}
+}
+
+void MeshLoadBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunBenchmark();
+}
+
+void MeshLoadBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	m_Total = { L"Total" };
+
+	for (const auto& entry : fs::directory_iterator(ContentManager::GetFullAssetPath(L"Meshes")))
+	{
+		if (!entry.is_regular_file() || entry.path().extension() != L".ovm")
+			continue;
+
+		const Result& result = m_Results.emplace_back(Measure(entry.path()));
+
+		Logger::LogInfo(L"[MeshLoadBenchmark] {} ({} KB, {} vertices) > Per element: {:.3f} ms | Bulk stream: {:.3f} ms | Bulk mapped: {:.3f} ms | Mismatches: {}",
+			result.name, result.fileBytes / 1024, result.vertexCount, result.perElementMs, result.streamMs, result.mappedMs, result.mismatches);
+
+		m_Total.fileBytes += result.fileBytes;
+		m_Total.vertexCount += result.vertexCount;
+		m_Total.perElementMs += result.perElementMs;
+		m_Total.streamMs += result.streamMs;
+		m_Total.mappedMs += result.mappedMs;
+		m_Total.mismatches += result.mismatches;
+	}
+
+	Logger::LogInfo(L"[MeshLoadBenchmark] Total ({} files, {:.2f} MB) > Per element: {:.3f} ms | Bulk stream: {:.3f} ms | Bulk mapped: {:.3f} ms | Mismatches: {}",
+		m_Results.size(), static_cast<float>(m_Total.fileBytes) / (1024.f * 1024.f), m_Total.perElementMs, m_Total.streamMs, m_Total.mappedMs, m_Total.mismatches);
+}
+
+MeshLoadBenchmarkScene::Result MeshLoadBenchmarkScene::Measure(const fs::path& filePath)
+{
+	Result result{};
+	result.name = filePath.filename().wstring();
+	result.fileBytes = fs::file_size(filePath);
+
+	//Untimed pass, all three paths read from the OS file cache
+	const std::vector<SubMeshFilter> reference = ParsePerElement(filePath);
+	for (const SubMeshFilter& subMesh : reference)
+		result.vertexCount += subMesh.vertexCount;
+
+	//Per element
+	auto start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		ParsePerElement(filePath);
+	}
+	result.perElementMs = ElapsedMs(start) / m_Repetitions;
+
+	//Bulk, stream & mapped view
+	const auto measureBulk = [&](bool isMapped)
+	{
+		const auto bulkStart = Clock::now();
+		for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+		{
+			BinaryReader reader{};
+			if (isMapped) reader.OpenMapped(filePath);
+			else reader.Open(filePath);
+
+			MeshFilter* pMeshFilter{ reader.Exists() ? MeshFilterLoader::Parse(&reader, result.name) : nullptr };
+			if (repetition == 0)
+				result.mismatches += CountMismatches(reference, pMeshFilter);
+
+			SafeDelete(pMeshFilter);
+		}
+		return ElapsedMs(bulkStart) / m_Repetitions;
+	};
+
+	result.streamMs = measureBulk(false);
+	result.mappedMs = measureBulk(true);
+
+	return result;
+}
+
+void MeshLoadBenchmarkScene::OnGUI()
+{
+	const auto toMBps = [](UINT64 bytes, float ms) { return ms > 0.f ? static_cast<float>(bytes) / (1024.f * 1024.f) / (ms / 1000.f) : 0.f; };
+
+	ImGui::Text("%u files, %.2f MB, %u vertices (avg of %u loads)", static_cast<UINT>(m_Results.size()), static_cast<float>(m_Total.fileBytes) / (1024.f * 1024.f), m_Total.vertexCount, m_Repetitions);
+	ImGui::Text("Per element %.3f ms (%.1f MB/s)", m_Total.perElementMs, toMBps(m_Total.fileBytes, m_Total.perElementMs));
+	ImGui::Text("Bulk stream %.3f ms (%.1f MB/s, x%.2f)", m_Total.streamMs, toMBps(m_Total.fileBytes, m_Total.streamMs), m_Total.streamMs > 0.f ? m_Total.perElementMs / m_Total.streamMs : 0.f);
+	ImGui::Text("Bulk mapped %.3f ms (%.1f MB/s, x%.2f)", m_Total.mappedMs, toMBps(m_Total.fileBytes, m_Total.mappedMs), m_Total.mappedMs > 0.f ? m_Total.perElementMs / m_Total.mappedMs : 0.f);
+	ImGui::TextColored(m_Total.mismatches == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u mismatching arrays", m_Total.mismatches);
+
+	for (const Result& result : m_Results)
+	{
+		ImGui::Separator();
+		ImGui::Text("%ls: %llu KB | Per element %.3f ms | Stream %.3f ms | Mapped %.3f ms", result.name.c_str(), result.fileBytes / 1024, result.perElementMs, result.streamMs, result.mappedMs);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
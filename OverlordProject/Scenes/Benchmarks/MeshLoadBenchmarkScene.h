@@ -0,0 +1,39 @@
+#pragma once
+
+//Parses every .ovm file in Resources/Meshes three ways: per element BinaryReader::Read through std::ifstream (MeshFilterLoader before
+//the bulk reads), bulk blocks through std::ifstream and bulk blocks out of the mapped file (MeshFilterLoader::LoadContent)
+//The bulk paths include the bounds computation, every parsed vertex & index array is compared with the per element output
+class MeshLoadBenchmarkScene final : public GameScene
+{
+public:
+	MeshLoadBenchmarkScene() :GameScene(L"MeshLoadBenchmarkScene") {}
+	~MeshLoadBenchmarkScene() override = default;
+	MeshLoadBenchmarkScene(const MeshLoadBenchmarkScene& other) = delete;
+	MeshLoadBenchmarkScene(MeshLoadBenchmarkScene&& other) noexcept = delete;
+	MeshLoadBenchmarkScene& operator=(const MeshLoadBenchmarkScene& other) = delete;
+	MeshLoadBenchmarkScene& operator=(MeshLoadBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		std::wstring name{};
+		UINT64 fileBytes{};
+		UINT vertexCount{};
+		float perElementMs{};
+		float streamMs{};
+		float mappedMs{};
+		UINT mismatches{}; //Arrays that differ from the per element output (or files the bulk parser rejected)
+	};
+
+	static constexpr UINT m_Repetitions{ 5 };
+
+	std::vector<Result> m_Results{};
+	Result m_Total{};
+
+	void RunBenchmark();
+	static Result Measure(const fs::path& filePath);
+};
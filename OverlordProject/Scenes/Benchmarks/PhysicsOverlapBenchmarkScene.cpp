@@ -0,0 +1,122 @@
+#include "stdafx.h"
+#include "PhysicsOverlapBenchmarkScene.h"
+
+void PhysicsOverlapBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.drawPhysXDebug = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	const auto pMaterial = PxGetPhysics().createMaterial(.5f, .5f, .1f);
+	GameSceneExt::CreatePhysXGroundPlane(*this, pMaterial);
+
+	m_pBoxes.clear(); //Unload residency, initialized again on every activation
+	m_pBoxes.reserve(m_GridSize * m_GridSize * m_Layers);
+	for (int i{}; i < m_GridSize * m_GridSize * m_Layers; ++i)
+	{
+		const auto pBox = AddChild(new GameObject());
+		const auto pRigidBody = pBox->AddComponent(new RigidBodyComponent());
+		pRigidBody->AddCollider(PxBoxGeometry{ .5f, .5f, .5f }, *pMaterial);
+		m_pBoxes.push_back(pBox);
+	}
+
+	ResetBoxes();
+	StartBenchmark();
+}
+
+void PhysicsOverlapBenchmarkScene::StartBenchmark()
+{
+	m_SyncWaitMs = 0.f;
+	m_AsyncWaitMs = 0.f;
+	m_AsyncOverlapMs = 0.f;
+	EnterStage(BenchmarkStage::WarmUp);
+}
+
+void PhysicsOverlapBenchmarkScene::EnterStage(BenchmarkStage stage)
+{
+	m_Stage = stage;
+	m_StageFrame = 0;
+	m_ResetPending = stage != BenchmarkStage::Done; //Same workload for every stage
+}
+
+void PhysicsOverlapBenchmarkScene::ResetBoxes() const
+{
+	//Slightly offset layers, the stacks topple and keep the simulation busy
+	for (size_t i{}; i < m_pBoxes.size(); ++i)
+	{
+		const int x{ static_cast<int>(i) % m_GridSize };
+		const int z{ (static_cast<int>(i) / m_GridSize) % m_GridSize };
+		const int y{ static_cast<int>(i) / (m_GridSize * m_GridSize) };
+		m_pBoxes[i]->GetTransform()->Translate(x * 1.5f + y * .3f, 1.f + y * 3.f, z * 1.5f + y * .3f);
+	}
+}
+
+void PhysicsOverlapBenchmarkScene::Update()
+{
+	if (m_ResetPending)
+	{
+		m_SceneContext.settings.asyncPhysics = m_Stage == BenchmarkStage::Async;
+		ResetBoxes(); //Buffered actor writes (applied after the sync point)
+		m_ResetPending = false;
+	}
+
+	//Gameplay stand-in, overlaps with the simulation in async mode
+	const auto workStart = std::chrono::steady_clock::now();
+	while (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - workStart).count() < m_UserWorkMs) {}
+}
+
+void PhysicsOverlapBenchmarkScene::PostDraw()
+{
+	//Sampled after this frame's sync point/step
+	const FrameStats& frameStats{ GameStats::GetFrameStats() };
+	++m_StageFrame;
+
+	switch (m_Stage)
+	{
+	case BenchmarkStage::WarmUp:
+		if (m_StageFrame >= m_WarmUpFrames)
+			EnterStage(BenchmarkStage::Sync);
+		break;
+	case BenchmarkStage::Sync:
+		m_SyncWaitMs += frameStats.physicsWaitMs / m_MeasureFrames;
+		if (m_StageFrame >= m_MeasureFrames)
+			EnterStage(BenchmarkStage::Async);
+		break;
+	case BenchmarkStage::Async:
+		//First frame fetches nothing yet (the kick happens at the end of the frame)
+		if (m_StageFrame > 1)
+		{
+			m_AsyncWaitMs += frameStats.physicsWaitMs / (m_MeasureFrames - 1);
+			m_AsyncOverlapMs += frameStats.physicsOverlapMs / (m_MeasureFrames - 1);
+		}
+
+		if (m_StageFrame >= m_MeasureFrames)
+		{
+			EnterStage(BenchmarkStage::Done);
+			Logger::LogInfo(L"[PhysicsOverlapBenchmark] {} bodies > Sync wait: {:.3f} ms | Async wait: {:.3f} ms (overlap {:.3f} ms) | Hidden: {:.1f}%",
+				m_pBoxes.size(), m_SyncWaitMs, m_AsyncWaitMs, m_AsyncOverlapMs, m_SyncWaitMs > 0.f ? (1.f - m_AsyncWaitMs / m_SyncWaitMs) * 100.f : 0.f);
+		}
+		break;
+	case BenchmarkStage::Done:
+		break;
+	}
+}
+
+void PhysicsOverlapBenchmarkScene::OnGUI()
+{
+	ImGui::Text("Bodies: %d | User work: %.1f ms", static_cast<int>(m_pBoxes.size()), m_UserWorkMs);
+
+	if (m_Stage == BenchmarkStage::Done)
+	{
+		ImGui::Text("Sync wait: %.3f ms", m_SyncWaitMs);
+		ImGui::Text("Async wait: %.3f ms (overlap %.3f ms)", m_AsyncWaitMs, m_AsyncOverlapMs);
+		ImGui::Text("Hidden: %.1f%%", m_SyncWaitMs > 0.f ? (1.f - m_AsyncWaitMs / m_SyncWaitMs) * 100.f : 0.f);
+	}
+	else
+	{
+		ImGui::Text("Measuring... (%s)", m_Stage == BenchmarkStage::Async ? "async" : "sync");
+	}
+
+	if (ImGui::Button("Restart Benchmark"))
+		StartBenchmark();
+}
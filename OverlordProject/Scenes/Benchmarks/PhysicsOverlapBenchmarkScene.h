@@ -0,0 +1,45 @@
+#pragma once
+
+//Compares the main thread time spent waiting on PhysX with synchronous and asynchronous stepping (SceneSettings::asyncPhysics)
+class PhysicsOverlapBenchmarkScene final : public GameScene
+{
+public:
+	PhysicsOverlapBenchmarkScene() :GameScene(L"PhysicsOverlapBenchmarkScene") { SetResidency(SceneResidency::Unload); } //2000 actors, released when switching away
+	~PhysicsOverlapBenchmarkScene() override = default;
+	PhysicsOverlapBenchmarkScene(const PhysicsOverlapBenchmarkScene& other) = delete;
+	PhysicsOverlapBenchmarkScene(PhysicsOverlapBenchmarkScene&& other) noexcept = delete;
+	PhysicsOverlapBenchmarkScene& operator=(const PhysicsOverlapBenchmarkScene& other) = delete;
+	PhysicsOverlapBenchmarkScene& operator=(PhysicsOverlapBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void Update() override;
+	void PostDraw() override;
+	void OnGUI() override;
+
+private:
+	enum class BenchmarkStage
+	{
+		WarmUp,
+		Sync,
+		Async,
+		Done
+	};
+
+	static constexpr int m_GridSize{ 20 };
+	static constexpr int m_Layers{ 5 }; //2000 bodies
+	static constexpr int m_WarmUpFrames{ 30 };
+	static constexpr int m_MeasureFrames{ 240 };
+	static constexpr float m_UserWorkMs{ 2.f }; //Simulated gameplay work before the sync point
+
+	std::vector<GameObject*> m_pBoxes{};
+
+	BenchmarkStage m_Stage{ BenchmarkStage::WarmUp };
+	int m_StageFrame{};
+	bool m_ResetPending{};
+	float m_SyncWaitMs{}, m_AsyncWaitMs{}, m_AsyncOverlapMs{};
+
+	void StartBenchmark();
+	void EnterStage(BenchmarkStage stage);
+	void ResetBoxes() const;
+};
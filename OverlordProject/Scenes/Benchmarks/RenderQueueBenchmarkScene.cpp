@@ -0,0 +1,120 @@
+#include "stdafx.h"
+#include <numeric>
+#include <random>
+
+#include "RenderQueueBenchmarkScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	//Stand-in for a state object, only compared (never dereferenced)
+	template<typename T>
+	T* FakeHandle(UINT category, UINT index)
+	{
+		return reinterpret_cast<T*>(static_cast<uintptr_t>((category << 24 | index) + 1) * 16);
+	}
+}
+
+void RenderQueueBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunBenchmark();
+}
+
+void RenderQueueBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	for (const UINT drawCount : m_DrawCounts)
+	{
+		const Result& result = m_Results.emplace_back(Measure(drawCount));
+
+		Logger::LogInfo(L"[RenderQueueBenchmark] {} draws > Radix sort: {:.3f} ms (std::stable_sort {:.3f} ms) | State changes: {} > {} | Order errors: {}",
+			result.drawCount, result.sortMs, result.stdSortMs, result.unsortedChanges.GetTotal(), result.sortedChanges.GetTotal(), result.orderErrors);
+	}
+}
+
+RenderQueueBenchmarkScene::Result RenderQueueBenchmarkScene::Measure(UINT drawCount) const
+{
+	Result result{};
+	result.drawCount = drawCount;
+
+	//Fixed seed, every run uses the same items
+	std::mt19937 generator{ drawCount };
+	std::uniform_int_distribution<UINT> material{ 0, m_MaterialCount - 1 };
+	std::uniform_int_distribution<UINT> mesh{ 0, m_MeshCount - 1 };
+	std::uniform_real_distribution<float> depth{ -10.f, 500.f };
+
+	RenderQueue queue{};
+	for (UINT i{}; i < drawCount; ++i)
+	{
+		const UINT materialId{ material(generator) };
+		const UINT effectId{ materialId % m_EffectCount };
+		const UINT meshId{ mesh(generator) };
+
+		RenderQueue::DrawItem item{};
+		item.key = RenderQueue::MakeKey(0, materialId, effectId, meshId, depth(generator));
+		item.pMaterial = FakeHandle<BaseMaterial>(0, materialId);
+		item.pTechnique = FakeHandle<ID3DX11EffectTechnique>(1, effectId);
+		item.pInputLayout = FakeHandle<ID3D11InputLayout>(2, effectId);
+		item.pPositionBuffer = FakeHandle<ID3D11Buffer>(5, meshId);
+		item.pVertexBuffer = FakeHandle<ID3D11Buffer>(3, meshId);
+		item.vertexStride = 20;
+		item.pIndexBuffer = FakeHandle<ID3D11Buffer>(4, meshId);
+		queue.Add(item);
+	}
+
+	result.unsortedChanges = queue.CountStateChanges();
+
+	auto start = Clock::now();
+	queue.Sort();
+	result.sortMs = ElapsedMs(start);
+
+	result.sortedChanges = queue.CountStateChanges();
+
+	//Reference order
+	std::vector<UINT> reference(drawCount);
+	std::iota(reference.begin(), reference.end(), 0);
+	const auto& items = queue.GetItems();
+
+	start = Clock::now();
+	std::ranges::stable_sort(reference, [&items](UINT a, UINT b) { return items[a].key < items[b].key; });
+	result.stdSortMs = ElapsedMs(start);
+
+	const auto& commands = queue.GetCommands();
+	for (UINT i{}; i < drawCount; ++i)
+	{
+		if (commands[i] != reference[i])
+			++result.orderErrors;
+	}
+
+	return result;
+}
+
+void RenderQueueBenchmarkScene::OnGUI()
+{
+	for (const Result& result : m_Results)
+	{
+		const RenderQueue::StateChanges& unsorted{ result.unsortedChanges };
+		const RenderQueue::StateChanges& sorted{ result.sortedChanges };
+
+		ImGui::Separator();
+		ImGui::Text("%u draws (%u materials, %u meshes)", result.drawCount, m_MaterialCount, m_MeshCount);
+		ImGui::Text("Radix sort %.3f ms | std::stable_sort %.3f ms", result.sortMs, result.stdSortMs);
+		ImGui::Text("Tree order: %u materials, %u techniques, %u layouts, %u VBs, %u IBs (%u total)",
+			unsorted.materials, unsorted.techniques, unsorted.inputLayouts, unsorted.vertexBuffers, unsorted.indexBuffers, unsorted.GetTotal());
+		ImGui::Text("Sorted:     %u materials, %u techniques, %u layouts, %u VBs, %u IBs (%u total)",
+			sorted.materials, sorted.techniques, sorted.inputLayouts, sorted.vertexBuffers, sorted.indexBuffers, sorted.GetTotal());
+		ImGui::TextColored(result.orderErrors == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u order errors", result.orderErrors);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+//Headless RenderQueue sort & state elision (fake draw items, nothing is submitted), the command list is validated against std::stable_sort
+class RenderQueueBenchmarkScene final : public GameScene
+{
+public:
+	RenderQueueBenchmarkScene() :GameScene(L"RenderQueueBenchmarkScene") {}
+	~RenderQueueBenchmarkScene() override = default;
+	RenderQueueBenchmarkScene(const RenderQueueBenchmarkScene& other) = delete;
+	RenderQueueBenchmarkScene(RenderQueueBenchmarkScene&& other) noexcept = delete;
+	RenderQueueBenchmarkScene& operator=(const RenderQueueBenchmarkScene& other) = delete;
+	RenderQueueBenchmarkScene& operator=(RenderQueueBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		UINT drawCount{};
+		float sortMs{};
+		float stdSortMs{}; //std::stable_sort on the same keys
+		RenderQueue::StateChanges unsortedChanges{}; //Scene tree order
+		RenderQueue::StateChanges sortedChanges{};
+		UINT orderErrors{}; //Commands that differ from std::stable_sort
+	};
+
+	static constexpr UINT m_DrawCounts[]{ 1000, 10000, 100000 };
+	static constexpr UINT m_MaterialCount{ 64 };
+	static constexpr UINT m_EffectCount{ 4 }; //Materials share technique & input layout per effect
+	static constexpr UINT m_MeshCount{ 512 };
+
+	std::vector<Result> m_Results{};
+
+	void RunBenchmark();
+	Result Measure(UINT drawCount) const;
+};
@@ -0,0 +1,110 @@
+#include "stdafx.h"
+#include "SceneTeardownBenchmarkScene.h"
+
+#pragma region Benchmark Components
+namespace
+{
+	class PayloadComponent final : public BaseComponent
+	{
+	protected:
+		void Initialize(const SceneContext&) override {}
+
+	private:
+		float m_Values[8]{};
+	};
+
+	const wchar_t* GetModeName(int mode)
+	{
+		switch (mode)
+		{
+		case 0: return L"Heap";
+		case 1: return L"Pool";
+		case 2: return L"Pool (bulk teardown)";
+		default: return L"";
+		}
+	}
+}
+#pragma endregion
+
+void SceneTeardownBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunBenchmark();
+}
+
+void SceneTeardownBenchmarkScene::RunBenchmark()
+{
+	for (int mode{}; mode < static_cast<int>(AllocationMode::Count); ++mode)
+	{
+		BenchmarkResult& result = m_Results[mode];
+		result = {};
+
+		for (int i{}; i < m_Iterations; ++i)
+		{
+			const BenchmarkResult iteration{ RunMode(static_cast<AllocationMode>(mode)) };
+			result.spawnMs += iteration.spawnMs / m_Iterations;
+			result.teardownMs += iteration.teardownMs / m_Iterations;
+		}
+
+		Logger::LogInfo(L"[SceneTeardownBenchmark] {} GameObjects > {}: Spawn {:.3f} ms | Teardown {:.3f} ms",
+			m_RootCount * (m_ChildrenPerRoot + 1), GetModeName(mode), result.spawnMs, result.teardownMs);
+	}
+}
+
+SceneTeardownBenchmarkScene::BenchmarkResult SceneTeardownBenchmarkScene::RunMode(AllocationMode mode) const
+{
+	using clock = std::chrono::high_resolution_clock;
+	BenchmarkResult result{};
+
+	//The tree is never added to the scene, only allocation & destruction are measured
+	PoolAllocator* pAllocator{ mode == AllocationMode::Heap ? nullptr : new PoolAllocator() };
+	PoolAllocator::Scope allocatorScope{ pAllocator };
+
+	auto start = clock::now();
+	GameObject* pRoot{ SpawnTree() };
+	result.spawnMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+	start = clock::now();
+	if (mode == AllocationMode::PoolBulkTeardown)
+		pAllocator->BeginTeardown();
+
+	SafeDelete(pRoot);
+	SafeDelete(pAllocator);
+	result.teardownMs = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+	return result;
+}
+
+GameObject* SceneTeardownBenchmarkScene::SpawnTree() const
+{
+	const auto pTree = new GameObject();
+
+	for (int root{}; root < m_RootCount; ++root)
+	{
+		const auto pRoot = pTree->AddChild(new GameObject());
+		pRoot->AddComponent(new PayloadComponent());
+
+		for (int child{}; child < m_ChildrenPerRoot; ++child)
+		{
+			const auto pChild = pRoot->AddChild(new GameObject());
+			pChild->AddComponent(new PayloadComponent());
+		}
+	}
+
+	return pTree;
+}
+
+void SceneTeardownBenchmarkScene::OnGUI()
+{
+	ImGui::Text("GameObjects: %d", m_RootCount * (m_ChildrenPerRoot + 1));
+
+	for (int mode{}; mode < static_cast<int>(AllocationMode::Count); ++mode)
+	{
+		ImGui::Text("%ls > Spawn %.3f ms | Teardown %.3f ms", GetModeName(mode), m_Results[mode].spawnMs, m_Results[mode].teardownMs);
+	}
+
+	if (ImGui::Button("Restart Benchmark"))
+		RunBenchmark();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+//Compares spawning/destroying a large GameObject tree on the heap against the scene PoolAllocator
+class SceneTeardownBenchmarkScene final : public GameScene
+{
+public:
+	SceneTeardownBenchmarkScene() :GameScene(L"SceneTeardownBenchmarkScene") {}
+	~SceneTeardownBenchmarkScene() override = default;
+	SceneTeardownBenchmarkScene(const SceneTeardownBenchmarkScene& other) = delete;
+	SceneTeardownBenchmarkScene(SceneTeardownBenchmarkScene&& other) noexcept = delete;
+	SceneTeardownBenchmarkScene& operator=(const SceneTeardownBenchmarkScene& other) = delete;
+	SceneTeardownBenchmarkScene& operator=(SceneTeardownBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	enum class AllocationMode
+	{
+		Heap,
+		Pool,
+		PoolBulkTeardown,
+		Count
+	};
+
+	struct BenchmarkResult
+	{
+		float spawnMs{};
+		float teardownMs{};
+	};
+
+	static constexpr int m_RootCount{ 1000 };
+	static constexpr int m_ChildrenPerRoot{ 9 }; //10k GameObjects
+	static constexpr int m_Iterations{ 5 };
+
+	BenchmarkResult m_Results[static_cast<int>(AllocationMode::Count)]{};
+
+	void RunBenchmark();
+	BenchmarkResult RunMode(AllocationMode mode) const;
+	GameObject* SpawnTree() const;
+};
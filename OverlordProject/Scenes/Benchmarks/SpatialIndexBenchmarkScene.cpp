@@ -0,0 +1,212 @@
+#include "stdafx.h"
+#include <random>
+
+#include "SpatialIndexBenchmarkScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	void* ToUserData(UINT index)
+	{
+		return reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+	}
+
+	UINT FromUserData(void* pUserData)
+	{
+		return static_cast<UINT>(reinterpret_cast<uintptr_t>(pUserData));
+	}
+}
+
+void SpatialIndexBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	RunBenchmark();
+}
+
+void SpatialIndexBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	for (const UINT objectCount : m_ObjectCounts)
+	{
+		const Result& result = m_Results.emplace_back(Measure(objectCount));
+
+		Logger::LogInfo(L"[SpatialIndexBenchmark] {} objects > Build: {:.2f} ms | Refit: {:.2f} ms | Move 10%: {:.2f} ms ({} reinserts) | Height: {} | Cost: {:.1f}",
+			result.objectCount, result.buildMs, result.refitMs, result.moveMs, result.reinserts, result.height, result.cost);
+		Logger::LogInfo(L"[SpatialIndexBenchmark] {} objects > Frustum: {:.4f} ms ({:.0f} hits, brute force {:.4f} ms) | Sphere: {:.4f} ms | AABB: {:.4f} ms | Ray: {:.4f} ms | Mismatches: {}",
+			result.objectCount, result.frustumMs, result.frustumHits, result.bruteFrustumMs, result.sphereMs, result.aabbMs, result.rayMs, result.mismatches);
+	}
+}
+
+SpatialIndexBenchmarkScene::Result SpatialIndexBenchmarkScene::Measure(UINT objectCount) const
+{
+	Result result{};
+	result.objectCount = objectCount;
+
+	//Fixed seed, every run uses the same layout
+	std::mt19937 generator{ objectCount };
+	std::uniform_real_distribution<float> position{ -m_WorldSize * .5f, m_WorldSize * .5f };
+	std::uniform_real_distribution<float> height{ 0.f, 50.f };
+	std::uniform_real_distribution<float> extent{ .5f, 3.f };
+	std::uniform_real_distribution<float> jitter{ -.05f, .05f };
+	std::uniform_real_distribution<float> angle{ 0.f, XM_2PI };
+
+	std::vector<BoundingBox> boxes(objectCount);
+	for (BoundingBox& box : boxes)
+	{
+		box.Center = { position(generator), height(generator), position(generator) };
+		box.Extents = { extent(generator), extent(generator), extent(generator) };
+	}
+
+	BoundingVolumeHierarchy bvh{};
+	std::vector<UINT> proxies(objectCount);
+
+	//BUILD (incremental inserts)
+	auto start = Clock::now();
+	for (UINT i{}; i < objectCount; ++i)
+	{
+		proxies[i] = bvh.CreateProxy(boxes[i], ToUserData(i));
+	}
+	result.buildMs = ElapsedMs(start);
+
+	//REFIT (small motion, stays inside the fat bounds most of the time)
+	for (BoundingBox& box : boxes)
+	{
+		box.Center.x += jitter(generator);
+		box.Center.z += jitter(generator);
+	}
+
+	bvh.ResetStats();
+	start = Clock::now();
+	for (UINT i{}; i < objectCount; ++i)
+	{
+		bvh.MoveProxy(proxies[i], boxes[i]);
+	}
+	result.refitMs = ElapsedMs(start);
+
+	//MOVE (teleport 10%, every one of them is reinserted)
+	for (UINT i{}; i < objectCount; i += 10)
+	{
+		boxes[i].Center = { position(generator), height(generator), position(generator) };
+	}
+
+	start = Clock::now();
+	for (UINT i{}; i < objectCount; i += 10)
+	{
+		bvh.MoveProxy(proxies[i], boxes[i]);
+	}
+	result.moveMs = ElapsedMs(start);
+	result.reinserts = bvh.GetStats().reinserts;
+	result.height = bvh.GetStats().height;
+	result.cost = bvh.ComputeCost();
+
+	//QUERY VOLUMES
+	std::vector<XMFLOAT4X4> viewProjections(m_QueryCount);
+	std::vector<BoundingFrustum> frustums(m_QueryCount);
+	std::vector<XMFLOAT3> origins(m_QueryCount), directions(m_QueryCount);
+	const XMMATRIX projection{ XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.f / 9.f, .1f, 300.f) };
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		const float yaw{ angle(generator) };
+		origins[i] = { position(generator), 10.f, position(generator) };
+		directions[i] = { std::sinf(yaw), -.1f, std::cosf(yaw) };
+
+		const XMMATRIX view{ XMMatrixLookToLH(XMLoadFloat3(&origins[i]), XMVector3Normalize(XMLoadFloat3(&directions[i])), g_XMIdentityR1) };
+		XMStoreFloat4x4(&viewProjections[i], view * projection);
+
+		BoundingFrustum::CreateFromMatrix(frustums[i], projection);
+		frustums[i].Transform(frustums[i], XMMatrixInverse(nullptr, view));
+	}
+
+	//FRUSTUM
+	UINT hits{};
+	start = Clock::now();
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		bvh.QueryFrustum(viewProjections[i], [&hits](void*) { ++hits; });
+	}
+	result.frustumMs = ElapsedMs(start) / m_QueryCount;
+	result.frustumHits = static_cast<float>(hits) / m_QueryCount;
+
+	UINT bruteHits{};
+	start = Clock::now();
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		for (const BoundingBox& box : boxes)
+		{
+			if (frustums[i].Intersects(box))
+				++bruteHits;
+		}
+	}
+	result.bruteFrustumMs = ElapsedMs(start) / m_QueryCount;
+
+	//Validation (BVH results are a superset, fat bounds)
+	std::vector<uint8_t> isReported(objectCount);
+	for (UINT i{}; i < m_QueryCount; i += 16)
+	{
+		std::ranges::fill(isReported, uint8_t{ 0 });
+		bvh.QueryFrustum(viewProjections[i], [&isReported](void* pUserData) { isReported[FromUserData(pUserData)] = 1; });
+
+		for (UINT object{}; object < objectCount; ++object)
+		{
+			if (frustums[i].Intersects(boxes[object]) && !isReported[object])
+				++result.mismatches;
+		}
+	}
+
+	//SPHERE
+	hits = 0;
+	start = Clock::now();
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		bvh.QuerySphere(BoundingSphere{ origins[i], 25.f }, [&hits](void*) { ++hits; });
+	}
+	result.sphereMs = ElapsedMs(start) / m_QueryCount;
+
+	//AABB
+	start = Clock::now();
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		bvh.QueryAABB(BoundingBox{ origins[i], { 25.f, 25.f, 25.f } }, [&hits](void*) { ++hits; });
+	}
+	result.aabbMs = ElapsedMs(start) / m_QueryCount;
+
+	//RAY (closest hit, the traversal is clipped by every box that is hit)
+	start = Clock::now();
+	for (UINT i{}; i < m_QueryCount; ++i)
+	{
+		XMFLOAT3 direction{};
+		XMStoreFloat3(&direction, XMVector3Normalize(XMLoadFloat3(&directions[i])));
+		bvh.Raycast(origins[i], direction, 500.f, [&hits](void*, float distance) { ++hits; return distance; });
+	}
+	result.rayMs = ElapsedMs(start) / m_QueryCount;
+
+	//Keeps the query loops from being optimized away
+	if (hits == UINT_MAX || bruteHits == UINT_MAX)
+		Logger::LogDebug(L"[SpatialIndexBenchmark] {} {}", hits, bruteHits);
+
+	return result;
+}
+
+void SpatialIndexBenchmarkScene::OnGUI()
+{
+	for (const Result& result : m_Results)
+	{
+		ImGui::Separator();
+		ImGui::Text("%u objects (height %u, cost %.1f)", result.objectCount, result.height, result.cost);
+		ImGui::Text("Build %.2f ms | Refit %.2f ms | Move 10%% %.2f ms (%u reinserts)", result.buildMs, result.refitMs, result.moveMs, result.reinserts);
+		ImGui::Text("Frustum %.4f ms (%.0f hits) vs brute force %.4f ms", result.frustumMs, result.frustumHits, result.bruteFrustumMs);
+		ImGui::Text("Sphere %.4f ms | AABB %.4f ms | Ray %.4f ms", result.sphereMs, result.aabbMs, result.rayMs);
+		ImGui::TextColored(result.mismatches == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u mismatches", result.mismatches);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
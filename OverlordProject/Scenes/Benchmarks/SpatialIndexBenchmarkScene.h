@@ -0,0 +1,42 @@
+#pragma once
+
+//Headless build/refit/query cost of the BoundingVolumeHierarchy (random boxes, no GameObjects), queries are validated against brute force
+class SpatialIndexBenchmarkScene final : public GameScene
+{
+public:
+	SpatialIndexBenchmarkScene() :GameScene(L"SpatialIndexBenchmarkScene") {}
+	~SpatialIndexBenchmarkScene() override = default;
+	SpatialIndexBenchmarkScene(const SpatialIndexBenchmarkScene& other) = delete;
+	SpatialIndexBenchmarkScene(SpatialIndexBenchmarkScene&& other) noexcept = delete;
+	SpatialIndexBenchmarkScene& operator=(const SpatialIndexBenchmarkScene& other) = delete;
+	SpatialIndexBenchmarkScene& operator=(SpatialIndexBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		UINT objectCount{};
+		float buildMs{};
+		float refitMs{}; //Every object jittered (mostly inside the fat bounds)
+		float moveMs{}; //10% of the objects teleported (reinserts)
+		UINT reinserts{};
+		UINT height{};
+		float cost{};
+		float frustumMs{}, sphereMs{}, aabbMs{}, rayMs{}; //Per query
+		float bruteFrustumMs{}; //Per query, testing every object
+		float frustumHits{}; //Average
+		UINT mismatches{}; //Brute force hits the BVH didn't report
+	};
+
+	static constexpr UINT m_ObjectCounts[]{ 10000, 50000, 100000 };
+	static constexpr UINT m_QueryCount{ 256 };
+	static constexpr float m_WorldSize{ 2000.f };
+
+	std::vector<Result> m_Results{};
+
+	void RunBenchmark();
+	Result Measure(UINT objectCount) const;
+};
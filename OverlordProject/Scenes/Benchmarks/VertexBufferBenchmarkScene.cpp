@@ -0,0 +1,226 @@
+#include "stdafx.h"
+#include "VertexBufferBenchmarkScene.h"
+
+#include "Materials/BasicMaterial_Deferred.h"
+#include "Materials/BasicMaterial_Deferred_Skinned.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	//Same split as MeshFilter::BuildPendingVertexBuffers
+	constexpr UINT g_VerticesPerJob{ 16384 };
+
+	template<typename T>
+	void WriteElement(BYTE* pDestination, const T& value, UINT size)
+	{
+		std::memcpy(pDestination, &value, std::min(size, static_cast<UINT>(sizeof(T))));
+	}
+
+	//MeshFilter::BuildVertexBuffer before the interleavers (element sizes clamped to the streams, the old memcpy could read past them)
+	//Positions are left out, they're in the shared position stream since the split
+	void InterleaveSwitch(const SubMeshFilter& subMesh, const MaterialTechniqueContext& techniqueContext, BYTE* pData)
+	{
+		for (UINT i{}; i < subMesh.vertexCount; ++i)
+		{
+			for (const ILDescription& ilDescription : techniqueContext.pInputLayoutDescriptions)
+			{
+				if (ilDescription.SemanticType == ILSemantic::POSITION)
+					continue;
+
+				const bool hasElement{ subMesh.HasElement(ilDescription.SemanticType) };
+				switch (ilDescription.SemanticType)
+				{
+				case ILSemantic::NORMAL:
+					WriteElement(pData, hasElement ? subMesh.normals[i] : XMFLOAT3{}, ilDescription.Offset);
+					break;
+				case ILSemantic::COLOR:
+					WriteElement(pData, hasElement ? subMesh.colors[i] : XMFLOAT4{ 1.f, 0.f, 0.f, 1.f }, ilDescription.Offset);
+					break;
+				case ILSemantic::TEXCOORD:
+					WriteElement(pData, hasElement ? subMesh.texCoords[i] : XMFLOAT2{}, ilDescription.Offset);
+					break;
+				case ILSemantic::TANGENT:
+					WriteElement(pData, hasElement ? subMesh.tangents[i] : XMFLOAT3{}, ilDescription.Offset);
+					break;
+				case ILSemantic::BINORMAL:
+					WriteElement(pData, hasElement ? subMesh.binormals[i] : XMFLOAT3{}, ilDescription.Offset);
+					break;
+				case ILSemantic::BLENDINDICES:
+					WriteElement(pData, hasElement ? subMesh.blendIndices[i] : XMFLOAT4{}, ilDescription.Offset);
+					break;
+				case ILSemantic::BLENDWEIGHTS:
+					WriteElement(pData, hasElement ? subMesh.blendWeights[i] : XMFLOAT4{}, ilDescription.Offset);
+					break;
+				default:
+					break;
+				}
+
+				pData += ilDescription.Offset;
+			}
+		}
+	}
+}
+
+void VertexBufferBenchmarkScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	//Layouts of the materials VO_GameScene draws these meshes with
+	const auto pTrackMaterial = MaterialManager::Get()->CreateMaterial<BasicMaterial_Deferred>();
+	const auto pCharacterMaterial = MaterialManager::Get()->CreateMaterial<BasicMaterial_Deferred_Skinned>();
+
+	m_Subjects.push_back({ L"F1_Track", ContentManager::Load<MeshFilter>(L"Meshes/F1_Track.ovm"), &pTrackMaterial->GetTechniqueContext() });
+	m_Subjects.push_back({ L"Character", ContentManager::Load<MeshFilter>(L"Meshes/Character.ovm"), &pCharacterMaterial->GetTechniqueContext() });
+
+	RunBenchmark();
+}
+
+void VertexBufferBenchmarkScene::RunBenchmark()
+{
+	m_Results.clear();
+	for (const Subject& subject : m_Subjects)
+	{
+		const Result& result = m_Results.emplace_back(Measure(subject));
+
+		Logger::LogInfo(L"[VertexBufferBenchmark] {} ({} vertices, {} submeshes, {} bytes/vertex) > Switch: {:.3f} ms | Interleaver: {:.3f} ms | Parallel: {:.3f} ms | Upload: {:.3f} ms | Errors: {}",
+			result.name, result.vertexCount, result.subMeshCount, result.stride, result.switchMs, result.interleaverMs, result.parallelMs, result.uploadMs, result.byteErrors);
+	}
+}
+
+VertexBufferBenchmarkScene::Result VertexBufferBenchmarkScene::Measure(const Subject& subject) const
+{
+	const std::vector<SubMeshFilter>& subMeshes{ subject.pMeshFilter->GetMeshes() };
+	const MaterialTechniqueContext& techniqueContext{ *subject.pTechniqueContext };
+	const VertexInterleaver& interleaver{ VertexInterleaver::Get(techniqueContext.inputLayoutID, techniqueContext.inputLayoutSize, techniqueContext.pInputLayoutDescriptions) };
+
+	Result result{};
+	result.name = subject.name;
+	result.subMeshCount = static_cast<UINT>(subMeshes.size());
+	result.stride = interleaver.GetStride();
+
+	std::vector<std::vector<BYTE>> reference(subMeshes.size());
+	std::vector<std::vector<BYTE>> interleaved(subMeshes.size());
+	for (size_t i{}; i < subMeshes.size(); ++i)
+	{
+		reference[i].resize(static_cast<size_t>(result.stride) * subMeshes[i].vertexCount);
+		interleaved[i].resize(reference[i].size());
+		result.vertexCount += subMeshes[i].vertexCount;
+	}
+
+	const auto validate = [&]()
+	{
+		for (size_t i{}; i < subMeshes.size(); ++i)
+		{
+			if (interleaved[i] != reference[i]) ++result.byteErrors;
+			std::ranges::fill(interleaved[i], BYTE{ 0xCD }); //Stale bytes fail the next pass
+		}
+	};
+
+	//Per vertex switch
+	auto start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		for (size_t i{}; i < subMeshes.size(); ++i)
+		{
+			InterleaveSwitch(subMeshes[i], techniqueContext, reference[i].data());
+		}
+	}
+	result.switchMs = ElapsedMs(start) / m_Repetitions;
+
+	//Layout interleaver, one thread
+	start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		for (size_t i{}; i < subMeshes.size(); ++i)
+		{
+			interleaver.Interleave(subMeshes[i], interleaved[i].data());
+		}
+	}
+	result.interleaverMs = ElapsedMs(start) / m_Repetitions;
+	validate();
+
+	//Layout interleaver, submeshes split in vertex ranges over the JobSystem
+	struct Range
+	{
+		size_t subMesh;
+		UINT begin;
+		UINT end;
+	};
+
+	std::vector<Range> ranges{};
+	for (size_t i{}; i < subMeshes.size(); ++i)
+	{
+		for (UINT begin{}; begin < subMeshes[i].vertexCount; begin += g_VerticesPerJob)
+		{
+			ranges.push_back({ i, begin, std::min(begin + g_VerticesPerJob, subMeshes[i].vertexCount) });
+		}
+	}
+
+	start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		if (interleaver.HasPadding())
+		{
+			for (auto& buffer : interleaved) std::ranges::fill(buffer, BYTE{ 0 });
+		}
+
+		m_SceneContext.pJobSystem->ParallelFor(static_cast<UINT>(ranges.size()), [&](UINT begin, UINT end)
+		{
+			for (UINT i{ begin }; i < end; ++i)
+			{
+				const Range& range{ ranges[i] };
+				interleaver.Interleave(subMeshes[range.subMesh], interleaved[range.subMesh].data(), range.begin, range.end);
+			}
+		}, 1);
+	}
+	result.parallelMs = ElapsedMs(start) / m_Repetitions;
+
+	//Upload (same buffer description as MeshFilter)
+	const auto pDevice = m_SceneContext.d3dContext.pDevice;
+	start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		for (size_t i{}; i < subMeshes.size(); ++i)
+		{
+			if (interleaved[i].empty()) continue;
+
+			D3D11_BUFFER_DESC bd{};
+			bd.Usage = D3D11_USAGE_DEFAULT;
+			bd.ByteWidth = static_cast<UINT>(interleaved[i].size());
+			bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+			D3D11_SUBRESOURCE_DATA initData{};
+			initData.pSysMem = interleaved[i].data();
+
+			ID3D11Buffer* pBuffer{};
+			HANDLE_ERROR(pDevice->CreateBuffer(&bd, &initData, &pBuffer))
+			SafeRelease(pBuffer);
+		}
+	}
+	result.uploadMs = ElapsedMs(start) / m_Repetitions;
+	validate();
+
+	return result;
+}
+
+void VertexBufferBenchmarkScene::OnGUI()
+{
+	for (const Result& result : m_Results)
+	{
+		ImGui::Separator();
+		ImGui::Text("%ls: %u vertices, %u submeshes, %u bytes/vertex (avg of %u builds)", result.name.c_str(), result.vertexCount, result.subMeshCount, result.stride, m_Repetitions);
+		ImGui::Text("Switch %.3f ms | Interleaver %.3f ms (x%.2f)", result.switchMs, result.interleaverMs, result.interleaverMs > 0.f ? result.switchMs / result.interleaverMs : 0.f);
+		ImGui::Text("Parallel %.3f ms (x%.2f) | Upload %.3f ms", result.parallelMs, result.parallelMs > 0.f ? result.switchMs / result.parallelMs : 0.f, result.uploadMs);
+		ImGui::TextColored(result.byteErrors == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u mismatching buffers", result.byteErrors);
+	}
+
+	if (ImGui::Button("Run Again"))
+		RunBenchmark();
+}
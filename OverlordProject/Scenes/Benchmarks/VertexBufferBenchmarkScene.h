@@ -0,0 +1,49 @@
+#pragma once
+
+//Vertex buffer build of the track & character meshes, per vertex element switch (MeshFilter before the interleavers)
+//against the cached layout interleaver (VertexInterleaver) on one thread and split over the JobSystem
+//Every interleaved buffer is compared with the switch output, the upload (CreateBuffer) is timed separately
+//Only the attribute stream is built, positions are a separate stream (MeshFilter::PositionSlot)
+class VertexBufferBenchmarkScene final : public GameScene
+{
+public:
+	VertexBufferBenchmarkScene() :GameScene(L"VertexBufferBenchmarkScene") {}
+	~VertexBufferBenchmarkScene() override = default;
+	VertexBufferBenchmarkScene(const VertexBufferBenchmarkScene& other) = delete;
+	VertexBufferBenchmarkScene(VertexBufferBenchmarkScene&& other) noexcept = delete;
+	VertexBufferBenchmarkScene& operator=(const VertexBufferBenchmarkScene& other) = delete;
+	VertexBufferBenchmarkScene& operator=(VertexBufferBenchmarkScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Subject
+	{
+		std::wstring name{};
+		const MeshFilter* pMeshFilter{};
+		const MaterialTechniqueContext* pTechniqueContext{};
+	};
+
+	struct Result
+	{
+		std::wstring name{};
+		UINT vertexCount{};
+		UINT subMeshCount{};
+		UINT stride{};
+		float switchMs{};
+		float interleaverMs{};
+		float parallelMs{};
+		float uploadMs{};
+		UINT byteErrors{}; //Interleaved buffers that differ from the switch output
+	};
+
+	static constexpr UINT m_Repetitions{ 10 };
+
+	std::vector<Subject> m_Subjects{};
+	std::vector<Result> m_Results{};
+
+	void RunBenchmark();
+	Result Measure(const Subject& subject) const;
+};
@@ -0,0 +1,149 @@
+#include "stdafx.h"
+#include "ContentPackerScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	bool ReadFile(const fs::path& file, std::vector<BYTE>& data)
+	{
+		std::ifstream stream{ file, std::ios::in | std::ios::binary | std::ios::ate };
+		if (!stream.is_open())
+			return false;
+
+		data.resize(static_cast<size_t>(stream.tellg()));
+		stream.seekg(0, std::ios::beg);
+		stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		return !stream.fail();
+	}
+
+	//Touches every byte, pack views are only paged in once read
+	UINT64 Checksum(const BYTE* pData, size_t size)
+	{
+		UINT64 checksum{};
+		for (size_t i{}; i < size; ++i)
+			checksum += pData[i];
+
+		return checksum;
+	}
+}
+
+void ContentPackerScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	PackAll();
+}
+
+void ContentPackerScene::PackAll()
+{
+	m_Result = {};
+
+	const fs::path packFile{ ContentManager::GetPackFile() };
+	if (packFile.empty())
+	{
+		Logger::LogWarning(L"[ContentPacker] No content pack configured (GameContext::contentPack)");
+		return;
+	}
+
+	//Loaders read the open pack on workers
+	if (SceneManager::Get()->IsLoading())
+	{
+		Logger::LogWarning(L"[ContentPacker] A scene is loading, the content pack can't be replaced now");
+		return;
+	}
+
+	//The open pack is mapped, it can't be replaced
+	ContentManager::ClosePack();
+
+	const auto start = Clock::now();
+	m_Result.isBuilt = ContentPack::Build(ContentManager::GetFullAssetPath(L""), packFile, true, &m_Result.stats);
+	m_Result.buildMs = ElapsedMs(start);
+
+	//The new pack (or the old one when the build failed)
+	ContentManager::OpenPack(packFile);
+
+	if (!m_Result.isBuilt)
+	{
+		Logger::LogWarning(L"[ContentPacker] Failed to build \"{}\"", packFile.wstring());
+		return;
+	}
+
+	std::error_code error{};
+	m_Result.packBytes = fs::file_size(packFile, error);
+
+	CompareReads();
+
+	constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+	Logger::LogInfo(L"[ContentPacker] \"{}\" > {} entries ({} compressed), {:.2f} MB > {:.2f} MB ({:.2f} MB file) in {:.1f} ms | Mismatches: {}",
+		packFile.wstring(), m_Result.stats.entries, m_Result.stats.compressed, static_cast<float>(m_Result.stats.bytes) * toMB, static_cast<float>(m_Result.stats.storedBytes) * toMB,
+		static_cast<float>(m_Result.packBytes) * toMB, m_Result.buildMs, m_Result.mismatches);
+	Logger::LogInfo(L"[ContentPacker] Read all entries > Loose files: {:.3f} ms | Pack: {:.3f} ms (x{:.2f})",
+		m_Result.looseMs, m_Result.packMs, m_Result.packMs > 0.f ? m_Result.looseMs / m_Result.packMs : 0.f);
+}
+
+void ContentPackerScene::CompareReads()
+{
+	const ContentPack& pack{ ContentManager::GetPack() };
+	const std::vector<std::wstring>& paths{ pack.GetPaths() };
+
+	//Round trip
+	std::vector<BYTE> data{};
+	ContentBlob blob{};
+	for (const std::wstring& path : paths)
+	{
+		const bool isSame{ ReadFile(ContentManager::GetFullAssetPath(path), data) && pack.Read(path, blob) &&
+			blob.size == data.size() && (data.empty() || std::memcmp(blob.pData, data.data(), data.size()) == 0) };
+		m_Result.mismatches += isSame ? 0 : 1;
+	}
+
+	UINT64 looseChecksum{};
+	auto start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		for (const std::wstring& path : paths)
+		{
+			if (ReadFile(ContentManager::GetFullAssetPath(path), data))
+				looseChecksum += Checksum(data.data(), data.size());
+		}
+	}
+	m_Result.looseMs = ElapsedMs(start) / m_Repetitions;
+
+	//A separate instance, opening (mapping & index) is part of the cost
+	UINT64 packChecksum{};
+	start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		ContentPack timedPack{};
+		if (!timedPack.Open(pack.GetPackFile()))
+			break;
+
+		for (const std::wstring& path : paths)
+		{
+			if (timedPack.Read(path, blob))
+				packChecksum += Checksum(blob.pData, blob.size);
+		}
+	}
+	m_Result.packMs = ElapsedMs(start) / m_Repetitions;
+
+	m_Result.mismatches += looseChecksum == packChecksum ? 0 : 1;
+}
+
+void ContentPackerScene::OnGUI()
+{
+	constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+
+	ImGui::Text("%u entries (%u compressed), %.2f MB > %.2f MB (%.2f MB pack) in %.1f ms", m_Result.stats.entries, m_Result.stats.compressed,
+		static_cast<float>(m_Result.stats.bytes) * toMB, static_cast<float>(m_Result.stats.storedBytes) * toMB, static_cast<float>(m_Result.packBytes) * toMB, m_Result.buildMs);
+	ImGui::Text("Read all (avg of %u) > loose %.3f ms | pack %.3f ms (x%.2f)", m_Repetitions, m_Result.looseMs, m_Result.packMs, m_Result.packMs > 0.f ? m_Result.looseMs / m_Result.packMs : 0.f);
+	ImGui::TextColored(m_Result.isBuilt && m_Result.mismatches == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%s, %u round trip mismatches", m_Result.isBuilt ? "Packed" : "NOT packed", m_Result.mismatches);
+
+	if (ImGui::Button("Pack Again"))
+		PackAll();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+//Packs the content root into the content pack (GameContext::contentPack, see ContentPack::Build) and reopens it for ContentManager
+//Every entry is read back and compared with its loose file. Read times (warm file cache): every packed asset opened & read as a
+//loose file vs. the pack opened & every entry read out of it (views or Lz4 decompression)
+//Cold startup: the VO_GameScene content time logged by the SceneManager, with the pack and with GameContext::contentPack = L""
+class ContentPackerScene final : public GameScene
+{
+public:
+	ContentPackerScene() :GameScene(L"ContentPackerScene") {}
+	~ContentPackerScene() override = default;
+	ContentPackerScene(const ContentPackerScene& other) = delete;
+	ContentPackerScene(ContentPackerScene&& other) noexcept = delete;
+	ContentPackerScene& operator=(const ContentPackerScene& other) = delete;
+	ContentPackerScene& operator=(ContentPackerScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct Result
+	{
+		bool isBuilt{};
+		ContentPack::BuildStats stats{};
+		UINT64 packBytes{};
+		float buildMs{};
+		float looseMs{};
+		float packMs{};
+		UINT mismatches{}; //Entries that differ from their loose file (or couldn't be read)
+	};
+
+	static constexpr UINT m_Repetitions{ 3 };
+
+	Result m_Result{};
+
+	void PackAll();
+	void CompareReads();
+};
@@ -0,0 +1,240 @@
+#include "stdafx.h"
+#include "MeshCookerScene.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float ElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	//Same meshes & layouts as VO_GameScene::DeclareContent
+	const wchar_t* gBatchedMeshNames[] =
+	{
+		L"F1_Track", L"F1_Fence01", L"F1_Fence02", L"F1_Fence03", L"F1_Fence04", L"F1_Fence05",
+		L"F1_FenceOuter", L"F1_Building01", L"F1_Building02", L"F1_Building03", L"F1_GrandStand01", L"F1_GrandStandCanpoy01",
+		L"F1_Spotlights01", L"F1_Signs01", L"F1_Ground01", L"F1_Cone01"
+	};
+	const wchar_t* gDynamicMeshNames[] = { L"F1_Car", L"F1_Wheel" };
+
+	MeshFilter* ParseFile(const fs::path& filePath, const D3D11Context* pD3DContext)
+	{
+		BinaryReader reader{};
+		reader.OpenMapped(filePath);
+		if (!reader.Exists())
+			return nullptr;
+
+		const std::wstring fileName{ filePath.filename().wstring() };
+		return MeshCooker::IsCookedFile(filePath) ? MeshFilterLoader::ParseCooked(&reader, fileName, pD3DContext) : MeshFilterLoader::Parse(&reader, fileName);
+	}
+
+	template<typename T>
+	UINT Compare(const std::vector<T>& a, const std::vector<T>& b)
+	{
+		return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0) ? 0 : 1;
+	}
+
+	template<typename T>
+	UINT Compare(const T& a, const T& b)
+	{
+		return std::memcmp(&a, &b, sizeof(T)) == 0 ? 0 : 1;
+	}
+
+	//Source (.ovm) against the headless cooked parse (attribute streams in VertexBufferData::pDataStart)
+	UINT CountMismatches(const MeshFilter& source, const MeshFilter& cooked, const std::vector<MeshCooker::Layout>& layouts)
+	{
+		if (source.GetMeshCount() != cooked.GetMeshCount() || source.GetAnimationClips().size() != cooked.GetAnimationClips().size())
+			return 1;
+
+		UINT mismatches{};
+		mismatches += source.GetMeshName() == cooked.GetMeshName() ? 0 : 1;
+		mismatches += source.GetBoneCount() == cooked.GetBoneCount() ? 0 : 1;
+		mismatches += source.HasAnimations() == cooked.HasAnimations() ? 0 : 1;
+		mismatches += Compare(source.GetBounds(), cooked.GetBounds());
+
+		for (const SubMeshFilter& expected : source.GetMeshes())
+		{
+			const SubMeshFilter& subMesh{ cooked.GetMeshes()[expected.id] };
+
+			mismatches += expected.name == subMesh.name ? 0 : 1;
+			mismatches += expected.vertexCount == subMesh.vertexCount && expected.indexCount == subMesh.indexCount && expected.uvChannelCount == subMesh.uvChannelCount ? 0 : 1;
+			mismatches += expected.layoutElements == subMesh.layoutElements ? 0 : 1;
+			mismatches += Compare(expected.bounds, subMesh.bounds);
+			mismatches += Compare(expected.positions, subMesh.positions);
+			mismatches += Compare(expected.indices, subMesh.indices);
+
+			if (!cooked.IsCpuDataReleased())
+			{
+				mismatches += Compare(expected.normals, subMesh.normals);
+				mismatches += Compare(expected.tangents, subMesh.tangents);
+				mismatches += Compare(expected.binormals, subMesh.binormals);
+				mismatches += Compare(expected.texCoords, subMesh.texCoords);
+				mismatches += Compare(expected.colors, subMesh.colors);
+				mismatches += Compare(expected.blendIndices, subMesh.blendIndices);
+				mismatches += Compare(expected.blendWeights, subMesh.blendWeights);
+			}
+
+			for (const MeshCooker::Layout& layout : layouts)
+			{
+				if (cooked.GetVertexBufferId(layout.inputLayoutID, expected.id) < 0)
+				{
+					++mismatches;
+					continue;
+				}
+
+				const VertexInterleaver& interleaver{ VertexInterleaver::Get(layout.inputLayoutID, layout.inputLayoutSize, layout.descriptions) };
+				std::vector<BYTE> stream(static_cast<size_t>(interleaver.GetStride()) * expected.vertexCount);
+				if (!stream.empty())
+					interleaver.Interleave(expected, stream.data());
+
+				const VertexBufferData& data{ cooked.GetVertexBufferData(layout.inputLayoutID, expected.id) };
+				const bool isSame{ data.BufferSize == stream.size() && (stream.empty() || std::memcmp(data.pDataStart, stream.data(), stream.size()) == 0) };
+				mismatches += isSame && data.LayoutStride == layout.inputLayoutSize ? 0 : 1;
+			}
+		}
+
+		for (size_t i{}; i < source.GetAnimationClips().size(); ++i)
+		{
+			const AnimationClip& expected{ source.GetAnimationClips()[i] };
+			const AnimationClip& clip{ cooked.GetAnimationClips()[i] };
+
+			mismatches += expected.name == clip.name && expected.duration == clip.duration && expected.ticksPerSecond == clip.ticksPerSecond ? 0 : 1;
+			if (expected.keys.size() != clip.keys.size())
+			{
+				++mismatches;
+				continue;
+			}
+
+			for (size_t key{}; key < expected.keys.size(); ++key)
+			{
+				mismatches += expected.keys[key].tick == clip.keys[key].tick ? 0 : 1;
+				mismatches += Compare(expected.keys[key].boneTransforms, clip.keys[key].boneTransforms);
+			}
+		}
+
+		return mismatches;
+	}
+}
+
+void MeshCookerScene::Initialize()
+{
+	m_SceneContext.settings.drawGrid = false;
+	m_SceneContext.settings.enableOnGUI = true;
+
+	m_Requests.push_back({ L"Character", L"Effects/Deferred/BasicEffect_Deferred_Skinned.fx", false });
+	for (const auto meshName : gBatchedMeshNames)
+		m_Requests.push_back({ meshName, L"Effects/Deferred/BasicEffect_Deferred.fx", false });
+	for (const auto meshName : gDynamicMeshNames)
+		m_Requests.push_back({ meshName, L"Effects/Deferred/BasicEffect_Deferred.fx", true });
+
+	CookAll();
+}
+
+void MeshCookerScene::CookAll()
+{
+	m_Results.clear();
+	m_Total = { L"Total", true };
+
+	for (const CookRequest& request : m_Requests)
+	{
+		const Result& result = m_Results.emplace_back(Cook(request));
+
+		Logger::LogInfo(L"[MeshCooker] {} > {} | {} KB > {} KB, {} layouts | OVM load: {:.3f} ms | OVMC load: {:.3f} ms | Mismatches: {}",
+			result.name, result.isCooked ? L"Cooked" : L"FAILED", result.sourceBytes / 1024, result.cookedBytes / 1024, result.layouts, result.ovmMs, result.ovmcMs, result.mismatches);
+
+		m_Total.isCooked &= result.isCooked;
+		m_Total.sourceBytes += result.sourceBytes;
+		m_Total.cookedBytes += result.cookedBytes;
+		m_Total.layouts += result.layouts;
+		m_Total.ovmMs += result.ovmMs;
+		m_Total.ovmcMs += result.ovmcMs;
+		m_Total.mismatches += result.mismatches;
+	}
+
+	Logger::LogInfo(L"[MeshCooker] Total ({} meshes) > {:.2f} MB > {:.2f} MB | OVM load: {:.3f} ms | OVMC load: {:.3f} ms | Mismatches: {}",
+		m_Results.size(), static_cast<float>(m_Total.sourceBytes) / (1024.f * 1024.f), static_cast<float>(m_Total.cookedBytes) / (1024.f * 1024.f), m_Total.ovmMs, m_Total.ovmcMs, m_Total.mismatches);
+}
+
+MeshCookerScene::Result MeshCookerScene::Cook(const CookRequest& request) const
+{
+	const D3D11Context& d3dContext{ m_SceneContext.d3dContext };
+	const fs::path sourceFile{ ContentManager::GetFullAssetPath(std::format(L"Meshes/{}.ovm", request.meshName)) };
+	const fs::path cookedFile{ MeshCooker::GetCookedPath(sourceFile) };
+
+	Result result{};
+	result.name = request.meshName;
+	result.mismatches = 1;
+
+	//The .ovm itself, ContentManager::Load would return the cooked file once it exists
+	MeshFilter* pSource{ ParseFile(sourceFile, nullptr) };
+	if (!pSource)
+		return result;
+
+	const std::vector<MeshCooker::Layout> layouts{ MeshCooker::ResolveLayouts(d3dContext, { request.layoutEffect }) };
+	result.layouts = static_cast<UINT>(layouts.size());
+	result.isCooked = MeshCooker::Cook(pSource, layouts, !request.releaseCpuData, cookedFile);
+
+	//Round trip
+	if (result.isCooked)
+	{
+		MeshFilter* pCooked{ ParseFile(cookedFile, nullptr) };
+		if (pCooked)
+			result.mismatches = CountMismatches(*pSource, *pCooked, layouts);
+
+		SafeDelete(pCooked);
+	}
+	SafeDelete(pSource);
+
+	if (!result.isCooked)
+		return result;
+
+	result.sourceBytes = fs::file_size(sourceFile);
+	result.cookedBytes = fs::file_size(cookedFile);
+
+	//OVM: parse, bounds, interleave & upload the same layouts
+	auto start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		MeshFilter* pMeshFilter{ ParseFile(sourceFile, nullptr) };
+		if (!pMeshFilter) break;
+
+		for (const MeshCooker::Layout& layout : layouts)
+			pMeshFilter->BuildVertexBuffer(d3dContext, layout.inputLayoutID, layout.inputLayoutSize, layout.descriptions, m_SceneContext.pJobSystem);
+		pMeshFilter->BuildIndexBuffer(d3dContext);
+
+		SafeDelete(pMeshFilter);
+	}
+	result.ovmMs = ElapsedMs(start) / m_Repetitions;
+
+	//OVMC: buffers created out of the mapped view
+	start = Clock::now();
+	for (UINT repetition{}; repetition < m_Repetitions; ++repetition)
+	{
+		MeshFilter* pMeshFilter{ ParseFile(cookedFile, &d3dContext) };
+		SafeDelete(pMeshFilter);
+	}
+	result.ovmcMs = ElapsedMs(start) / m_Repetitions;
+
+	return result;
+}
+
+void MeshCookerScene::OnGUI()
+{
+	constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+
+	ImGui::Text("%u meshes, %.2f MB > %.2f MB cooked (avg of %u loads)", static_cast<UINT>(m_Results.size()), static_cast<float>(m_Total.sourceBytes) * toMB, static_cast<float>(m_Total.cookedBytes) * toMB, m_Repetitions);
+	ImGui::Text("OVM load %.3f ms | OVMC load %.3f ms (x%.2f)", m_Total.ovmMs, m_Total.ovmcMs, m_Total.ovmcMs > 0.f ? m_Total.ovmMs / m_Total.ovmcMs : 0.f);
+	ImGui::TextColored(m_Total.isCooked && m_Total.mismatches == 0 ? ImVec4{ 0.f, 1.f, 0.f, 1.f } : ImVec4{ 1.f, 0.f, 0.f, 1.f }, "%u round trip mismatches", m_Total.mismatches);
+
+	for (const Result& result : m_Results)
+	{
+		ImGui::Separator();
+		ImGui::Text("%ls: %s | %llu KB > %llu KB | OVM %.3f ms | OVMC %.3f ms | %u mismatches", result.name.c_str(), result.isCooked ? "cooked" : "FAILED",
+			result.sourceBytes / 1024, result.cookedBytes / 1024, result.ovmMs, result.ovmcMs, result.mismatches);
+	}
+
+	if (ImGui::Button("Cook Again"))
+		CookAll();
+}
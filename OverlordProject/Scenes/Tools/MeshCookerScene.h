@@ -0,0 +1,48 @@
+#pragma once
+
+//Cooks the meshes VO_GameScene loads to the runtime format (.ovmc next to each .ovm, see MeshCooker), with the layouts of its manifest
+//Every cooked file is parsed back and compared with its .ovm: CPU arrays, bounds, animation data and every attribute stream against the
+//VertexInterleaver output. Load times: .ovm parse + interleave + upload vs. the cooked file uploaded straight out of the mapped view
+class MeshCookerScene final : public GameScene
+{
+public:
+	MeshCookerScene() :GameScene(L"MeshCookerScene") {}
+	~MeshCookerScene() override = default;
+	MeshCookerScene(const MeshCookerScene& other) = delete;
+	MeshCookerScene(MeshCookerScene&& other) noexcept = delete;
+	MeshCookerScene& operator=(const MeshCookerScene& other) = delete;
+	MeshCookerScene& operator=(MeshCookerScene&& other) noexcept = delete;
+
+protected:
+	void Initialize() override;
+	void OnGUI() override;
+
+private:
+	struct CookRequest
+	{
+		std::wstring meshName{};
+		std::wstring layoutEffect{};
+		bool releaseCpuData{}; //Cooked without the CPU attribute arrays
+	};
+
+	struct Result
+	{
+		std::wstring name{};
+		bool isCooked{};
+		UINT64 sourceBytes{};
+		UINT64 cookedBytes{};
+		UINT layouts{};
+		float ovmMs{};
+		float ovmcMs{};
+		UINT mismatches{}; //Values that differ after the round trip (or files that couldn't be cooked or parsed back)
+	};
+
+	static constexpr UINT m_Repetitions{ 3 };
+
+	std::vector<CookRequest> m_Requests{};
+	std::vector<Result> m_Results{};
+	Result m_Total{};
+
+	void CookAll();
+	Result Cook(const CookRequest& request) const;
+};
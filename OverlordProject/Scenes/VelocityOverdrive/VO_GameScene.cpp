@@ -21,6 +21,52 @@ float gSteerVsForwardSpeedData[2 * 8] =
 	PX_MAX_F32,		PX_MAX_F32
 };
 
+//Static batching bakes these from their CPU vertex data
+const wchar_t* gBatchedMeshNames[] =
+{
+	L"F1_Track", L"F1_Fence01", L"F1_Fence02", L"F1_Fence03", L"F1_Fence04", L"F1_Fence05",
+	L"F1_FenceOuter", L"F1_Building01", L"F1_Building02", L"F1_Building03", L"F1_GrandStand01", L"F1_GrandStandCanpoy01",
+	L"F1_Spotlights01", L"F1_Signs01", L"F1_Ground01", L"F1_Cone01"
+};
+
+//Moving parts, only drawn with the deferred & static shadow layouts (CPU vertex data released after loading)
+const wchar_t* gDynamicMeshNames[] = { L"F1_Car", L"F1_Wheel" };
+
+void VO_GameScene::DeclareContent(ContentManifest& manifest)
+{
+	// MESHES (vertex buffers of the material layouts are built while loading)
+	manifest.AddMesh(L"Meshes/Character.ovm", { L"Effects/Deferred/BasicEffect_Deferred_Skinned.fx" });
+
+	for (const auto meshName : gBatchedMeshNames)
+	{
+		manifest.AddMesh(std::format(L"Meshes/{}.ovm", meshName), { L"Effects/Deferred/BasicEffect_Deferred.fx" });
+	}
+
+	for (const auto meshName : gDynamicMeshNames)
+	{
+		manifest.AddMesh(std::format(L"Meshes/{}.ovm", meshName), { L"Effects/Deferred/BasicEffect_Deferred.fx" }, true);
+	}
+
+	// PHYSX MESHES
+	for (const auto meshName : { L"F1_Fence01", L"F1_Fence02", L"F1_Fence03", L"F1_Fence04", L"F1_Fence05",
+		L"F1_Building01", L"F1_Building02", L"F1_Cone01" })
+	{
+		manifest.Add<PxConvexMesh>(std::format(L"Meshes/{}.ovpc", meshName));
+	}
+	manifest.Add<PxTriangleMesh>(L"Meshes/F1_FenceOuter.ovpt");
+
+	// TEXTURES
+	for (const auto textureName : { L"F1_Car", L"F1_Track", L"F1_Building", L"F1_Ground", L"Character_Diffuse", L"Smoke",
+		L"UI/ControllerLayout_Colored", L"UI/Panel", L"UI/ButtonBase", L"UI/ButtonSelected", L"UI/ButtonPressed", L"UI/BannerSpecial" })
+	{
+		manifest.Add<TextureData>(std::format(L"Textures/{}.png", textureName));
+	}
+
+	// FONTS
+	manifest.Add<SpriteFont>(L"SpriteFonts/LemonMilk_32.fnt");
+	manifest.Add<SpriteFont>(L"SpriteFonts/LemonMilk_24.fnt");
+}
+
 void VO_GameScene::Initialize()
 {
 	// SCENE SETTINGS
@@ -29,6 +75,9 @@ void VO_GameScene::Initialize()
 	m_SceneContext.settings.showInfoOverlay = false;
 	m_SceneContext.settings.enableOnGUI = true;
 	m_SceneContext.useDeferredRendering = true;
+	m_SceneContext.settings.staticBatching = true; //Track, fences & buildings (static GameObjects)
+	m_SceneContext.settings.sortedRendering = true;
+	m_SceneContext.settings.instancing = true; //Deferred effects have an Instanced technique
 
 	PhysXManager::Get()->SetVehicleScene(this);
 
@@ -109,6 +158,12 @@ void VO_GameScene::Initialize()
 
 	inputAction = InputAction(Confirm, InputState::pressed, VK_RETURN, -1, XINPUT_GAMEPAD_A);
 	m_SceneContext.pInput->AddInputAction(inputAction);
+
+	//Material memory, shared effects against an effect clone per material (before)
+	const auto materialStats = MaterialManager::Get()->GetMemoryStats();
+	Logger::LogInfo(L"[VO_GameScene] {} materials on {} effects | Effect constant buffers: {:.1f} KB (cloned per material {:.1f} KB) | Instance parameters: {:.1f} KB | Creation: {:.2f} ms",
+		materialStats.materials, materialStats.effects, static_cast<float>(materialStats.effectBytes) / 1024.f, static_cast<float>(materialStats.clonedEffectBytes) / 1024.f,
+		static_cast<float>(materialStats.parameterBytes) / 1024.f, materialStats.createMs);
 }
 
 VO_GameScene::~VO_GameScene()
@@ -123,7 +178,12 @@ void VO_GameScene::Update()
 	UpdateInput();
 	UpdateLighting();
 	UpdateSound();
-	UpdateVehicle();
+}
+
+void VO_GameScene::FixedUpdate(float fixedTimeStep)
+{
+	//Vehicle simulation runs at the physics rate (frame rate independent handling)
+	UpdateVehicle(fixedTimeStep);
 }
 
 void VO_GameScene::Draw()
@@ -237,6 +297,43 @@ void VO_GameScene::OnGUI()
 		ImGui::Checkbox("Motion Blur PP", &isEnabled);
 		m_pPostMotionBlur->SetIsEnabled(isEnabled);
 	}
+
+	// MESH MEMORY
+	if (ImGui::CollapsingHeader("Mesh Memory"))
+	{
+		if (ImGui::Button("Log Mesh Memory"))
+			LogMeshMemory();
+	}
+}
+
+void VO_GameScene::LogMeshMemory() const
+{
+	constexpr float toMB{ 1.f / (1024.f * 1024.f) };
+
+	std::vector<std::wstring> meshFiles{ L"Meshes/Character.ovm" };
+	for (const auto meshName : gBatchedMeshNames) meshFiles.push_back(std::format(L"Meshes/{}.ovm", meshName));
+	for (const auto meshName : gDynamicMeshNames) meshFiles.push_back(std::format(L"Meshes/{}.ovm", meshName));
+
+	MeshFilter::MemoryStats total{};
+	for (const std::wstring& meshFile : meshFiles)
+	{
+		const MeshFilter* pMeshFilter = ContentManager::Load<MeshFilter>(meshFile);
+		const MeshFilter::MemoryStats stats = pMeshFilter->GetMemoryStats();
+
+		Logger::LogInfo(L"[MeshMemory] {} > {} layouts | CPU {:.2f} MB{} | GPU positions {:.2f} MB, attributes {:.2f} MB, indices {:.2f} MB (interleaved {:.2f} MB)",
+			meshFile, stats.layouts, stats.cpuBytes * toMB, pMeshFilter->IsCpuDataReleased() ? L" (released)" : L"",
+			stats.positionBytes * toMB, stats.attributeBytes * toMB, stats.indexBytes * toMB, stats.interleavedBytes * toMB);
+
+		total.cpuBytes += stats.cpuBytes;
+		total.positionBytes += stats.positionBytes;
+		total.attributeBytes += stats.attributeBytes;
+		total.indexBytes += stats.indexBytes;
+		total.interleavedBytes += stats.interleavedBytes;
+		total.layouts += stats.layouts;
+	}
+
+	Logger::LogInfo(L"[MeshMemory] Total > {} layouts | CPU {:.2f} MB | GPU vertices {:.2f} MB (interleaved {:.2f} MB), indices {:.2f} MB",
+		total.layouts, total.cpuBytes * toMB, (total.positionBytes + total.attributeBytes) * toMB, total.interleavedBytes * toMB, total.indexBytes * toMB);
 }
 
 void VO_GameScene::OnSceneActivated()
@@ -455,12 +552,12 @@ void VO_GameScene::ConstructScene()
 	auto pGroundMat = MaterialManager::Get()->CreateMaterial<BasicMaterial_Deferred>();
 	pGroundMat->SetDiffuseMap(L"Textures/F1_Ground.png");
 
-	// CROWD
+	// CROWD (one material, the characters are drawn as one instanced batch)
+	const auto pSkinnedMaterial = MaterialManager::Get()->CreateMaterial<BasicMaterial_Deferred_Skinned>();
+	pSkinnedMaterial->SetDiffuseMap(L"Textures/Character_Diffuse.png");
+
 	for (int i = 0; i < 8; i++)
 	{
-		const auto pSkinnedMaterial = MaterialManager::Get()->CreateMaterial<BasicMaterial_Deferred_Skinned>();
-		pSkinnedMaterial->SetDiffuseMap(L"Textures/Character_Diffuse.png");
-
 		const auto pObject = AddChild(new GameObject);
 		const auto pModel = pObject->AddComponent(new ModelComponent(L"Meshes/Character.ovm"));
 		pModel->SetMaterial(pSkinnedMaterial);
@@ -486,6 +583,7 @@ void VO_GameScene::ConstructScene()
 	m_pTrack->AddComponent(new ModelComponent(L"Meshes/F1_Track.ovm"))->SetMaterial(pTrackMat);
 	m_pTrack->GetTransform()->Translate(0.f, -0.1f, 0.f);
 	AddChild(m_pTrack);
+	m_pTrack->SetFrozen(true);
 
 	// FENCE01
 	auto go = new GameObject(true);
@@ -496,6 +594,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// FENCE02
 	go = new GameObject(true);
@@ -506,6 +605,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// FENCE03
 	go = new GameObject(true);
@@ -516,6 +616,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// FENCE04
 	go = new GameObject(true);
@@ -526,6 +627,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// FENCE05
 	go = new GameObject(true);
@@ -536,6 +638,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// FENCE OUTER
 	go = new GameObject(true);
@@ -546,6 +649,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxTriangleMeshGeometry{ pTriangleMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// BUILDING01
 	go = new GameObject(true);
@@ -556,6 +660,7 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// BUILDING02
 	go = new GameObject(true);
@@ -566,16 +671,19 @@ void VO_GameScene::ConstructScene()
 	pRb->SetCollisionGroup(CollisionGroup::Group0 | CollisionGroup::Group1);
 	pRb->AddCollider(PxConvexMeshGeometry{ pConvexMesh }, *pDefaultMaterial);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// BUILDING03
 	go = new GameObject(true);
 	go->AddComponent(new ModelComponent(L"Meshes/F1_Building03.ovm"))->SetMaterial(pBuildingMat);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// GRANDSTAND01
 	go = new GameObject(true);
 	go->AddComponent(new ModelComponent(L"Meshes/F1_GrandStand01.ovm"))->SetMaterial(pBuildingMat);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// GRANDSTANDCANOPY01
 	/*go = new GameObject();
@@ -586,16 +694,19 @@ void VO_GameScene::ConstructScene()
 	go = new GameObject(true);
 	go->AddComponent(new ModelComponent(L"Meshes/F1_Spotlights01.ovm"))->SetMaterial(pTrackMat);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// SIGNS01
 	go = new GameObject(true);
 	go->AddComponent(new ModelComponent(L"Meshes/F1_Signs01.ovm"))->SetMaterial(pTrackMat);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// GROUND01
 	go = new GameObject(true);
 	go->AddComponent(new ModelComponent(L"Meshes/F1_Ground01.ovm"))->SetMaterial(pGroundMat);
 	AddChild(go);
+	go->SetFrozen(true);
 
 	// CONES
 	go = new GameObject();
@@ -634,7 +745,7 @@ void VO_GameScene::ConstructScene()
 	for (int i = 0; i < 4; i++)
 	{
 		m_pWheels[i] = new GameObject();
-		AddChild(m_pWheels[i]);
+		m_pChassis->AddChild(m_pWheels[i]);
 		m_pWheels[i]->AddComponent(new ModelComponent(L"Meshes/F1_Wheel.ovm"))->SetMaterial(pVehicleMat);
 	}
 	SetupTelemetryData();
@@ -745,7 +856,7 @@ void VO_GameScene::UpdateInput()
 		AccelerateReverse(1.f);
 }
 
-void VO_GameScene::UpdateVehicle()
+void VO_GameScene::UpdateVehicle(float fixedTimeStep)
 {
 	if (m_pVehicle == nullptr) return;
 
@@ -756,10 +867,10 @@ void VO_GameScene::UpdateVehicle()
 	//Update the control inputs for the vehicle
 	if (m_IsDigitalControl)
 		PxVehicleDrive4WSmoothDigitalRawInputsAndSetAnalogInputs(m_keySmoothingData, m_SteerVsForwardSpeedTable,
-			*m_pVehicleInputData, m_SceneContext.pGameTime->GetElapsed(), m_IsVehicleInAir, *m_pVehicle);
+			*m_pVehicleInputData, fixedTimeStep, m_IsVehicleInAir, *m_pVehicle);
 	else
 		PxVehicleDrive4WSmoothAnalogRawInputsAndSetAnalogInputs(m_padSmoothingData, m_SteerVsForwardSpeedTable,
-			*m_pVehicleInputData, m_SceneContext.pGameTime->GetElapsed(), m_IsVehicleInAir, *m_pVehicle);
+			*m_pVehicleInputData, fixedTimeStep, m_IsVehicleInAir, *m_pVehicle);
 
 	//Raycasts
 	PxVehicleWheels* vehicleWheels[6] = { m_pVehicle };
@@ -771,7 +882,7 @@ void VO_GameScene::UpdateVehicle()
 	const PxVec3 grav = GetPhysxProxy()->GetPhysxScene()->getGravity();
 	PxVehicleWheelQueryResult vehicleQueryResults[1] = { {m_WheelQueryResults, m_pVehicle->mWheelsSimData.getNbWheels()} };
 
-	PxVehicleUpdateSingleVehicleAndStoreTelemetryData(m_SceneContext.pGameTime->GetElapsed(), grav,
+	PxVehicleUpdateSingleVehicleAndStoreTelemetryData(fixedTimeStep, grav,
 		*tireFrictionPairs, m_pVehicle, vehicleQueryResults, *m_pVehicleTelemetryData);
 
 	//Work out if the vehicle is in the air.
@@ -781,17 +892,13 @@ void VO_GameScene::UpdateVehicle()
 	m_pVehicle->getRigidDynamicActor()->getShapes(shapes, 5);
 
 	// Translate and rotate m_pWheelFL gameobject to match with shape of the wheel attached to rigid body of m_pVehicle
+	// Wheels are children of the chassis, the shape's local pose follows the (interpolated) chassis transform
 	for (int i = 0; i < 4; i++)
 	{
-		PxTransform localTm = shapes[i]->getLocalPose();
-		PxMat44 shapePose = PxMat44(localTm);
-		PxMat44 vehiclePose = PxMat44(m_pVehicle->getRigidDynamicActor()->getGlobalPose());
-		PxMat44 wheelPose = vehiclePose * shapePose;
-
-		auto wheelPos = wheelPose.getPosition();
-		m_pWheels[i]->GetTransform()->Translate(wheelPos.x, wheelPos.y, wheelPos.z);
+		const PxTransform localTm = shapes[i]->getLocalPose();
+		m_pWheels[i]->GetTransform()->Translate(localTm.p.x, localTm.p.y, localTm.p.z);
 
-		auto wheelRot = PxQuat(PxMat33(wheelPose.getBasis(0), wheelPose.getBasis(1), wheelPose.getBasis(2)));
+		auto wheelRot = localTm.q;
 
 		// Left wheels are facing inwards, rotate them 180 degrees
 		if (i == 0 || i == 2)
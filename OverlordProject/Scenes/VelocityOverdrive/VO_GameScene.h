@@ -12,14 +12,17 @@ public:
 	VO_GameScene& operator=(VO_GameScene&& other) noexcept = delete;
 
 protected:
+	void DeclareContent(ContentManifest& manifest) override;
 	void Initialize() override;
 	void Update() override;
+	void FixedUpdate(float fixedTimeStep) override;
 	void Draw() override;
 	void PostDraw() override;
 	void OnGUI() override;
 
 	void OnSceneActivated() override;
 	void OnSceneDeactivated() override;
+
 private:
 	
 #pragma region Game Settings
@@ -83,6 +86,10 @@ private:
 	float m_ShadowMapScale{ 0.3f };
 #pragma endregion
 
+#pragma region Mesh Memory
+	void LogMeshMemory() const; //MeshFilter::GetMemoryStats of the declared meshes
+#pragma endregion
+
 #pragma region Camera Settings
 	float m_CameraSmoothing{ 1.f };
 	float m_CameraLookAhead{ 45.f };
@@ -203,7 +210,7 @@ std::vector<GameObject*> m_pCrowd{};
 	void SetupTelemetryData();
 
 	void UpdateInput();
-	void UpdateVehicle();
+	void UpdateVehicle(float fixedTimeStep);
 
 	void OnTriggerCallback(GameObject* trigger, GameObject* other, PxTriggerAction action);
 
@@ -79,6 +79,15 @@ void VO_MenuScene::Initialize()
 	pAnimator->Play();
 }
 
+void VO_MenuScene::Update()
+{
+	if (m_IsStartRequested && !SceneManager::Get()->IsLoading())
+	{
+		m_IsStartRequested = false;
+		SceneManager::Get()->NextScene();
+	}
+}
+
 void VO_MenuScene::Draw()
 {
 	// GAME NAME
@@ -86,8 +95,14 @@ void VO_MenuScene::Draw()
 	TextRenderer::Get()->DrawText(m_pFontTitle, L"Velocity Overdrive", { 36.f,  34.f }, XMFLOAT4{ 0.86f, 0.42f, 0.19f, 0.85f });
 	TextRenderer::Get()->DrawText(m_pFontTitle, L"Velocity Overdrive", { 33.f, 30.f }, XMFLOAT4{ 0.95f, 0.51f, 0.16f, 1.f });
 
-	// START TEXT
-	TextRenderer::Get()->DrawText(m_pFontText, L"START GAME", { 42.5f, m_SceneContext.windowHeight - 225.f }, XMFLOAT4{ Colors::Orange });
+	// START TEXT (load progress while the game scene is streaming in)
+	if (m_IsStartRequested)
+	{
+		const int progress{ static_cast<int>(SceneManager::Get()->GetLoadProgress() * 100.f) };
+		TextRenderer::Get()->DrawText(m_pFontText, std::format(L"LOADING {}%", progress), { 42.5f, m_SceneContext.windowHeight - 225.f }, XMFLOAT4{ Colors::Orange });
+	}
+	else
+		TextRenderer::Get()->DrawText(m_pFontText, L"START GAME", { 42.5f, m_SceneContext.windowHeight - 225.f }, XMFLOAT4{ Colors::Orange });
 
 	// QUIT TEXT
 	TextRenderer::Get()->DrawText(m_pFontText, L"QUIT GAME", { 50.f, m_SceneContext.windowHeight - 125.f }, XMFLOAT4{ Colors::Orange });
@@ -118,6 +133,13 @@ void VO_MenuScene::OnSceneDeactivated()
 
 void VO_MenuScene::LoadGame()
 {
+	//The game scene is loaded in the background (see MainGame), wait for it to finish
+	if (SceneManager::Get()->IsLoading())
+	{
+		m_IsStartRequested = true;
+		return;
+	}
+
 	SceneManager::Get()->NextScene();
 }
 
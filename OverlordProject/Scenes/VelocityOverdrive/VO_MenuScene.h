@@ -11,6 +11,7 @@ public:
 
 protected:
 	void Initialize() override;
+	void Update() override;
 	void Draw() override;
 	void OnGUI() override;
 
@@ -39,6 +40,8 @@ private:
 	FixedCamera* m_pFixedCamera{};
 #pragma endregion
 
+	bool m_IsStartRequested{}; //Start was pressed while the game scene was still loading
+
 	void LoadGame();
 	void QuitGame();
 };
@@ -56,8 +56,10 @@ void SoftwareSkinningScene_3::Update()
 	m_pBone1->GetTransform()->Rotate(m_RotBone1[0], m_RotBone1[1], m_RotBone1[2]);
 
 	// UPDATE VERTICES
-	auto tBone0 = XMMatrixMultiply(XMLoadFloat4x4(&m_pBone0->GetBindPose()), XMLoadFloat4x4(&m_pBone0->GetTransform()->GetWorld()));
-	auto tBone1 = XMMatrixMultiply(XMLoadFloat4x4(&m_pBone1->GetBindPose()), XMLoadFloat4x4(&m_pBone1->GetTransform()->GetWorld()));
+	const XMFLOAT4X4 bone0World{ m_pBone0->GetTransform()->GetWorld() };
+	const XMFLOAT4X4 bone1World{ m_pBone1->GetTransform()->GetWorld() };
+	auto tBone0 = XMMatrixMultiply(XMLoadFloat4x4(&m_pBone0->GetBindPose()), XMLoadFloat4x4(&bone0World));
+	auto tBone1 = XMMatrixMultiply(XMLoadFloat4x4(&m_pBone1->GetBindPose()), XMLoadFloat4x4(&bone1World));
 
 	for (size_t i = 0; i < m_SkinnedVertices.size(); i++)
 	{